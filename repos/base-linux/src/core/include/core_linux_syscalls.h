@@ -48,6 +48,34 @@ inline int lx_unlink(const char *fname)
 }
 
 
+/* flags of 'memfd_create', not provided by all host libc versions */
+enum {
+	LX_MFD_CLOEXEC       = 0x1,
+	LX_MFD_ALLOW_SEALING = 0x2,
+};
+
+
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+	return (int)lx_syscall(SYS_memfd_create, name, flags);
+}
+
+
+/* seals applied via 'fcntl(F_ADD_SEALS)' */
+enum {
+	LX_F_ADD_SEALS   = 1033,
+	LX_F_SEAL_SEAL   = 0x1,
+	LX_F_SEAL_SHRINK = 0x2,
+	LX_F_SEAL_GROW   = 0x4,
+};
+
+
+inline int lx_add_seals(int fd, int seals)
+{
+	return (int)lx_syscall(SYS_fcntl, fd, LX_F_ADD_SEALS, seals);
+}
+
+
 /*******************************************************
  ** Functions used by core's rom-session support code **
  *******************************************************/
@@ -30,17 +30,74 @@ using namespace Core;
 
 static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
 
+
+/**
+ * Create anonymous shared-memory file for backing a RAM dataspace
+ *
+ * \return  file descriptor, or -1 if 'memfd_create' is unsupported
+ */
+static int create_memfd()
+{
+	static bool memfd_supported = true;
+
+	if (!memfd_supported)
+		return -1;
+
+	int const fd = lx_memfd_create("ds", LX_MFD_CLOEXEC | LX_MFD_ALLOW_SEALING);
+	if (fd < 0) {
+		memfd_supported = false;
+		return -1;
+	}
+	return fd;
+}
+
+
+/**
+ * Set the size of the memfd and seal it
+ */
+static bool init_memfd(int const fd, size_t const size)
+{
+	if (lx_ftruncate(fd, size) < 0) {
+		error("could not set size of RAM dataspace memfd to ", size);
+		return false;
+	}
+
+	/*
+	 * Seal the size of the file such that a client cannot shrink the
+	 * dataspace underneath other processes, which would cause them to
+	 * fault on access.
+	 */
+	if (lx_add_seals(fd, LX_F_SEAL_SHRINK | LX_F_SEAL_GROW | LX_F_SEAL_SEAL) < 0) {
+		error("could not seal RAM dataspace memfd");
+		return false;
+	}
+	return true;
+}
+
+
 bool Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
 {
+	if (int const fd = create_memfd(); fd >= 0) {
+
+		if (!init_memfd(fd, ds.size())) {
+			lx_close(fd);
+			return false;
+		}
+
+		ds.fd(fd);
+		return true;
+	}
+
+	/* fall back to a file in the resource path if memfd is unavailable */
 	Linux_dataspace::Filename const fname(resource_path(), "/ds-", ram_ds_cnt++);
 
 	/* create file using a unique file name in the resource path */
 	lx_unlink(fname.string());
 	int const fd = lx_open(fname.string(), O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds.size());
-
-	/* remember file descriptor in dataspace component object */
-	ds.fd(fd);
+	if (fd < 0) {
+		error("could not create RAM dataspace file ", fname);
+		return false;
+	}
 
 	/*
 	 * Wipe the file from the Linux file system. The kernel will still keep the
@@ -49,6 +106,15 @@ bool Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
 	 * w/o the right file descriptor won't be able to open and access the file.
 	 */
 	lx_unlink(fname.string());
+
+	if (lx_ftruncate(fd, ds.size()) < 0) {
+		error("could not set size of RAM dataspace file to ", ds.size());
+		lx_close(fd);
+		return false;
+	}
+
+	/* remember file descriptor in dataspace component object */
+	ds.fd(fd);
 	return true;
 }
 
@@ -114,6 +114,8 @@ class Genode::Capability_space_tpl : Noncopyable
 		Avl_tree<Tree_managed_data> _tree  { };
 		Mutex               mutable _mutex { };
 
+		unsigned long _last_dst_id = 0;
+
 		/**
 		 * Calculate index into _caps_data for capability data object
 		 */
@@ -153,6 +155,8 @@ class Genode::Capability_space_tpl : Noncopyable
 
 					construct_at<Tree_managed_data>(&data, args...);
 
+					data.dst.id = ++_last_dst_id;
+
 					/*
 					 * Register capability in the tree only if it refers to a valid
 					 * object hosted locally within the component (not foreign).
@@ -0,0 +1,240 @@
+/*
+ * \brief  Cache of dataspace properties and file descriptors
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Attaching a dataspace to the local address space requires the size,
+ * the writeability, and the file descriptor of the dataspace, each
+ * obtained via an RPC to core. The cache retains this information for
+ * recently attached dataspace capabilities such that re-attaching the same
+ * dataspace, e.g., by an 'Attached_dataspace' that is repeatedly
+ * constructed, becomes a local operation.
+ *
+ * A retained file descriptor keeps the memory of the dataspace alive even
+ * after the dataspace got freed. This memory is not accounted to any RAM
+ * quota. Therefore, file descriptors are retained for small dataspaces
+ * only, the accumulated size of those dataspaces is tightly bounded, and
+ * the entry of a dataspace is dropped when the component frees the
+ * dataspace.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__DATASPACE_CACHE_H_
+#define _INCLUDE__BASE__INTERNAL__DATASPACE_CACHE_H_
+
+/* Genode includes */
+#include <base/mutex.h>
+#include <dataspace/capability.h>
+
+/* Linux syscall bindings */
+#include <linux_syscalls.h>
+
+namespace Genode {
+
+	class Dataspace_cache;
+
+	Dataspace_cache &dataspace_cache();
+}
+
+
+class Genode::Dataspace_cache : Noncopyable
+{
+	public:
+
+		static constexpr unsigned MAX_ENTRIES  = 32;
+		static constexpr size_t   MAX_FD_BYTES = 64*1024;   /* per dataspace */
+		static constexpr size_t   MAX_BYTES    = 1024*1024; /* all retained fds */
+
+		struct Info
+		{
+			size_t size;
+			bool   writeable;
+		};
+
+		struct Stats
+		{
+			unsigned long info_hits, info_misses, fd_hits, fd_misses, evictions;
+
+			void print(Output &out) const
+			{
+				Genode::print(out, "info hits=", info_hits, " misses=", info_misses, ", "
+				                   "fd hits=", fd_hits, " misses=", fd_misses, ", "
+				                   "evictions=", evictions);
+			}
+		};
+
+	private:
+
+		struct Entry
+		{
+			Dataspace_capability ds { };
+
+			Info info { };
+
+			int fd = -1;  /* retained file descriptor, or -1 */
+
+			unsigned long last_use = 0;
+
+			bool used() const { return ds.valid(); }
+		};
+
+		Mutex mutable _mutex { };
+
+		Entry _entries[MAX_ENTRIES] { };
+
+		unsigned long _use_count = 0;
+
+		size_t _fd_bytes = 0;  /* accumulated size of entries with retained fd */
+
+		Stats _stats { };
+
+		void _release_fd(Entry &entry)
+		{
+			if (entry.fd < 0)
+				return;
+
+			lx_close(entry.fd);
+			entry.fd   = -1;
+			_fd_bytes -= entry.info.size;
+		}
+
+		void _evict(Entry &entry)
+		{
+			_release_fd(entry);
+			entry = Entry();
+			_stats.evictions++;
+		}
+
+		Entry *_lookup(Dataspace_capability const &ds)
+		{
+			for (Entry &entry : _entries)
+				if (entry.used() && entry.ds == ds) {
+					entry.last_use = ++_use_count;
+					return &entry;
+				}
+			return nullptr;
+		}
+
+		/**
+		 * Return least-recently used entry that matches 'cond_fn'
+		 */
+		Entry *_lru(auto const &cond_fn)
+		{
+			Entry *lru = nullptr;
+			for (Entry &entry : _entries)
+				if (cond_fn(entry) && (!lru || entry.last_use < lru->last_use))
+					lru = &entry;
+			return lru;
+		}
+
+		Entry &_alloc_entry()
+		{
+			for (Entry &entry : _entries)
+				if (!entry.used())
+					return entry;
+
+			Entry &lru = *_lru([] (Entry const &) { return true; });
+			_evict(lru);
+			return lru;
+		}
+
+	public:
+
+		/**
+		 * Return size and writeability of dataspace
+		 *
+		 * \param obtain_fn  functor returning the 'Info' of a dataspace
+		 *                   that is not present in the cache
+		 */
+		Info info(Dataspace_capability const &ds, auto const &obtain_fn)
+		{
+			Mutex::Guard guard(_mutex);
+
+			if (Entry const *entry = _lookup(ds)) {
+				_stats.info_hits++;
+				return entry->info;
+			}
+
+			_stats.info_misses++;
+
+			Entry &entry = _alloc_entry();
+			entry.ds       = ds;
+			entry.info     = obtain_fn();
+			entry.last_use = ++_use_count;
+			return entry.info;
+		}
+
+		/**
+		 * Return file descriptor of dataspace, owned by the caller
+		 *
+		 * \param obtain_fn  functor returning a new file descriptor for a
+		 *                   dataspace without a retained file descriptor
+		 */
+		int dup_fd(Dataspace_capability const &ds, auto const &obtain_fn)
+		{
+			Mutex::Guard guard(_mutex);
+
+			Entry * const entry = _lookup(ds);
+
+			if (entry && entry->fd >= 0) {
+				_stats.fd_hits++;
+				return lx_dup(entry->fd);
+			}
+
+			_stats.fd_misses++;
+
+			int const fd = obtain_fn();
+
+			if (!entry || fd < 0 || entry->info.size > MAX_FD_BYTES)
+				return fd;
+
+			/* make room by releasing the least-recently used file descriptors */
+			while (_fd_bytes + entry->info.size > MAX_BYTES)
+				_release_fd(*_lru([] (Entry const &e) { return e.fd >= 0; }));
+
+			entry->fd  = lx_dup(fd);
+			_fd_bytes += entry->fd >= 0 ? entry->info.size : 0;
+			return fd;
+		}
+
+		/**
+		 * Drop cached information about a dataspace
+		 *
+		 * Called before the dataspace gets freed such that no retained
+		 * file descriptor keeps its memory alive.
+		 */
+		void forget(Dataspace_capability const &ds)
+		{
+			Mutex::Guard guard(_mutex);
+
+			for (Entry &entry : _entries)
+				if (entry.used() && entry.ds == ds)
+					_evict(entry);
+		}
+
+		/**
+		 * Drop all cached information
+		 */
+		void flush()
+		{
+			Mutex::Guard guard(_mutex);
+
+			for (Entry &entry : _entries)
+				if (entry.used())
+					_evict(entry);
+		}
+
+		Stats stats() const
+		{
+			Mutex::Guard guard(_mutex);
+			return _stats;
+		}
+};
+
+#endif /* _INCLUDE__BASE__INTERNAL__DATASPACE_CACHE_H_ */
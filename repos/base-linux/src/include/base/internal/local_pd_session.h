@@ -50,6 +50,11 @@ struct Genode::Local_pd_session : Expanding_pd_session_client
 	{
 		return Local_capability<Region_map>::local_cap(&_linker_area);
 	}
+
+	/*
+	 * Drop the dataspace from the dataspace cache before freeing it
+	 */
+	void free_ram(Ram_dataspace_capability) override;
 };
 
 #endif /* _INCLUDE__BASE__INTERNAL__LOCAL_PD_SESSION_H_ */
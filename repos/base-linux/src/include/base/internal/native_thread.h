@@ -16,6 +16,7 @@
 
 #include <base/stdint.h>
 #include <base/native_capability.h>
+#include <util/reconstructible.h>
 
 #include <linux_syscalls.h>
 
@@ -97,6 +98,47 @@ struct Genode::Native_thread : Noncopyable
 
 	} epoll { };
 
+	/**
+	 * Socket pairs for receiving RPC replies, cached per RPC destination
+	 *
+	 * The remote end of a reply channel is handed out to the server of a
+	 * single RPC destination only. So replies received via the channel
+	 * can only originate from this server, which allows for reusing the
+	 * channel for subsequent calls of the same destination instead of
+	 * creating and closing a socket pair per call.
+	 */
+	class Reply_channels : Noncopyable
+	{
+		private:
+
+			struct Entry
+			{
+				unsigned long dst_id = 0;
+
+				Constructible<Lx_socketpair> sockets { };
+
+				void release();
+			};
+
+			enum { NUM_ENTRIES = 4 };
+
+			Entry _entries[NUM_ENTRIES] { };
+
+			unsigned _next_victim = 0;
+
+		public:
+
+			Reply_channels() { }
+
+			~Reply_channels();
+
+			/**
+			 * Return reply channel for the RPC destination with the given ID
+			 */
+			Lx_socketpair const &channel(unsigned long dst_id);
+
+	} reply_channels { };
+
 	Native_thread() { }
 };
 
@@ -34,6 +34,15 @@ struct Genode::Rpc_destination
 	 */
 	bool foreign = true;
 
+	/*
+	 * Identity assigned by the capability space when importing the socket
+	 *
+	 * In contrast to the socket descriptor, which may be reused after the
+	 * capability is released, the ID is never assigned twice. The value 0
+	 * denotes an unknown identity.
+	 */
+	unsigned long id = 0;
+
 	Rpc_destination(Lx_sd socket) : socket(socket) { }
 
 	bool valid() const { return socket.valid(); }
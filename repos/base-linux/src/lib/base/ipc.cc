@@ -283,35 +283,18 @@ static inline void lx_reply(Lx_sd reply_socket, Rpc_exception_code exception_cod
  ** IPC client **
  ****************/
 
-Rpc_exception_code Genode::ipc_call(Native_capability dst,
-                                    Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
-                                    size_t)
+/**
+ * Perform RPC call, receiving the reply via the given reply channel
+ */
+static Rpc_exception_code call(Lx_sd const dst_socket, Lx_socketpair const &reply_channel,
+                               Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf)
 {
-	if (!dst.valid()) {
-		error("attempt to call invalid capability, blocking forever");
-		sleep_forever();
-	}
-
 	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
 	snd_header.protocol_word = 0;
 
 	Message snd_msg(snd_header.msg_start(),
 	                sizeof(Protocol_header) + snd_msgbuf.data_size());
 
-	/*
-	 * Create reply channel
-	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
-	 */
-	struct Reply_channel : Lx_socketpair
-	{
-		~Reply_channel()
-		{
-			if (local.value  != -1) lx_close(local.value);
-			if (remote.value != -1) lx_close(remote.value);
-		}
-	} reply_channel;
-
 	/* assemble message */
 
 	/* marshal reply capability */
@@ -320,8 +303,6 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	/* marshal capabilities contained in 'snd_msgbuf' */
 	insert_sds_into_message(snd_msg, snd_header, snd_msgbuf);
 
-	Lx_sd const dst_socket = Capability_space::ipc_cap_data(dst).dst.socket;
-
 	int const send_ret = lx_sendmsg(dst_socket, snd_msg.msg(), 0);
 	if (send_ret < 0) {
 		error(lx_getpid(), ":", lx_gettid(), " lx_sendmsg to sd ", dst_socket,
@@ -360,6 +341,49 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 }
 
 
+Rpc_exception_code Genode::ipc_call(Native_capability dst,
+                                    Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
+                                    size_t)
+{
+	if (!dst.valid()) {
+		error("attempt to call invalid capability, blocking forever");
+		sleep_forever();
+	}
+
+	Rpc_destination const destination = Capability_space::ipc_cap_data(dst).dst;
+
+	/*
+	 * Use a temporary reply channel if the caller is not a Genode thread,
+	 * i.e., the initial thread, or if the identity of the destination is
+	 * unknown. The channel is closed when leaving the scope.
+	 */
+	auto call_via_temporary_channel = [&]
+	{
+		struct Reply_channel : Lx_socketpair
+		{
+			~Reply_channel()
+			{
+				if (local.value  != -1) lx_close(local.value);
+				if (remote.value != -1) lx_close(remote.value);
+			}
+		} reply_channel;
+
+		return call(destination.socket, reply_channel, snd_msgbuf, rcv_msgbuf);
+	};
+
+	Thread * const myself_ptr = Thread::myself();
+	if (!myself_ptr || destination.id == 0)
+		return call_via_temporary_channel();
+
+	return myself_ptr->with_native_thread(
+		[&] (Native_thread &nt) {
+			return call(destination.socket,
+			            nt.reply_channels.channel(destination.id),
+			            snd_msgbuf, rcv_msgbuf); },
+		[&] { return call_via_temporary_channel(); });
+}
+
+
 /****************
  ** IPC server **
  ****************/
@@ -204,3 +204,41 @@ void Native_thread::Epoll::free_rpc_cap(Native_capability cap)
 
 	_exec_control([&] { _remove(Lx_sd{local_socket}); });
 }
+
+
+void Native_thread::Reply_channels::Entry::release()
+{
+	if (!sockets.constructed())
+		return;
+
+	lx_close(sockets->local.value);
+	lx_close(sockets->remote.value);
+
+	sockets.destruct();
+	dst_id = 0;
+}
+
+
+Native_thread::Reply_channels::~Reply_channels()
+{
+	for (Entry &entry : _entries)
+		entry.release();
+}
+
+
+Lx_socketpair const &Native_thread::Reply_channels::channel(unsigned long const dst_id)
+{
+	for (Entry &entry : _entries)
+		if (entry.sockets.constructed() && entry.dst_id == dst_id)
+			return *entry.sockets;
+
+	/* replace the entries in round-robin fashion */
+	Entry &entry = _entries[_next_victim];
+	_next_victim = (_next_victim + 1) % NUM_ENTRIES;
+
+	entry.release();
+	entry.sockets.construct();
+	entry.dst_id = dst_id;
+
+	return *entry.sockets;
+}
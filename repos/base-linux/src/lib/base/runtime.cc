@@ -23,6 +23,7 @@
 #include <base/internal/native_thread.h>
 #include <base/internal/parent_socket_handle.h>
 #include <base/internal/capability_space_tpl.h>
+#include <base/internal/dataspace_cache.h>
 
 using namespace Genode;
 
@@ -31,26 +32,54 @@ using namespace Genode;
  ** Support for Rm_session_mmap **
  *********************************/
 
+Dataspace_cache &Genode::dataspace_cache()
+{
+	static Dataspace_cache inst { };
+	return inst;
+}
+
+
+static Dataspace_cache::Info cached_dataspace_info(Dataspace_capability ds)
+{
+	return dataspace_cache().info(ds, [&] {
+		Dataspace_client client(ds);
+		return Dataspace_cache::Info { .size      = client.size(),
+		                               .writeable = client.writeable() }; });
+}
+
+
 size_t Region_map_mmap::_dataspace_size(Dataspace_capability ds)
 {
 	if (local(ds))
 		return Local_capability<Dataspace>::deref(ds)->size();
 
-	return Dataspace_client(ds).size();
-
+	return cached_dataspace_info(ds).size;
 }
 
 
 int Region_map_mmap::_dataspace_fd(Dataspace_capability ds)
 {
-	Untyped_capability fd_cap = Linux_dataspace_client(ds).fd();
-	return lx_dup(Capability_space::ipc_cap_data(fd_cap).dst.socket.value);
+	return dataspace_cache().dup_fd(ds, [&] {
+		Untyped_capability fd_cap = Linux_dataspace_client(ds).fd();
+		return lx_dup(Capability_space::ipc_cap_data(fd_cap).dst.socket.value); });
 }
 
 
 bool Region_map_mmap::_dataspace_writeable(Dataspace_capability ds)
 {
-	return Dataspace_client(ds).writeable();
+	return cached_dataspace_info(ds).writeable;
+}
+
+
+/**********************
+ ** Local_pd_session **
+ **********************/
+
+void Local_pd_session::free_ram(Ram_dataspace_capability ds)
+{
+	dataspace_cache().forget(ds);
+
+	Expanding_pd_session_client::free_ram(ds);
 }
 
 
@@ -0,0 +1,85 @@
+/*
+ * \brief  Benchmark for re-attaching dataspaces on Linux
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The benchmark repeatedly attaches and detaches the same dataspace, once
+ * with the dataspace cache in effect and once with the cache flushed
+ * before each attach operation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_dataspace.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+
+/* base-internal includes */
+#include <base/internal/dataspace_cache.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	static constexpr unsigned NUM_ROUNDS = 10000;
+
+	void _measure(char const *name, size_t const size, bool const flush)
+	{
+		Ram_dataspace_capability const ds = _env.ram().alloc(size);
+
+		uint64_t const start_us = _timer.curr_time().trunc_to_plain_us().value;
+
+		for (unsigned i = 0; i < NUM_ROUNDS; i++) {
+
+			if (flush)
+				dataspace_cache().flush();
+
+			Attached_dataspace attached { _env.rm(), ds };
+			*attached.local_addr<char volatile>() = 1;
+		}
+
+		uint64_t const us = max(_timer.curr_time().trunc_to_plain_us().value
+		                        - start_us, 1ULL);
+
+		_env.ram().free(ds);
+
+		log(name, " size ", Number_of_bytes(size), ": ",
+		    (NUM_ROUNDS*1000000ULL)/us, " attach/detach/s");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- dataspace attach benchmark ---");
+
+		static size_t const sizes[] = { 4*1024, 64*1024, 1024*1024 };
+
+		for (size_t const size : sizes) {
+			_measure("uncached", size, true);
+			_measure("cached  ", size, false);
+		}
+
+		log("cache statistics: ", dataspace_cache().stats());
+
+		log("--- dataspace attach benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
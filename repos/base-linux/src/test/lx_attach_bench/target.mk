@@ -0,0 +1,4 @@
+TARGET   = test-lx_attach_bench
+SRC_CC   = main.cc
+LIBS     = base syscall-linux
+INC_DIR += $(REP_DIR)/src/include $(BASE_DIR)/src/include
@@ -0,0 +1,84 @@
+/*
+ * \brief  Benchmark for the allocation of RAM dataspaces
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The benchmark measures the rate of allocating, attaching, touching, and
+ * freeing RAM dataspaces of different sizes, which reflects the cost of
+ * creating the backing store in core and of populating the memory.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	static constexpr uint64_t DURATION_MS = 1000;
+
+	/**
+	 * Allocate and release dataspaces of 'size' bytes for 'DURATION_MS'
+	 */
+	void _measure(size_t const size)
+	{
+		uint64_t const start_ms = _timer.elapsed_ms();
+		uint64_t       end_ms   = start_ms;
+
+		unsigned long count = 0;
+
+		while (end_ms - start_ms < DURATION_MS) {
+
+			Attached_ram_dataspace ds { _env.ram(), _env.rm(), size };
+
+			/* touch each page to account for populating the memory */
+			char * const ptr = ds.local_addr<char>();
+			for (size_t offset = 0; offset < size; offset += 4096)
+				ptr[offset] = 1;
+
+			count++;
+			end_ms = _timer.elapsed_ms();
+		}
+
+		uint64_t const ms = end_ms - start_ms;
+
+		log("size ", Number_of_bytes(size), ": ",
+		    (count*1000)/ms, " allocations/s, ",
+		    (count*(size/1024)*1000)/(ms*1024), " MiB/s");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RAM allocation benchmark ---");
+
+		static size_t const sizes[] = { 4*1024, 64*1024, 1024*1024,
+		                                4*1024*1024, 16*1024*1024 };
+		for (size_t const size : sizes)
+			_measure(size);
+
+		log("--- RAM allocation benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-lx_ram_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -58,6 +58,8 @@ class Genode::Entrypoint : Noncopyable
 		struct Signal_proxy_component :
 			Rpc_object<Signal_proxy, Signal_proxy_component>
 		{
+			static constexpr unsigned MAX_SIGNALS_PER_DELIVERY = 16;
+
 			Entrypoint &ep;
 			Signal_proxy_component(Entrypoint &ep) : ep(ep) { }
 
@@ -0,0 +1,273 @@
+/*
+ * \brief  Pool of entrypoints serving RPC objects in parallel
+ * \author agent
+ * \date   2026-10-18
+ *
+ * An entrypoint dispatches the RPC requests for all objects it manages in a
+ * single thread. A server that hosts independent objects, e.g., one session
+ * object per client, can distribute those objects over a pool of
+ * entrypoints, each running in a thread of its own, optionally pinned to
+ * a distinct CPU.
+ *
+ * Each object is served by exactly one entrypoint of the pool. Hence, the
+ * requests for one object are always processed in order. Objects that share
+ * state can be co-located at the same entrypoint to serialize their requests
+ * with respect to each other. Objects managed at different entrypoints are
+ * invoked concurrently and must synchronize access to shared state.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__ENTRYPOINT_POOL_H_
+#define _INCLUDE__BASE__ENTRYPOINT_POOL_H_
+
+#include <base/allocator.h>
+#include <base/entrypoint.h>
+#include <base/env.h>
+#include <base/mutex.h>
+#include <util/avl_tree.h>
+#include <util/reconstructible.h>
+
+namespace Genode { class Entrypoint_pool; }
+
+
+class Genode::Entrypoint_pool : Noncopyable
+{
+	public:
+
+		static constexpr unsigned MAX_ENTRYPOINTS = 16;
+
+		using Name = String<32>;
+
+		struct Attr
+		{
+			unsigned count;       /* number of entrypoints, limited to
+			                         'MAX_ENTRYPOINTS' */
+			size_t   stack_size;
+			Name     name;        /* name prefix of the entrypoint threads */
+			bool     pin;         /* assign distinct CPUs to the entrypoints */
+		};
+
+	private:
+
+		struct Member : Noncopyable
+		{
+			Entrypoint ep;
+
+			unsigned num_objects = 0;
+
+			Member(Env &env, size_t stack_size, Name const &name,
+			       Affinity::Location location)
+			: ep(env, stack_size, name.string(), location) { }
+		};
+
+		Constructible<Member> _members[MAX_ENTRYPOINTS] { };
+
+		unsigned const _count;
+
+		/*
+		 * Association of a managed object with its entrypoint
+		 *
+		 * The pool keeps track of the associations by itself instead of
+		 * asking the entrypoints. A lookup at an entrypoint would take the
+		 * lock of the object entry, which is held while the object's RPC
+		 * function is executed.
+		 */
+		struct Assignment : Avl_node<Assignment>
+		{
+			Rpc_object_base const &obj;
+			Member                &member;
+
+			Assignment(Rpc_object_base const &obj, Member &member)
+			: obj(obj), member(member) { }
+
+			addr_t _key() const { return addr_t(&obj); }
+
+			bool higher(Assignment const *other) const
+			{
+				return other->_key() > _key();
+			}
+
+			Assignment *find(Rpc_object_base const &o)
+			{
+				if (addr_t(&o) == _key())
+					return this;
+
+				Assignment *a = Avl_node<Assignment>::child(addr_t(&o) > _key());
+				return a ? a->find(o) : nullptr;
+			}
+		};
+
+		Allocator &_alloc;
+
+		Avl_tree<Assignment> _assignments { };
+
+		Mutex mutable _mutex { };
+
+		void _for_each_member(auto const &fn)
+		{
+			for (unsigned i = 0; i < _count; i++)
+				fn(*_members[i]);
+		}
+
+		Member &_least_loaded()
+		{
+			Member *result = &*_members[0];
+			_for_each_member([&] (Member &m) {
+				if (m.num_objects < result->num_objects)
+					result = &m; });
+			return *result;
+		}
+
+		Assignment *_find(Rpc_object_base const &obj)
+		{
+			return _assignments.first() ? _assignments.first()->find(obj) : nullptr;
+		}
+
+		/**
+		 * Return member that manages 'obj', or nullptr
+		 */
+		Member *_member_of(Rpc_object_base const &obj)
+		{
+			Mutex::Guard guard(_mutex);
+
+			Assignment const * const a = _find(obj);
+			return a ? &a->member : nullptr;
+		}
+
+		/**
+		 * Record the assignment of 'obj' to 'member', called with '_mutex' held
+		 */
+		void _assign(Rpc_object_base const &obj, Member &member)
+		{
+			member.num_objects++;
+			_assignments.insert(new (_alloc) Assignment(obj, member));
+		}
+
+		static unsigned _limited(unsigned count)
+		{
+			return max(1U, min(count, MAX_ENTRYPOINTS));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator for the book keeping of managed objects
+		 */
+		Entrypoint_pool(Env &env, Allocator &alloc, Attr const &attr)
+		:
+			_count(_limited(attr.count)), _alloc(alloc)
+		{
+			Affinity::Space const space = env.cpu().affinity_space();
+
+			for (unsigned i = 0; i < _count; i++) {
+
+				Affinity::Location const location =
+					attr.pin ? space.location_of_index(i) : Affinity::Location();
+
+				_members[i].construct(env, attr.stack_size,
+				                      Name(attr.name, "_", i), location);
+			}
+		}
+
+		~Entrypoint_pool()
+		{
+			while (Assignment *a = _assignments.first()) {
+				_assignments.remove(a);
+				destroy(_alloc, a);
+			}
+		}
+
+		unsigned count() const { return _count; }
+
+		/**
+		 * Associate RPC object with the least loaded entrypoint
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		Capability<RPC_INTERFACE>
+		manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> &obj)
+		{
+			Member *member_ptr = nullptr;
+			{
+				Mutex::Guard guard(_mutex);
+
+				member_ptr = &_least_loaded();
+				_assign(obj, *member_ptr);
+			}
+			return member_ptr->ep.manage(obj);
+		}
+
+		/**
+		 * Associate RPC object with the entrypoint of an already managed object
+		 *
+		 * This way, the requests for both objects are serialized.
+		 *
+		 * \return invalid capability if 'colocated' is not managed by the pool
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		Capability<RPC_INTERFACE>
+		manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> &obj,
+		       Rpc_object_base const &colocated)
+		{
+			Member *member_ptr = nullptr;
+			{
+				Mutex::Guard guard(_mutex);
+
+				Assignment const * const a = _find(colocated);
+				if (!a)
+					return { };
+
+				member_ptr = &a->member;
+				_assign(obj, *member_ptr);
+			}
+			return member_ptr->ep.manage(obj);
+		}
+
+		/**
+		 * Dissolve RPC object from the pool
+		 *
+		 * The pool's lock is not held while the object is dissolved from its
+		 * entrypoint, which may need to wait for a request in progress.
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		void dissolve(Rpc_object<RPC_INTERFACE, RPC_SERVER> &obj)
+		{
+			Member *member_ptr = nullptr;
+			{
+				Mutex::Guard guard(_mutex);
+
+				Assignment * const a = _find(obj);
+				if (!a)
+					return;
+
+				member_ptr = &a->member;
+				member_ptr->num_objects--;
+				_assignments.remove(a);
+				destroy(_alloc, a);
+			}
+			member_ptr->ep.dissolve(obj);
+		}
+
+		/**
+		 * Call 'fn' with the entrypoint that serves the given RPC object
+		 *
+		 * This is useful for installing signal handlers at the same
+		 * entrypoint as the RPC object such that signals and RPC requests
+		 * for the object are serialized. The function may be called from
+		 * within an RPC function of any object of the pool.
+		 */
+		void with_entrypoint(Rpc_object_base const &obj, auto const &fn)
+		{
+			if (Member * const member_ptr = _member_of(obj))
+				fn(member_ptr->ep);
+		}
+};
+
+#endif /* _INCLUDE__BASE__ENTRYPOINT_POOL_H_ */
@@ -198,6 +198,11 @@ class Genode::Signal_context : Interface, Noncopyable
 		Signal_context mutable *_next { nullptr };
 		Signal_context mutable *_prev { nullptr };
 
+		/**
+		 * Queue element in the receiver's queue of pending contexts
+		 */
+		Signal_context *_pending_next { nullptr };
+
 		/**
 		 * List element in process-global registry
 		 */
@@ -314,6 +319,51 @@ class Genode::Signal_receiver : Noncopyable
 				}
 		};
 
+		/**
+		 * Queue of contexts with a pending signal
+		 *
+		 * Submitters enqueue contexts without taking a lock by pushing them
+		 * onto a stack. The receiver takes all submitted contexts at once
+		 * and dequeues them in the order of their submission. All methods
+		 * except for 'enqueue' must be called with the receiver's
+		 * '_pending_mutex' acquired.
+		 */
+		class Pending_queue
+		{
+			private:
+
+				Signal_context *_submitted { nullptr };  /* most recent first */
+
+				Signal_context *_head { nullptr };
+				Signal_context *_tail { nullptr };
+
+				void _take_submitted();
+
+				/*
+				 * Noncopyable
+				 */
+				Pending_queue(Pending_queue const &);
+				Pending_queue &operator = (Pending_queue const &);
+
+			public:
+
+				Pending_queue() { }
+
+				/**
+				 * Enqueue context, called with the context's mutex acquired
+				 *
+				 * \return  true if the queue of submitted contexts was empty,
+				 *          which calls for waking up the receiver
+				 */
+				bool enqueue(Signal_context &);
+
+				Signal_context *dequeue();
+
+				void remove(Signal_context &);
+
+				bool empty() const;
+		};
+
 		Pd_session &_pd;
 
 		/**
@@ -334,6 +384,12 @@ class Genode::Signal_receiver : Noncopyable
 		Mutex        _contexts_mutex { };
 		Context_ring _contexts       { };
 
+		/**
+		 * Contexts with a pending signal
+		 */
+		Mutex         _pending_mutex    { };
+		Pending_queue _pending_contexts { };
+
 		/**
 		 * Helper to dissolve given context
 		 *
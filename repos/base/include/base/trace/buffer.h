@@ -85,6 +85,13 @@
  * to use half of the buffer. Care must be taken, however, to eliminate a race
  * between the producer wrapping and the consumer switching to the foreground
  * buffer.
+ *
+ * Each entry carries a sequence number assigned by the producer. The
+ * sequence numbers of consecutive entries are consecutive, also across
+ * partition switches. This way, the consumer can account for each entry
+ * lost due to overwriting by comparing the sequence number of an entry with
+ * the one expected, independent of the wrap and lost-entries counters that
+ * are only updated when the producer switches partitions.
  */
 
 /*
@@ -123,6 +130,8 @@ class Genode::Trace::Simple_buffer
 		size_t            _size;         /* in bytes */
 		unsigned volatile _num_entries;  /* number of entries currently in buffer */
 
+		unsigned long long _sequence;    /* sequence number of next entry */
+
 		struct _Entry
 		{
 			enum Type : size_t {
@@ -130,8 +139,9 @@ class Genode::Trace::Simple_buffer
 				PADDING  = ~(size_t)0
 			};
 
-			size_t len;
-			char   data[0];
+			size_t             len;
+			unsigned long long seq;
+			char               data[0];
 
 			void mark(Type t)    { len = t; }
 
@@ -179,12 +189,14 @@ class Genode::Trace::Simple_buffer
 				return;
 
 			/**
-			 * remember current length field so that we can write it after we set
-			 * the new head
+			 * remember current entry so that we can write its length after we
+			 * set the new head
 			 */
-			size_t *old_head_len = &_head_entry()->len;
+			_Entry *old_head = _head_entry();
 			_num_entries = _num_entries + 1;
 
+			old_head->seq = _sequence++;
+
 			/* advance head offset, wrap when next entry does not fit into buffer */
 			_head_offset += sizeof(_Entry) + len;
 			if (_head_offset + sizeof(_Entry) > _size)
@@ -194,7 +206,7 @@ class Genode::Trace::Simple_buffer
 			else if (_head_offset + sizeof(_Entry) <= _size)
 				_head_entry()->mark(_Entry::HEAD);
 
-			*old_head_len = len;
+			old_head->len = len;
 		}
 
 	public:
@@ -206,6 +218,7 @@ class Genode::Trace::Simple_buffer
 		void init(size_t size)
 		{
 			_head_offset = 0;
+			_sequence    = 0;
 
 			/* compute number of bytes available for tracing data */
 			size_t const header_size = (addr_t)&_entries - (addr_t)this;
@@ -255,6 +268,9 @@ class Genode::Trace::Simple_buffer
 				size_t      length() const { return _entry->len; }
 				char const *data()   const { return _entry->data; }
 
+				/* sequence number assigned by the producer */
+				unsigned long long sequence() const { return _entry->seq; }
+
 				template <typename T>
 				T const    &object() const { return *reinterpret_cast<const T*>(data()); }
 
@@ -271,6 +287,9 @@ class Genode::Trace::Simple_buffer
 		/* Return whether buffer has been initialized. */
 		bool initialized() const { return _size && _head_offset <= _size; }
 
+		/* Return buffer space occupied by an entry of 'len' bytes */
+		static constexpr size_t entry_size(size_t len) { return sizeof(_Entry) + len; }
+
 		/* Return the very first entry at the start of the buffer. */
 		Entry first() const
 		{
@@ -32,6 +32,7 @@ namespace Genode {
 	class Time_source;
 	class Timeout;
 	class Timeout_handler;
+	class Timeout_wheel;
 	class Timeout_scheduler;
 }
 
@@ -85,10 +86,10 @@ struct Genode::Time_source : Interface
  * example, in a Timer-session server. If this is not the case, the classes
  * Periodic_timeout and One_shot_timeout are the better choice.
  */
-class Genode::Timeout : private Noncopyable,
-                        public Genode::List<Timeout>::Element
+class Genode::Timeout : private Noncopyable
 {
 	friend class Timeout_scheduler;
+	friend class Timeout_wheel;
 
 	private:
 
@@ -96,6 +97,10 @@ class Genode::Timeout : private Noncopyable,
 		Timeout_scheduler     &_scheduler;
 		Microseconds           _period              { 0 };
 		Microseconds           _deadline            { Microseconds { 0 } };
+		Timeout               *_wheel_next          { nullptr };
+		Timeout              **_wheel_pprev         { nullptr };
+		unsigned               _wheel_level         { 0 };
+		unsigned               _wheel_slot          { 0 };
 		List_element<Timeout>  _pending_timeouts_le { this };
 		Timeout_handler       *_pending_handler     { nullptr };
 		Timeout_handler       *_handler             { nullptr };
@@ -117,8 +122,15 @@ class Genode::Timeout : private Noncopyable,
 		void schedule_periodic(Microseconds     duration,
 		                       Timeout_handler &handler);
 
+		/**
+		 * Schedule one-shot timeout
+		 *
+		 * \param slack  tolerated delay of the timeout, which allows for
+		 *               coalescing timeouts with similar deadlines
+		 */
 		void schedule_one_shot(Microseconds     duration,
-		                       Timeout_handler &handler);
+		                       Timeout_handler &handler,
+		                       Microseconds     slack = Microseconds { 0 });
 
 		void discard();
 
@@ -128,6 +140,95 @@ class Genode::Timeout : private Noncopyable,
 };
 
 
+/**
+ * Hierarchical timer wheel that orders timeouts by their deadlines
+ *
+ * Each level of the wheel consists of 'NUM_SLOTS' slots. A timeout is held
+ * at the level that corresponds to the most significant bit in which its
+ * deadline differs from the wheel time, in the slot selected by the
+ * deadline bits of this level. Inserting and removing a timeout take
+ * constant time. While the wheel time advances, each timeout descends at
+ * most once per level until it expires.
+ */
+class Genode::Timeout_wheel
+{
+	public:
+
+		static constexpr unsigned SLOT_BITS  = 6;
+		static constexpr unsigned NUM_SLOTS  = 1 << SLOT_BITS;
+		static constexpr unsigned NUM_LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+
+	private:
+
+		struct Level
+		{
+			Timeout  *slots[NUM_SLOTS] { };
+			uint64_t  occupied = 0;  /* bit mask of non-empty slots */
+		};
+
+		Level     _levels[NUM_LEVELS] { };
+		Timeout  *_expired { nullptr };  /* deadline not after wheel time */
+		uint64_t  _time    { 0 };
+
+		static uint64_t _prefix(uint64_t time, unsigned level)
+		{
+			unsigned const shift = SLOT_BITS*(level + 1);
+			return shift >= 64 ? 0 : (time >> shift) << shift;
+		}
+
+		/**
+		 * Return point in time when the timeouts of the slot become due
+		 * for being moved to a lower level, or for expiring at level 0
+		 */
+		uint64_t _slot_start(unsigned level, unsigned slot) const
+		{
+			return _prefix(_time, level) | ((uint64_t)slot << (SLOT_BITS*level));
+		}
+
+		static void _link(Timeout *&head, Timeout &timeout);
+
+		Timeout_wheel(Timeout_wheel const &);
+
+		Timeout_wheel &operator = (Timeout_wheel const &);
+
+	public:
+
+		Timeout_wheel() { }
+
+		void insert(Timeout &timeout);
+
+		/**
+		 * Remove timeout from wheel, if present
+		 */
+		void remove(Timeout &timeout);
+
+		/**
+		 * Advance wheel time
+		 *
+		 * Timeouts with a deadline not after the new time can be obtained
+		 * via 'take_expired' afterwards.
+		 */
+		void advance(uint64_t time);
+
+		/**
+		 * Remove and return one expired timeout
+		 */
+		Timeout *take_expired();
+
+		/**
+		 * Return any timeout of the wheel, or nullptr if the wheel is empty
+		 */
+		Timeout *any();
+
+		/**
+		 * Return point in time at which the wheel must be advanced next
+		 *
+		 * \return  ~0 if the wheel is empty
+		 */
+		uint64_t next_event() const;
+};
+
+
 /**
  * Multiplexes one time source amongst different timeouts
  */
@@ -145,14 +246,12 @@ class Genode::Timeout_scheduler : private Noncopyable,
 		Mutex               _mutex              { };
 		Time_source        &_time_source;
 		Microseconds const  _max_sleep_time     { min(_time_source.max_timeout().value, max_sleep_time_us) };
-		List<Timeout>       _timeouts           { };
+		Timeout_wheel       _timeouts           { };
 		Microseconds        _current_time       { 0 };
 		bool                _destructor_called  { false };
 		Microseconds        _rate_limit_period;
 		Microseconds        _rate_limit_deadline;
 
-		void _insert_into_timeouts_list(Timeout &timeout);
-
 		void _set_time_source_timeout();
 
 		void _set_time_source_timeout(uint64_t duration_us);
@@ -160,6 +259,7 @@ class Genode::Timeout_scheduler : private Noncopyable,
 		void _schedule_timeout(Timeout         &timeout,
 		                       Microseconds     duration,
 		                       Microseconds     period,
+		                       Microseconds     slack,
 		                       Timeout_handler &handler);
 
 		void _discard_timeout_unsynchronized(Timeout &timeout);
@@ -168,7 +268,8 @@ class Genode::Timeout_scheduler : private Noncopyable,
 
 		void _schedule_one_shot_timeout(Timeout         &timeout,
 		                                Microseconds     duration,
-                                        Timeout_handler &handler);
+		                                Microseconds     slack,
+		                                Timeout_handler &handler);
 
 		void _schedule_periodic_timeout(Timeout         &timeout,
 		                                Microseconds     period,
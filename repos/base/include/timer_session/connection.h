@@ -111,8 +111,14 @@ class Timer::One_shot_timeout : private Genode::Noncopyable,
 			_method  { method }
 		{ }
 
-		void schedule(Microseconds duration) {
-			_timeout.schedule_one_shot(duration, *this); }
+		/**
+		 * Schedule timeout
+		 *
+		 * \param slack  tolerated delay, which allows for coalescing
+		 *               timeouts with similar deadlines
+		 */
+		void schedule(Microseconds duration, Microseconds slack = Microseconds { 0 }) {
+			_timeout.schedule_one_shot(duration, *this, slack); }
 
 		void discard() { _timeout.discard(); }
 
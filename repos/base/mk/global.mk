@@ -230,10 +230,12 @@ CXX_LINK_OPT       += $(addprefix $(LD_OPT_PREFIX),$(LD_OPT))
 CXX_LINK_OPT       += $(LD_OPT_NOSTDLIB)
 
 #
-# Genode linker does not support .gnu.hash so there is no point in having it
-# in the ELF files. Tell the linker to only produce SysV hash tables.
+# The Genode linker prefers the .gnu.hash table for symbol lookups because its
+# Bloom filter skips most objects that do not define a symbol. The SysV hash
+# table is still needed for looking up undefined symbols of executables,
+# which are not covered by .gnu.hash.
 #
-LD_OPT += --hash-style=sysv
+LD_OPT += --hash-style=both
 
 #
 # Linker script for dynamically linked programs
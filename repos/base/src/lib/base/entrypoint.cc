@@ -44,14 +44,20 @@ void Entrypoint::Signal_proxy_component::signal()
 	bool io_progress = false;
 
 	/*
-	 * Try to dispatch one pending signal picked-up by the signal-proxy thread.
-	 * Note, we handle only one signal here to ensure fairness between RPCs and
-	 * signals.
+	 * Dispatch the signals picked-up by the signal-proxy thread. One wakeup
+	 * of the proxy may stand for several pending signals. Note, we handle
+	 * only a limited batch of signals here to ensure fairness between RPCs
+	 * and signals. Should signals remain pending, the signal-proxy thread
+	 * delivers the next batch right away.
 	 */
 
-	Signal sig = ep._sig_rec->pending_signal();
+	for (unsigned i = 0; i < MAX_SIGNALS_PER_DELIVERY; i++) {
+
+		Signal sig = ep._sig_rec->pending_signal();
+
+		if (!sig.valid())
+			break;
 
-	if (sig.valid()) {
 		ep._dispatch_signal(sig);
 
 		if (sig.context()->level() == Signal_context::Level::Io) {
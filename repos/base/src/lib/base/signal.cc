@@ -117,8 +117,10 @@ namespace Genode {
 
 void Signal_context::local_submit()
 {
+	Mutex::Guard guard(_mutex);
+
+	/* the receiver is reset when dissolving the context */
 	if (_receiver) {
-		Mutex::Guard guard(_mutex);
 		/* construct and locally submit signal object */
 		Signal::Data signal(this, 1);
 		_receiver->local_submit(signal);
@@ -274,32 +276,53 @@ Signal_context_capability Signal_receiver::manage(Signal_context &context)
 
 void Signal_receiver::block_for_signal()
 {
-	_signal_available.down();
+	/*
+	 * The semaphore is increased only if the queue of submitted contexts
+	 * turns non-empty. Hence, one wakeup may stand for many pending signals.
+	 * A wakeup may also be stale if the signals got picked up via
+	 * 'pending_signal' already.
+	 */
+	for (;;) {
+		{
+			Mutex::Guard pending_guard(_pending_mutex);
+			if (!_pending_contexts.empty())
+				return;
+		}
+		_signal_available.down();
+	}
 }
 
 
 Signal Signal_receiver::pending_signal()
 {
-	Mutex::Guard contexts_guard(_contexts_mutex);
-	Signal::Data result;
-	_contexts.for_each_locked([&] (Signal_context &context) -> bool {
+	Mutex::Guard pending_guard(_pending_mutex);
 
-		if (!context._pending) return false;
+	while (Signal_context *context = _pending_contexts.dequeue()) {
 
-		_contexts.head(context._next);
-		context._pending     = false;
-		result               = context._curr_signal;
-		context._curr_signal = Signal::Data();
+		Signal::Data result;
+		{
+			Mutex::Guard context_guard(context->_mutex);
+
+			context->_pending     = false;
+			result               = context->_curr_signal;
+			context->_curr_signal = Signal::Data();
+
+			/* skip context that is in the process of being dissolved */
+			if (!context->_receiver)
+				continue;
+		}
+
+		Trace::Signal_received trace_event(*context, result.num);
 
-		Trace::Signal_received trace_event(context, result.num);
-		return true;
-	});
-	if (result.context) {
-		Mutex::Guard context_guard(result.context->_mutex);
 		if (result.num == 0)
 			warning("returning signal with num == 0");
 
-		return result;
+		/*
+		 * Construct the signal while holding '_pending_mutex' such that a
+		 * concurrent 'dissolve' of the context waits until the signal got
+		 * handled.
+		 */
+		return Signal(result);
 	}
 
 	/*
@@ -307,9 +330,9 @@ Signal Signal_receiver::pending_signal()
 	 * mean, the '_signal_available' semaphore was increased without
 	 * registering the signal in any context associated to the receiver.
 	 *
-	 * However, if a context gets dissolved right after submitting a
-	 * signal, we may have increased the semaphore already. In this case
-	 * the signal-causing context is absent from the list.
+	 * However, all signals of a wakeup may have been picked up by a
+	 * previous call, or the signal-causing context got dissolved right
+	 * after submitting a signal.
 	 */
 	return Signal();
 }
@@ -327,10 +350,14 @@ void Signal_receiver::local_submit(Signal::Data data)
 	unsigned num = context->_curr_signal.num + data.num;
 	context->_curr_signal = Signal::Data(context, num);
 
-	/* wake up the receiver if the context becomes pending */
+	/*
+	 * Enqueue the context if it becomes pending and wake up the receiver
+	 * unless a wakeup is already outstanding
+	 */
 	if (!context->_pending) {
 		context->_pending = true;
-		_signal_available.up();
+		if (_pending_contexts.enqueue(*context))
+			_signal_available.up();
 	}
 }
 
@@ -378,12 +405,123 @@ void Signal_receiver::_platform_begin_dissolve(Signal_context &context)
 }
 
 
-void Signal_receiver::_platform_finish_dissolve(Signal_context &) { }
+void Signal_receiver::_platform_finish_dissolve(Signal_context &context)
+{
+	/*
+	 * Drop the context from the queue of pending contexts. At this point,
+	 * the context is no longer associated with the receiver and cannot
+	 * become pending again. Taking the context mutex waits for the
+	 * completion of a concurrent 'local_submit'.
+	 */
+	Mutex::Guard pending_guard(_pending_mutex);
+	Mutex::Guard context_guard(context._mutex);
+
+	if (context._pending) {
+		_pending_contexts.remove(context);
+		context._pending = false;
+	}
+}
 
 
 void Signal_receiver::_platform_destructor() { }
 
 
+/************************************
+ ** Signal_receiver::Pending_queue **
+ ************************************/
+
+/*
+ * The queue of submitted contexts is a stack updated via atomic operations
+ * on the pointer to its top. Submitters only push single contexts, the
+ * receiver only detaches the whole stack. Hence, the stack is not prone to
+ * the ABA problem.
+ */
+
+bool Signal_receiver::Pending_queue::enqueue(Signal_context &context)
+{
+	Signal_context *top = __atomic_load_n(&_submitted, __ATOMIC_RELAXED);
+	do {
+		context._pending_next = top;
+	} while (!__atomic_compare_exchange_n(&_submitted, &top, &context, true,
+	                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	return top == nullptr;
+}
+
+
+void Signal_receiver::Pending_queue::_take_submitted()
+{
+	Signal_context *context = __atomic_exchange_n(&_submitted, nullptr,
+	                                              __ATOMIC_ACQUIRE);
+	if (!context)
+		return;
+
+	/* revert the most-recent-first order of the stack */
+	Signal_context * const last  = context;
+	Signal_context        *first = nullptr;
+	while (context) {
+		Signal_context * const next = context->_pending_next;
+		context->_pending_next = first;
+		first   = context;
+		context = next;
+	}
+
+	if (_tail)
+		_tail->_pending_next = first;
+	else
+		_head = first;
+
+	_tail = last;
+}
+
+
+Signal_context *Signal_receiver::Pending_queue::dequeue()
+{
+	if (!_head)
+		_take_submitted();
+
+	Signal_context * const context = _head;
+	if (!context)
+		return nullptr;
+
+	_head = context->_pending_next;
+	if (!_head)
+		_tail = nullptr;
+
+	context->_pending_next = nullptr;
+	return context;
+}
+
+
+void Signal_receiver::Pending_queue::remove(Signal_context &context)
+{
+	_take_submitted();
+
+	Signal_context *prev = nullptr;
+	for (Signal_context *c = _head; c; prev = c, c = c->_pending_next) {
+
+		if (c != &context)
+			continue;
+
+		if (prev)
+			prev->_pending_next = c->_pending_next;
+		else
+			_head = c->_pending_next;
+
+		if (_tail == c)
+			_tail = prev;
+
+		c->_pending_next = nullptr;
+		return;
+	}
+}
+
+
+bool Signal_receiver::Pending_queue::empty() const
+{
+	return !_head && !__atomic_load_n(&_submitted, __ATOMIC_ACQUIRE);
+}
+
+
 void Genode::init_signal_receiver(Pd_session &pd, Parent &parent)
 {
 	_pd_ptr     = &pd;
@@ -70,6 +70,9 @@ Trace::Simple_buffer &Trace::Partitioned_buffer::_switch_producer()
 	/* stops consumer from reading after switching */
 	_consumer_lock = SPINLOCK_LOCKED;
 
+	/* continue the sequence numbers in whatever partition we end up in */
+	unsigned long long const sequence = _producer()._sequence;
+
 	bool switched = false;
 	while (!switched) {
 		int const old_state = _state;
@@ -89,6 +92,7 @@ Trace::Simple_buffer &Trace::Partitioned_buffer::_switch_producer()
 	Trace::Simple_buffer &current = _producer();
 
 	current._buffer_wrapped();
+	current._sequence = sequence;
 
 	/* XXX _wrapped only needed for testing */
 	if (State::Producer::get(_state) == PRIMARY)
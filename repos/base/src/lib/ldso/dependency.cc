@@ -35,6 +35,9 @@ Linker::Dependency::Dependency(Env &env, Allocator &md_alloc,
 
 Linker::Dependency::~Dependency()
 {
+	/* the dependency may serve as scope of cached symbol lookups */
+	flush_symbol_cache();
+
 	if (!_unload_on_destruct)
 		return;
 
@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,91 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU-style hash table
+ *
+ * The table starts with a Bloom filter that rejects most lookups of symbols
+ * not defined by the object without touching the hash buckets. The hash
+ * chains hold the hash values of the symbols, which allows for comparing
+ * symbol names only if the hash values match. Symbols below 'symoffset'
+ * (undefined symbols) are not covered by the table.
+ */
+struct Linker::Gnu_hash_table
+{
+	uint32_t const *_header() const { return (uint32_t const *)this; }
+
+	uint32_t nbuckets()    const { return _header()[0]; }
+	uint32_t symoffset()   const { return _header()[1]; }
+	uint32_t bloom_size()  const { return _header()[2]; }
+	uint32_t bloom_shift() const { return _header()[3]; }
+
+	Elf::Addr const *bloom()   const { return (Elf::Addr const *)(_header() + 4); }
+	uint32_t  const *buckets() const { return (uint32_t const *)(bloom() + bloom_size()); }
+
+	/**
+	 * Return hash value of symbol with the given index, lowest bit marks
+	 * the end of a chain
+	 */
+	uint32_t chain(uint32_t sym_index) const {
+		return (buckets() + nbuckets())[sym_index - symoffset()]; }
+
+	/**
+	 * GNU hash function (Bernstein)
+	 */
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+		return h;
+	}
+
+	/**
+	 * Return false if the object does not define a symbol with 'hash'
+	 */
+	bool may_contain(uint32_t hash) const
+	{
+		unsigned  const bits = sizeof(Elf::Addr)*8;
+		Elf::Addr const word = bloom()[(hash / bits) & (bloom_size() - 1)];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % bits))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift()) % bits));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of entries of the symbol table
+	 */
+	unsigned long num_symbols() const
+	{
+		uint32_t last = 0;
+		for (uint32_t i = 0; i < nbuckets(); i++)
+			last = max(last, buckets()[i]);
+
+		if (last < symoffset())
+			return symoffset();
+
+		while (!(chain(last) & 1))
+			last++;
+
+		return last + 1;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name for both kinds of hash tables
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long const sysv;
+	uint32_t      const gnu;
+
+	Symbol_hash(char const *name)
+	: sysv(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -94,9 +181,12 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash      = nullptr;
+		unsigned long        _num_symbols   = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
+		unsigned long        _reloca_relative = 0;
 
 		Elf::Sym            *_symtab        = nullptr;
 		char                *_strtab        = nullptr;
@@ -169,10 +259,84 @@ class Linker::Dynamic
 				case DT_REL     : _section<typeof(_rel)>(&_rel, d);                     break;
 				case DT_RELSZ   : _rel_size = d->un.val;                                break;
 				case DT_DEBUG   : _section_dt_debug(d);                                 break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash)>(&_gnu_hash, d);           break;
+				case DT_RELACOUNT: _reloca_relative = d->un.val;                        break;
 				default:
 					break;
 				}
 			}
+
+			if (_hash_table)
+				_num_symbols = _hash_table->nchains();
+		}
+
+		/**
+		 * Return true if 'sym' is a candidate for resolving symbol 'name'
+		 */
+		bool _matches(Elf::Sym const &sym, char const *name) const
+		{
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym.type() > STT_FUNC)
+				return false;
+
+			if (sym.st_value == 0)
+				return false;
+
+			/* check for symbol name */
+			char const *sym_name = symbol_name(sym);
+			return name[0] == sym_name[0] && !strcmp(name, sym_name);
+		}
+
+		Elf::Sym const *_lookup_gnu(char const *name, uint32_t const hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash;
+
+			if (!h.nbuckets() || !h.bloom_size() || !h.may_contain(hash))
+				return nullptr;
+
+			uint32_t sym_index = h.buckets()[hash % h.nbuckets()];
+			if (sym_index < h.symoffset())
+				return nullptr;
+
+			/* traverse hash chain, compare names only for matching hashes */
+			for (;; sym_index++) {
+
+				uint32_t const chain_hash = h.chain(sym_index);
+
+				if ((chain_hash | 1) == (hash | 1)) {
+					Elf::Sym const *sym = symbol(sym_index);
+					if (sym && _matches(*sym, name))
+						return sym;
+				}
+
+				if (chain_hash & 1)
+					return nullptr;
+			}
+		}
+
+		Elf::Sym const *_lookup_sysv(char const *name, unsigned long const hash) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->buckets())
+				return nullptr;
+
+			unsigned sym_index = h->buckets()[hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index > h->nchains())
+					return nullptr;
+
+				Elf::Sym const *sym = symbol(sym_index);
+
+				if (_matches(*sym, name))
+					return sym;
+			}
+
+			return nullptr;
 		}
 
 	public:
@@ -192,6 +356,10 @@ class Linker::Dynamic
 			_dep(&dep), _obj(obj), _dynamic(_find_dynamic(phdr)), _md_alloc(&md_alloc)
 		{
 			_init();
+
+			/* the linker itself always has a SysV hash table */
+			if (!_hash_table && _gnu_hash)
+				_num_symbols = _gnu_hash->num_symbols();
 		}
 
 		~Dynamic()
@@ -216,7 +384,7 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index > _num_symbols)
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -233,47 +401,51 @@ class Linker::Dynamic
 
 		Dependency const &dep() const { return *_dep; }
 
+		struct Reloc_count
+		{
+			unsigned long total, relative;
+
+			void print(Genode::Output &out) const
+			{
+				Genode::print(out, total, " relocations (", relative, " relative)");
+			}
+		};
+
+		/**
+		 * Return number of non-PLT relocations, used for startup statistics
+		 */
+		Reloc_count reloc_count() const
+		{
+			unsigned long const rela = _reloca_size / sizeof(Elf::Rela);
+
+			return { .total    = rela + _rel_size / sizeof(Elf::Rel),
+			         .relative = _reloca_relative < rela ? _reloca_relative : rela };
+		}
+
 		/*
 		 * Use DT_HASH table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred if present. It does not cover
+		 * undefined symbols though, which are considered for 'undef' lookups.
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash,
+		                              bool undef = false) const
 		{
-			Hash_table *h = _hash_table;
-
-			if (!h->buckets())
-				return nullptr;
-
-			unsigned sym_index = h->buckets()[hash % h->nbuckets()];
-
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
-					return nullptr;
-
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
+			if (_gnu_hash && !(undef && _hash_table))
+				return _lookup_gnu(name, hash.gnu);
 
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_sysv(name, hash.sysv);
 
 			return nullptr;
 		}
@@ -285,7 +457,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned i = 0; i < _num_symbols; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
@@ -338,10 +510,42 @@ class Linker::Dynamic
 				Plt_got r(*_dep, _pltgot);
 		}
 
+		/**
+		 * Apply the relative relocations at the start of the RELA table
+		 *
+		 * The static linker sorts relative relocations to the front and
+		 * records their number as DT_RELACOUNT. Those relocations need
+		 * neither a symbol lookup nor a dispatch by relocation type.
+		 *
+		 * \return number of relocations applied
+		 */
+		unsigned long _relocate_relative(Pass pass) SELF_RELOC
+		{
+			unsigned long const entries = _reloca_size / sizeof(Elf::Rela);
+			unsigned long const count   = _reloca_relative < entries
+			                            ? _reloca_relative : entries;
+
+			/* the second pass covers global-data relocations only */
+			if (pass == SECOND_PASS)
+				return count;
+
+			Elf::Addr const base = _obj.reloc_base();
+
+			for (Elf::Rela const *rel = _reloca; rel < _reloca + count; rel++)
+				*(Elf::Addr *)(base + rel->offset) = base + rel->addend;
+
+			return count;
+		}
+
 		void relocate_non_plt(Bind bind, Pass pass) SELF_RELOC
 		{
-			if (_reloca)
-				Reloc_non_plt r(*_dep, _reloca, _reloca_size, pass == SECOND_PASS);
+			if (_reloca) {
+				unsigned long const relative = _relocate_relative(pass);
+
+				Reloc_non_plt r(*_dep, _reloca + relative,
+				                _reloca_size - relative*sizeof(Elf::Rela),
+				                pass == SECOND_PASS);
+			}
 
 			if (_rel)
 				Reloc_non_plt r(*_dep, _rel, _rel_size, pass == SECOND_PASS);
@@ -101,6 +101,14 @@ namespace Linker {
 	Elf::Sym const *lookup_symbol(char const *name, Dependency const &dep, Elf::Addr *base,
 	                              bool undef = false, bool other = false);
 
+	/**
+	 * Drop the cached results of symbol lookups
+	 *
+	 * Must be called whenever the set of loaded objects or dependencies
+	 * changes.
+	 */
+	void flush_symbol_cache();
+
 	/**
 	 * Load an ELF (setup segments and map program header)
 	 *
@@ -0,0 +1,128 @@
+/*
+ * \brief  Cache of resolved symbols
+ * \author agent
+ * \date   2026-10-18
+ *
+ * When relocating a large graph of shared objects, the same symbols (e.g.,
+ * 'memcpy' or the 'Genode::log' helpers) are resolved over and over again
+ * for each object, each time traversing the hash tables of all objects of
+ * the dependency scope. The cache remembers the result of a lookup per
+ * scope so that repeated lookups of the same symbol bypass the traversal.
+ *
+ * The cache refers to the symbol names, symbols, and dependencies of loaded
+ * objects. Hence, it must be flushed whenever an object is loaded or
+ * unloaded, or a dependency vanishes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SYMBOL_CACHE_H_
+#define _INCLUDE__SYMBOL_CACHE_H_
+
+#include <linker.h>
+
+namespace Linker { class Symbol_cache; }
+
+
+class Linker::Symbol_cache : Noncopyable
+{
+	public:
+
+		static constexpr unsigned NUM_ENTRIES = 1024;
+
+		struct Stats
+		{
+			unsigned long hits, misses;
+
+			void print(Output &out) const
+			{
+				Genode::print(out, "hits=", hits, " misses=", misses);
+			}
+		};
+
+	private:
+
+		struct Entry
+		{
+			Dependency const *scope;
+			uint32_t          hash;
+			char const       *name;
+			Elf::Sym   const *sym;
+			Elf::Addr         base;
+		};
+
+		Mutex mutable _mutex { };
+
+		/* direct-mapped, indexed by the lowest bits of the symbol hash */
+		Entry _entries[NUM_ENTRIES] { };
+
+		Stats _stats { };
+
+		static Entry &_slot(Entry *entries, uint32_t hash) {
+			return entries[hash % NUM_ENTRIES]; }
+
+	public:
+
+		/**
+		 * Look up symbol 'name' resolved within 'scope'
+		 *
+		 * \return symbol, or nullptr if the symbol is not cached
+		 */
+		Elf::Sym const *lookup(Dependency const &scope, char const *name,
+		                       uint32_t hash, Elf::Addr *base)
+		{
+			Mutex::Guard guard(_mutex);
+
+			Entry const &entry = _slot(_entries, hash);
+
+			if (entry.sym && entry.scope == &scope && entry.hash == hash
+			 && !strcmp(entry.name, name)) {
+				_stats.hits++;
+				*base = entry.base;
+				return entry.sym;
+			}
+
+			_stats.misses++;
+			return nullptr;
+		}
+
+		void insert(Dependency const &scope, char const *name, uint32_t hash,
+		            Elf::Sym const *sym, Elf::Addr base)
+		{
+			Mutex::Guard guard(_mutex);
+
+			_slot(_entries, hash) = { .scope = &scope, .hash = hash,
+			                          .name  = name,   .sym  = sym,
+			                          .base  = base };
+		}
+
+		void flush()
+		{
+			Mutex::Guard guard(_mutex);
+
+			for (Entry &entry : _entries)
+				entry = { };
+		}
+
+		Stats stats() const
+		{
+			Mutex::Guard guard(_mutex);
+			return _stats;
+		}
+};
+
+
+namespace Linker {
+
+	/**
+	 * Return statistics of the process-global symbol cache
+	 */
+	Symbol_cache::Stats symbol_cache_stats();
+}
+
+#endif /* _INCLUDE__SYMBOL_CACHE_H_ */
@@ -20,6 +20,7 @@
 #include <base/thread.h>
 #include <base/heap.h>
 #include <base/sleep.h>
+#include <trace/timestamp.h>
 
 /* base-internal includes */
 #include <base/internal/globals.h>
@@ -29,6 +30,7 @@
 #include <init.h>
 #include <region_map.h>
 #include <config.h>
+#include <symbol_cache.h>
 
 using namespace Linker;
 
@@ -44,6 +46,9 @@ namespace Linker {
 
 static    Binary *binary_ptr = nullptr;
 static    Parent *parent_ptr = nullptr;
+
+/* valid once the linker is relocated, see 'init_ldso_phdr' */
+static Symbol_cache *symbol_cache_ptr = nullptr;
 bool      Linker::verbose  = false;
 Stage     Linker::stage    = STAGE_BINARY;
 Link_map *Link_map::first;
@@ -147,6 +152,8 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			with_object_list([&] (Object_list &list) {
 				list.enqueue(*this); });
 
+			flush_symbol_cache();
+
 			/* add to link map */
 			Debug::state_change(Debug::ADD, nullptr);
 			setup_link_map();
@@ -170,6 +177,8 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			with_object_list([&] (Object_list &list) {
 				list.remove(*this); });
 			Init::list()->remove(this);
+
+			flush_symbol_cache();
 		}
 
 		/**
@@ -191,9 +200,10 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash,
+		                              bool undef) const
 		{
-			return _dyn.lookup_symbol(name, hash);
+			return _dyn.lookup_symbol(name, hash, undef);
 		}
 
 		/**
@@ -484,8 +494,7 @@ void genode_exit(int status)
 
 Elf::Addr Linker::Object::_symbol_address(char const *name)
 {
-	unsigned long   hash = Hash_table::hash(name);
-	Elf::Sym const *sym  = dynamic().lookup_symbol(name, hash);
+	Elf::Sym const *sym = dynamic().lookup_symbol(name, Symbol_hash(name));
 
 	if (sym)
 		return reloc_base() + sym->st_value;
@@ -550,11 +559,11 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
 }
 
 
-Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
-                                      Elf::Addr *base, bool undef, bool other)
+static Elf::Sym const *lookup_in_scope(char const *name, Symbol_hash const &hash,
+                                       Dependency const &dep, Elf::Addr *base,
+                                       bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -567,7 +576,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 
 		Elf_object const &elf = static_cast<Elf_object const &>(curr->obj());
 
-		if ((symbol = elf.lookup_symbol(name, hash)) && (symbol->st_value || undef)) {
+		if ((symbol = elf.lookup_symbol(name, hash, undef)) && (symbol->st_value || undef)) {
 
 			if (dep.root() && verbose_lookup)
 				log("LD: lookup ", name, " obj_src ", elf.name(),
@@ -592,7 +601,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 	/* try searching binary's dependencies */
 	if (!weak_symbol && dep.root()) {
 		if (binary_ptr && &dep != binary_ptr->first_dep()) {
-			return lookup_symbol(name, *binary_ptr->first_dep(), base, undef, other);
+			return lookup_in_scope(name, hash, *binary_ptr->first_dep(), base, undef, other);
 		} else {
 			throw Not_found(name);
 		}
@@ -609,6 +618,43 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 }
 
 
+void Linker::flush_symbol_cache()
+{
+	if (symbol_cache_ptr)
+		symbol_cache_ptr->flush();
+}
+
+
+Linker::Symbol_cache::Stats Linker::symbol_cache_stats()
+{
+	return symbol_cache_ptr ? symbol_cache_ptr->stats() : Symbol_cache::Stats { };
+}
+
+
+Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
+                                      Elf::Addr *base, bool undef, bool other)
+{
+	Symbol_hash const hash(name);
+
+	/*
+	 * The result of a lookup within a root's scope depends solely on the
+	 * scope, which is shared by all objects of the scope.
+	 */
+	Symbol_cache * const cache = (dep.root() && !undef && !other)
+	                           ? symbol_cache_ptr : nullptr;
+	if (cache) {
+		if (Elf::Sym const *symbol = cache->lookup(dep.first(), name, hash.gnu, base))
+			return symbol;
+
+		Elf::Sym const *symbol = lookup_in_scope(name, hash, dep, base, undef, other);
+		cache->insert(dep.first(), name, hash.gnu, symbol, *base);
+		return symbol;
+	}
+
+	return lookup_in_scope(name, hash, dep, base, undef, other);
+}
+
+
 /********************
  ** Initialization **
  ********************/
@@ -700,6 +746,10 @@ void Genode::init_ldso_phdr(Env &env)
 	heap().construct(&env.ram(), &ld_rm, Heap::UNLIMITED,
 	                 initial_block, sizeof(initial_block));
 
+	/* statically allocated to keep the heap allocations deterministic */
+	static Symbol_cache symbol_cache { };
+	symbol_cache_ptr = &symbol_cache;
+
 	/* load program headers of linker now */
 	if (!Ld::linker().file())
 		Ld::linker().load_phdr(env, *heap());
@@ -781,6 +831,8 @@ extern "C" void wait_for_continue();
 
 void Component::construct(Genode::Env &env)
 {
+	Trace::Timestamp const start = Trace::timestamp();
+
 	/* read configuration */
 	Config const config(env);
 
@@ -822,6 +874,23 @@ void Component::construct(Genode::Env &env)
 
 	binary_ready_hook_for_platform();
 
+	if (config.startup_stats) {
+		unsigned num_objects = 0;
+		Dynamic::Reloc_count relocs { };
+		Object::with_object_list([&] (Object::Object_list &list) {
+			list.for_each([&] (Object const &obj) {
+				Dynamic::Reloc_count const count = obj.dynamic().reloc_count();
+				relocs.total    += count.total;
+				relocs.relative += count.relative;
+				num_objects++;
+			});
+		});
+
+		log("LD: startup took ", Trace::timestamp() - start, " ticks, ",
+		    num_objects, " objects, ", relocs, ", "
+		    "symbol cache ", symbol_cache_stats());
+	}
+
 	/* start binary */
 	binary_ptr->call_entry_point(env);
 }
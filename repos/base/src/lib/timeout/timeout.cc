@@ -30,9 +30,10 @@ void Timeout::schedule_periodic(Microseconds     duration,
 
 
 void Timeout::schedule_one_shot(Microseconds     duration,
-                                Timeout_handler &handler)
+                                Timeout_handler &handler,
+                                Microseconds     slack)
 {
-	_scheduler._schedule_one_shot_timeout(*this, duration, handler);
+	_scheduler._schedule_one_shot_timeout(*this, duration, slack, handler);
 }
 
 
@@ -55,6 +56,155 @@ void Timeout::discard() { _scheduler._discard_timeout(*this); }
 bool Timeout::scheduled() { return _handler != nullptr; }
 
 
+/*******************
+ ** Timeout_wheel **
+ *******************/
+
+void Timeout_wheel::_link(Timeout *&head, Timeout &timeout)
+{
+	timeout._wheel_next  = head;
+	timeout._wheel_pprev = &head;
+	if (head)
+		head->_wheel_pprev = &timeout._wheel_next;
+	head = &timeout;
+}
+
+
+void Timeout_wheel::insert(Timeout &timeout)
+{
+	uint64_t const deadline = timeout._deadline.value;
+
+	if (deadline <= _time) {
+		timeout._wheel_level = NUM_LEVELS;
+		_link(_expired, timeout);
+		return;
+	}
+
+	/* select level by the most significant bit that differs from the time */
+	unsigned const msb   = 63 - (unsigned)__builtin_clzll(deadline ^ _time);
+	unsigned const level = msb / SLOT_BITS;
+	unsigned const slot  = (unsigned)(deadline >> (SLOT_BITS*level)) & (NUM_SLOTS - 1);
+
+	timeout._wheel_level = level;
+	timeout._wheel_slot  = slot;
+
+	_link(_levels[level].slots[slot], timeout);
+	_levels[level].occupied |= 1ULL << slot;
+}
+
+
+void Timeout_wheel::remove(Timeout &timeout)
+{
+	if (!timeout._wheel_pprev)
+		return;
+
+	*timeout._wheel_pprev = timeout._wheel_next;
+	if (timeout._wheel_next)
+		timeout._wheel_next->_wheel_pprev = timeout._wheel_pprev;
+
+	if (timeout._wheel_level < NUM_LEVELS) {
+		Level &level = _levels[timeout._wheel_level];
+		if (!level.slots[timeout._wheel_slot])
+			level.occupied &= ~(1ULL << timeout._wheel_slot);
+	}
+
+	timeout._wheel_next  = nullptr;
+	timeout._wheel_pprev = nullptr;
+}
+
+
+void Timeout_wheel::advance(uint64_t const time)
+{
+	if (time <= _time)
+		return;
+
+	/*
+	 * Detach the timeouts of all slots that start not after the new time.
+	 * Within a level, the start of the occupied slots ascends with the
+	 * slot index.
+	 */
+	Timeout *due = nullptr;
+	for (unsigned l = 0; l < NUM_LEVELS; l++) {
+
+		Level &level = _levels[l];
+
+		for (uint64_t occupied = level.occupied; occupied; occupied &= occupied - 1) {
+
+			unsigned const slot = (unsigned)__builtin_ctzll(occupied);
+
+			if (_slot_start(l, slot) > time)
+				break;
+
+			while (Timeout *timeout = level.slots[slot]) {
+				remove(*timeout);
+				timeout->_wheel_next = due;
+				due = timeout;
+			}
+		}
+	}
+
+	_time = time;
+
+	/* re-insert the detached timeouts relative to the new time */
+	while (Timeout *timeout = due) {
+		due = timeout->_wheel_next;
+		timeout->_wheel_next = nullptr;
+		insert(*timeout);
+	}
+}
+
+
+Timeout *Timeout_wheel::take_expired()
+{
+	Timeout * const timeout = _expired;
+	if (timeout)
+		remove(*timeout);
+
+	return timeout;
+}
+
+
+Timeout *Timeout_wheel::any()
+{
+	if (_expired)
+		return _expired;
+
+	for (Level &level : _levels)
+		if (level.occupied)
+			return level.slots[__builtin_ctzll(level.occupied)];
+
+	return nullptr;
+}
+
+
+uint64_t Timeout_wheel::next_event() const
+{
+	if (_expired)
+		return _time;
+
+	/*
+	 * The timeouts of a lower level are always due before those of higher
+	 * levels, and the deadlines within a level ascend with the slot index.
+	 * Hence, the earliest deadline is found in the lowest occupied slot.
+	 * Returning the slot start instead would program needless wake-ups for
+	 * merely cascading the timeouts of higher levels.
+	 */
+	for (Level const &level : _levels) {
+
+		if (!level.occupied)
+			continue;
+
+		uint64_t earliest = ~(uint64_t)0;
+		for (Timeout const *timeout = level.slots[__builtin_ctzll(level.occupied)];
+		     timeout; timeout = timeout->_wheel_next)
+			earliest = min(earliest, timeout->_deadline.value);
+
+		return earliest;
+	}
+	return ~(uint64_t)0;
+}
+
+
 /***********************
  ** Timeout_scheduler **
  ***********************/
@@ -86,17 +236,14 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 		/*
 		 * Filter out all pending timeouts to a local list first. The
 		 * processing of pending timeouts can have effects on the '_timeouts'
-		 * list and these would interfere with the filtering if we would do
+		 * wheel and these would interfere with the filtering if we would do
 		 * it all in the same loop.
 		 */
-		while (Timeout *timeout = _timeouts.first()) {
+		_timeouts.advance(_current_time.value);
+
+		while (Timeout *timeout = _timeouts.take_expired()) {
 
 			timeout->_mutex.acquire();
-			if (timeout->_deadline.value > _current_time.value) {
-				timeout->_mutex.release();
-				break;
-			}
-			_timeouts.remove(timeout);
 			pending_timeouts.insert(&timeout->_pending_timeouts_le);
 		}
 		/*
@@ -153,9 +300,9 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 				if (deadline_us < _current_time.value) {
 					deadline_us = ~(uint64_t)0;
 				}
-				/* re-insert timeout into timeouts list */
+				/* re-insert timeout into timeouts wheel */
 				timeout._deadline = Microseconds { deadline_us };
-				_insert_into_timeouts_list(timeout);
+				_timeouts.insert(timeout);
 			}
 			timeout._mutex.release();
 		}
@@ -223,7 +370,7 @@ Timeout_scheduler::~Timeout_scheduler()
 	_destructor_called = true;
 
 	/* discard all scheduled timeouts */
-	while (Timeout *timeout = _timeouts.first()) {
+	while (Timeout *timeout = _timeouts.any()) {
 		Mutex::Guard const timeout_guard { timeout->_mutex };
 		_discard_timeout_unsynchronized(*timeout);
 	}
@@ -242,10 +389,11 @@ void Timeout_scheduler::_enable()
 
 void Timeout_scheduler::_set_time_source_timeout()
 {
+	uint64_t const next_us = _timeouts.next_event();
+
 	_set_time_source_timeout(
-		_timeouts.first() ?
-			_timeouts.first()->_deadline.value - _current_time.value :
-			~(uint64_t)0);
+		next_us == ~(uint64_t)0        ? ~(uint64_t)0 :
+		next_us >  _current_time.value ? next_us - _current_time.value : 0);
 }
 
 
@@ -263,9 +411,10 @@ void Timeout_scheduler::_set_time_source_timeout(uint64_t duration_us)
 
 void Timeout_scheduler::_schedule_one_shot_timeout(Timeout         &timeout,
                                                    Microseconds     duration,
+                                                   Microseconds     slack,
                                                    Timeout_handler &handler)
 {
-	_schedule_timeout(timeout, duration, Microseconds { 0 }, handler);
+	_schedule_timeout(timeout, duration, Microseconds { 0 }, slack, handler);
 }
 
 
@@ -279,13 +428,15 @@ void Timeout_scheduler::_schedule_periodic_timeout(Timeout         &timeout,
 		error("attempt to schedule a periodic timeout of 0");
 		return;
 	}
-	_schedule_timeout(timeout, Microseconds { 0 }, period, handler);
+	_schedule_timeout(timeout, Microseconds { 0 }, period, Microseconds { 0 },
+	                  handler);
 }
 
 
 void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
                                           Microseconds     duration,
                                           Microseconds     period,
+                                          Microseconds     slack,
                                           Timeout_handler &handler)
 {
 	/* acquire scheduler and timeout mutex */
@@ -297,52 +448,46 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 
 	/* prevent inserting a timeout twice */
 	if (timeout._handler != nullptr) {
-		_timeouts.remove(&timeout);
+		_timeouts.remove(timeout);
 	}
 	/* determine timeout deadline */
 	uint64_t const curr_time_us {
 		_time_source.curr_time().trunc_to_plain_us().value };
 
-	uint64_t const deadline_us {
+	uint64_t deadline_us {
 		duration.value <= ~(uint64_t)0 - curr_time_us ?
 			curr_time_us + duration.value : ~(uint64_t)0 };
 
-	/* set up timeout object and insert into timeouts list */
+	/*
+	 * Coalesce timeouts with similar deadlines by rounding up the deadline
+	 * to the largest power of two not exceeding the tolerated slack
+	 */
+	if (slack.value) {
+		uint64_t const mask = (1ULL << log2(slack.value)) - 1;
+		if (deadline_us <= ~(uint64_t)0 - mask)
+			deadline_us = (deadline_us + mask) & ~mask;
+	}
+
+	uint64_t const next_event_us = _timeouts.next_event();
+
+	_timeouts.advance(curr_time_us);
+
+	/* set up timeout object and insert into timeouts wheel */
 	timeout._handler = &handler;
 	timeout._deadline = Microseconds { deadline_us };
 	timeout._period = period;
-	_insert_into_timeouts_list(timeout);
+	_timeouts.insert(timeout);
 
 	/*
 	 * If the new timeout is the first to trigger, we have to  update the
-	 * time-source timeout.
+	 * time-source timeout. For a timeout at a higher level of the wheel,
+	 * the next event is the point in time for moving it to a lower level.
 	 */
-	if (_timeouts.first() == &timeout) {
-		_set_time_source_timeout(deadline_us - curr_time_us);
-	}
-}
-
-
-void Timeout_scheduler::_insert_into_timeouts_list(Timeout &timeout)
-{
-	/* if timeout list is empty, insert as first element */
-	if (_timeouts.first() == nullptr) {
-		_timeouts.insert(&timeout);
-		return;
-	}
-	/* if timeout has the shortest deadline, insert as first element */
-	if (_timeouts.first()->_deadline.value >= timeout._deadline.value) {
-		_timeouts.insert(&timeout);
-		return;
+	uint64_t const new_next_event_us = _timeouts.next_event();
+	if (new_next_event_us < next_event_us) {
+		_set_time_source_timeout(new_next_event_us > curr_time_us ?
+		                         new_next_event_us - curr_time_us : 0);
 	}
-	/* find list element with next shorter deadline and insert behind it */
-	Timeout *curr_timeout { _timeouts.first() };
-	for (;
-	     curr_timeout->next() != nullptr &&
-	     curr_timeout->next()->_deadline.value < timeout._deadline.value;
-	     curr_timeout = curr_timeout->_next);
-
-	_timeouts.insert(&timeout, curr_timeout);
 }
 
 
@@ -393,7 +538,7 @@ void Timeout_scheduler::_discard_timeout_unsynchronized(Timeout &timeout)
 		timeout._mutex.acquire();
 		timeout._in_discard_blockade = false;
 	}
-	_timeouts.remove(&timeout);
+	_timeouts.remove(timeout);
 	timeout._handler = nullptr;
 }
 
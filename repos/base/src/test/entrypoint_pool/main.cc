@@ -0,0 +1,195 @@
+/*
+ * \brief  Test for serving RPC objects by a pool of entrypoints
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Client threads invoke RPC objects concurrently. The objects are served
+ * by a pool of entrypoints, once with a single entrypoint and once with one
+ * entrypoint per CPU. Pairs of co-located objects share state, which
+ * is used to check that their requests are never processed concurrently.
+ * Each object also looks up its entrypoint from within an RPC function,
+ * which must not block.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/entrypoint_pool.h>
+#include <base/heap.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Interface;
+	struct Group;
+	struct Object;
+	struct Client;
+	struct Main;
+
+	static constexpr unsigned NUM_CALLS = 2000;
+}
+
+
+struct Test::Interface : Genode::Interface
+{
+	GENODE_RPC(Rpc_work, void, work, unsigned);
+	GENODE_RPC(Rpc_lookup, bool, lookup);
+	GENODE_RPC_INTERFACE(Rpc_work, Rpc_lookup);
+};
+
+
+/**
+ * State shared by co-located objects
+ */
+struct Test::Group
+{
+	unsigned busy      = 0;
+	unsigned conflicts = 0;
+};
+
+
+struct Test::Object : Rpc_object<Test::Interface, Test::Object>
+{
+	Group           &_group;
+	Entrypoint_pool &_pool;
+
+	Object(Group &group, Entrypoint_pool &pool) : _group(group), _pool(pool) { }
+
+	void work(unsigned spin)
+	{
+		if (__atomic_fetch_add(&_group.busy, 1, __ATOMIC_SEQ_CST))
+			_group.conflicts++;
+
+		for (unsigned i = 0; i < spin; i++)
+			asm volatile ("" ::: "memory");
+
+		__atomic_fetch_sub(&_group.busy, 1, __ATOMIC_SEQ_CST);
+	}
+
+	/**
+	 * Look up the entrypoint of the object while serving an RPC
+	 */
+	bool lookup()
+	{
+		bool found = false;
+		_pool.with_entrypoint(*this, [&] (Entrypoint &) { found = true; });
+		return found;
+	}
+};
+
+
+struct Test::Client : Thread
+{
+	Capability<Interface> const _cap;
+
+	Client(Env &env, Capability<Interface> cap, Affinity::Location location)
+	:
+		Thread(env, "client", Stack_size { 16*1024 }, location), _cap(cap)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < NUM_CALLS; i++)
+			_cap.call<Interface::Rpc_work>(10000);
+	}
+
+	using Thread::start;
+	using Thread::join;
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Affinity::Space const _space = _env.cpu().affinity_space();
+
+	static constexpr unsigned MAX_OBJECTS = 2*Entrypoint_pool::MAX_ENTRYPOINTS;
+
+	/**
+	 * Return number of conflicting requests between co-located objects and
+	 * failed entrypoint lookups
+	 */
+	unsigned _measure(unsigned const num_entrypoints)
+	{
+		Entrypoint_pool pool { _env, _heap, { .count      = num_entrypoints,
+		                                      .stack_size = 16*1024,
+		                                      .name       = "pool_ep",
+		                                      .pin        = true } };
+
+		unsigned const num_objects = min(2*_space.total(), MAX_OBJECTS);
+
+		Group                 groups  [MAX_OBJECTS/2] { };
+		Constructible<Object> objects [MAX_OBJECTS]   { };
+		Constructible<Client> clients [MAX_OBJECTS]   { };
+
+		/* each pair of objects shares one group and is co-located */
+		for (unsigned i = 0; i < num_objects; i++) {
+			objects[i].construct(groups[i/2], pool);
+			if (i % 2)
+				pool.manage(*objects[i], *objects[i - 1]);
+			else
+				pool.manage(*objects[i]);
+		}
+
+		for (unsigned i = 0; i < num_objects; i++)
+			clients[i].construct(_env, objects[i]->cap(),
+			                     _space.location_of_index(int(i)));
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_objects; i++) clients[i]->start();
+		for (unsigned i = 0; i < num_objects; i++) clients[i]->join();
+
+		uint64_t const ms = max(_timer.elapsed_ms() - start_ms, 1ULL);
+
+		unsigned conflicts = 0;
+
+		for (unsigned i = 0; i < num_objects; i++)
+			if (!objects[i]->cap().call<Interface::Rpc_lookup>()) {
+				error("entrypoint lookup of object ", i, " failed");
+				conflicts++;
+			}
+
+		for (unsigned i = 0; i < num_objects; i++) {
+			pool.dissolve(*objects[i]);
+			conflicts += (i % 2) ? 0 : groups[i/2].conflicts;
+		}
+
+		log(pool.count(), " entrypoint(s), ", num_objects, " objects: ",
+		    (num_objects*NUM_CALLS*1000ULL)/ms, " calls/s");
+
+		return conflicts;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- entrypoint-pool test ---");
+		log("affinity space: ", _space.width(), "x", _space.height());
+
+		unsigned const conflicts = _measure(1) + _measure(_space.total());
+
+		if (conflicts)
+			error(conflicts, " concurrent requests or failed lookups");
+		else
+			log("--- entrypoint-pool test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,133 @@
+/*
+ * \brief  RPC round-trip benchmark
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The benchmark issues RPC calls to an object served by a separate
+ * entrypoint and reports the call rate as well as latency percentiles
+ * for calls without arguments and for calls transferring a payload.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <timer_session/connection.h>
+#include <trace/timestamp.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Payload { char bytes[1024]; };
+
+	struct Interface;
+	struct Object;
+	struct Main;
+}
+
+
+struct Test::Interface : Genode::Interface
+{
+	GENODE_RPC(Rpc_null,    void,     null);
+	GENODE_RPC(Rpc_payload, unsigned, payload, Payload const &);
+	GENODE_RPC_INTERFACE(Rpc_null, Rpc_payload);
+};
+
+
+struct Test::Object : Rpc_object<Test::Interface, Test::Object>
+{
+	void null() { }
+
+	unsigned payload(Payload const &payload) { return payload.bytes[0]; }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Entrypoint _server_ep { _env, 4*1024*sizeof(long), "server_ep",
+	                        Affinity::Location() };
+
+	Object _object { };
+
+	Capability<Interface> _cap = _server_ep.manage(_object);
+
+	static constexpr unsigned NUM_CALLS = 20000;
+
+	Trace::Timestamp _samples[NUM_CALLS] { };
+
+	Payload _payload { };
+
+	void _sort_samples()
+	{
+		/* shell sort */
+		for (unsigned gap = NUM_CALLS/2; gap > 0; gap /= 2)
+			for (unsigned i = gap; i < NUM_CALLS; i++)
+				for (unsigned j = i; j >= gap && _samples[j - gap] > _samples[j]; j -= gap) {
+					Trace::Timestamp const t = _samples[j];
+					_samples[j]       = _samples[j - gap];
+					_samples[j - gap] = t;
+				}
+	}
+
+	void _measure(char const *name, auto const &call_fn)
+	{
+		/* warm up */
+		for (unsigned i = 0; i < 100; i++)
+			call_fn();
+
+		uint64_t const start_us = _timer.curr_time().trunc_to_plain_us().value;
+		Trace::Timestamp const start_ts = Trace::timestamp();
+
+		for (unsigned i = 0; i < NUM_CALLS; i++) {
+			Trace::Timestamp const t = Trace::timestamp();
+			call_fn();
+			_samples[i] = Trace::timestamp() - t;
+		}
+
+		Trace::Timestamp const total_ts = Trace::timestamp() - start_ts;
+		uint64_t const total_us = max(_timer.curr_time().trunc_to_plain_us().value
+		                              - start_us, 1ULL);
+
+		_sort_samples();
+
+		/* convert timestamp ticks to nanoseconds */
+		auto ns = [&] (unsigned percent)
+		{
+			Trace::Timestamp const ticks = _samples[(NUM_CALLS - 1)*percent/100];
+			return total_ts ? (ticks*total_us*1000)/total_ts : 0;
+		};
+
+		log(name, ": ", (NUM_CALLS*1000000ULL)/total_us, " calls/s, "
+		    "latency p50=", ns(50), " ns p90=", ns(90), " ns p99=", ns(99), " ns "
+		    "max=", ns(100), " ns");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC benchmark ---");
+
+		Capability<Interface> const cap = _cap;
+
+		_measure("null   ", [&] { cap.call<Interface::Rpc_null>(); });
+		_measure("payload", [&] { cap.call<Interface::Rpc_payload>(_payload); });
+
+		_server_ep.dissolve(_object);
+
+		log("--- RPC benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
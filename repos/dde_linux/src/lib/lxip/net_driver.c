@@ -74,7 +74,11 @@ static unsigned long nic_tx_packet_content(struct genode_nic_client_tx_packet_co
 		return 0;
 	}
 
-	skb_copy_from_linear_data(skb, dst, skb->len);
+	/* the skb may be non-linear when using scatter-gather */
+	if (skb_copy_bits(skb, 0, dst, skb->len)) {
+		memset(dst, 0, dst_len);
+		return 0;
+	}
 
 	/* clear unused part of the destination buffer */
 	memset(dst + skb->len, 0, dst_len - skb->len);
@@ -83,6 +87,26 @@ static unsigned long nic_tx_packet_content(struct genode_nic_client_tx_packet_co
 }
 
 
+static struct genode_nic_offload skb_offload(struct sk_buff *skb)
+{
+	struct genode_nic_offload offload = { 0 };
+
+	if (skb_is_gso(skb)) {
+		offload.flags    = GENODE_NIC_OFFLOAD_GSO_TCPV4;
+		offload.gso_size = skb_shinfo(skb)->gso_size;
+		return offload;
+	}
+
+	if (skb->ip_summed == CHECKSUM_PARTIAL) {
+		offload.flags       = GENODE_NIC_OFFLOAD_CSUM_NEEDED;
+		offload.csum_start  = skb_checksum_start_offset(skb);
+		offload.csum_offset = skb->csum_offset;
+	}
+
+	return offload;
+}
+
+
 static int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 {
 	bool progress = false;
@@ -90,10 +114,12 @@ static int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 
 	struct genode_nic_client *nic_client = dev_nic_client(dev);
 	struct genode_nic_client_tx_packet_context ctx = { .skb = skb };
+	struct genode_nic_offload const offload = skb_offload(skb);
 
 	if (!nic_client) return NETDEV_TX_BUSY;
 
-	progress = genode_nic_client_tx_packet(nic_client, nic_tx_packet_content, &ctx);
+	progress = genode_nic_client_tx_offload_packet(nic_client, skb->len, &offload,
+	                                               nic_tx_packet_content, &ctx);
 	/* transmit to nic-session */
 	if (!progress) {
 		/* tx queue is  full, could not enqueue packet */
@@ -135,8 +161,10 @@ struct task_struct *lx_nic_client_rx_task(void)
 }
 
 
-static genode_nic_client_rx_result_t nic_rx_one_packet(struct genode_nic_client_rx_context *ctx,
-                                                       char const *ptr, unsigned long len)
+static genode_nic_client_rx_result_t
+nic_rx_one_packet(struct genode_nic_client_rx_context *ctx,
+                  char const *ptr, unsigned long len,
+                  struct genode_nic_offload const *offload)
 {
 	enum {
 		ADDITIONAL_HEADROOM = 4, /* smallest value found by trial & error */
@@ -155,6 +183,19 @@ static genode_nic_client_rx_result_t nic_rx_one_packet(struct genode_nic_client_
 	skb->protocol  = eth_type_trans(skb, ctx->dev);
 	skb->ip_summed = CHECKSUM_NONE;
 
+	if (offload->flags & GENODE_NIC_OFFLOAD_CSUM_VALID)
+		skb->ip_summed = CHECKSUM_UNNECESSARY;
+
+	/* csum_start is relative to the Ethernet header consumed above */
+	if ((offload->flags & GENODE_NIC_OFFLOAD_CSUM_NEEDED)
+	 && (offload->csum_start < ETH_HLEN
+	  || !skb_partial_csum_set(skb, offload->csum_start - ETH_HLEN,
+	                           offload->csum_offset))) {
+		kfree_skb(skb);
+		stats->rx_dropped++;
+		return GENODE_NIC_CLIENT_RX_REJECTED;
+	}
+
 	netif_receive_skb(skb);
 
 	stats->rx_packets++;
@@ -176,9 +217,9 @@ static int rx_task_function(void *arg)
 
 		lx_emul_task_schedule(true);
 
-		while (genode_nic_client_rx(nic_client,
-		                        nic_rx_one_packet,
-		                        &ctx)) {
+		while (genode_nic_client_rx_offload(nic_client,
+		                                    nic_rx_one_packet,
+		                                    &ctx)) {
 			progress = true; }
 
 		if (progress) socket_schedule_peer();
@@ -197,6 +238,7 @@ static int __init virtio_net_driver_init(void)
 	struct net_device *dev;
 	int err = -ENODEV;
 	struct genode_mac_address mac;
+	struct genode_nic_offload_features offload;
 	pid_t pid;
 
 	dev = alloc_etherdev(0);
@@ -206,8 +248,11 @@ static int __init virtio_net_driver_init(void)
 
 	dev->netdev_ops = &net_ops;
 
+	/* large receive frames are not supported, partial checksums are */
 	dev->ifalias = (struct dev_ifalias *)
-	               genode_nic_client_create(socket_nic_client_label());
+	               genode_nic_client_create_offload(socket_nic_client_label(),
+	                                                (struct genode_nic_offload_features) {
+	                                                	.csum = true, .gso = false });
 
 	if (!dev->ifalias) {
 		printk("Failed to create nic client\n");
@@ -218,6 +263,16 @@ static int __init virtio_net_driver_init(void)
 	mac = genode_nic_client_mac_address(dev_nic_client(dev));
 	dev_addr_set(dev, mac.addr);
 
+	/* let the server complete checksums and segment large TCP frames */
+	offload = genode_nic_client_offload(dev_nic_client(dev));
+	if (offload.csum)
+		dev->hw_features |= NETIF_F_HW_CSUM | NETIF_F_SG;
+	if (offload.csum && offload.gso) {
+		dev->hw_features |= NETIF_F_TSO;
+		netif_set_tso_max_size(dev, GENODE_NIC_OFFLOAD_MAX_FRAME_SIZE - ETH_HLEN);
+	}
+	dev->features |= dev->hw_features;
+
 	if ((err = register_netdev(dev))) {
 		printk("Could not register net device driver %d\n", err);
 		goto out_nic;
@@ -0,0 +1,163 @@
+/*
+ * \brief  Scheduler of frames for animated GUI applications
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The frame scheduler drives an 'Animator' by the sync signals of a GUI
+ * session's framebuffer. Animation steps have a fixed period. At each sync
+ * signal, the application is asked to produce a frame that accounts for all
+ * steps passed since the previous frame. Hence, if the application falls
+ * behind, intermediate frames are skipped instead of delaying the animation.
+ * Sync signals are requested only while animations are in progress or a
+ * frame is pending, which lets the application idle otherwise.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__GEMS__FRAME_SCHEDULER_H_
+#define _INCLUDE__GEMS__FRAME_SCHEDULER_H_
+
+/* Genode includes */
+#include <base/signal.h>
+#include <framebuffer_session/framebuffer_session.h>
+#include <timer_session/connection.h>
+
+/* gems includes */
+#include <gems/animator.h>
+
+class Frame_scheduler : Genode::Noncopyable
+{
+	public:
+
+		struct Attr
+		{
+			unsigned step_ms;    /* period of one animation step */
+			unsigned max_steps;  /* steps caught up at most per frame */
+			unsigned idle_steps; /* steps without sync until considered idle */
+		};
+
+		static constexpr Attr default_attr() {
+			return { .step_ms = 10, .max_steps = 25, .idle_steps = 3 }; }
+
+		struct Frame
+		{
+			unsigned steps;  /* animation steps to apply for this frame */
+
+			/*
+			 * Number of animation steps dropped because the application
+			 * fell behind by more than 'max_steps'
+			 */
+			unsigned skipped;
+		};
+
+		struct Action : Genode::Interface
+		{
+			/**
+			 * Produce frame
+			 *
+			 * The implementation is expected to call 'Animator::animate'
+			 * 'frame.steps' times before drawing.
+			 */
+			virtual void produce_frame(Frame) = 0;
+		};
+
+	private:
+
+		Framebuffer::Session &_framebuffer;
+		Timer::Connection    &_timer;
+		Animator       const &_animator;
+		Action               &_action;
+
+		Attr const _attr;
+
+		Genode::Signal_handler<Frame_scheduler> _sync_handler;
+
+		bool _sync_enabled = false;
+
+		Genode::uint64_t _previous_step = 0;
+
+		Genode::uint64_t _now()
+		{
+			return _timer.curr_time().trunc_to_plain_ms().value / _attr.step_ms;
+		}
+
+		void _sync(bool const enabled)
+		{
+			if (enabled == _sync_enabled)
+				return;
+
+			_framebuffer.sync_sigh(enabled ? Genode::Signal_context_capability(_sync_handler)
+			                               : Genode::Signal_context_capability());
+			_sync_enabled = enabled;
+		}
+
+		void _handle_sync()
+		{
+			Genode::uint64_t const now    = _now();
+			Genode::uint64_t const passed = now - _previous_step;
+
+			_previous_step = now;
+
+			unsigned const steps = unsigned(Genode::min(passed, Genode::uint64_t(_attr.max_steps)));
+
+			_action.produce_frame({ .steps   = steps,
+			                        .skipped = unsigned(passed - steps) });
+
+			/* keep sync signals enabled only while animations are in progress */
+			_sync(_animator.active());
+		}
+
+	public:
+
+		Frame_scheduler(Genode::Entrypoint &ep, Framebuffer::Session &framebuffer,
+		                Timer::Connection &timer, Animator const &animator,
+		                Action &action, Attr const attr = default_attr())
+		:
+			_framebuffer(framebuffer), _timer(timer), _animator(animator),
+			_action(action), _attr(attr),
+			_sync_handler(ep, *this, &Frame_scheduler::_handle_sync)
+		{ }
+
+		~Frame_scheduler() { _sync(false); }
+
+		/**
+		 * Request a frame, e.g., after a model update
+		 *
+		 * While sync signals are enabled, the frame is produced at the next
+		 * sync signal, which batches model updates arriving in short
+		 * succession. Otherwise, the frame is produced immediately.
+		 */
+		void schedule()
+		{
+			Genode::uint64_t const now = _now();
+
+			bool const idle = now - _previous_step > _attr.idle_steps;
+
+			if (!_sync_enabled || idle) {
+				_previous_step = now;
+				_sync_handler.local_submit();
+			}
+		}
+
+		/**
+		 * Start the animation clock after the application produced a frame
+		 *
+		 * This method is meant for applications that draw directly in
+		 * response to a model update and may have started new animations.
+		 */
+		void animate()
+		{
+			if (_sync_enabled)
+				return;
+
+			_previous_step = _now();
+			_sync(true);
+		}
+};
+
+#endif /* _INCLUDE__GEMS__FRAME_SCHEDULER_H_ */
@@ -126,7 +126,39 @@ struct Gui_buffer : Genode::Noncopyable
 		});
 	}
 
-	void _update_input_mask()
+	/**
+	 * Reset the part of the drawing surface covered by 'rect'
+	 */
+	void reset_surface(Rect const rect)
+	{
+		Rect const clipped = Rect::intersect(rect, Rect({ 0, 0 }, size()));
+		if (!clipped.valid())
+			return;
+
+		with_alpha_surface([&] (Alpha_surface &alpha) {
+
+			if (!alpha.size().valid())
+				return;
+
+			for (unsigned y = 0; y < clipped.h(); y++)
+				Genode::memset(alpha.addr() + (clipped.y1() + y)*alpha.size().w
+				                            + clipped.x1(), 0, clipped.w());
+		});
+
+		with_pixel_surface([&] (Pixel_surface &pixel) {
+
+			Pixel_rgb888 const color = reset_color;
+
+			for (unsigned y = 0; y < clipped.h(); y++) {
+				Pixel_rgb888 *dst = pixel.addr() + (clipped.y1() + y)*pixel.size().w
+				                                 + clipped.x1();
+				for (unsigned n = clipped.w(); n; n--)
+					*dst++ = color;
+			}
+		});
+	}
+
+	void _update_input_mask(Rect const rect)
 	{
 		with_alpha_surface([&] (Alpha_surface &alpha) {
 
@@ -135,32 +167,50 @@ struct Gui_buffer : Genode::Noncopyable
 			_gui_mode.with_input_surface(_fb_ds, [&] (Input_surface &input) {
 				input.with_window(_backbuffer, [&] (Input_surface &input) {
 
-					uint8_t const * src = (uint8_t *)alpha.addr();
-					uint8_t       * dst = (uint8_t *)input.addr();
+					Rect const clipped =
+						Rect::intersect(rect, Rect::intersect(Rect({ 0, 0 }, alpha.size()),
+						                                      Rect({ 0, 0 }, input.size())));
 
 					/*
 					 * Set input mask for all pixels where the alpha value is
 					 * above a given threshold. The threshold is defined such
 					 * that typical drop shadows are below the value.
 					 */
-					uint8_t const threshold  = 100;
-					size_t  const num_pixels = Genode::min(alpha.size().count(),
-					                                       input.size().count());
+					uint8_t const threshold = 100;
+
+					for (unsigned y = 0; y < clipped.h(); y++) {
+
+						size_t const offset = (clipped.y1() + y)*alpha.size().w
+						                    + clipped.x1();
 
-					for (unsigned i = 0; i < num_pixels; i++)
-						*dst++ = (*src++) > threshold;
+						uint8_t const * src = (uint8_t *)alpha.addr() + offset;
+						uint8_t       * dst = (uint8_t *)input.addr() + offset;
+
+						for (unsigned n = clipped.w(); n; n--)
+							*dst++ = (*src++) > threshold;
+					}
 				});
 			});
 		});
 	}
 
-	void flush_surface()
+	/**
+	 * Make the part of the drawing surface covered by 'rect' visible
+	 */
+	void flush_surface(Rect const rect)
 	{
-		_update_input_mask();
+		Rect const clipped = Rect::intersect(rect, Rect({ 0, 0 }, size()));
+		if (!clipped.valid())
+			return;
+
+		_update_input_mask(clipped);
 
-		/* copy lower part of virtual framebuffer to upper part */
-		_gui.framebuffer.blit({ { 0, int(size().h) }, size() }, { 0, 0 });
+		/* copy part of the lower virtual framebuffer to the upper part */
+		_gui.framebuffer.blit({ clipped.p1() + Point(0, int(size().h)), clipped.area },
+		                      clipped.p1());
 	}
+
+	void flush_surface() { flush_surface(Rect({ 0, 0 }, size())); }
 };
 
 #endif /* _INCLUDE__GEMS__GUI_BUFFER_H_ */
@@ -190,6 +190,21 @@ class Png_image
 			return Genode::Surface_base::Area(_info.img_w, _info.img_h);
 		}
 
+		/**
+		 * Decode PNG image data into the given texture
+		 *
+		 * The texture must have the size of the PNG image. The image can be
+		 * decoded only once.
+		 */
+		template <typename PT>
+		void decode(Genode::Texture<PT> &texture)
+		{
+			for (unsigned i = 0; i < size().h; i++) {
+				png_read_row(_read_struct.png_ptr, _row.row_ptr, NULL);
+				texture.rgba((unsigned char *)_row.row_ptr, size().w*4, i);
+			}
+		}
+
 		/**
 		 * Obtain PNG image as texture
 		 */
@@ -200,10 +215,7 @@ class Png_image
 				Chunky_texture<PT>(_ram, _rm, size());
 
 			/* fill texture with PNG image data */
-			for (unsigned i = 0; i < size().h; i++) {
-				png_read_row(_read_struct.png_ptr, _row.row_ptr, NULL);
-				texture->rgba((unsigned char *)_row.row_ptr, size().w*4, i);
-			}
+			decode(*texture);
 
 			return texture;
 		}
@@ -0,0 +1,374 @@
+/*
+ * \brief  Content-addressed cache of decoded textures
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Textures are identified by a hash of their encoded (e.g., PNG) data.
+ * Besides keeping decoded textures in memory, the cache can persist them
+ * in a directory that is shared by several components, e.g., a RAM file
+ * system. When configured, previously decoded textures are obtained as
+ * ROM modules from this directory (e.g., via fs_rom), which allows all
+ * components to use the same physical memory.
+ *
+ * Since the hash is not collision resistant, a persistent texture stores
+ * a copy of its encoded data, which is compared with the encoded data at
+ * hand before the texture is used.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__GEMS__TEXTURE_CACHE_H_
+#define _INCLUDE__GEMS__TEXTURE_CACHE_H_
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <util/list.h>
+#include <os/texture.h>
+#include <os/vfs.h>
+
+/* gems includes */
+#include <gems/chunky_texture.h>
+
+template <typename PT>
+class Texture_cache
+{
+	public:
+
+		using Texture = Genode::Texture<PT>;
+		using Area    = Genode::Surface_base::Area;
+		using Path    = Genode::Directory::Path;
+
+		struct Key
+		{
+			Genode::uint64_t value;
+
+			/**
+			 * Compute key from encoded image data using the FNV-1a hash
+			 */
+			static Key from_bytes(char const *start, Genode::size_t num_bytes)
+			{
+				Genode::uint64_t h = 0xcbf29ce484222325ull;
+				for (Genode::size_t i = 0; i < num_bytes; i++)
+					h = (h ^ (Genode::uint8_t)start[i])*0x100000001b3ull;
+
+				return { h };
+			}
+
+			bool operator == (Key const &other) const { return value == other.value; }
+
+			Path file_name() const
+			{
+				return Path(Genode::Hex(value, Genode::Hex::OMIT_PREFIX,
+				                        Genode::Hex::PAD), ".texture");
+			}
+		};
+
+		/**
+		 * Header of a persistent texture
+		 *
+		 * The header is followed by the pixel and alpha buffers, using the
+		 * same layout as 'Chunky_texture', and the encoded data the texture
+		 * was decoded from.
+		 */
+		struct Header
+		{
+			static constexpr Genode::uint32_t MAGIC = 0x54584332; /* "TXC2" */
+
+			/* limit of width and height, which keeps the payload size sane */
+			static constexpr Genode::uint32_t MAX_SIZE = 8192;
+
+			Genode::uint32_t magic, format, w, h, source_bytes;
+
+			static Header from_area(Area area, Genode::size_t source_bytes)
+			{
+				return { .magic        = MAGIC,
+				         .format       = PT::format(),
+				         .w            = area.w,
+				         .h            = area.h,
+				         .source_bytes = (Genode::uint32_t)source_bytes };
+			}
+
+			Area area() const { return { w, h }; }
+
+			static Genode::size_t payload_bytes(Area area)
+			{
+				return area.count()*(sizeof(PT) + 1);
+			}
+
+			Genode::size_t source_offset() const
+			{
+				return sizeof(Header) + payload_bytes(area());
+			}
+
+			bool valid(Genode::size_t num_bytes) const
+			{
+				return magic == MAGIC && format == (Genode::uint32_t)PT::format()
+				    && area().valid() && w <= MAX_SIZE && h <= MAX_SIZE
+				    && num_bytes >= source_offset() + source_bytes;
+			}
+		};
+
+		struct Attr
+		{
+			Path path;  /* location of the cache directory */
+			bool rom;   /* obtain persistent textures as ROM modules */
+
+			static Attr from_node(Genode::Node const &node)
+			{
+				return { .path = node.attribute_value("path", Path("/texture_cache")),
+				         .rom  = node.attribute_value("rom", false) };
+			}
+
+			/**
+			 * Return ROM name of a persistent texture
+			 *
+			 * The ROM module is named after the file path relative to the
+			 * root directory, e.g., 'texture_cache/<hash>.texture' for the
+			 * path '/texture_cache'. This way, an fs_rom instance that
+			 * serves the same file system as the cache directory finds
+			 * the texture.
+			 */
+			Path rom_name(Key const &key) const
+			{
+				char const *dir = path.string();
+				while (*dir == '/')
+					dir++;
+
+				if (*dir == 0)
+					return key.file_name();
+
+				return Path(dir, "/", key.file_name());
+			}
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Texture_cache(Texture_cache const &);
+		Texture_cache &operator = (Texture_cache const &);
+
+		Genode::Env       &_env;
+		Genode::Allocator &_alloc;
+
+		Attr const _attr;
+
+		Genode::Directory * const _dir;
+
+		struct Entry : Genode::List<Entry>::Element, Genode::Noncopyable
+		{
+			Key            const key;
+			Genode::size_t const source_bytes;
+
+			Genode::Constructible<Chunky_texture<PT>>             ram { };
+			Genode::Constructible<Genode::Attached_rom_dataspace> rom { };
+			Genode::Constructible<Texture>                        rom_texture { };
+
+			Entry(Key key, Genode::size_t source_bytes)
+			: key(key), source_bytes(source_bytes) { }
+
+			Texture const *texture() const
+			{
+				if (rom_texture.constructed()) return &*rom_texture;
+				if (ram.constructed())         return &*ram;
+				return nullptr;
+			}
+		};
+
+		Genode::List<Entry> _entries { };
+
+		Entry *_lookup(Key const key, Genode::size_t source_bytes)
+		{
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (e->key == key && e->source_bytes == source_bytes)
+					return e;
+			return nullptr;
+		}
+
+		static bool _header_matches(Header const &header,
+		                            Genode::Const_byte_range_ptr const &source)
+		{
+			return header.w <= Header::MAX_SIZE && header.h <= Header::MAX_SIZE
+			    && header.source_bytes == source.num_bytes;
+		}
+
+		bool _try_obtain_rom(Entry &entry, Genode::Const_byte_range_ptr const &source)
+		{
+			using namespace Genode;
+
+			Path const name = _attr.rom_name(entry.key);
+
+			try { entry.rom.construct(_env, name.string()); }
+			catch (...) { return false; }
+
+			Attached_rom_dataspace const &rom = *entry.rom;
+
+			Header const *header = rom.local_addr<Header const>();
+
+			if (rom.size() < sizeof(Header)
+			 || !_header_matches(*header, source)
+			 || !header->valid(rom.size())
+			 || memcmp(rom.local_addr<char const>() + header->source_offset(),
+			           source.start, source.num_bytes)) {
+				entry.rom.destruct();
+				return false;
+			}
+
+			Area const area  = header->area();
+			PT * const pixel = (PT *)(rom.local_addr<char const>() + sizeof(Header));
+
+			entry.rom_texture.construct(pixel, (unsigned char *)(pixel + area.count()), area);
+			return true;
+		}
+
+		bool _try_read_file(Entry &entry, Genode::Const_byte_range_ptr const &source,
+		                    Genode::Ram_allocator &ram, Genode::Env::Local_rm &rm)
+		{
+			using namespace Genode;
+
+			try {
+				Readonly_file const file(*_dir, entry.key.file_name());
+
+				Header header { };
+				if (file.read(Readonly_file::At { 0 },
+				              Byte_range_ptr((char *)&header, sizeof(header))) != sizeof(header)
+				 || !_header_matches(header, source)
+				 || !header.valid(header.source_offset() + header.source_bytes))
+					return false;
+
+				/* compare the stored encoded data chunk-wise with the source */
+				for (size_t offset = 0; offset < source.num_bytes; ) {
+
+					char chunk[256];
+					size_t const n = min(sizeof(chunk), source.num_bytes - offset);
+
+					if (file.read(Readonly_file::At { header.source_offset() + offset },
+					              Byte_range_ptr(chunk, n)) != n
+					 || memcmp(chunk, source.start + offset, n))
+						return false;
+
+					offset += n;
+				}
+
+				size_t const payload = Header::payload_bytes(header.area());
+
+				entry.ram.construct(ram, rm, header.area());
+
+				if (file.read(Readonly_file::At { sizeof(Header) },
+				              Byte_range_ptr((char *)entry.ram->pixel(), payload)) == payload)
+					return true;
+
+				entry.ram.destruct();
+			}
+			catch (...) { }
+
+			return false;
+		}
+
+		void _write_file(Entry const &entry, Genode::Const_byte_range_ptr const &source)
+		{
+			using namespace Genode;
+
+			Texture const &texture = *entry.texture();
+
+			Path const name = entry.key.file_name();
+			if (_dir->file_exists(name))
+				return;
+
+			try {
+				Header const header = Header::from_area(texture.size(), source.num_bytes);
+
+				New_file file(*_dir, name);
+
+				auto append = [&] (void const *ptr, size_t num_bytes)
+				{
+					return file.append((char const *)ptr, num_bytes)
+					       == New_file::Append_result::OK;
+				};
+
+				if (!append(&header, sizeof(header))
+				 || !append(texture.pixel(), Header::payload_bytes(texture.size()))
+				 || !append(source.start, source.num_bytes))
+					warning("failed to write texture cache entry ", name);
+			}
+			catch (...) {
+				warning("unable to create texture cache entry ", name);
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param dir  directory used for persisting decoded textures,
+		 *             or 'nullptr' for an in-memory cache only
+		 */
+		Texture_cache(Genode::Env &env, Genode::Allocator &alloc,
+		              Genode::Directory *dir, Attr attr)
+		:
+			_env(env), _alloc(alloc), _attr(attr), _dir(dir)
+		{ }
+
+		~Texture_cache()
+		{
+			while (Entry *e = _entries.first()) {
+				_entries.remove(e);
+				Genode::destroy(_alloc, e);
+			}
+		}
+
+		/**
+		 * Return texture decoded from the encoded data 'source'
+		 *
+		 * If the texture is not cached, 'decode_fn' is called with a
+		 * functor that takes the image size as argument and returns a
+		 * texture to be filled with the decoded image.
+		 *
+		 * \return  texture, or nullptr if the image has no valid size
+		 */
+		Texture const *texture(Genode::Const_byte_range_ptr const &source,
+		                       Genode::Ram_allocator &ram,
+		                       Genode::Env::Local_rm &rm, auto const &decode_fn)
+		{
+			Key const key = Key::from_bytes(source.start, source.num_bytes);
+
+			if (Entry const *e = _lookup(key, source.num_bytes))
+				return e->texture();
+
+			Entry &entry = *new (_alloc) Entry(key, source.num_bytes);
+
+			bool const cached = _dir && ((_attr.rom && _try_obtain_rom(entry, source))
+			                          || _try_read_file(entry, source, ram, rm));
+			if (!cached) {
+				try {
+					decode_fn([&] (Area size) -> Texture & {
+						entry.ram.construct(ram, rm, size);
+						return *entry.ram; });
+				}
+				catch (...) {
+					Genode::destroy(_alloc, &entry);
+					throw;
+				}
+
+				if (!entry.texture() || !entry.texture()->size().valid()) {
+					Genode::destroy(_alloc, &entry);
+					return nullptr;
+				}
+
+				if (_dir)
+					_write_file(entry, source);
+			}
+
+			_entries.insert(&entry);
+			return entry.texture();
+		}
+};
+
+#endif /* _INCLUDE__GEMS__TEXTURE_CACHE_H_ */
@@ -15,6 +15,8 @@
 #define _INCLUDE__GEMS__TEXTURE_UTILS_H_
 
 #include <os/texture.h>
+#include <os/dither_painter.h>
+#include <os/pixel_alpha8.h>
 
 template <typename PT>
 static void scale(Genode::Texture<PT> const &src, Genode::Texture<PT> &dst,
@@ -68,6 +70,21 @@ static void convert_pixel_format(Genode::Texture<SRC_PT> const &src,
 	if (src.size() != dst.size())
 		return;
 
+	/*
+	 * Without scaling of the alpha values, the pixels are converted by the
+	 * dither painter, which employs the vectorized blit kernels for RGB888
+	 * textures. The alpha values are taken over unmodified.
+	 */
+	if (alpha == 256) {
+		Genode::Surface<DST_PT> surface(dst.pixel(), dst.size());
+		Dither_painter::paint(surface, src, Genode::Surface_base::Point(0, 0));
+
+		if (dst.alpha() && src.alpha())
+			Genode::memcpy(dst.alpha(), src.alpha(), dst.size().count());
+
+		return;
+	}
+
 	Genode::size_t const row_num_bytes = dst.size().w*4;
 	unsigned char *row = (unsigned char *)alloc.alloc(row_num_bytes);
 
@@ -127,6 +127,8 @@ struct Menu_view::Box_layout_widget : Widget
 		_stack_and_count_child_widgets();
 	}
 
+	void _children_changed() override { _stack_and_count_child_widgets(); }
+
 	Area min_size() const override
 	{
 		return _min_size;
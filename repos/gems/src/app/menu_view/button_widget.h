@@ -175,6 +175,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 		_draw_children(pixel_surface, alpha_surface, at);
 	}
 
+	bool _animated() const override { return Animator::Item::animated(); }
+
 	void _layout() override
 	{
 		_children.for_each([&] (Widget &child) {
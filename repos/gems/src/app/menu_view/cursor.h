@@ -109,6 +109,8 @@ class Menu_view::Cursor : List_model<Cursor>::Element
 			}
 		}
 
+		bool animated() const { return _position.animated(); }
+
 		bool matches(Node const &node) const
 		{
 			return _node_name(node) == _name;
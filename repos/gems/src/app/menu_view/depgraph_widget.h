@@ -501,7 +501,7 @@ struct Menu_view::Depgraph_widget : Widget
 			},
 
 			/* update */
-			[&] (Widget &w, Genode::Node const &node) { w.update(node); }
+			[&] (Widget &w, Genode::Node const &node) { w.update_if_changed(node); }
 		);
 
 		/*
@@ -553,6 +553,14 @@ struct Menu_view::Depgraph_widget : Widget
 		_nodes.for_each([&] (Node &node) {
 			node.destroy_stale_deps(); });
 
+		_compute_geometries();
+	}
+
+	/**
+	 * Compute node positions according to the minimum sizes of the widgets
+	 */
+	void _compute_geometries()
+	{
 		_nodes.for_each([&] (Node &node) {
 			node.layout_breadth_child_offset = 0; });
 
@@ -701,6 +709,21 @@ struct Menu_view::Depgraph_widget : Widget
 		_draw_children(pixel_surface, alpha_surface, at);
 	}
 
+	/*
+	 * The connections depend on the animated geometries of all nodes and
+	 * dependencies. Hence, the graph is redrawn as a whole while any animation
+	 * is in progress.
+	 */
+	bool _animated() const override { return _factory.animator.active(); }
+
+	void _children_changed() override
+	{
+		_compute_geometries();
+
+		/* the connections follow the new node positions */
+		_damage.changed = true;
+	}
+
 	void _layout() override
 	{
 		/*
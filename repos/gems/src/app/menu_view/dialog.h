@@ -19,6 +19,7 @@
 
 /* gems includes */
 #include <gems/gui_buffer.h>
+#include <gems/frame_scheduler.h>
 
 /* local includes */
 #include <types.h>
@@ -51,7 +52,6 @@ struct Menu_view::Dialog : List_model<Dialog>::Element
 	{
 		virtual void hover_changed() = 0;
 		virtual void observed_seq_number(Input::Seq_number) = 0;
-		virtual Ticks now() = 0;
 	};
 
 	Action &_action;
@@ -74,14 +74,20 @@ struct Menu_view::Dialog : List_model<Dialog>::Element
 
 	void _handle_input();
 
-	Signal_handler<Dialog> _gui_sync_handler {
-		_env.ep(), *this, &Dialog::_handle_gui_sync };
+	void _produce_frame(Frame_scheduler::Frame);
 
-	void _handle_gui_sync();
+	struct Frame_action : Frame_scheduler::Action
+	{
+		Dialog &_dialog;
+
+		Frame_action(Dialog &dialog) : _dialog(dialog) { }
+
+		void produce_frame(Frame_scheduler::Frame frame) override {
+			_dialog._produce_frame(frame); }
 
-	bool _gui_sync_enabled = false;
+	} _frame_action { *this };
 
-	Ticks _previous_sync { };
+	Frame_scheduler _frame_scheduler;
 
 	Constructible<Gui_buffer> _buffer { };
 
@@ -140,11 +146,13 @@ struct Menu_view::Dialog : List_model<Dialog>::Element
 	void _handle_dialog();
 
 	Dialog(Env &env, Widget_factory &widget_factory, Action &action,
-	       Hover_version &global_hover_version, Node const &node)
+	       Timer::Connection &timer, Hover_version &global_hover_version,
+	       Node const &node)
 	:
 		_env(env), _global_widget_factory(widget_factory),
 		_global_hover_version(global_hover_version), _action(action),
-		_name(_name_from_attr(node))
+		_name(_name_from_attr(node)),
+		_frame_scheduler(_env.ep(), _gui.framebuffer, timer, _local_animator, _frame_action)
 	{
 		_gui.view(_view.id(), { });
 
@@ -166,6 +174,11 @@ struct Menu_view::Dialog : List_model<Dialog>::Element
 			_root_widget.gen_hover_model(g, _hovered_position);
 	}
 
+	/*
+	 * Size of the root widget at the most recent redraw
+	 */
+	Area _drawn_size { };
+
 	void _redraw()
 	{
 		if (!_redraw_scheduled)
@@ -181,23 +194,53 @@ struct Menu_view::Dialog : List_model<Dialog>::Element
 		bool const size_increased = (max_size.w > buffer_w)
 		                         || (max_size.h > buffer_h);
 
+		bool const full_redraw = !_buffer.constructed() || size_increased
+		                      || (size != _drawn_size);
+
 		if (!_buffer.constructed() || size_increased)
 			_buffer.construct(_gui, max_size, _env.ram(), _env.rm(),
 			                  _opaque ? Gui_buffer::Alpha::OPAQUE
 			                          : Gui_buffer::Alpha::ALPHA,
 			                  _background_color);
-		else
+		else if (full_redraw)
 			_buffer->reset_surface();
 
 		_root_widget.position(Point(0, 0));
 
-		_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
-		                               Surface<Pixel_alpha8> &alpha) {
-			_root_widget.draw(pixel, alpha, Point(0, 0));
-		});
+		/* collect areas affected by changes since the previous redraw */
+		Dirty_rect dirty { };
+		_root_widget.mark_damaged(dirty, Point(0, 0));
+
+		if (full_redraw) {
+
+			_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
+			                               Surface<Pixel_alpha8> &alpha) {
+				_root_widget.draw(pixel, alpha, Point(0, 0));
+			});
+
+			_buffer->flush_surface();
+			_gui.framebuffer.refresh({ { 0, 0 }, _buffer->size() });
+
+		} else {
+
+			/* repaint only the damaged areas */
+			dirty.flush([&] (Rect const &rect) {
+
+				_buffer->reset_surface(rect);
+
+				_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
+				                               Surface<Pixel_alpha8> &alpha) {
+					pixel.clip(rect);
+					alpha.clip(rect);
+					_root_widget.draw(pixel, alpha, Point(0, 0));
+				});
+
+				_buffer->flush_surface(rect);
+			});
+		}
+
+		_drawn_size = size;
 
-		_buffer->flush_surface();
-		_gui.framebuffer.refresh({ { 0, 0 }, _buffer->size() });
 		_update_view(Rect(_position, size));
 
 		_redraw_scheduled = false;
@@ -217,6 +260,9 @@ struct Menu_view::Dialog : List_model<Dialog>::Element
 
 	void enforce_font_sytle_change()
 	{
+		/* update all widgets regardless of their unchanged node content */
+		_root_widget.invalidate();
+
 		_handle_dialog();
 
 		/* fast-forward geometry animation */
@@ -263,20 +309,16 @@ void Menu_view::Dialog::_handle_dialog()
 	if (dialog.has_type("empty"))
 		return;
 
-	_root_widget.update(dialog);
+	_root_widget.update_if_changed(dialog);
 	_root_widget.size(_root_widget_size());
 
 	_redraw_scheduled = true;
 
 	_action.hover_changed();
 
-	if (!_gui_sync_enabled) {
-		_previous_sync = _action.now();
-		_gui.framebuffer.sync_sigh(_gui_sync_handler);
-		_gui_sync_enabled = true;
-	}
-
 	_redraw();
+
+	_frame_scheduler.animate();
 }
 
 
@@ -329,24 +371,13 @@ void Menu_view::Dialog::_handle_input()
 }
 
 
-void Menu_view::Dialog::_handle_gui_sync()
+void Menu_view::Dialog::_produce_frame(Frame_scheduler::Frame const frame)
 {
-	Ticks const now = _action.now();
-
-	Ticks const passed_ticks { now.cs - _previous_sync.cs };
-
-	for (unsigned i = 0; i < passed_ticks.cs; i++)
+	for (unsigned i = 0; i < frame.steps; i++)
 		_animate();
 
-	if (passed_ticks.cs)
+	if (frame.steps)
 		_redraw();
-
-	/* deactivate sync signalling when idle */
-	if (_gui_sync_enabled && !_local_animator.active()) {
-		_gui.framebuffer.sync_sigh(Signal_context_capability());
-		_gui_sync_enabled = false;
-	}
-	_previous_sync = now;
 }
 
 #endif /* _DIALOG_H_ */
@@ -37,6 +37,8 @@ struct Menu_view::Label_widget : Widget, Cursor::Glyph_position
 	int _min_width  = 0;
 	int _min_height = 0;
 
+	Area _min_size { }; /* value cached from 'update' */
+
 	List_model<Cursor>         _cursors    { };
 	List_model<Text_selection> _selections { };
 
@@ -104,15 +106,35 @@ struct Menu_view::Label_widget : Widget, Cursor::Glyph_position
 		}
 
 		_update_children(node);
+
+		_min_size = _font ? Area(max(_font->string_width(_text.string()).decimal(), _min_width),
+		                         _min_height)
+		                  : Area(0, 0);
 	}
 
-	Area min_size() const override
+	Area min_size() const override { return _min_size; }
+
+	bool _animated() const override
 	{
-		if (!_font)
-			return Area(0, 0);
+		bool result = _color.animated();
+		_cursors.for_each([&] (Cursor const &cursor) {
+			result = result || cursor.animated(); });
+		return result;
+	}
+
+	Rect _damage_rect(Point at) const override
+	{
+		/* the text may exceed the widget boundaries while shrinking */
+		Area const text_size = min_size();
+		Area const area      = _animated_geometry.area();
+
+		if (!text_size.valid())
+			return Rect(at, area);
+
+		Point const centered = at + Point(((int)area.w - (int)text_size.w)/2,
+		                                  ((int)area.h - (int)text_size.h)/2);
 
-		return Area(max(_font->string_width(_text.string()).decimal(), _min_width),
-		            _min_height);
+		return Rect::compound(Rect(at, area), Rect(centered, text_size));
 	}
 
 	void draw(Surface<Pixel_rgb888> &pixel_surface,
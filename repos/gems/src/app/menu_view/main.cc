@@ -12,19 +12,12 @@
  */
 
 /* Genode includes */
-#include <base/sleep.h>
 #include <os/reporter.h>
 #include <timer_session/connection.h>
 #include <os/vfs.h>
 
 /* local includes */
 #include <dialog.h>
-#include <button_widget.h>
-#include <label_widget.h>
-#include <box_layout_widget.h>
-#include <float_widget.h>
-#include <frame_widget.h>
-#include <depgraph_widget.h>
 
 namespace Menu_view { struct Main; }
 
@@ -48,8 +41,45 @@ struct Menu_view::Main : Dialog::Action
 	Directory _fonts_dir  { _root_dir, "fonts" };
 	Directory _styles_dir { _root_dir, "styles" };
 
+	static Texture_cache::Attr _texture_cache_attr_from_config(Node const &config)
+	{
+		Texture_cache::Attr attr { .path = { }, .rom = false };
+		config.with_optional_sub_node("texture_cache", [&] (Node const &node) {
+			attr = Texture_cache::Attr::from_node(node); });
+		return attr;
+	}
+
+	Texture_cache::Attr const _texture_cache_attr =
+		_texture_cache_attr_from_config(_config.node());
+
+	/*
+	 * Optional directory for sharing decoded textures with other instances
+	 */
+	struct Texture_cache_dir
+	{
+		Constructible<Directory> _dir { };
+
+		Texture_cache_dir(Directory &root_dir, Texture_cache::Attr const &attr)
+		{
+			if (!attr.path.valid())
+				return;
+
+			if (root_dir.directory_exists(attr.path))
+				_dir.construct(root_dir, attr.path);
+			else
+				warning("texture-cache directory ", attr.path, " does not exist");
+		}
+
+		Directory *ptr() { return _dir.constructed() ? &*_dir : nullptr; }
+
+	} _texture_cache_dir { _root_dir, _texture_cache_attr };
+
+	Texture_cache _texture_cache { _env, _heap, _texture_cache_dir.ptr(),
+	                               _texture_cache_attr };
+
 	Style_database _styles { _env.ep(), _env.ram(), _env.rm(), _heap,
-	                         _fonts_dir, _styles_dir, _config_handler };
+	                         _fonts_dir, _styles_dir, _texture_cache,
+	                         _config_handler };
 
 	Animator _global_animator { };
 
@@ -87,14 +117,6 @@ struct Menu_view::Main : Dialog::Action
 
 	Timer::Connection _timer { _env };
 
-	/**
-	 * Dialog::Action
-	 */
-	Ticks now() override
-	{
-		return { .cs = _timer.curr_time().trunc_to_plain_ms().value / 10 };
-	}
-
 	/**
 	 * Dialog::Action
 	 */
@@ -181,7 +203,7 @@ void Menu_view::Main::_handle_config()
 		/* create */
 		[&] (Node const &node) -> Dialog & {
 			return *new (_heap)
-				Dialog(_env, _widget_factory, *this, _global_hover_version, node); },
+				Dialog(_env, _widget_factory, *this, _timer, _global_hover_version, node); },
 
 		/* destroy */
 		[&] (Dialog &d) { destroy(_heap, &d); },
@@ -200,51 +222,6 @@ void Menu_view::Main::_handle_config()
 }
 
 
-Menu_view::Widget &
-Menu_view::Widget_factory::create(Node const &node)
-{
-	Widget::Unique_id const unique_id(++_unique_id_cnt);
-
-	Widget::Attr const attr { .type    = node.type(),
-	                          .name    = Widget::node_name(node),
-	                          .version = Widget::node_version(node),
-	                          .id      = unique_id };
-
-	auto dir = [] (Node const &node)
-	{
-		return node.has_type("vbox") ? Box_layout_widget::VERTICAL
-		                             : Box_layout_widget::HORIZONTAL;
-	};
-
-	if (node.has_type("label"))    return *new (alloc) Label_widget      (*this, attr);
-	if (node.has_type("button"))   return *new (alloc) Button_widget     (*this, attr);
-	if (node.has_type("vbox"))     return *new (alloc) Box_layout_widget (*this, attr, dir(node));
-	if (node.has_type("hbox"))     return *new (alloc) Box_layout_widget (*this, attr, dir(node));
-	if (node.has_type("frame"))    return *new (alloc) Frame_widget      (*this, attr);
-	if (node.has_type("float"))    return *new (alloc) Float_widget      (*this, attr);
-	if (node.has_type("depgraph")) return *new (alloc) Depgraph_widget   (*this, attr);
-
-	/*
-	 * This cannot occur because the 'List_model' ensures that 'create' is only
-	 * called for nodes that passed 'node_type_known'.
-	 */
-	error("unknown widget type '", node.type(), "'");
-	sleep_forever();
-}
-
-
-bool Menu_view::Widget_factory::node_type_known(Node const &node)
-{
-	return node.has_type("label")
-	    || node.has_type("button")
-	    || node.has_type("vbox")
-	    || node.has_type("hbox")
-	    || node.has_type("frame")
-	    || node.has_type("float")
-	    || node.has_type("depgraph");
-}
-
-
 /*
  * Silence debug messages
  */
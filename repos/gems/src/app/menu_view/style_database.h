@@ -17,6 +17,7 @@
 /* gems includes */
 #include <gems/file.h>
 #include <gems/png_image.h>
+#include <gems/texture_cache.h>
 #include <gems/cached_font.h>
 #include <gems/vfs_font.h>
 
@@ -27,6 +28,8 @@ namespace Menu_view {
 
 	struct Label_style;
 	struct Style_database;
+
+	using Texture_cache = ::Texture_cache<Pixel_rgb888>;
 }
 
 
@@ -93,32 +96,14 @@ class Menu_view::Style_database
 
 		struct Texture_entry : List<Texture_entry>::Element
 		{
-			Path             const path;
-			File_content           png_file;
-			Png_image              png_image;
-			Texture<Pixel_rgb888> &texture;
+			Path                  const  path;
+			Texture<Pixel_rgb888> const &texture;  /* owned by texture cache */
 
 			bool const out_of_date = false;
 
-			void const *_png_data()
-			{
-				void const *result = nullptr;
-				png_file.bytes([&] (char const *ptr, size_t) { result = ptr; });
-				return result;
-			}
-
-			/**
-			 * Constructor
-			 *
-			 * \throw Reading_failed
-			 */
-			Texture_entry(Ram_allocator &ram, Env::Local_rm &rm, Allocator &alloc,
-			              Directory const &dir, Path const &path)
+			Texture_entry(Path const &path, Texture<Pixel_rgb888> const &texture)
 			:
-				path(path),
-				png_file(alloc, dir, path.string(), File_content::Limit{256*1024}),
-				png_image(ram, rm, alloc, _png_data()),
-				texture(*png_image.texture<Pixel_rgb888>())
+				path(path), texture(texture)
 			{ }
 		};
 
@@ -172,6 +157,7 @@ class Menu_view::Style_database
 		Allocator       &_alloc;
 		Directory const &_fonts_dir;
 		Directory const &_styles_dir;
+		Texture_cache   &_texture_cache;
 
 		Signal_context_capability _style_changed_sigh;
 
@@ -237,10 +223,12 @@ class Menu_view::Style_database
 		Style_database(Entrypoint &ep, Ram_allocator &ram, Env::Local_rm &rm,
 		               Allocator &alloc,
 		               Directory const &fonts_dir, Directory const &styles_dir,
+		               Texture_cache &texture_cache,
 		               Signal_context_capability style_changed_sigh)
 		:
 			_ep(ep), _ram(ram), _rm(rm), _alloc(alloc),
 			_fonts_dir(fonts_dir), _styles_dir(styles_dir),
+			_texture_cache(texture_cache),
 			_style_changed_sigh(style_changed_sigh)
 		{ }
 
@@ -252,11 +240,28 @@ class Menu_view::Style_database
 				return &e->texture;
 
 			/*
-			 * Load and remember PNG image
+			 * Load PNG image, obtain decoded texture from the texture cache,
+			 * and remember it
 			 */
 			try {
-				Texture_entry *e = new (_alloc)
-					Texture_entry(_ram, _rm, _alloc, _styles_dir, path.string());
+				File_content const png_file(_alloc, _styles_dir, path.string(),
+				                            File_content::Limit{256*1024});
+
+				Texture<Pixel_rgb888> const *texture_ptr = nullptr;
+
+				png_file.bytes([&] (char const *ptr, size_t num_bytes) {
+
+					texture_ptr = _texture_cache.texture({ ptr, num_bytes }, _ram, _rm,
+						[&] (auto const &create_texture_fn) {
+							Png_image png_image(_ram, _rm, _alloc, ptr);
+							png_image.decode(create_texture_fn(png_image.size()));
+						});
+				});
+
+				if (!texture_ptr)
+					throw Reading_failed();
+
+				Texture_entry *e = new (_alloc) Texture_entry(path, *texture_ptr);
 
 				_textures.insert(e);
 				return &e->texture;
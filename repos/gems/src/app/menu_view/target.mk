@@ -1,5 +1,5 @@
 TARGET   = menu_view
-SRC_CC   = main.cc
+SRC_CC   = main.cc widget_factory.cc
 LIBS     = base libc libm vfs libpng zlib blit file
 INC_DIR += $(PRG_DIR)
 
@@ -24,6 +24,7 @@
 #include <os/pixel_alpha8.h>
 #include <os/texture_rgb888.h>
 #include <util/reconstructible.h>
+#include <util/dirty_rect.h>
 #include <nitpicker_gfx/text_painter.h>
 #include <libc/component.h>
 
@@ -37,7 +38,7 @@ namespace Menu_view {
 	using Area  = Surface_base::Area;
 	using Rect  = Surface_base::Rect;
 
-	struct Ticks { uint64_t cs; /* centi-seconds (10 ms) */ };
+	using Dirty_rect = Genode::Dirty_rect<Rect, 3>;
 
 	struct Hover_version { uint64_t value; };
 
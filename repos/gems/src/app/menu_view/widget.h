@@ -25,6 +25,7 @@ namespace Menu_view {
 
 	struct Margin;
 	struct Widget;
+	class Own_node_content;
 
 	using Padding = Margin;
 }
@@ -44,6 +45,191 @@ struct Menu_view::Margin
 };
 
 
+/**
+ * Content of a widget node excluding the content of its widget sub nodes
+ *
+ * The own content comprises the type, attributes, and quoted lines of the
+ * node, the complete content of non-widget sub nodes like the cursors of a
+ * label, and the type and attributes of the widget sub nodes. The latter
+ * determine the identity and order of the child widgets and cover the
+ * attributes interpreted by the parent, e.g., by the depgraph widget. The
+ * content of each child widget is compared by the child itself. So the
+ * dialog is examined only once per update.
+ */
+class Menu_view::Own_node_content
+{
+	private:
+
+		Allocator &_alloc;
+
+		char   *_bytes     = nullptr;
+		size_t  _num_bytes = 0;
+		bool    _valid     = false;
+
+		/*
+		 * Output that terminates each field with an unambiguous separator
+		 */
+		struct Field_output : Output
+		{
+			Output &_out;
+
+			Field_output(Output &out) : _out(out) { }
+
+			void out_char(char c) override
+			{
+				if (c == '\\')
+					_out.out_char('\\');
+
+				_out.out_char(c);
+			}
+
+			void field(char tag, auto const &... args)
+			{
+				out_char(tag);
+				Genode::print(*this, args...);
+				_out.out_char('\\');
+				_out.out_char(';');
+			}
+		};
+
+		static void _print(Output &out, Node const &node)
+		{
+			Field_output fields { out };
+
+			auto print_attributes = [&] (Node const &node)
+			{
+				node.for_each_attribute([&] (Node::Attribute const &attr) {
+					fields.field('a', attr.name);
+					fields.field('v', Cstring(attr.value.start,
+					                          attr.value.num_bytes)); });
+			};
+
+			fields.field('t', node.type());
+			print_attributes(node);
+
+			node.for_each_quoted_line([&] (Node::Quoted_line const &line) {
+				fields.field('q', line); });
+
+			node.for_each_sub_node([&] (Node const &sub_node) {
+				if (Widget_factory::node_type_known(sub_node)) {
+					fields.field('w', sub_node.type());
+					print_attributes(sub_node);
+				} else {
+					fields.field('n', sub_node);
+				}
+			});
+		}
+
+		void _free()
+		{
+			if (_bytes)
+				_alloc.free(_bytes, _num_bytes);
+
+			_bytes = nullptr; _num_bytes = 0; _valid = false;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Own_node_content(Own_node_content const &);
+		Own_node_content &operator = (Own_node_content const &);
+
+	public:
+
+		Own_node_content(Allocator &alloc) : _alloc(alloc) { }
+
+		~Own_node_content() { _free(); }
+
+		bool differs_from(Node const &node) const
+		{
+			if (!_valid)
+				return true;
+
+			struct Comparing_output : Output
+			{
+				Const_byte_range_ptr const _bytes;
+
+				size_t _pos    = 0;
+				bool   differs = false;
+
+				Comparing_output(char const *start, size_t n) : _bytes(start, n) { }
+
+				void out_char(char c) override
+				{
+					if (differs)
+						return;
+
+					if (_pos == _bytes.num_bytes || _bytes.start[_pos] != c) {
+						differs = true;
+						return;
+					}
+					_pos++;
+				}
+
+				bool complete() const { return !differs && _pos == _bytes.num_bytes; }
+
+			} output { _bytes, _num_bytes };
+
+			_print(output, node);
+
+			return !output.complete();
+		}
+
+		void import(Node const &node)
+		{
+			_free();
+
+			struct Counting_output : Output
+			{
+				size_t count = 0;
+
+				void out_char(char) override { count++; }
+
+			} counter { };
+
+			_print(counter, node);
+
+			if (counter.count == 0)
+				return;
+
+			_bytes = _alloc.try_alloc(counter.count).convert<char *>(
+				[&] (Allocator::Allocation &a) {
+					a.deallocate = false; return (char *)a.ptr; },
+				[&] (Alloc_error) -> char * { return nullptr; });
+
+			/* content that cannot be stored is considered as changed */
+			if (!_bytes)
+				return;
+
+			struct Writing_output : Output
+			{
+				Byte_range_ptr const _dst;
+
+				size_t _pos = 0;
+
+				Writing_output(char *start, size_t n) : _dst(start, n) { }
+
+				void out_char(char c) override
+				{
+					if (_pos < _dst.num_bytes)
+						_dst.start[_pos++] = c;
+				}
+
+			} writer { _bytes, counter.count };
+
+			_print(writer, node);
+
+			_num_bytes = counter.count;
+			_valid     = true;
+		}
+
+		/**
+		 * Discard the content so that the next comparison reports a change
+		 */
+		void invalidate() { _free(); }
+};
+
+
 class Menu_view::Widget : List_model<Widget>::Element
 {
 	private:
@@ -137,7 +323,7 @@ class Menu_view::Widget : List_model<Widget>::Element
 
 				/* update */
 				[&] (Widget &w, Node const &node) {
-					w.update(node); }
+					w.update_if_changed(node); }
 			);
 		}
 
@@ -151,6 +337,50 @@ class Menu_view::Widget : List_model<Widget>::Element
 
 		virtual void _layout() { }
 
+		/*
+		 * Own content of the node applied by the most recent 'update'
+		 */
+		Own_node_content _own_content { _factory.alloc };
+
+		/**
+		 * Called if a child widget changed while the own content stayed same
+		 *
+		 * Widgets that derive state from their children at 'update' time,
+		 * e.g., the minimum size, refresh this state here.
+		 */
+		virtual void _children_changed() { }
+
+		/*
+		 * True if the sub tree changed since the last layout computation
+		 */
+		bool _layout_needed = true;
+
+		/*
+		 * State for tracking the screen area affected by changes
+		 */
+		struct Damage
+		{
+			Rect drawn    { };      /* screen area covered at the last redraw */
+			bool changed  = true;   /* node content changed since last redraw */
+			bool animated = false;  /* animation in progress at last redraw */
+		} _damage { };
+
+		/**
+		 * Return true if the widget's appearance is subject to an animation
+		 *
+		 * Geometry animations are covered by '_damage_rect' and need not
+		 * be considered.
+		 */
+		virtual bool _animated() const { return false; }
+
+		/**
+		 * Return screen area covered by the widget when drawn at 'at'
+		 */
+		virtual Rect _damage_rect(Point at) const
+		{
+			return Rect(at, _animated_geometry.area());
+		}
+
 		Rect _inner_geometry() const
 		{
 			return Rect(Point(margin.left, margin.top),
@@ -225,6 +455,90 @@ class Menu_view::Widget : List_model<Widget>::Element
 
 		virtual void update(Node const &node) = 0;
 
+		/**
+		 * Update widget sub tree according to the changes of the node content
+		 *
+		 * \return true if the sub tree changed
+		 */
+		bool update_if_changed(Node const &node)
+		{
+			if (!_factory.incremental) {
+				_own_content.invalidate();
+				_layout_needed  = true;
+				_damage.changed = true;
+
+				update(node);
+				return true;
+			}
+
+			if (_own_content.differs_from(node)) {
+
+				_own_content.import(node);
+				_layout_needed  = true;
+				_damage.changed = true;
+
+				update(node);
+				return true;
+			}
+
+			/*
+			 * The unchanged own content implies that the set and order of the
+			 * child widgets stayed the same. Hence, no widget is created or
+			 * destroyed here.
+			 */
+			bool children_changed = false;
+			_children.update_from_node(node,
+				[&] (Node const &node) -> Widget & {
+					return _factory.create(node); },
+				[&] (Widget &w) {
+					_factory.destroy(&w); },
+				[&] (Widget &w, Node const &node) {
+					children_changed |= w.update_if_changed(node); });
+
+			if (children_changed) {
+				_layout_needed = true;
+				_children_changed();
+			}
+			return children_changed;
+		}
+
+		/**
+		 * Force the update of the whole sub tree on the next 'update_if_changed'
+		 *
+		 * This is needed whenever the widgets' presentation depends on
+		 * information besides the node content, e.g., on a style change.
+		 */
+		void invalidate()
+		{
+			_own_content.invalidate();
+
+			_children.for_each([&] (Widget &w) { w.invalidate(); });
+		}
+
+		/**
+		 * Mark screen areas affected by changes since the last call
+		 *
+		 * \param at  screen position of the widget as passed to 'draw'
+		 */
+		void mark_damaged(Dirty_rect &dirty, Point at)
+		{
+			Rect const rect     = _damage_rect(at);
+			bool const animated = _animated();
+
+			bool const damaged = _damage.changed
+			                  || animated || _damage.animated
+			                  || rect != _damage.drawn;
+			if (damaged) {
+				if (_damage.drawn.valid()) dirty.mark_as_dirty(_damage.drawn);
+				if (rect.valid())          dirty.mark_as_dirty(rect);
+			}
+
+			_damage = { .drawn = rect, .changed = false, .animated = animated };
+
+			_children.for_each([&] (Widget &w) {
+				w.mark_damaged(dirty, at + w._animated_geometry.p1()); });
+		}
+
 		virtual Area min_size() const = 0;
 
 		virtual void draw(Surface<Pixel_rgb888> &pixel_surface,
@@ -236,9 +550,15 @@ class Menu_view::Widget : List_model<Widget>::Element
 		 */
 		void size(Area size)
 		{
+			bool const size_changed = (size != _geometry.area);
+
 			_geometry = Rect(_geometry.p1(), size);
 
-			_layout();
+			/* the layout of an unchanged sub tree of the same size is final */
+			if (size_changed || _layout_needed) {
+				_layout();
+				_layout_needed = false;
+			}
 
 			_trigger_geometry_animation();
 		}
@@ -0,0 +1,68 @@
+/*
+ * \brief  Creation of widgets from their node description
+ * \author Norman Feske
+ * \date   2009-09-11
+ */
+
+/*
+ * Copyright (C) 2014-2025 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/sleep.h>
+
+/* local includes */
+#include <button_widget.h>
+#include <label_widget.h>
+#include <box_layout_widget.h>
+#include <float_widget.h>
+#include <frame_widget.h>
+#include <depgraph_widget.h>
+
+
+Menu_view::Widget &
+Menu_view::Widget_factory::create(Node const &node)
+{
+	Widget::Unique_id const unique_id(++_unique_id_cnt);
+
+	Widget::Attr const attr { .type    = node.type(),
+	                          .name    = Widget::node_name(node),
+	                          .version = Widget::node_version(node),
+	                          .id      = unique_id };
+
+	auto dir = [] (Node const &node)
+	{
+		return node.has_type("vbox") ? Box_layout_widget::VERTICAL
+		                             : Box_layout_widget::HORIZONTAL;
+	};
+
+	if (node.has_type("label"))    return *new (alloc) Label_widget      (*this, attr);
+	if (node.has_type("button"))   return *new (alloc) Button_widget     (*this, attr);
+	if (node.has_type("vbox"))     return *new (alloc) Box_layout_widget (*this, attr, dir(node));
+	if (node.has_type("hbox"))     return *new (alloc) Box_layout_widget (*this, attr, dir(node));
+	if (node.has_type("frame"))    return *new (alloc) Frame_widget      (*this, attr);
+	if (node.has_type("float"))    return *new (alloc) Float_widget      (*this, attr);
+	if (node.has_type("depgraph")) return *new (alloc) Depgraph_widget   (*this, attr);
+
+	/*
+	 * This cannot occur because the 'List_model' ensures that 'create' is only
+	 * called for nodes that passed 'node_type_known'.
+	 */
+	error("unknown widget type '", node.type(), "'");
+	sleep_forever();
+}
+
+
+bool Menu_view::Widget_factory::node_type_known(Node const &node)
+{
+	return node.has_type("label")
+	    || node.has_type("button")
+	    || node.has_type("vbox")
+	    || node.has_type("hbox")
+	    || node.has_type("frame")
+	    || node.has_type("float")
+	    || node.has_type("depgraph");
+}
@@ -39,6 +39,13 @@ class Menu_view::Widget_factory
 		Style_database &styles;
 		Animator       &animator;
 
+		/*
+		 * Widgets skip the update of unchanged sub trees by comparing their
+		 * node content. Without it, each update processes all widgets,
+		 * which serves as baseline for the menu-view benchmark.
+		 */
+		bool incremental = true;
+
 		Widget_factory(Allocator &alloc, Style_database &styles, Animator &animator)
 		:
 			alloc(alloc), styles(styles), animator(animator)
@@ -22,6 +22,9 @@
 /* decorator includes */
 #include <decorator/window_stack.h>
 
+/* gems includes */
+#include <gems/frame_scheduler.h>
+
 /* local includes */
 #include "window.h"
 
@@ -32,7 +35,7 @@ namespace Decorator {
 }
 
 
-struct Decorator::Main : Window_factory_base
+struct Decorator::Main : Window_factory_base, Frame_scheduler::Action
 {
 	Env &_env;
 
@@ -40,16 +43,6 @@ struct Decorator::Main : Window_factory_base
 
 	Timer::Connection _timer { _env };
 
-	/*
-	 * Time base for animations, which are computed in steps of 10 ms
-	 */
-	struct Ticks { uint64_t cs; /* centi-seconds (10 ms) */ };
-
-	Ticks _now()
-	{
-		return { .cs = _timer.curr_time().trunc_to_plain_ms().value / 10 };
-	}
-
 	Window_stack _window_stack = { *this, _heap };
 
 	Windows _windows { };
@@ -91,28 +84,13 @@ struct Decorator::Main : Window_factory_base
 
 	Expanding_reporter _decorator_margins_reporter = { _env, "decorator_margins" };
 
-	Ticks _previous_sync { };
+	Frame_scheduler _frame_scheduler { _env.ep(), _gui.framebuffer, _timer,
+	                                   _animator, *this };
 
 	/**
-	 * Install handler for responding to GUI sync events
+	 * Frame_scheduler::Action
 	 */
-	void _handle_gui_sync();
-
-	Signal_handler<Main> _gui_sync_handler = {
-		_env.ep(), *this, &Main::_handle_gui_sync };
-
-	bool _gui_sync_enabled = false;
-
-	void _trigger_gui_sync()
-	{
-		Ticks const now  = _now();
-		bool  const idle = now.cs - _previous_sync.cs > 3;
-
-		if (!_gui_sync_enabled || idle) {
-			_previous_sync = now;
-			_gui_sync_handler.local_submit();
-		}
-	}
+	void produce_frame(Frame_scheduler::Frame) override;
 
 	Attached_rom_dataspace _config { _env, "config" };
 
@@ -151,7 +129,7 @@ struct Decorator::Main : Window_factory_base
 			Genode::log("pointer information unavailable");
 		}
 
-		_trigger_gui_sync();
+		_frame_scheduler.schedule();
 
 		_decorator_margins_reporter.generate([&] (Generator &g) {
 
@@ -274,16 +252,12 @@ void Decorator::Main::_handle_window_layout_update()
 
 	_window_layout_update_needed = true;
 
-	_trigger_gui_sync();
+	_frame_scheduler.schedule();
 }
 
 
-void Decorator::Main::_handle_gui_sync()
+void Decorator::Main::produce_frame(Frame_scheduler::Frame const frame)
 {
-	Ticks const now = _now();
-
-	Ticks const passed_ticks { now.cs - _previous_sync.cs };
-
 	bool model_updated = false;
 
 	auto flush_window_stack_changes = [&] () {
@@ -307,30 +281,13 @@ void Decorator::Main::_handle_gui_sync()
 
 	bool const windows_animated = _window_stack.schedule_animated_windows();
 
-	for (unsigned i = 0; i < passed_ticks.cs; i++)
+	for (unsigned i = 0; i < frame.steps; i++)
 		_animator.animate();
 
 	if (model_updated || windows_animated) {
 		_window_stack.update_gui_views();
 		_gui.execute();
 	}
-
-	/*
-	 * Enable/disable periodic sync depending on animation state
-	 */
-	if (_gui_sync_enabled) {
-		if (!_animator.active()) {
-			_gui.framebuffer.sync_sigh(Signal_context_capability());
-			_gui_sync_enabled = false;
-		}
-	} else {
-		if (_animator.active()) {
-			_gui.framebuffer.sync_sigh(_gui_sync_handler);
-			_gui_sync_enabled = true;
-		}
-	}
-
-	_previous_sync = now;
 }
 
 
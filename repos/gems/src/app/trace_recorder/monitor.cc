@@ -98,9 +98,22 @@ void Trace_recorder::Monitor::_with_session_policy(Trace::Subject_info const &in
 
 void Trace_recorder::Monitor::_handle_timeout()
 {
+	unsigned long long lost_entries = 0;
+
 	_trace_buffers.for_each([&] (Attached_buffer &buf) {
 		buf.process_events(*_trace_directory);
+		lost_entries += buf.lost_entries();
 	});
+
+	/* sample more often if the producers outpace the current period */
+	if (lost_entries == _lost_entries || _period_ms <= _min_period_ms)
+		return;
+
+	_lost_entries = lost_entries;
+	_period_ms    = max(_period_ms / 2, _min_period_ms);
+
+	log("lost trace entries, reducing sampling period to ", _period_ms, " ms");
+	_timer.trigger_periodic(_period_ms * 1000);
 }
 
 
@@ -206,6 +219,10 @@ void Trace_recorder::Monitor::start(Node const &config)
 	else
 		period_ms = config.attribute_value("period_ms", period_ms);
 
+	_period_ms     = period_ms;
+	_min_period_ms = min(config.attribute_value("min_period_ms", period_ms), period_ms);
+	_lost_entries  = 0;
+
 	_timer.trigger_periodic(period_ms * 1000);
 }
 
@@ -105,6 +105,8 @@ class Trace_recorder::Monitor
 
 				Registry<Writer_base>   &writers()            { return _writers; }
 
+				unsigned long long lost_entries() const { return _buffer.lost_entries(); }
+
 				Subject_info      const &info()         const { return _info;   }
 				Trace::Subject_id const  subject_id()   const { return _subject_id; }
 		};
@@ -130,6 +132,14 @@ class Trace_recorder::Monitor
 
 		Constructible<Trace::Connection> _trace          { };
 
+		/*
+		 * Current sampling period, shortened down to '_min_period_ms'
+		 * whenever trace entries got lost
+		 */
+		unsigned                       _period_ms        { 0 };
+		unsigned                       _min_period_ms    { 0 };
+		unsigned long long             _lost_entries     { 0 };
+
 		Signal_handler<Monitor>        _timeout_handler  { _env.ep(),
 		                                                   *this,
 		                                                   &Monitor::_handle_timeout };
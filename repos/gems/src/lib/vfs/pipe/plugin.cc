@@ -269,7 +269,13 @@ Vfs_pipe::Pipe_handle::read(Byte_range_ptr const &dst, size_t &out_count)
 
 bool Vfs_pipe::Pipe_handle::read_ready() const
 {
-	return !writer && !pipe.buffer.empty();
+	if (writer)
+		return false;
+
+	/* the end of file is readable once all writers closed the pipe */
+	bool const end_of_file = (pipe.num_writers == 0) && !pipe.waiting_for_writers;
+
+	return !pipe.buffer.empty() || end_of_file;
 }
 
 
@@ -100,6 +100,12 @@ void Cpu_sampler::Cpu_thread_component::flush()
 	if (_sample_buf_index == 0)
 		return;
 
+	if (_sample_sink) {
+		_sample_sink->submit(_label, _sample_buf, _sample_buf_index);
+		_sample_buf_index = 0;
+		return;
+	}
+
 	if (!_log.constructed())
 		_log.construct(_env, _log_session_label);
 
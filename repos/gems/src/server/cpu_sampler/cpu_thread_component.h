@@ -21,6 +21,7 @@
 
 /* local includes */
 #include "cpu_session_component.h"
+#include "sample_sink.h"
 
 namespace Cpu_sampler {
 	using namespace Genode;
@@ -52,6 +53,9 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 
 		Constructible<Log_connection> _log;
 
+		/* destination of the samples, or nullptr for LOG output */
+		Sample_sink           *_sample_sink = nullptr;
+
 	public:
 
 		Cpu_thread_component(Cpu_session_component   &cpu_session_component,
@@ -77,6 +81,8 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 		void reset();
 		void flush();
 
+		void sample_sink(Sample_sink *sink) { _sample_sink = sink; }
+
 		/**************************
 		 ** CPU thread interface **
 		 *************************/
@@ -0,0 +1,283 @@
+/*
+ * \brief  Function symbols of an ELF image obtained from a ROM module
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The symbol table ('.symtab', or '.dynsym' for stripped shared objects) is
+ * read from the ROM module or from an ELF image in memory. The function symbols are kept in an array
+ * sorted by address to map sampled instruction pointers to function names.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ELF_SYMBOLS_H_
+#define _ELF_SYMBOLS_H_
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/allocator.h>
+#include <util/list.h>
+#include <util/reconstructible.h>
+
+/* local includes */
+#include "heap_sort.h"
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	class Elf_symbols;
+}
+
+
+class Cpu_sampler::Elf_symbols : public List<Elf_symbols>::Element
+{
+	public:
+
+		using Rom_name = String<64>;
+
+		/*
+		 * ELF structures of the native word size, see the System V ABI
+		 */
+
+		struct Ehdr
+		{
+			unsigned char ident[16];
+			uint16_t      type, machine;
+			uint32_t      version;
+			addr_t        entry, phoff, shoff;
+			uint32_t      flags;
+			uint16_t      ehsize, phentsize, phnum, shentsize, shnum, shstrndx;
+		};
+
+		struct Shdr
+		{
+			uint32_t name, type;
+			addr_t   flags, addr, offset, size;
+			uint32_t link, info;
+			addr_t   addralign, entsize;
+		};
+
+		template <unsigned> struct Elf_sym;
+
+		using Sym = Elf_sym<sizeof(addr_t)>;
+
+		enum { SHT_SYMTAB = 2, SHT_STRTAB = 3, SHT_DYNSYM = 11, STT_FUNC = 2 };
+
+	private:
+
+		struct Symbol
+		{
+			addr_t      addr;
+			size_t      size;
+			char const *name;
+		};
+
+		Allocator &_alloc;
+
+		Rom_name const _rom_name;
+		addr_t   const _base;
+
+		Constructible<Attached_rom_dataspace> _rom { };
+
+		Symbol  *_symbols     = nullptr;
+		unsigned _num_symbols = 0;
+
+		/*
+		 * Noncopyable
+		 */
+		Elf_symbols(Elf_symbols const &);
+		Elf_symbols &operator = (Elf_symbols const &);
+
+		static bool _valid_range(Const_byte_range_ptr const &image,
+		                         addr_t offset, size_t size)
+		{
+			return offset <= image.num_bytes && size <= image.num_bytes - offset;
+		}
+
+		static Shdr const *_section(Const_byte_range_ptr const &image,
+		                            Ehdr const &ehdr, unsigned type)
+		{
+			if (ehdr.shentsize != sizeof(Shdr)
+			 || !_valid_range(image, ehdr.shoff, ehdr.shnum*sizeof(Shdr)))
+				return nullptr;
+
+			Shdr const *shdr = (Shdr const *)(image.start + ehdr.shoff);
+			for (unsigned i = 0; i < ehdr.shnum; i++)
+				if (shdr[i].type == type)
+					return &shdr[i];
+
+			return nullptr;
+		}
+
+		void _import(Const_byte_range_ptr const &image, Ehdr const &ehdr,
+		             Shdr const &symtab);
+
+		void _import(Const_byte_range_ptr const &image)
+		{
+			Ehdr const &ehdr = *(Ehdr const *)image.start;
+
+			if (image.num_bytes < sizeof(Ehdr) || memcmp(ehdr.ident, "\177ELF", 4)) {
+				warning("'", _rom_name, "' is no ELF image");
+				return;
+			}
+
+			Shdr const *symtab = _section(image, ehdr, SHT_SYMTAB);
+			if (!symtab)
+				symtab = _section(image, ehdr, SHT_DYNSYM);
+
+			if (!symtab) {
+				warning("ELF image '", _rom_name, "' lacks a symbol table");
+				return;
+			}
+
+			_import(image, ehdr, *symtab);
+
+			heap_sort(_symbols, _num_symbols, [] (Symbol const &s) { return s.addr; });
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param base  address where the ELF image is loaded, zero for
+		 *              binaries linked at their final address
+		 */
+		Elf_symbols(Env &env, Allocator &alloc, Rom_name const &rom_name, addr_t base)
+		:
+			_alloc(alloc), _rom_name(rom_name), _base(base)
+		{
+			_rom.construct(env, rom_name.string());
+			_import(Const_byte_range_ptr(_rom->local_addr<char const>(), _rom->size()));
+		}
+
+		/**
+		 * Constructor for using an ELF image in memory
+		 *
+		 * The image must stay in place for the lifetime of the object
+		 * because the symbol names refer to its string table.
+		 */
+		Elf_symbols(Allocator &alloc, Const_byte_range_ptr const &image, addr_t base)
+		:
+			_alloc(alloc), _rom_name("<memory>"), _base(base)
+		{
+			_import(image);
+		}
+
+		~Elf_symbols()
+		{
+			if (_symbols)
+				_alloc.free(_symbols, _num_symbols*sizeof(Symbol));
+		}
+
+		bool matches(Rom_name const &rom_name, addr_t base) const {
+			return rom_name == _rom_name && base == _base; }
+
+		/**
+		 * Call 'fn' with the name of the function that contains 'addr'
+		 *
+		 * \return false if no function contains 'addr'
+		 */
+		bool with_function(addr_t addr, auto const &fn) const
+		{
+			if (addr < _base)
+				return false;
+
+			addr -= _base;
+
+			/* binary search for the last symbol starting at or below 'addr' */
+			unsigned lo = 0, hi = _num_symbols;
+			while (lo < hi) {
+				unsigned const mid = lo + (hi - lo)/2;
+				if (_symbols[mid].addr <= addr)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+
+			if (lo == 0)
+				return false;
+
+			Symbol const &sym = _symbols[lo - 1];
+			if (addr >= sym.addr + max(sym.size, (size_t)1))
+				return false;
+
+			fn(sym.name);
+			return true;
+		}
+};
+
+
+template <> struct Cpu_sampler::Elf_symbols::Elf_sym<4>
+{
+	uint32_t      name;
+	addr_t        value;
+	size_t        size;
+	unsigned char info, other;
+	uint16_t      shndx;
+};
+
+
+template <> struct Cpu_sampler::Elf_symbols::Elf_sym<8>
+{
+	uint32_t      name;
+	unsigned char info, other;
+	uint16_t      shndx;
+	addr_t        value;
+	size_t        size;
+};
+
+
+inline void Cpu_sampler::Elf_symbols::_import(Const_byte_range_ptr const &image,
+                                             Ehdr const &ehdr, Shdr const &symtab)
+{
+	Shdr const *shdr = (Shdr const *)(image.start + ehdr.shoff);
+
+	if (symtab.link >= ehdr.shnum)
+		return;
+
+	Shdr const &strtab = shdr[symtab.link];
+
+	if (!_valid_range(image, symtab.offset, symtab.size)
+	 || !_valid_range(image, strtab.offset, strtab.size) || !strtab.size)
+		return;
+
+	char const * const strings = image.start + strtab.offset;
+	Sym  const * const syms    = (Sym const *)(image.start + symtab.offset);
+
+	/*
+	 * A string table ends with a NUL character. Checking this once ensures
+	 * that each name starting within the table is terminated within it.
+	 */
+	if (strings[strtab.size - 1] != 0) {
+		warning("ELF image '", _rom_name, "' has an unterminated string table");
+		return;
+	}
+	unsigned     const num     = unsigned(symtab.size / sizeof(Sym));
+
+	auto is_function = [&] (Sym const &sym) {
+		return (sym.info & 0xf) == STT_FUNC && sym.value && sym.name < strtab.size; };
+
+	unsigned count = 0;
+	for (unsigned i = 0; i < num; i++)
+		if (is_function(syms[i]))
+			count++;
+
+	if (!count)
+		return;
+
+	_symbols = (Symbol *)_alloc.alloc(count*sizeof(Symbol));
+
+	for (unsigned i = 0; i < num; i++)
+		if (is_function(syms[i]))
+			_symbols[_num_symbols++] = { .addr = syms[i].value,
+			                             .size = syms[i].size,
+			                             .name = strings + syms[i].name };
+}
+
+
+#endif /* _ELF_SYMBOLS_H_ */
@@ -0,0 +1,201 @@
+/*
+ * \brief  Output of samples as folded stacks
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The samples of each thread are appended to a file named after the
+ * thread's label, using the folded-stack format understood by flame-graph
+ * tools, e.g., 'flamegraph.pl' or 'inferno'. Each line contains the
+ * semicolon-separated frames followed by the number of samples. Sampled
+ * instruction pointers are symbolized with the ELF images named by the
+ * '<elf>' sub nodes of the thread's policy. The ELF images are obtained when
+ * the configuration is applied.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _FOLDED_OUTPUT_H_
+#define _FOLDED_OUTPUT_H_
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <os/session_policy.h>
+#include <os/path.h>
+#include <os/vfs.h>
+
+/* local includes */
+#include "elf_symbols.h"
+#include "heap_sort.h"
+#include "sample_sink.h"
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	class Folded_output;
+}
+
+
+class Cpu_sampler::Folded_output : public Sample_sink
+{
+	private:
+
+		Env                          &_env;
+		Allocator                    &_alloc;
+		Attached_rom_dataspace const &_config;
+		Root_directory                _root;
+		List<Elf_symbols>             _elf_symbols { };
+
+		static Elf_symbols::Rom_name _rom_name(Node const &elf) {
+			return elf.attribute_value("rom", Elf_symbols::Rom_name()); }
+
+		static addr_t _base(Node const &elf) {
+			return elf.attribute_value("base", addr_t(0)); }
+
+		Elf_symbols *_lookup_elf_symbols(Elf_symbols::Rom_name const &rom, addr_t base)
+		{
+			for (Elf_symbols *e = _elf_symbols.first(); e; e = e->next())
+				if (e->matches(rom, base))
+					return e;
+
+			return nullptr;
+		}
+
+		/**
+		 * Import the symbols of all ELF images named by the policies
+		 *
+		 * The ROM sessions are opened when the configuration is applied
+		 * rather than while handling samples. ELF images that cannot be
+		 * obtained are skipped so that their addresses appear in hex.
+		 */
+		void _import_elf_symbols()
+		{
+			auto import_elf = [&] (Node const &elf) {
+
+				Elf_symbols::Rom_name const rom = _rom_name(elf);
+				addr_t const base = _base(elf);
+
+				if (_lookup_elf_symbols(rom, base))
+					return;
+
+				try {
+					_elf_symbols.insert(new (_alloc) Elf_symbols(_env, _alloc, rom, base)); }
+				catch (Service_denied) {
+					warning("ELF image '", rom, "' not available"); }
+				catch (Attached_dataspace::Invalid_dataspace) {
+					warning("ELF image '", rom, "' is empty"); }
+			};
+
+			auto import_policy = [&] (Node const &policy) {
+				policy.for_each_sub_node("elf", import_elf); };
+
+			_config.node().for_each_sub_node("policy",         import_policy);
+			_config.node().for_each_sub_node("default-policy", import_policy);
+		}
+
+		/**
+		 * Call 'fn' with the name of the function containing 'addr'
+		 */
+		void _with_function(Node const &policy, addr_t addr, auto const &fn)
+		{
+			bool found = false;
+			policy.for_each_sub_node("elf", [&] (Node const &elf) {
+				if (found)
+					return;
+
+				Elf_symbols const * const e = _lookup_elf_symbols(_rom_name(elf), _base(elf));
+
+				found = e && e->with_function(addr, fn);
+			});
+
+			if (!found)
+				fn(String<2*sizeof(addr_t) + 3>(Hex(addr)).string());
+		}
+
+		static Directory::Path _path(Session_label const &label)
+		{
+			using Label_path = Genode::Path<Session_label::capacity()>;
+
+			Label_path const path = path_from_label<Label_path>(label.string());
+
+			return Directory::Path(path, ".folded");
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Folded_output(Folded_output const &);
+		Folded_output &operator = (Folded_output const &);
+
+	public:
+
+		Folded_output(Env &env, Allocator &alloc, Attached_rom_dataspace const &config,
+		              Node const &vfs_config)
+		:
+			_env(env), _alloc(alloc), _config(config),
+			_root(env, alloc, vfs_config)
+		{
+			_import_elf_symbols();
+		}
+
+		~Folded_output()
+		{
+			while (Elf_symbols *e = _elf_symbols.first()) {
+				_elf_symbols.remove(e);
+				destroy(_alloc, e);
+			}
+		}
+
+		/**
+		 * Sample_sink interface
+		 */
+		void submit(Session_label const &label, addr_t *samples, unsigned count) override
+		{
+			/* sorting groups the samples of each function */
+			heap_sort(samples, count, [] (addr_t addr) { return addr; });
+
+			using Line = String<512>;
+
+			try {
+				Append_file file { _root, _path(label) };
+
+				with_matching_policy(label, _config.node(), [&] (Node const &policy) {
+
+					Line     curr { };
+					unsigned num  = 0;
+
+					auto write_line = [&] {
+						if (!num)
+							return;
+						Line const line(label, ";", curr, " ", num, "\n");
+						file.append(line.string(), line.length() - 1);
+					};
+
+					for (unsigned i = 0; i < count; i++) {
+						_with_function(policy, samples[i], [&] (char const *name) {
+
+							Line const function(name);
+							if (function == curr) {
+								num++;
+								return;
+							}
+
+							write_line();
+							curr = function;
+							num  = 1;
+						});
+					}
+
+					write_line();
+				},
+				[&] { });
+			}
+			catch (Append_file::Create_failed) {
+				warning("unable to write samples of ", label); }
+		}
+};
+
+#endif /* _FOLDED_OUTPUT_H_ */
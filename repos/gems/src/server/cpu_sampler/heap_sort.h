@@ -0,0 +1,51 @@
+/*
+ * \brief  In-place sorting of arrays
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _HEAP_SORT_H_
+#define _HEAP_SORT_H_
+
+namespace Cpu_sampler {
+
+	/**
+	 * Sort array in ascending order of the values returned by 'key_fn'
+	 */
+	template <typename T>
+	void heap_sort(T *array, unsigned const num, auto const &key_fn)
+	{
+		auto swap = [&] (unsigned i, unsigned j) {
+			T const tmp = array[i];
+			array[i] = array[j];
+			array[j] = tmp;
+		};
+
+		auto sift_down = [&] (unsigned root, unsigned const end) {
+			for (unsigned child; (child = 2*root + 1) < end; root = child) {
+				if (child + 1 < end && key_fn(array[child]) < key_fn(array[child + 1]))
+					child++;
+				if (!(key_fn(array[root]) < key_fn(array[child])))
+					return;
+				swap(root, child);
+			}
+		};
+
+		for (unsigned i = num/2; i-- > 0; )
+			sift_down(i, num);
+
+		for (unsigned end = num; end > 1; end--) {
+			swap(0, end - 1);
+			sift_down(0, end - 1);
+		}
+	}
+}
+
+#endif /* _HEAP_SORT_H_ */
@@ -26,6 +26,7 @@
 #include "cpu_root.h"
 #include "cpu_session_component.h"
 #include "cpu_thread_component.h"
+#include "folded_output.h"
 #include "thread_list_change_handler.h"
 
 namespace Cpu_sampler { struct Main; }
@@ -48,6 +49,9 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 	Thread_list             thread_list;
 	Thread_list             selected_thread_list;
 
+	/* output of folded stacks, constructed if a '<vfs>' is configured */
+	Constructible<Folded_output> folded_output { };
+
 	unsigned int            sample_index;
 	unsigned int            max_sample_index;
 	Genode::uint64_t        timeout_us;
@@ -97,6 +101,19 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 
 		timeout_us = sample_interval_ms * 1000;
 
+		/*
+		 * Rebuild the folded output to apply changes of the VFS
+		 * configuration and to re-read ELF images named by the policies.
+		 * The threads are detached from the old output here and attached
+		 * to the new one by 'thread_list_changed'.
+		 */
+		for_each_thread(thread_list, [&] (Thread_element *cpu_thread_element) {
+			cpu_thread_element->object()->sample_sink(nullptr); });
+
+		folded_output.destruct();
+		config.node().with_optional_sub_node("vfs", [&] (Node const &vfs) {
+			folded_output.construct(env, alloc, config, vfs); });
+
 		thread_list_changed();
 
 		if (verbose_sample_duration)
@@ -140,6 +157,8 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 			with_matching_policy(thread.label(), config.node(),
 				[&] (Node const &policy) {
 					thread.reset();
+					thread.sample_sink(folded_output.constructed() ? &*folded_output
+					                                               : nullptr);
 					selected_thread_list.insert(new (&alloc) Thread_element(&thread));
 					if (verbose)
 						Genode::log("added thread ", thread.label(), " to selection");
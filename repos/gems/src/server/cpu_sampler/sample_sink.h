@@ -0,0 +1,36 @@
+/*
+ * \brief  Interface for processing the samples of a thread
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SAMPLE_SINK_H_
+#define _SAMPLE_SINK_H_
+
+/* Genode includes */
+#include <base/session_label.h>
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	struct Sample_sink;
+}
+
+
+struct Cpu_sampler::Sample_sink : Interface
+{
+	/**
+	 * Process sampled instruction pointers
+	 *
+	 * The sink may reorder the 'samples' array.
+	 */
+	virtual void submit(Session_label const &thread, addr_t *samples, unsigned count) = 0;
+};
+
+#endif /* _SAMPLE_SINK_H_ */
@@ -189,7 +189,9 @@ class Terminal::Text_screen_surface
 			_palette(palette),
 			_geometry(font, initial_fb_size),
 			_cell_array(_geometry.columns, _geometry.lines, alloc)
-		{ }
+		{
+			_cell_array.track_scrolling(true);
+		}
 
 		/**
 		 * Update geometry
@@ -215,131 +217,203 @@ class Terminal::Text_screen_surface
 
 		struct Redraw_attr { bool focused; };
 
-		Rect redraw(Surface<PT> &surface, Redraw_attr attr)
+	private:
+
+		/**
+		 * Implement scroll operation as block move of the rendered pixels
+		 *
+		 * \return  pixel area affected by the block move
+		 */
+		Rect _move_scrolled_pixels(Surface<PT> &surface,
+		                           Cell_array<Char_cell>::Scroll const &scroll)
 		{
-			unsigned const fg_alpha = 255;
+			unsigned const n = (unsigned)max(scroll.lines, -scroll.lines);
 
-			/* clear border */
-			{
-				Color const bg_color =
-					_palette.background(Color_palette::Index{0},
-					                    Color_palette::Highlighted{false});
+			/* all lines of the scroll region are dirty anyway */
+			if (n >= scroll.height())
+				return Rect();
 
-				_geometry.fb_rect().cut(_geometry.used_rect()).for_each([&] (Rect const &r) {
-					Box_painter::paint(surface, r, bg_color); });
-			}
+			unsigned const ch     = _geometry.char_height,
+			               w      = _geometry.fb_size.w,
+			               y0     = _geometry.start().y + scroll.start*ch,
+			               rows   = (scroll.height() - n)*ch,
+			               offset = n*ch;
 
-			int const clip_top  = 0, clip_bottom = _geometry.fb_size.h,
-			          clip_left = 0, clip_right  = _geometry.fb_size.w;
+			PT * const base = surface.addr();
 
-			unsigned y = _geometry.start().y;
-			for (unsigned line = 0; line < _cell_array.num_lines(); line++) {
+			auto move_row = [&] (unsigned dst_y, unsigned src_y) {
+				memcpy(base + dst_y*w, base + src_y*w, w*sizeof(PT)); };
 
-				if (_cell_array.line_dirty(line)) {
+			if (scroll.lines > 0)
+				for (unsigned i = 0; i < rows; i++)
+					move_row(y0 + i, y0 + offset + i);
+			else
+				for (unsigned i = rows; i > 0; i--)
+					move_row(y0 + offset + i - 1, y0 + i - 1);
 
-					Fixpoint_number x { (int)_geometry.start().x };
-					for (unsigned column = 0; column < _cell_array.num_cols(); column++) {
+			/* the pointer highlight must not travel with the moved pixels */
+			auto in_region = [&] (int line) {
+				return line >= scroll.start && line <= scroll.end; };
 
-						Char_cell const cell = _cell_array.get_cell(column, line);
+			if (in_region(_pointer.y))
+				_cell_array.mark_line_as_dirty(_pointer.y);
 
-						Codepoint codepoint = cell.codepoint();
+			/* line that received the highlighted pixels of the pointer line */
+			int const moved_pointer_line = _pointer.y - scroll.lines;
+			if (in_region(moved_pointer_line))
+				_cell_array.mark_line_as_dirty(moved_pointer_line);
 
-						/* display absent codepoints as whitespace */
-						bool const codepoint_valid = (codepoint.value != 0);
+			return Rect(Point(0, y0), Area(w, scroll.height()*ch));
+		}
 
-						bool const selected = _selection.selected(Position(column, line))
-						                   && codepoint_valid;
+		void _paint_cell(Surface<PT> &surface, Redraw_attr attr,
+		                 unsigned column, unsigned line,
+		                 Fixpoint_number x, int y)
+		{
+			unsigned const fg_alpha = 255;
 
-						bool const pointer = (_pointer == Position(column, line));
+			int const clip_top  = 0, clip_bottom = _geometry.fb_size.h,
+			          clip_left = 0, clip_right  = _geometry.fb_size.w;
 
-						if (!codepoint_valid)
-							codepoint = Codepoint{' '};
+			Char_cell const cell = _cell_array.get_cell(column, line);
 
-						_font.apply_glyph(codepoint, [&] (Glyph_painter::Glyph const &glyph) {
+			Codepoint codepoint = cell.codepoint();
 
-							Color_palette::Highlighted const highlighted { cell.highlight() };
+			/* display absent codepoints as whitespace */
+			bool const codepoint_valid = (codepoint.value != 0);
 
-							Color_palette::Index fg_idx { cell.colidx_fg() };
-							Color_palette::Index bg_idx { cell.colidx_bg() };
+			bool const selected = _selection.selected(Position(column, line))
+			                   && codepoint_valid;
 
-							/* swap color index for inverse cells */
-							if (cell.inverse()) {
-								Color_palette::Index tmp { fg_idx };
-								fg_idx = bg_idx;
-								bg_idx = tmp;
-							}
+			bool const pointer = (_pointer == Position(column, line));
 
-							Color fg_color = _palette.foreground(fg_idx, highlighted);
-							Color bg_color = _palette.background(bg_idx, highlighted);
+			if (!codepoint_valid)
+				codepoint = Codepoint{' '};
 
-							if (selected) {
-								bg_color = Color::rgb(180, 180, 180);
-								fg_color = Color::rgb( 50, 50,   50);
-							}
+			_font.apply_glyph(codepoint, [&] (Glyph_painter::Glyph const &glyph) {
 
-							if (pointer) {
-								bg_color = Color::rgb(220, 220, 220);
-								fg_color = Color::rgb( 50, 50,   50);
-							}
+				Color_palette::Highlighted const highlighted { cell.highlight() };
 
-							if (cell.has_cursor()) {
-								if (attr.focused) {
-									fg_color = Color::rgb( 63,  63,  63);
-									bg_color = Color::rgb(255, 255, 255);
-								} else {
-									fg_color = Color::rgb( 31,  31,  31);
-									bg_color = Color::rgb(128, 128, 128);
-								}
-							}
+				Color_palette::Index fg_idx { cell.colidx_fg() };
+				Color_palette::Index bg_idx { cell.colidx_bg() };
 
-							PT const pixel(fg_color.r, fg_color.g, fg_color.b);
+				/* swap color index for inverse cells */
+				if (cell.inverse()) {
+					Color_palette::Index tmp { fg_idx };
+					fg_idx = bg_idx;
+					bg_idx = tmp;
+				}
 
-							Fixpoint_number next_x = x;
-							next_x.value += _geometry.char_width.value;
+				Color fg_color = _palette.foreground(fg_idx, highlighted);
+				Color bg_color = _palette.background(bg_idx, highlighted);
 
-							Box_painter::paint(surface,
-							                   Rect::compound(Point(x.decimal(), y),
-							                                  Point(next_x.decimal() - 1,
-							                                        y + _geometry.char_height - 1)),
-							                   bg_color);
+				if (selected) {
+					bg_color = Color::rgb(180, 180, 180);
+					fg_color = Color::rgb( 50, 50,   50);
+				}
 
-							/* horizontally align glyph within cell */
-							x.value += (_geometry.char_width.value - (int)((glyph.width - 1)<<8)) >> 1;
+				if (pointer) {
+					bg_color = Color::rgb(220, 220, 220);
+					fg_color = Color::rgb( 50, 50,   50);
+				}
 
-							Glyph_painter::paint(Glyph_painter::Position(x, (int)y),
-							                     glyph, surface.addr(), _geometry.fb_size.w,
-							                     clip_top, clip_bottom, clip_left, clip_right,
-							                     pixel, fg_alpha);
-							x = next_x;
-						});
+				if (cell.has_cursor()) {
+					if (attr.focused) {
+						fg_color = Color::rgb( 63,  63,  63);
+						bg_color = Color::rgb(255, 255, 255);
+					} else {
+						fg_color = Color::rgb( 31,  31,  31);
+						bg_color = Color::rgb(128, 128, 128);
 					}
 				}
-				y += _geometry.char_height;
-			}
 
-			int first_dirty_line =  10000,
-			    last_dirty_line  = -10000;
+				PT const pixel(fg_color.r, fg_color.g, fg_color.b);
 
-			for (int line = 0; line < (int)_cell_array.num_lines(); line++) {
-				if (!_cell_array.line_dirty(line)) continue;
+				Fixpoint_number next_x = x;
+				next_x.value += _geometry.char_width.value;
 
-				first_dirty_line = min(line, first_dirty_line);
-				last_dirty_line  = max(line, last_dirty_line);
+				Box_painter::paint(surface,
+				                   Rect::compound(Point(x.decimal(), y),
+				                                  Point(next_x.decimal() - 1,
+				                                        y + _geometry.char_height - 1)),
+				                   bg_color);
 
-				_cell_array.mark_line_as_clean(line);
+				/* horizontally align glyph within cell */
+				x.value += (_geometry.char_width.value - (int)((glyph.width - 1)<<8)) >> 1;
+
+				Glyph_painter::paint(Glyph_painter::Position(x, y),
+				                     glyph, surface.addr(), _geometry.fb_size.w,
+				                     clip_top, clip_bottom, clip_left, clip_right,
+				                     pixel, fg_alpha);
+			});
+		}
+
+	public:
+
+		Rect redraw(Surface<PT> &surface, Redraw_attr attr)
+		{
+			/* clear border */
+			{
+				Color const bg_color =
+					_palette.background(Color_palette::Index{0},
+					                    Color_palette::Highlighted{false});
+
+				_geometry.fb_rect().cut(_geometry.used_rect()).for_each([&] (Rect const &r) {
+					Box_painter::paint(surface, r, bg_color); });
 			}
 
-			int const num_dirty_lines = last_dirty_line - first_dirty_line + 1;
-			if (num_dirty_lines > 0) {
-				int      const y = _geometry.start().y
-				                 + first_dirty_line*_geometry.char_height;
-				unsigned const h = num_dirty_lines*_geometry.char_height
-				                 + _geometry.unused_pixels().h;
+			Rect dirty { };
+
+			auto add_dirty = [&] (Rect const &rect) {
+				dirty = dirty.valid() ? Rect::compound(dirty, rect) : rect; };
+
+			_cell_array.consume_scroll([&] (Cell_array<Char_cell>::Scroll const &scroll) {
+				Rect const moved = _move_scrolled_pixels(surface, scroll);
+				if (moved.valid())
+					add_dirty(moved); });
 
-				return Rect(Point(0, y), Area(_geometry.fb_size.w, h));
+			unsigned const last_column = _cell_array.num_cols() - 1;
+
+			int y = _geometry.start().y;
+			for (unsigned line = 0; line < _cell_array.num_lines(); line++) {
+
+				Cell_array<Char_cell>::Dirty_columns const columns =
+					_cell_array.dirty_columns(line);
+
+				if (columns.any()) {
+
+					unsigned const first = columns.first,
+					               last  = min(columns.last, last_column);
+
+					Fixpoint_number x { (int)_geometry.start().x };
+					x.value += first*_geometry.char_width.value;
+
+					int const x1 = x.decimal();
+
+					for (unsigned column = first; column <= last; column++) {
+						_paint_cell(surface, attr, column, line, x, y);
+						x.value += _geometry.char_width.value;
+					}
+
+					/* cover the border when touching an edge of the grid */
+					bool const top_line    = (line == 0),
+					           bottom_line = (line == _cell_array.num_lines() - 1);
+
+					int const left   = (first == 0)           ? 0 : x1,
+					          right  = (last  == last_column) ? _geometry.fb_size.w - 1
+					                                          : x.decimal() - 1,
+					          top    = top_line    ? 0 : y,
+					          bottom = bottom_line ? _geometry.fb_size.h - 1
+					                               : y + _geometry.char_height - 1;
+
+					add_dirty(Rect::compound(Point(left, top), Point(right, bottom)));
+
+					_cell_array.mark_line_as_clean(line);
+				}
+				y += _geometry.char_height;
 			}
 
-			return Rect();
+			return dirty;
 		}
 
 		void apply_character(Character c)
@@ -0,0 +1,177 @@
+/*
+ * \brief  Test for the folded-stack output of the CPU sampler
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The test symbolizes samples with the symbol table of its own debug
+ * information, reads back the resulting folded-stack file, and checks the
+ * handling of malformed string tables with ELF images crafted in memory.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+
+/* cpu_sampler includes */
+#include <folded_output.h>
+
+namespace Test {
+	using namespace Cpu_sampler;
+	struct Main;
+}
+
+
+extern "C" __attribute__((noinline)) void test_sampled_function_a() { asm volatile (""); }
+extern "C" __attribute__((noinline)) void test_sampled_function_b() { asm volatile (""); }
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned _errors = 0;
+
+	void _check(bool condition, auto &&... args)
+	{
+		if (condition)
+			return;
+
+		error(args...);
+		_errors++;
+	}
+
+	void _test_folded_output()
+	{
+		_config.node().with_sub_node("vfs", [&] (Node const &vfs) {
+
+			Folded_output output { _env, _heap, _config, vfs };
+
+			addr_t const a = addr_t(&test_sampled_function_a);
+			addr_t const b = addr_t(&test_sampled_function_b);
+
+			/* the order of samples is arbitrary */
+			addr_t samples[] { b, a, 0x10, a, b, a };
+
+			output.submit("test -> thread", samples, 6);
+		},
+		[&] { _check(false, "missing <vfs> config"); });
+
+		using Line = String<128>;
+
+		unsigned lines = 0;
+
+		_config.node().with_sub_node("vfs", [&] (Node const &vfs) {
+
+			Root_directory root { _env, _heap, vfs };
+
+			File_content const content { _heap, root, "test/thread.folded",
+			                             File_content::Limit { 4096 } };
+
+			content.for_each_line<Line>([&] (Line const &line) {
+				log("folded: ", line);
+				lines++;
+
+				bool const expected = (line == "test -> thread;0x10 1")
+				                   || (line == "test -> thread;test_sampled_function_a 3")
+				                   || (line == "test -> thread;test_sampled_function_b 2");
+
+				_check(expected, "unexpected line '", line, "'");
+			});
+		},
+		[&] { });
+
+		_check(lines == 3, "unexpected number of lines: ", lines);
+	}
+
+	/**
+	 * ELF image with one function symbol named "sym" at 0x1000
+	 *
+	 * The size of the string table is given as argument to test the bounds
+	 * checks applied to symbol names.
+	 */
+	struct Image
+	{
+		using Ehdr = Elf_symbols::Ehdr;
+		using Shdr = Elf_symbols::Shdr;
+		using Sym  = Elf_symbols::Sym;
+
+		Ehdr ehdr { };
+		Shdr shdr[3] { };
+		Sym  sym[2] { };
+		char strtab[5] { 0, 's', 'y', 'm', 0 };
+
+		addr_t _offset(void const *member) const {
+			return addr_t((char const *)member - (char const *)this); }
+
+		Image(size_t strtab_size)
+		{
+			memcpy(ehdr.ident, "\177ELF", 4);
+			ehdr.shoff     = _offset(shdr);
+			ehdr.shentsize = sizeof(Shdr);
+			ehdr.shnum     = 3;
+
+			shdr[1].type   = Elf_symbols::SHT_SYMTAB;
+			shdr[1].offset = _offset(sym);
+			shdr[1].size   = sizeof(sym);
+			shdr[1].link   = 2;
+
+			shdr[2].type   = Elf_symbols::SHT_STRTAB;
+			shdr[2].offset = _offset(strtab);
+			shdr[2].size   = strtab_size;
+
+			sym[1].name  = 1;
+			sym[1].info  = Elf_symbols::STT_FUNC;
+			sym[1].value = 0x1000;
+			sym[1].size  = 0x10;
+		}
+
+		Const_byte_range_ptr bytes() const {
+			return { (char const *)this, sizeof(*this) }; }
+	};
+
+	void _test_string_table()
+	{
+		using Name = String<8>;
+
+		auto lookup = [&] (size_t strtab_size) {
+			Image const image { strtab_size };
+			Elf_symbols symbols { _heap, image.bytes(), 0 };
+			Name name { };
+			symbols.with_function(0x1008, [&] (char const *s) { name = s; });
+			return name;
+		};
+
+		_check(lookup(5) == "sym", "symbol of well-formed image not found");
+
+		/* the last name lacks its terminating NUL within the table */
+		_check(lookup(4) == "", "unterminated string table accepted");
+
+		/* the symbol name starts beyond the table */
+		_check(lookup(1) == "", "symbol name beyond string table accepted");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_test_folded_output();
+		_test_string_table();
+
+		if (_errors)
+			error("test failed");
+		else
+			log("test succeeded");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
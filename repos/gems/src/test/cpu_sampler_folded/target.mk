@@ -0,0 +1,4 @@
+TARGET  = test-cpu_sampler_folded
+SRC_CC  = main.cc
+INC_DIR = $(REP_DIR)/src/server/cpu_sampler
+LIBS    = base vfs
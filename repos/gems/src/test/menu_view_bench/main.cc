@@ -0,0 +1,203 @@
+/*
+ * \brief  Benchmark for replaying dialog updates through the menu-view widgets
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The benchmark feeds a recorded sequence of dialog models into a widget
+ * tree and renders each resulting frame into an off-screen buffer. It
+ * compares the full relayout and redraw of the dialog with the incremental
+ * processing of changed sub trees and damaged screen areas.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <timer_session/connection.h>
+#include <os/vfs.h>
+
+/* local includes */
+#include <root_widget.h>
+
+namespace Menu_view { struct Main; }
+
+
+struct Menu_view::Main
+{
+	Env &_env;
+
+	Vfs::Env &_vfs_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Directory _root_dir   { _vfs_env };
+	Directory _fonts_dir  { _root_dir, "fonts" };
+	Directory _styles_dir { _root_dir, "styles" };
+
+	Signal_handler<Main> _style_changed_handler {
+		_env.ep(), *this, &Main::_handle_style_changed };
+
+	void _handle_style_changed() { }
+
+	Texture_cache _texture_cache { _env, _heap, nullptr, { .path = { }, .rom = false } };
+
+	Style_database _styles { _env.ep(), _env.ram(), _env.rm(), _heap,
+	                         _fonts_dir, _styles_dir, _texture_cache,
+	                         _style_changed_handler };
+
+	Animator _animator { };
+
+	Widget_factory _widget_factory { _heap, _styles, _animator };
+
+	Timer::Connection _timer { _env };
+
+	Area const _area { _config.node().attribute_value("width",  640u),
+	                   _config.node().attribute_value("height", 480u) };
+
+	Attached_ram_dataspace _pixel_ds { _env.ram(), _env.rm(),
+	                                   _area.count()*sizeof(Pixel_rgb888) };
+
+	Attached_ram_dataspace _alpha_ds { _env.ram(), _env.rm(),
+	                                   _area.count()*sizeof(Pixel_alpha8) };
+
+	enum class Mode { FULL, INCREMENTAL };
+
+	static char const *_mode_name(Mode mode)
+	{
+		return (mode == Mode::FULL) ? "full" : "incremental";
+	}
+
+	void _reset(Rect const rect)
+	{
+		Surface<Pixel_rgb888> pixel { _pixel_ds.local_addr<Pixel_rgb888>(), _area };
+		Surface<Pixel_alpha8> alpha { _alpha_ds.local_addr<Pixel_alpha8>(), _area };
+
+		pixel.clip(rect);
+
+		Box_painter::paint(pixel, rect, Color::rgb(127, 127, 127));
+
+		/* clear the alpha channel like 'Gui_buffer::reset_surface' */
+		Rect const clipped = Rect::intersect(rect, Rect(Point(0, 0), _area));
+		for (unsigned y = 0; y < clipped.h(); y++)
+			memset(alpha.addr() + (clipped.y1() + y)*_area.w + clipped.x1(),
+			       0, clipped.w());
+	}
+
+	void _draw(Root_widget &root, Rect const rect)
+	{
+		_reset(rect);
+
+		Surface<Pixel_rgb888> pixel { _pixel_ds.local_addr<Pixel_rgb888>(), _area };
+		Surface<Pixel_alpha8> alpha { _alpha_ds.local_addr<Pixel_alpha8>(), _area };
+
+		pixel.clip(rect);
+		alpha.clip(rect);
+
+		root.draw(pixel, alpha, Point(0, 0));
+	}
+
+	/**
+	 * Lay out and draw one frame, return number of drawn pixels
+	 */
+	size_t _frame(Root_widget &root, Mode mode)
+	{
+		root.position(Point(0, 0));
+
+		Rect const screen { Point(0, 0), _area };
+
+		if (mode == Mode::FULL) {
+			_draw(root, screen);
+			return screen.area.count();
+		}
+
+		Dirty_rect dirty { };
+		root.mark_damaged(dirty, Point(0, 0));
+
+		size_t pixels = 0;
+		dirty.flush([&] (Rect const &rect) {
+			Rect const clipped = Rect::intersect(rect, screen);
+			if (clipped.valid()) {
+				_draw(root, clipped);
+				pixels += clipped.area.count();
+			}
+		});
+		return pixels;
+	}
+
+	void _replay(Node const &replay, Mode mode)
+	{
+		Root_widget root { _widget_factory, Widget::Attr {
+			.type = "dialog", .name = "bench", .version = { }, .id = { } } };
+
+		unsigned const iterations = replay.attribute_value("iterations", 100u);
+
+		/* number of animation frames rendered after each dialog update */
+		unsigned const frames_per_update = replay.attribute_value("frames", 2u);
+
+		unsigned frames = 0, updates = 0;
+		size_t   pixels = 0;
+
+		/* the full mode updates all widgets without comparing node content */
+		_widget_factory.incremental = (mode == Mode::INCREMENTAL);
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < iterations; i++) {
+			replay.for_each_sub_node("dialog", [&] (Node const &dialog) {
+
+				root.update_if_changed(dialog);
+
+				Area const min_size = root.min_size();
+				root.size(Area(min(min_size.w, _area.w), min(min_size.h, _area.h)));
+				updates++;
+
+				for (unsigned j = 0; j < frames_per_update; j++) {
+					_animator.animate();
+					pixels += _frame(root, mode);
+					frames++;
+				}
+			});
+		}
+
+		/* drain pending animations before destructing the widget tree */
+		while (_animator.active())
+			_animator.animate();
+
+		uint64_t const duration_ms = max(_timer.elapsed_ms() - start_ms, 1ull);
+
+		log(_mode_name(mode), ": ", updates, " updates, ", frames, " frames in ",
+		    duration_ms, " ms, ", (frames*1000ull)/duration_ms, " frames/s, ",
+		    pixels/max(frames, 1u), " pixels/frame");
+	}
+
+	Main(Env &env, Vfs::Env &vfs_env) : _env(env), _vfs_env(vfs_env)
+	{
+		log("--- menu-view benchmark started ---");
+
+		_config.node().with_optional_sub_node("replay", [&] (Node const &replay) {
+			_replay(replay, Mode::FULL);
+			_replay(replay, Mode::INCREMENTAL);
+		});
+
+		log("--- menu-view benchmark finished ---");
+	}
+};
+
+
+/*
+ * Silence debug messages
+ */
+extern "C" void _sigprocmask() { }
+
+
+void Libc::Component::construct(Libc::Env &env)
+{
+	static Menu_view::Main main(env, env.vfs_env());
+}
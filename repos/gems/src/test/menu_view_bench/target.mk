@@ -0,0 +1,18 @@
+TARGET   = test-menu_view_bench
+SRC_CC   = main.cc widget_factory.cc
+LIBS     = base libc libm vfs libpng zlib blit file
+MENU_DIR = $(call select_from_repositories,src/app/menu_view)
+INC_DIR += $(MENU_DIR)
+
+vpath widget_factory.cc $(MENU_DIR)
+
+CUSTOM_TARGET_DEPS += menu_view_styles.tar
+
+BUILD_ARTIFACTS := $(TARGET) menu_view_styles.tar
+
+.PHONY: menu_view_styles.tar
+
+menu_view_styles.tar:
+	$(MSG_CONVERT)$@
+	$(VERBOSE)tar $(TAR_OPT) -cf $@ -C $(MENU_DIR) styles
+	$(VERBOSE)ln -sf $(BUILD_BASE_DIR)/$(PRG_REL_DIR)/$@ $(INSTALL_DIR)/$@
@@ -0,0 +1,68 @@
+/*
+ * \brief  Linux-compatible epoll interface
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The epoll functions are implemented on top of kqueue.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__INCLUDE__SYS__EPOLL_H_
+#define _LIBC__INCLUDE__SYS__EPOLL_H_
+
+#include <sys/cdefs.h>
+#include <sys/types.h>
+#include <fcntl.h>
+
+#define EPOLL_CLOEXEC O_CLOEXEC
+
+#define EPOLLIN      0x001
+#define EPOLLPRI     0x002
+#define EPOLLOUT     0x004
+#define EPOLLERR     0x008
+#define EPOLLHUP     0x010
+#define EPOLLRDNORM  0x040
+#define EPOLLWRNORM  0x100
+#define EPOLLRDHUP   0x2000
+#define EPOLLONESHOT (1U << 30)
+#define EPOLLET      (1U << 31)
+
+#define EPOLL_CTL_ADD 1
+#define EPOLL_CTL_DEL 2
+#define EPOLL_CTL_MOD 3
+
+typedef union epoll_data
+{
+	void     *ptr;
+	int       fd;
+	uint32_t  u32;
+	uint64_t  u64;
+} epoll_data_t;
+
+struct epoll_event
+{
+	uint32_t     events;
+	epoll_data_t data;
+}
+#ifdef __x86_64__
+/* match the layout of Linux for ported code that relies on it */
+__packed
+#endif
+;
+
+__BEGIN_DECLS
+
+int epoll_create(int size);
+int epoll_create1(int flags);
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+
+__END_DECLS
+
+#endif /* _LIBC__INCLUDE__SYS__EPOLL_H_ */
@@ -19,12 +19,12 @@ SRC_CC = atexit.cc dummies.cc rlimit.cc sysctl.cc \
          vfs_plugin.cc dynamic_linker.cc signal.cc \
          socket_operations.cc socket_fs_plugin.cc syscall.cc \
          getpwent.cc getrandom.cc fork.cc execve.cc kernel.cc component.cc \
-         genode.cc spinlock.cc kqueue.cc call_func.cc
+         genode.cc spinlock.cc kqueue.cc epoll.cc call_func.cc
 
 #
 # Pthreads
 #
-SRC_CC += semaphore.cc rwlock.cc \
+SRC_CC += futex.cc semaphore.cc rwlock.cc \
           pthread.cc pthread_create.cc
 
 #
@@ -0,0 +1,185 @@
+/*
+ * \brief  epoll compatibility layer on top of kqueue
+ * \author agent
+ * \date   2026-10-18
+ *
+ * An epoll instance is a kqueue. Each registered file descriptor is
+ * represented by an EVFILT_READ and an EVFILT_WRITE kevent, the one not
+ * requested by the epoll events being disabled. The epoll data and the
+ * requested events are kept in the kevent's extension fields. A oneshot
+ * registration uses EV_DISPATCH, which keeps the disabled kevents registered
+ * for EPOLL_CTL_MOD. Edge-triggered notification is not supported.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+extern "C" {
+#include <sys/event.h>
+#include <sys/epoll.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+}
+
+/* libc-internal includes */
+#include <internal/errno.h>
+#include <internal/kqueue.h>
+
+using namespace Libc;
+
+
+static int apply_kevent(int epfd, int fd, short filter, unsigned short flags,
+                        uint64_t data = 0, uint32_t events = 0)
+{
+	struct kevent k;
+	EV_SET(&k, fd, filter, flags, 0, 0, nullptr);
+	k.ext[0] = data;
+	k.ext[1] = events;
+
+	return kevent(epfd, &k, 1, nullptr, 0, nullptr);
+}
+
+
+static int add_or_modify(int epfd, int fd, struct epoll_event const &event)
+{
+	/*
+	 * Edge-triggered notification would require the VFS to signal the
+	 * arrival of new data, which it does only for handles with a pending
+	 * read-ready notification. Reporting such registrations level-triggered
+	 * instead would let epoll_wait spin on writable file descriptors.
+	 */
+	if (event.events & EPOLLET)
+		return Errno(EINVAL);
+
+	unsigned short flags = EV_ADD;
+
+	if (event.events & EPOLLONESHOT) flags |= EV_DISPATCH;
+
+	auto filter_flags = [&] (uint32_t mask) -> unsigned short {
+		return (event.events & mask) ? flags : (unsigned short)(flags | EV_DISABLE); };
+
+	if (apply_kevent(epfd, fd, EVFILT_READ,  filter_flags(EPOLLIN  | EPOLLRDNORM),
+	                 event.data.u64, event.events)
+	 || apply_kevent(epfd, fd, EVFILT_WRITE, filter_flags(EPOLLOUT | EPOLLWRNORM),
+	                 event.data.u64, event.events))
+		return -1;
+
+	return 0;
+}
+
+
+extern "C" int epoll_create1(int flags)
+{
+	if (flags & ~EPOLL_CLOEXEC)
+		return Errno(EINVAL);
+
+	return kqueue();
+}
+
+
+extern "C" int epoll_create(int size)
+{
+	if (size <= 0)
+		return Errno(EINVAL);
+
+	return epoll_create1(0);
+}
+
+
+extern "C" int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	if (epfd == fd)
+		return Errno(EINVAL);
+
+	if (fcntl(fd, F_GETFD) == -1)
+		return Errno(EBADF);
+
+	bool const registered = kevent_registered(epfd, fd);
+
+	switch (op) {
+	case EPOLL_CTL_ADD:
+	case EPOLL_CTL_MOD:
+		if (!event)
+			return Errno(EFAULT);
+
+		if (op == EPOLL_CTL_ADD && registered)
+			return Errno(EEXIST);
+
+		if (op == EPOLL_CTL_MOD && !registered)
+			return Errno(ENOENT);
+
+		return add_or_modify(epfd, fd, *event);
+
+	case EPOLL_CTL_DEL:
+		if (!registered)
+			return Errno(ENOENT);
+
+		apply_kevent(epfd, fd, EVFILT_READ,  EV_DELETE);
+		apply_kevent(epfd, fd, EVFILT_WRITE, EV_DELETE);
+		return 0;
+	}
+
+	return Errno(EINVAL);
+}
+
+
+extern "C" int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+	if (maxevents <= 0)
+		return Errno(EINVAL);
+
+	timespec const timeout_ts { .tv_sec  = timeout / 1000,
+	                            .tv_nsec = (timeout % 1000)*1000*1000 };
+
+	enum { MAX_KEVENTS = 64 };
+	struct kevent kevents[MAX_KEVENTS];
+
+	int const nkevents = kevent(epfd, nullptr, 0, kevents,
+	                            maxevents < MAX_KEVENTS ? maxevents : MAX_KEVENTS,
+	                            timeout < 0 ? nullptr : &timeout_ts);
+	if (nkevents < 0)
+		return -1;
+
+	/*
+	 * Merge the read and write events of each file descriptor. Errors and
+	 * hangups are reported regardless of the requested events.
+	 */
+	uintptr_t idents[MAX_KEVENTS];
+	int nevents = 0;
+	for (int i = 0; i < nkevents; i++) {
+
+		struct kevent const &k = kevents[i];
+
+		uint32_t mask = (k.filter == EVFILT_READ) ? EPOLLIN : EPOLLOUT;
+
+		if (k.flags & EV_EOF) mask |= EPOLLHUP;
+		if (k.fflags)         mask |= EPOLLERR;
+
+		int j = 0;
+		while (j < nevents && idents[j] != k.ident)
+			j++;
+
+		if (j == nevents) {
+			idents[nevents]          = k.ident;
+			events[nevents].events   = 0;
+			events[nevents].data.u64 = k.ext[0];
+			nevents++;
+
+			/* a oneshot registration is disabled as a whole once reported */
+			if (k.ext[1] & EPOLLONESHOT) {
+				apply_kevent(epfd, int(k.ident), EVFILT_READ,  EV_DISABLE);
+				apply_kevent(epfd, int(k.ident), EVFILT_WRITE, EV_DISABLE);
+			}
+		}
+
+		events[j].events |= mask;
+	}
+
+	return nevents;
+}
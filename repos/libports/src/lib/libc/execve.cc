@@ -26,6 +26,7 @@
 
 /* libc-internal includes */
 #include <internal/fd_alloc.h>
+#include <internal/fd_buffer.h>
 #include <internal/call_func.h>
 #include <internal/init.h>
 #include <internal/errno.h>
@@ -350,6 +351,9 @@ extern "C" int execve(char const *filename,
 		return Libc::Errno(EACCES);
 	}
 
+	/* the buffers of the file descriptors do not survive the new image */
+	Libc::flush_fd_buffers();
+
 	/* close all file descriptors with the close-on-execve flag enabled */
 	while (Libc::File_descriptor *fd = _fd_alloc_ptr->any_cloexec_libc_fd())
 		close(fd->libc_fd);
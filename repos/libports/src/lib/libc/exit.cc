@@ -17,6 +17,7 @@
 /* libc-internal includes */
 #include <internal/types.h>
 #include <internal/atexit.h>
+#include <internal/fd_buffer.h>
 
 
 extern void genode_exit(int status) __attribute__((noreturn));
@@ -26,6 +27,9 @@ extern "C" void _exit(int status)
 {
 	Libc::execute_atexit_handlers_in_application_context();
 
+	/* data written to file descriptors must survive the exit */
+	Libc::flush_fd_buffers();
+
 	genode_exit(status);
 }
 
@@ -24,6 +24,7 @@
 /* libc-internal includes */
 #include <internal/fd_alloc.h>
 #include <internal/init.h>
+#include <internal/fd_buffer.h>
 
 using namespace Libc;
 
@@ -116,6 +117,20 @@ File_descriptor *File_descriptor_allocator::any_cloexec_libc_fd()
 }
 
 
+File_descriptor *File_descriptor_allocator::any_pending_write_fd()
+{
+	Mutex::Guard guard(_mutex);
+
+	File_descriptor *result = nullptr;
+
+	_id_space.for_each<File_descriptor>([&] (File_descriptor &fd) {
+		if (!result && fd.buffer && fd.buffer->pending_write())
+			result = &fd; });
+
+	return result;
+}
+
+
 void File_descriptor_allocator::update_append_libc_fds()
 {
 	Mutex::Guard guard(_mutex);
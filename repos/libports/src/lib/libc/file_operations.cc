@@ -46,6 +46,7 @@ extern "C" {
 #include <internal/mmap_registry.h>
 #include <internal/errno.h>
 #include <internal/init.h>
+#include <internal/kqueue.h>
 #include <internal/cwd.h>
 
 using namespace Libc;
@@ -271,6 +272,9 @@ __SYS_(int, close, (int libc_fd),
 	if (!fd)
 		return Errno(EBADF);
 
+	/* kqueue(2): "Calling close() on a file descriptor will remove any kevents" */
+	remove_kevents(libc_fd);
+
 	if (!fd->plugin || fd->plugin->close(fd) != 0)
 		file_descriptor_allocator()->free(fd);
 
@@ -793,6 +797,8 @@ __SYS_(ssize_t, write, (int libc_fd, const void *buf, ::size_t count),
 	if ((flags != -1) && (flags & O_APPEND))
 		lseek(libc_fd, 0, SEEK_END);
 
+	rearm_write_kevents(libc_fd);
+
 	FD_FUNC_WRAPPER(write, libc_fd, buf, count);
 })
 
@@ -31,6 +31,7 @@
 
 /* libc-internal includes */
 #include <internal/fd_alloc.h>
+#include <internal/fd_buffer.h>
 #include <internal/init.h>
 #include <internal/clone_session.h>
 #include <internal/monitor.h>
@@ -617,6 +618,9 @@ extern "C" pid_t __sys_fork(void)
 {
 	fork_result = -1;
 
+	/* the child must not write the buffered data of the parent once more */
+	Libc::flush_fd_buffers();
+
 	/* obtain current stack info, which might have changed since the startup */
 	Thread::Stack_info const mystack = Thread::mystack();
 	_user_stack_base_ptr = (void *)mystack.base;
@@ -0,0 +1,93 @@
+/*
+ * \brief  Futex-like synchronization words for pthread primitives
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc-internal includes */
+#include <internal/futex.h>
+#include <internal/init.h>
+#include <internal/kernel.h>
+#include <internal/pthread.h>
+
+using namespace Libc;
+
+
+static Timer_accessor *_timer_accessor_ptr;
+static unsigned        _spin_limit;
+
+
+void Libc::init_futex_support(Timer_accessor &timer_accessor, unsigned num_cpus)
+{
+	/* number of polls of a futex word before blocking */
+	enum { SPIN_LIMIT = 100 };
+
+	_timer_accessor_ptr = &timer_accessor;
+	_spin_limit         = (num_cpus > 1) ? SPIN_LIMIT : 0;
+}
+
+
+unsigned Libc::Futex::spin_limit() { return _spin_limit; }
+
+
+bool Libc::Futex::_wait(int volatile const &word, int expected,
+                        Libc::Blockade &blockade)
+{
+	Mutex::Guard guard(_mutex);
+
+	/* the word changed before the caller got the chance to block */
+	if (word != expected)
+		return true;
+
+	Waiter waiter { blockade };
+
+	_append(waiter);
+
+	_mutex.release();
+
+	blockade.block();
+
+	_mutex.acquire();
+
+	if (blockade.woken_up())
+		return true;
+
+	_remove(waiter);
+	return false;
+}
+
+
+bool Libc::Futex::wait(int volatile const &word, int expected, uint64_t timeout_ms)
+{
+	struct Missing_call_of_init_futex_support : Exception { };
+
+	if (Libc::Kernel::kernel().main_context()) {
+		Main_blockade blockade { timeout_ms };
+		return _wait(word, expected, blockade);
+	}
+
+	if (!_timer_accessor_ptr)
+		throw Missing_call_of_init_futex_support();
+
+	Pthread_blockade blockade { *_timer_accessor_ptr, timeout_ms };
+	return _wait(word, expected, blockade);
+}
+
+
+void Libc::Futex::wake(unsigned count)
+{
+	Mutex::Guard guard(_mutex);
+
+	for (; count && _waiters; count--) {
+		Waiter &waiter = *_waiters;
+		_waiters = waiter.next;
+		waiter.blockade.wakeup();
+	}
+}
@@ -29,10 +29,61 @@ struct Libc::Config
 {
 	using Path = String<Vfs::MAX_PATH_LEN>;
 
-	bool   update_mtime, cloned;
-	pid_t  pid;
-	Path   rtc, rng, pipe, socket, nameserver;
-	size_t stack_size;
+	/**
+	 * Sizes of per-file-descriptor I/O buffers
+	 *
+	 * Each '<buffer path="..." size="..."/>' node enables the buffering of
+	 * regular files located at or below the given path. If several nodes
+	 * match, the one with the longest path wins.
+	 */
+	struct Buffers
+	{
+		static constexpr unsigned MAX = 8;
+
+		struct { Path path; size_t size; } _entries[MAX] { };
+
+		unsigned _count = 0;
+
+		void add(Path const &path, size_t size)
+		{
+			if (_count < MAX)
+				_entries[_count++] = { path, size };
+			else
+				warning("libc: ignoring excess <buffer> config for ", path);
+		}
+
+		/**
+		 * Return buffer size for the file at 'path', 0 if unbuffered
+		 */
+		size_t size(char const *path) const
+		{
+			size_t result = 0, longest = 0;
+
+			for (unsigned i = 0; i < _count; i++) {
+
+				Path   const &prefix = _entries[i].path;
+				size_t const  len    = prefix.length() - 1;
+
+				bool const root = (len == 1 && prefix.string()[0] == '/');
+
+				bool const match = root
+				                || (Genode::strcmp(prefix.string(), path, len) == 0
+				                 && (path[len] == '/' || path[len] == 0));
+
+				if (match && len >= longest) {
+					longest = len;
+					result  = _entries[i].size;
+				}
+			}
+			return result;
+		}
+	};
+
+	bool    update_mtime, cloned;
+	pid_t   pid;
+	Path    rtc, rng, pipe, socket, nameserver;
+	size_t  stack_size;
+	Buffers buffers;
 
 	static Config _from_libc_node(Node const &libc)
 	{
@@ -43,6 +94,12 @@ struct Libc::Config
 		libc.with_optional_sub_node("stack", [&] (Node const &stack) {
 			stack_size = stack.attribute_value("size", Number_of_bytes(0)); });
 
+		Buffers buffers { };
+		libc.for_each_sub_node("buffer", [&] (Node const &buffer) {
+			size_t const size = buffer.attribute_value("size", Number_of_bytes(0));
+			if (size)
+				buffers.add(buffer.attribute_value("path", Path("/")), size); });
+
 		return {
 			.update_mtime = libc.attribute_value("update_mtime", true),
 			.cloned       = libc.attribute_value("cloned", false),
@@ -54,6 +111,7 @@ struct Libc::Config
 			.nameserver   = libc.attribute_value("nameserver_file",
 			                                     default_nameserver),
 			.stack_size   = stack_size,
+			.buffers      = buffers,
 		};
 	}
 
@@ -44,6 +44,8 @@ namespace Libc {
 
 	struct File_descriptor;
 
+	class Fd_buffer;
+
 	class File_descriptor_allocator;
 }
 
@@ -187,6 +189,8 @@ struct Libc::File_descriptor
 	bool cloexec  = 0;  /* for 'fcntl' */
 	bool modified = false;
 
+	Fd_buffer *buffer = nullptr;  /* optional read/write buffer */
+
 	File_descriptor(Id_space &id_space, Plugin &plugin, Plugin_context &context,
 	                Id_space::Id id)
 	: _elem(*this, id_space, id), plugin(&plugin), context(&context) { }
@@ -248,6 +252,14 @@ class Libc::File_descriptor_allocator
 		 */
 		File_descriptor *any_cloexec_libc_fd();
 
+		/**
+		 * Return any file descriptor with buffered data not yet written
+		 *
+		 * \return pointer to file descriptor, or
+		 *         nullptr if no such file descriptor exists
+		 */
+		File_descriptor *any_pending_write_fd();
+
 		/**
 		 * Update seek state of file descriptor with append flag set.
 		 */
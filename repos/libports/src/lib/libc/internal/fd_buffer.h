@@ -0,0 +1,128 @@
+/*
+ * \brief  Read/write buffer of a file descriptor
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The buffer holds either data read ahead from the file or data written but
+ * not yet passed to the VFS. In both cases, 'offset' denotes the file
+ * position of the first buffered byte. The seek position of the VFS handle
+ * always corresponds to the application's view of the file position. Hence,
+ * buffered data is used only if the seek position lies within the buffered
+ * range, which makes the buffer transparent to 'lseek'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__INTERNAL__FD_BUFFER_H_
+#define _LIBC__INTERNAL__FD_BUFFER_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+
+/* libc-internal includes */
+#include <internal/types.h>
+
+namespace Libc {
+
+	class Fd_buffer;
+
+	/**
+	 * Write back the buffered data of all file descriptors
+	 *
+	 * Called before the process image is left, i.e., on exit, fork, and
+	 * execve, so that no successfully written data is lost or duplicated.
+	 */
+	void flush_fd_buffers();
+}
+
+
+class Libc::Fd_buffer : Noncopyable
+{
+	public:
+
+		enum class Mode { EMPTY, READ, WRITE };
+
+	private:
+
+		Genode::Allocator &_alloc;
+
+	public:
+
+		size_t const capacity;
+		char * const data;
+
+		Mode    mode   = Mode::EMPTY;
+		::off_t offset = 0;
+		size_t  fill   = 0;
+
+		/**
+		 * Constructor
+		 *
+		 * The 'data' pointer is nullptr if the allocation failed.
+		 */
+		Fd_buffer(Genode::Allocator &alloc, size_t capacity)
+		:
+			_alloc(alloc), capacity(capacity),
+			data(alloc.try_alloc(capacity).convert<char *>(
+				[&] (Genode::Allocator::Allocation &a) {
+					a.deallocate = false; return (char *)a.ptr; },
+				[&] (Alloc_error) -> char * { return nullptr; }))
+		{ }
+
+		~Fd_buffer()
+		{
+			if (data)
+				_alloc.free(data, capacity);
+		}
+
+		void reset()
+		{
+			mode = Mode::EMPTY;
+			fill = 0;
+		}
+
+		bool pending_write() const { return mode == Mode::WRITE && fill; }
+
+		/**
+		 * Return number of read-ahead bytes available at file position 'pos'
+		 */
+		size_t readable(::off_t pos) const
+		{
+			if (mode != Mode::READ || pos < offset || pos >= offset + ::off_t(fill))
+				return 0;
+
+			return fill - size_t(pos - offset);
+		}
+
+		/**
+		 * Return true if 'count' bytes written at 'pos' can be buffered
+		 */
+		bool appendable(::off_t pos, size_t count) const
+		{
+			if (mode == Mode::READ)
+				return false;
+
+			if (mode == Mode::WRITE && pos != offset + ::off_t(fill))
+				return false;
+
+			return fill + count <= capacity;
+		}
+
+		void append(::off_t pos, void const *src, size_t count)
+		{
+			if (mode != Mode::WRITE) {
+				mode   = Mode::WRITE;
+				offset = pos;
+				fill   = 0;
+			}
+			Genode::memcpy(data + fill, src, count);
+			fill += count;
+		}
+};
+
+#endif /* _LIBC__INTERNAL__FD_BUFFER_H_ */
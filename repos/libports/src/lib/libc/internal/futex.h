@@ -0,0 +1,217 @@
+/*
+ * \brief  Futex-like synchronization words for pthread primitives
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The state of each synchronization object is kept in an integer word that
+ * is manipulated via atomic compare-and-exchange operations. Only if an
+ * operation cannot proceed, the caller spins for a short while and, if the
+ * word does not change, blocks in the wait queue of the 'Futex'. This way,
+ * uncontended operations do not take any lock.
+ *
+ * Blocking uses a 'Main_blockade' in the main context, which keeps the libc
+ * kernel going, and a 'Pthread_blockade' otherwise. The latter is based on
+ * 'Genode::Blockade', which natively maps to a futex on base-linux.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__INTERNAL__FUTEX_H_
+#define _LIBC__INTERNAL__FUTEX_H_
+
+/* Genode includes */
+#include <base/mutex.h>
+#include <cpu/atomic.h>
+
+/* libc-internal includes */
+#include <internal/monitor.h>
+#include <internal/types.h>
+
+namespace Libc {
+
+	class Futex;
+	class Futex_mutex;
+
+	/**
+	 * Atomically replace 'word' by 'value'
+	 *
+	 * \return previous value
+	 */
+	static inline int atomic_exchange(int volatile &word, int value)
+	{
+		for (;;) {
+			int const old = word;
+			if (Genode::cmpxchg(&word, old, value))
+				return old;
+		}
+	}
+
+	/**
+	 * Atomically add 'value' to 'word'
+	 *
+	 * \return new value
+	 */
+	static inline int atomic_add(int volatile &word, int value)
+	{
+		for (;;) {
+			int const old = word;
+			if (Genode::cmpxchg(&word, old, old + value))
+				return old + value;
+		}
+	}
+}
+
+
+class Libc::Futex : Noncopyable
+{
+	private:
+
+		struct Waiter : Noncopyable
+		{
+			Waiter *next { nullptr };
+
+			Libc::Blockade &blockade;
+
+			Waiter(Libc::Blockade &blockade) : blockade(blockade) { }
+		};
+
+		Mutex   _mutex   { };
+		Waiter *_waiters { nullptr };
+
+		/* _mutex must be held when calling the following methods */
+
+		void _append(Waiter &waiter)
+		{
+			Waiter **tail = &_waiters;
+
+			for (; *tail; tail = &(*tail)->next) ;
+
+			*tail = &waiter;
+		}
+
+		void _remove(Waiter &waiter)
+		{
+			Waiter **w = &_waiters;
+
+			for (; *w && *w != &waiter; w = &(*w)->next) ;
+
+			if (*w)
+				*w = waiter.next;
+		}
+
+		bool _wait(int volatile const &word, int expected, Libc::Blockade &);
+
+	public:
+
+		/**
+		 * Spin until 'cond_fn' returns true or the spin limit is reached
+		 *
+		 * Spinning avoids blocking if the lock holder executes on another
+		 * CPU and releases the lock soon. On a single CPU, spinning is
+		 * pointless and therefore disabled.
+		 *
+		 * \return result of the last 'cond_fn' call
+		 */
+		static bool spin(auto const &cond_fn)
+		{
+			for (unsigned i = spin_limit(); i > 0; i--)
+				if (cond_fn())
+					return true;
+
+			return false;
+		}
+
+		static unsigned spin_limit();
+
+		/**
+		 * Block while 'word' equals 'expected'
+		 *
+		 * The caller may return spuriously and must re-check its condition.
+		 *
+		 * \param timeout_ms  timeout in milliseconds, 0 for no timeout
+		 * \return            false if the timeout expired
+		 */
+		bool wait(int volatile const &word, int expected, uint64_t timeout_ms);
+
+		/**
+		 * Wake up at most 'count' waiters in FIFO order
+		 */
+		void wake(unsigned count);
+
+		void wake_all() { wake(~0U); }
+};
+
+
+/**
+ * Mutual exclusion based on a futex word
+ *
+ * The implementation follows the three-state mutex of Ulrich Drepper,
+ * "Futexes Are Tricky", extended by adaptive spinning.
+ */
+class Libc::Futex_mutex : Noncopyable
+{
+	private:
+
+		enum { UNLOCKED = 0, LOCKED = 1, CONTENDED = 2 };
+
+		int volatile _state { UNLOCKED };
+
+		Futex _futex { };
+
+		bool _spin()
+		{
+			return Futex::spin([&] {
+				return _state == UNLOCKED
+				    && Genode::cmpxchg(&_state, UNLOCKED, LOCKED); });
+		}
+
+	public:
+
+		bool try_lock() { return Genode::cmpxchg(&_state, UNLOCKED, LOCKED); }
+
+		void lock()
+		{
+			if (try_lock() || _spin())
+				return;
+
+			while (atomic_exchange(_state, CONTENDED) != UNLOCKED)
+				_futex.wait(_state, CONTENDED, 0);
+		}
+
+		/**
+		 * Acquire lock with timeout
+		 *
+		 * \param remaining_ms_fn  functor returning the remaining time in
+		 *                         milliseconds, 0 if the timeout expired
+		 * \return                 false if the timeout expired
+		 */
+		bool lock(auto const &remaining_ms_fn)
+		{
+			if (try_lock() || _spin())
+				return true;
+
+			while (atomic_exchange(_state, CONTENDED) != UNLOCKED) {
+
+				uint64_t const timeout_ms = remaining_ms_fn();
+				if (!timeout_ms)
+					return false;
+
+				_futex.wait(_state, CONTENDED, timeout_ms);
+			}
+			return true;
+		}
+
+		void unlock()
+		{
+			if (atomic_exchange(_state, UNLOCKED) == CONTENDED)
+				_futex.wake(1);
+		}
+};
+
+
+#endif /* _LIBC__INTERNAL__FUTEX_H_ */
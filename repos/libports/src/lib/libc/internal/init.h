@@ -68,7 +68,7 @@ namespace Libc {
 	/**
 	 * Virtual file system
 	 */
-	void init_vfs_plugin(Monitor &, Genode::Env::Local_rm &);
+	void init_vfs_plugin(Monitor &, Genode::Env::Local_rm &, File_descriptor_allocator &);
 	void init_file_operations(Cwd &, File_descriptor_allocator &, Config_accessor const &);
 	void init_pread_pwrite(File_descriptor_allocator &);
 
@@ -119,7 +119,7 @@ namespace Libc {
 	 */
 	void init_pthread_support(Monitor &, Timer_accessor &);
 	void init_pthread_support(Genode::Env &, Node const &, Genode::Allocator &);
-	void init_semaphore_support(Timer_accessor &);
+	void init_futex_support(Timer_accessor &, unsigned num_cpus);
 
 	/**
 	 * Fork mechanism
@@ -20,7 +20,26 @@
 #include <base/allocator.h>
 #include <internal/plugin.h>
 
-namespace Libc { class Kqueue_plugin; }
+namespace Libc {
+
+	class Kqueue_plugin;
+
+	/**
+	 * Remove the kevents of a file descriptor about to be closed from all
+	 * kqueues
+	 */
+	void remove_kevents(int libc_fd);
+
+	/**
+	 * Let all kqueues check the write event of a file descriptor written to
+	 */
+	void rearm_write_kevents(int libc_fd);
+
+	/**
+	 * Return true if kqueue 'kq_fd' has a kevent registered for 'ident'
+	 */
+	bool kevent_registered(int kq_fd, uintptr_t ident);
+}
 
 
 class Libc::Kqueue_plugin : public Libc::Plugin
@@ -148,6 +148,14 @@ namespace Libc {
 			virtual int unlink(const char *path);
 			virtual ssize_t write(File_descriptor *, const void *buf, ::size_t count);
 
+			/**
+			 * Transfer up to 'count' bytes from 'src' at 'offset' to 'dst'
+			 *
+			 * The file offset of 'src' is not modified.
+			 */
+			virtual ssize_t transfer(File_descriptor *src, ::off_t offset,
+			                         File_descriptor *dst, ::size_t count);
+
 			virtual int enqueue_aiocb(File_descriptor *, const struct aiocb * aiocb);
 			virtual int wait_aio(File_descriptor *, int timeout_ms);
 	};
@@ -25,6 +25,8 @@
 
 /* libc includes */
 #include <pthread.h>
+#include <setjmp.h>
+#include <sys/_cpuset.h>
 
 /* libc-internal includes */
 #include <internal/types.h>
@@ -38,6 +40,7 @@ namespace Libc {
 	struct Pthread_cleanup;
 	struct Pthread_job;
 	struct Pthread_mutex;
+	class  Pthread_worker_pool;
 }
 
 
@@ -58,6 +61,52 @@ class Libc::Pthread_cleanup
 Libc::Pthread_cleanup &pthread_cleanup();
 
 
+/**
+ * Idle pthreads kept for backing subsequent 'pthread_create' calls
+ *
+ * Creating a Genode thread involves the CPU session, the stack area, and the
+ * kernel. For applications that spawn many short-lived pthreads, the worker
+ * pool retains the threads of finished pthreads instead of destroying them.
+ * A parked thread resumes with the start routine of the next created pthread.
+ *
+ * The pool is disabled by default. Because the storage of 'thread_local'
+ * variables is tied to the Genode thread, it is not re-initialized when a
+ * parked thread picks up a new start routine.
+ */
+class Libc::Pthread_worker_pool : Noncopyable
+{
+	private:
+
+		Mutex     _mutex     { };
+		Pthread  *_idle      { nullptr };
+		unsigned  _num_idle  { 0 };
+		unsigned  _max_idle  { 0 };
+
+	public:
+
+		void max_idle(unsigned max_idle) { _max_idle = max_idle; }
+
+		bool enabled() const { return _max_idle > 0; }
+
+		/**
+		 * Park calling pthread until it is assigned a new start routine
+		 *
+		 * \return false if the pool is full
+		 */
+		bool park(Pthread &myself);
+
+		/**
+		 * Obtain an idle pthread with at least 'stack_size' bytes of stack
+		 *
+		 * \return nullptr if no suitable pthread is parked
+		 */
+		Pthread *take(size_t stack_size);
+};
+
+
+Libc::Pthread_worker_pool &pthread_worker_pool();
+
+
 extern "C" {
 
 	struct pthread_attr
@@ -65,6 +114,10 @@ extern "C" {
 		void   *stack_addr   { nullptr };
 		size_t  stack_size   { Libc::Component::stack_size() };
 		int     detach_state { PTHREAD_CREATE_JOINABLE };
+
+		/* CPUs defined via 'pthread_attr_setaffinity_np' */
+		bool     cpuset_defined { false };
+		cpuset_t cpuset         { };
 	};
 
 	/*
@@ -91,6 +144,9 @@ struct Libc::Pthread : Noncopyable
 
 			Pthread        *_pthread;
 
+			/* entry point for running the next start routine of a pooled thread */
+			jmp_buf _restart_env { };
+
 			/* 'stack_addr_out' and 'stack_size_out' are written when the thread starts */
 			Thread_object(Genode::Env &env, char const *name, size_t stack_size,
 			              Affinity::Location location,
@@ -105,6 +161,17 @@ struct Libc::Pthread : Noncopyable
 			{ }
 
 			void entry() override;
+
+			void assign(start_routine_t start_routine, void *arg)
+			{
+				_start_routine = start_routine;
+				_arg           = arg;
+			}
+
+			void resume_at_entry() __attribute__((noreturn))
+			{
+				_longjmp(_restart_env, 1);
+			}
 		};
 
 		Constructible<Thread_object> _thread_object;
@@ -126,6 +193,23 @@ struct Libc::Pthread : Noncopyable
 
 		bool _exiting = false;
 
+		/* true once the thread called 'exit()' */
+		bool _exited = false;
+
+		/* index of the CPU within the affinity space */
+		unsigned _cpu = 0;
+
+		/* stack size requested at creation time */
+		size_t const _stack_request = 0;
+
+		/* pthread parked in the worker pool */
+		Pthread *_next_idle = nullptr;
+
+		/* unblocked when a parked pthread is assigned a new start routine */
+		Genode::Blockade _restart_blockade { };
+
+		friend class Pthread_worker_pool;
+
 		/*
 		 * The mutex synchronizes the execution of cancel() and join() to
 		 * protect the about-to-exit pthread to be destructed before it leaves
@@ -188,11 +272,12 @@ struct Libc::Pthread : Noncopyable
 		 */
 		Pthread(Genode::Env &env, start_routine_t start_routine,
 		        void *arg, size_t stack_size, char const * name,
-		        Affinity::Location location)
+		        Affinity::Location location, unsigned cpu)
 		:
 			_thread(_construct_thread_object(env, name, stack_size, location,
 			                                 start_routine, arg,
-			                                 _stack_addr, _stack_size, this))
+			                                 _stack_addr, _stack_size, this)),
+			_cpu(cpu), _stack_request(stack_size)
 		{
 			pthread_cleanup().cleanup();
 		}
@@ -225,6 +310,25 @@ struct Libc::Pthread : Noncopyable
 
 		int detach();
 
+		/**
+		 * Release pthread after 'join()'
+		 *
+		 * \return false if the caller must destroy the pthread
+		 */
+		bool release();
+
+		/**
+		 * Assign new start routine to pthread obtained from the worker pool
+		 */
+		void restart(start_routine_t start_routine, void *arg);
+
+		/**
+		 * Move thread to CPU at 'location', which has the index 'cpu'
+		 */
+		void migrate(Affinity::Location location, unsigned cpu);
+
+		unsigned cpu() const { return _cpu; }
+
 		/*
 		 * Inform the thread calling 'pthread_join()' that this thread can be
 		 * destroyed.
@@ -235,6 +339,7 @@ struct Libc::Pthread : Noncopyable
 		{
 			while (cleanup_pop(1)) { }
 			_retval = retval;
+			_exited = true;
 			cancel();
 
 			/*
@@ -244,6 +349,10 @@ struct Libc::Pthread : Noncopyable
 
 			_detach_blockade.block();
 
+			/* run the next start routine if the thread was parked */
+			if (_thread_object.constructed() && pthread_worker_pool().park(*this))
+				_thread_object->resume_at_entry();
+
 			pthread_cleanup().cleanup(this);
 			sleep_forever();
 		}
@@ -25,7 +25,7 @@ struct Libc::Pthread_pool
 {
 	struct Pthread : Timeout_handler
 	{
-		Blockade blockade;
+		Genode::Blockade blockade;
 
 		Pthread *next { nullptr };
 
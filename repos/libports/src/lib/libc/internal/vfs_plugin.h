@@ -72,17 +72,33 @@ class Libc::Vfs_plugin final : public Plugin
 
 	private:
 
+		/**
+		 * Mapping of a dataspace obtained via 'Directory_service::dataspace'
+		 */
 		struct Mmap_entry : Registry<Mmap_entry>::Element
 		{
-			void            * const start;
-			Vfs::Vfs_handle * const reference_handle;
+			void                       * const start;
+			Vfs::Vfs_handle            * const reference_handle;
+			Absolute_path                const path;
+			Genode::Dataspace_capability const ds;
 
 			Mmap_entry(Registry<Mmap_entry> &registry, void *start,
-			           Vfs::Vfs_handle *reference_handle)
+			           Vfs::Vfs_handle *reference_handle,
+			           Absolute_path const &path,
+			           Genode::Dataspace_capability ds)
 			: Registry<Mmap_entry>::Element(registry, *this), start(start),
-			  reference_handle(reference_handle) { }
+			  reference_handle(reference_handle), path(path), ds(ds) { }
 		};
 
+		/**
+		 * Attach the dataspace of the file referred to by 'fd'
+		 *
+		 * \return  local address, or nullptr with 'errno_out' set
+		 */
+		void *_attach_file_dataspace(File_descriptor &fd, ::size_t length,
+		                             ::off_t offset, bool writeable,
+		                             int &errno_out);
+
 		File_descriptor_allocator        &_fd_alloc;
 		Genode::Allocator                &_alloc;
 		Vfs::File_system                 &_root_fs;
@@ -120,6 +136,29 @@ class Libc::Vfs_plugin final : public Plugin
 
 		} _cached_ioctl_info { *this };
 
+		/**
+		 * Pass pending writes of the buffer of 'fd' to the VFS
+		 *
+		 * The buffer is empty afterwards, regardless of the result.
+		 *
+		 * \return  false if the data could not be written, with errno set
+		 */
+		bool _flush_buffer(File_descriptor &fd);
+
+		/**
+		 * Counterpart of '_flush_buffer' for the kernel context, which
+		 * cannot use the monitor
+		 */
+		bool _flush_buffer_from_kernel(File_descriptor &fd);
+
+		void _destroy_buffer(File_descriptor &fd);
+
+		/**
+		 * Unbuffered I/O operations
+		 */
+		ssize_t _read(File_descriptor *, void *, ::size_t);
+		ssize_t _write(File_descriptor *, const void *, ::size_t);
+
 		/**
 		 * Sync a handle
 		 */
@@ -203,6 +242,11 @@ class Libc::Vfs_plugin final : public Plugin
 		bool supports_mmap()                                   override { return true; }
 		bool supports_aio()                                    override { return true; }
 
+		/**
+		 * Pass pending writes of the buffer of 'fd' to the VFS
+		 */
+		bool flush_buffer(File_descriptor &fd) { return _flush_buffer(fd); }
+
 		/* kernel-specific API without monitor */
 		File_descriptor *open_from_kernel(const char *, int, int libc_fd);
 		int close_from_kernel(File_descriptor *);
@@ -233,6 +277,7 @@ class Libc::Vfs_plugin final : public Plugin
 		int     symlink(const char *, const char *) override;
 		int     unlink(const char *) override;
 		ssize_t write(File_descriptor *, const void *, ::size_t ) override;
+		ssize_t transfer(File_descriptor *, ::off_t, File_descriptor *, ::size_t) override;
 		void   *mmap(void *, ::size_t, int, int, File_descriptor *, ::off_t) override;
 		int     munmap(void *, ::size_t) override;
 
@@ -484,7 +484,7 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 	_atexit_fd_alloc_ptr = &_fd_alloc;
 	atexit(close_file_descriptors_on_exit);
 
-	init_semaphore_support(_timer_accessor);
+	init_futex_support(_timer_accessor, _env.cpu().affinity_space().total());
 	init_pthread_support(*this, _timer_accessor);
 
 	_with_libc_sub_config("pthread", [&] (Node const &pthread_config) {
@@ -505,7 +505,7 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 	init_execve(_env, _heap, _user_stack, *this, _binary_name, _fd_alloc);
 	init_plugin(*this);
 	init_sleep(*this);
-	init_vfs_plugin(*this, _env.rm());
+	init_vfs_plugin(*this, _env.rm(), _fd_alloc);
 	init_file_operations(*this, _fd_alloc, _libc_env);
 	init_pread_pwrite(_fd_alloc);
 	init_time(*this, *this);
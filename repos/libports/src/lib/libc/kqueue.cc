@@ -26,7 +26,9 @@
 
 /* Genode includes */
 #include <base/mutex.h>
+#include <base/registry.h>
 #include <util/avl_tree.h>
+#include <util/fifo.h>
 #include <util/register.h>
 
 using namespace Libc;
@@ -34,9 +36,17 @@ using namespace Libc;
 namespace Libc {
 	class Kqueue;
 
+	bool vfs_file_descriptor(File_descriptor *);
 	bool read_ready_from_kernel(File_descriptor *);
 	void notify_read_ready_from_kernel(File_descriptor *);
 	bool write_ready_from_kernel(File_descriptor *);
+
+	Vfs::Read_ready_response_handler *
+	redirect_read_ready_from_kernel(File_descriptor *, Vfs::Read_ready_response_handler &);
+
+	void restore_read_ready_from_kernel(File_descriptor *, Vfs::Read_ready_response_handler &);
+
+	File_descriptor *socket_read_ready_file_descriptor(File_descriptor *);
 }
 
 namespace { using Fn = Libc::Monitor::Function_result; }
@@ -45,6 +55,14 @@ namespace { using Fn = Libc::Monitor::Function_result; }
 static Monitor             *_monitor_ptr;
 static Libc::Kqueue_plugin *_kqueue_plugin_ptr;
 
+using Kqueue_registry = Genode::Registry<Genode::Registered_no_delete<Libc::Kqueue>>;
+
+static Kqueue_registry &_kqueues()
+{
+	static Kqueue_registry registry { };
+	return registry;
+}
+
 
 static Libc::Monitor & monitor()
 {
@@ -86,6 +104,20 @@ static consteval int pos(int flag)
 
 /*
  * Kqueue backend implementation
+ *
+ * Registered events are kept in an AVL tree keyed by (ident, filter). Only
+ * the events on the ready list are checked when collecting events. An
+ * EVFILT_READ event that is not ready leaves the ready list and waits for the
+ * read-ready response of the VFS handle, which puts it back onto the ready
+ * list. Hence, the costs of collecting events scale with the number of ready
+ * events, not with the number of registered events. For sockets, the
+ * read-ready responses of the VFS handle backing the socket's data (or
+ * accept) file take this role.
+ *
+ * An EVFILT_WRITE event leaves the ready list once it has been reported and
+ * returns on the next write to the file descriptor, which is the only way
+ * the condition can cease to hold. Write events that are not ready remain
+ * on the ready list because there is no write-ready response to wait for.
  */
 
 struct Libc::Kqueue
@@ -95,6 +127,7 @@ struct Libc::Kqueue
 		EV_DELETE  |
 		EV_CLEAR   |
 		EV_ONESHOT |
+		EV_DISPATCH |
 		EV_ENABLE  |
 		EV_DISABLE;
 
@@ -109,12 +142,35 @@ struct Libc::Kqueue
 		struct Disable : Bitfield<pos(EV_DISABLE), 1> { };
 		struct Clear   : Bitfield<  pos(EV_CLEAR), 1> { };
 		struct Oneshot : Bitfield<pos(EV_ONESHOT), 1> { };
+		struct Dispatch: Bitfield<pos(EV_DISPATCH), 1> { };
 	};
 
 	struct Kqueue_elements;
 
-	struct Kqueue_element : kevent, public Avl_node<Kqueue_element>
+	struct Kqueue_element : kevent, public Avl_node<Kqueue_element>,
+	                        public Fifo<Kqueue_element>::Element,
+	                        Vfs::Read_ready_response_handler
 	{
+		Kqueue &_kqueue;
+
+		/*
+		 * Read-ready responses of the file descriptor are redirected to the
+		 * element while it is waiting for them
+		 */
+		Plugin_context                   *_redirected_context = nullptr;
+		Vfs::Read_ready_response_handler *_next_handler       = nullptr;
+
+		/*
+		 * Noncopyable
+		 */
+		Kqueue_element(Kqueue_element const &);
+		Kqueue_element &operator = (Kqueue_element const &);
+
+		Kqueue_element(Kqueue &kqueue, struct kevent const &k)
+		: kevent(k), _kqueue(kqueue) { }
+
+		~Kqueue_element() { restore_handler(); }
+
 		Kqueue_element *find_by_kevent(struct kevent const &k)
 		{
 			if (*this == k) return this;
@@ -127,23 +183,67 @@ struct Libc::Kqueue
 			return *e > *this;
 		}
 
-		/*
-		 * Run fn arcoss the element's subtree until fn returns false.
+		/**
+		 * Return file descriptor of the VFS handle that signals the
+		 * readability of 'fd'
 		 */
-		bool with_all_elements(auto const &fn)
+		static File_descriptor *read_ready_fd(File_descriptor *fd)
 		{
-			if (!fn(*this))
-				return false;
+			return vfs_file_descriptor(fd) ? fd : socket_read_ready_file_descriptor(fd);
+		}
 
-			if (Kqueue_element * l = child(Avl_node<Kqueue_element>::LEFT))
-				if (!l->with_all_elements(fn))
-					return false;
+		/**
+		 * Wait for the read-ready response of 'fd'
+		 *
+		 * \param fd  file descriptor backed by a VFS handle
+		 *
+		 * \return false if the response cannot be redirected to the element
+		 */
+		bool redirect_handler(File_descriptor *fd)
+		{
+			if (_redirected_context == fd->context)
+				return true;
 
-			if (Kqueue_element * r = child(Avl_node<Kqueue_element>::RIGHT))
-				if (!r->with_all_elements(fn))
-					return false;
+			restore_handler();
 
-			return true;
+			_next_handler = redirect_read_ready_from_kernel(fd, *this);
+			if (_next_handler)
+				_redirected_context = fd->context;
+
+			return _next_handler != nullptr;
+		}
+
+		void restore_handler()
+		{
+			if (!_redirected_context)
+				return;
+
+			/*
+			 * The file descriptor may have been closed in the meantime, in
+			 * which case the redirected VFS handle is gone.
+			 */
+			File_descriptor *fd =
+				file_descriptor_allocator()->find_by_libc_fd(int(ident));
+
+			if (fd && fd->context)
+				fd = read_ready_fd(fd);
+
+			if (fd && fd->context == _redirected_context)
+				restore_read_ready_from_kernel(fd, *this);
+
+			_redirected_context = nullptr;
+			_next_handler       = nullptr;
+		}
+
+		/*
+		 * Vfs::Read_ready_response_handler interface
+		 */
+		void read_ready_response() override
+		{
+			_kqueue._ready_response(*this);
+
+			if (_next_handler)
+				_next_handler->read_ready_response();
 		}
 	};
 
@@ -171,14 +271,6 @@ struct Libc::Kqueue
 			else
 				return no_match_fn();
 		}
-
-		/*
-		 * Run fn arcoss the tree until fn returns false.
-		 */
-		void with_all_elements(auto const &fn) const
-		{
-			if (first()) first()->with_all_elements(fn);
-		}
 	};
 
 
@@ -187,42 +279,40 @@ struct Libc::Kqueue
 	Kqueue_elements    _requests;
 
 	/*
-	 * Collect invalid elements for deletion.
-	 * This needs to be done out of band because otherwise the reshuffling of the AVL tree
-	 * might lead to missed valid events.
+	 * Events to be checked on the next collection, may be populated by
+	 * read-ready responses from the entrypoint
 	 */
-	struct Kqueue_element_container : Fifo<Kqueue_element_container>::Element
+	Mutex                _ready_mutex { };
+	Fifo<Kqueue_element> _ready       { };
+
+	void _ready_response(Kqueue_element &ele)
 	{
-		Kqueue_element const &ele;
-		Kqueue_element_container(Kqueue_element const &e) : ele(e)
-		{ }
-	};
+		Mutex::Guard guard(_ready_mutex);
 
-	Fifo<Kqueue_element_container> _delete_queue;
+		if (!ele.Fifo<Kqueue_element>::Element::enqueued())
+			_ready.enqueue(ele);
+	}
 
-	void _queue_for_deletion(Kqueue_element &ele)
+	/*
+	 * Must be called with '_ready_mutex' held
+	 */
+	static void _move(Fifo<Kqueue_element> &from, Fifo<Kqueue_element> &to)
 	{
-		Kqueue_element_container &c = *new (_alloc) Kqueue_element_container(ele);
-		_delete_queue.enqueue(c);
+		from.dequeue_all([&] (Kqueue_element &ele) { to.enqueue(ele); });
 	}
 
 	/*
-	 * This may be called only when we can safely reshuffle the AVL tree
+	 * Must be called with '_requests_mutex' held
 	 */
-	void _delete_elements()
+	void _destroy_element(Kqueue_element &ele)
 	{
-		auto cancel_fn = [&](Kqueue_element_container& c) {
-			/* At this point we are sure that we can reshuffle the AVL tree. */
-			Kqueue_element * non_const_ptr = &(const_cast<Kqueue_element &>(c.ele));
-			_requests.remove(non_const_ptr);
-			destroy(_alloc, non_const_ptr);
-			destroy(_alloc, &c);
-		};
-
+		ele.restore_handler();
 		{
-			Mutex::Guard guard(_requests_mutex);
-			_delete_queue.dequeue_all(cancel_fn);
+			Mutex::Guard guard(_ready_mutex);
+			_ready.remove(ele);
 		}
+		_requests.remove(&ele);
+		destroy(_alloc, &ele);
 	}
 
 	int _add_event(struct kevent const& k)
@@ -232,11 +322,22 @@ struct Libc::Kqueue
 			return EINVAL;
 		}
 
-		Kqueue_element *ele = new (_alloc) Kqueue_element(k);
-		{
-			Mutex::Guard guard(_requests_mutex);
-			_requests.insert(ele);
-		}
+		Mutex::Guard guard(_requests_mutex);
+
+		/* kqueue(2): "Re-adding an existing event will modify the parameters" */
+		auto match_fn = [&] (Kqueue_element &ele) -> Kqueue_element & {
+			ele.restore_handler();
+			static_cast<struct kevent &>(ele) = k;
+			return ele;
+		};
+
+		auto no_match_fn = [&] () -> Kqueue_element & {
+			Kqueue_element &ele = *new (_alloc) Kqueue_element(*this, k);
+			_requests.insert(&ele);
+			return ele;
+		};
+
+		_ready_response(_requests.with_element(k, match_fn, no_match_fn));
 
 		return 0;
 	}
@@ -246,26 +347,88 @@ struct Libc::Kqueue
 		Mutex::Guard guard(_requests_mutex);
 
 		auto match_fn = [&](Kqueue_element &ele) {
-			/* Since we know we won't match another element, we can safely remove the element here. */
-			_requests.remove(&ele);
-			destroy(_alloc, &ele);
-
+			_destroy_element(ele);
 			return 0;
 		};
 
 		auto no_match_fn = [&]() {
-			error("kqueue: did not find kevent to delete: ident: ", k.ident, " filter: ", k.filter);
-			return EINVAL;
+			return ENOENT;
 		};
 
 		return _requests.with_element(k, match_fn, no_match_fn);
 	}
 
+	/*
+	 * Readiness of file descriptors not backed by a VFS handle
+	 */
+	static short _poll(File_descriptor &fd, short events)
+	{
+		short revents = 0;
+
+		if (!fd.plugin->supports_poll())
+			return 0;
+
+		Plugin::Pollfd pollfd { .fdo = &fd, .events = events, .revents = &revents };
+		fd.plugin->poll(&pollfd, 1);
+
+		return revents;
+	}
+
+	static constexpr short filters[] { EVFILT_READ, EVFILT_WRITE };
+
+	/**
+	 * Remove the events of a file descriptor that is about to be closed
+	 */
+	void remove_events(uintptr_t ident)
+	{
+		Mutex::Guard guard(_requests_mutex);
+
+		for (short filter : filters) {
+			struct kevent k;
+			EV_SET(&k, ident, filter, 0, 0, 0, nullptr);
+			_requests.with_element(k,
+				[&] (Kqueue_element &ele) { _destroy_element(ele); },
+				[&] { });
+		}
+	}
+
+	/**
+	 * Check the write event of a file descriptor on the next collection
+	 */
+	void rearm_write_event(uintptr_t ident)
+	{
+		Mutex::Guard guard(_requests_mutex);
+
+		struct kevent k;
+		EV_SET(&k, ident, EVFILT_WRITE, 0, 0, 0, nullptr);
+		_requests.with_element(k,
+			[&] (Kqueue_element &ele) { _ready_response(ele); },
+			[&] { });
+	}
+
+	bool registered(uintptr_t ident)
+	{
+		Mutex::Guard guard(_requests_mutex);
+
+		bool result = false;
+		for (short filter : filters) {
+			struct kevent k;
+			EV_SET(&k, ident, filter, 0, 0, 0, nullptr);
+			_requests.with_element(k,
+				[&] (Kqueue_element &) { result = true; },
+				[&] { });
+		}
+		return result;
+	}
+
 	int _enable_event(struct kevent const& k)
 	{
+		Mutex::Guard guard(_requests_mutex);
+
 		auto match_fn = [&](Kqueue_element &ele) {
 			Kqueue_flags::Disable::clear((Kqueue_flags::access_t &)ele.flags);
 			Kqueue_flags::Enable::set((Kqueue_flags::access_t &)ele.flags);
+			_ready_response(ele);
 			return 0;
 		};
 
@@ -279,6 +442,8 @@ struct Libc::Kqueue
 
 	int _disable_event(struct kevent const& k)
 	{
+		Mutex::Guard guard(_requests_mutex);
+
 		auto match_fn = [&](Kqueue_element &ele) {
 			Kqueue_flags::Enable::clear((Kqueue_flags::access_t &)ele.flags);
 			Kqueue_flags::Disable::set((Kqueue_flags::access_t &)ele.flags);
@@ -298,9 +463,9 @@ struct Libc::Kqueue
 
 	~Kqueue()
 	{
-		auto destroy_fn = [&] (Kqueue_element &e) {
-			_requests.remove(&e);
-			destroy(_alloc, &e); };
+		Mutex::Guard guard(_requests_mutex);
+
+		auto destroy_fn = [&] (Kqueue_element &e) { _destroy_element(e); };
 		while (_requests.with_any_element(destroy_fn));
 	}
 
@@ -378,9 +543,18 @@ struct Libc::Kqueue
 			 * the event no longer holds, the kevent is removed from the kqueue and is
 			 * not returned."
 			 *
-			 * Since we need to check the condition on retrieval anyway, we *only* check
-			 * the condition on retrieval and not asynchronously.
+			 * Since we need to check the condition on retrieval anyway, we
+			 * check the condition of the events on the ready list on
+			 * retrieval and merely track wakeups asynchronously.
+			 */
+
+			/*
+			 * Events to be checked in this round, and events to be checked
+			 * again on the next collection. Read-ready responses during the
+			 * check are deferred to the next round.
 			 */
+			Fifo<Kqueue_element> pending { }, level_triggered { };
+
 			auto check_fn = [&](Kqueue_element &ele) {
 				File_descriptor *fd = libc_fd_to_fd(ele.ident, "kevent_collect");
 
@@ -388,19 +562,37 @@ struct Libc::Kqueue
 				 * kqueue(2): "Calling close() on a file  descriptor will remove any
 				 * kevents that reference the descriptor."
 				 *
-				 * Instead of removing the kqueue entry from close(), we collect
-				 * invalid entries for deletion here.
+				 * Instead of removing the kqueue entry from close(), we remove
+				 * invalid entries here.
 				 */
 				if (!fd || !fd->plugin || !fd->context) {
-					_queue_for_deletion(ele);
-					return true;
+					_destroy_element(ele);
+					return;
 				}
 
 				/*
-				 *  If an event is disabled, ignore it.
+				 * If an event is disabled, drop it from the ready list until
+				 * it becomes enabled.
 				 */
 				if (Kqueue_flags::Disable::get(ele.flags))
-					return true;
+					return;
+
+				bool reported = false;
+
+				/*
+				 * A hangup is reported as EV_EOF, an error in addition
+				 * with 'fflags' set, as done for sockets by FreeBSD
+				 */
+				auto report = [&] (short revents) {
+					eventlist[num_events] = ele;
+					eventlist[num_events].flags  = (revents & (POLLHUP | POLLERR))
+					                             ? EV_EOF : 0;
+					eventlist[num_events].fflags = (revents & POLLERR) ? EIO : 0;
+					num_events++;
+					reported = true;
+				};
+
+				bool const vfs = Libc::vfs_file_descriptor(fd);
 
 				/*
 				 * Right now we do not support tracking newly available read data via
@@ -409,41 +601,91 @@ struct Libc::Kqueue
 				 * client sets EV_CLEAR and does not read the available data after receiving
 				 * a kevent, this will lead to extraneous kevents for the already existing data.
 				 */
+				bool check_again = true;
+
 				switch (ele.filter) {
 				case EVFILT_READ:
-					if (Libc::read_ready_from_kernel(fd)) {
-						eventlist[num_events] = ele;
-						eventlist[num_events].flags = 0;
-						num_events++;
-					} else {
-						Libc::notify_read_ready_from_kernel(fd);
+					{
+						if (!vfs) {
+							short const revents = _poll(*fd, POLLIN);
+							if (revents & (POLLIN | POLLHUP | POLLERR)) {
+								report(revents);
+								break;
+							}
+						} else if (Libc::read_ready_from_kernel(fd)) {
+							report(0);
+							break;
+						}
+
+						/*
+						 * Wait for the read-ready response. Check again if
+						 * the data arrived in the meantime.
+						 */
+						File_descriptor * const ready_fd = Kqueue_element::read_ready_fd(fd);
+						if (ready_fd && ele.redirect_handler(ready_fd)) {
+							Libc::notify_read_ready_from_kernel(ready_fd);
+							check_again = Libc::read_ready_from_kernel(ready_fd);
+						}
 					}
 					break;
 				case EVFILT_WRITE:
-					if (Libc::write_ready_from_kernel(fd)) {
-						eventlist[num_events] = ele;
-						eventlist[num_events].flags = 0;
-						num_events++;
-					}
+					if (!vfs) {
+						short const revents = _poll(*fd, POLLOUT);
+						if (revents & (POLLOUT | POLLHUP | POLLERR))
+							report(revents);
+					} else if (Libc::write_ready_from_kernel(fd))
+						report(0);
+
+					/* wait for the next write to the file descriptor */
+					check_again = !reported;
 					break;
 				default:
 					assert(false && "Element with unknown filter inserted");
 				}
 
 				/* Delete oneshot event */
-				if (Kqueue_flags::Oneshot::get(ele.flags))
-					_queue_for_deletion(ele);
+				if (reported && Kqueue_flags::Oneshot::get(ele.flags)) {
+					_destroy_element(ele);
+					return;
+				}
 
-				return num_events < nevents;
+				/* Disable dispatched event until it is enabled again */
+				if (reported && Kqueue_flags::Dispatch::get(ele.flags)) {
+					Kqueue_flags::Enable::clear((Kqueue_flags::access_t &)ele.flags);
+					Kqueue_flags::Disable::set((Kqueue_flags::access_t &)ele.flags);
+					return;
+				}
+
+				Mutex::Guard guard(_ready_mutex);
+
+				if (check_again && !ele.Fifo<Kqueue_element>::Element::enqueued())
+					level_triggered.enqueue(ele);
 			};
 
 			{
 				Mutex::Guard guard(_requests_mutex);
-				_requests.with_all_elements(check_fn);
 
-			}
+				{
+					Mutex::Guard ready_guard(_ready_mutex);
+					_move(_ready, pending);
+				}
+
+				while (num_events < nevents) {
+					Kqueue_element *ele_ptr = nullptr;
+					{
+						Mutex::Guard ready_guard(_ready_mutex);
+						pending.dequeue([&] (Kqueue_element &ele) { ele_ptr = &ele; });
+					}
+					if (!ele_ptr)
+						break;
 
-			_delete_elements();
+					check_fn(*ele_ptr);
+				}
+
+				Mutex::Guard ready_guard(_ready_mutex);
+				_move(pending, _ready);
+				_move(level_triggered, _ready);
+			}
 
 			if (mode != Mode::POLL && num_events == 0)
 				return Monitor::Function_result::INCOMPLETE;
@@ -485,7 +727,7 @@ static Kqueue_plugin *kqueue_plugin()
 
 int Libc::Kqueue_plugin::create_kqueue()
 {
-	Kqueue *kq = new (_alloc) Kqueue(_alloc);
+	Kqueue *kq = new (_alloc) Registered_no_delete<Kqueue>(_kqueues(), _alloc);
 
 	Plugin_context *context = reinterpret_cast<Libc::Plugin_context *>(kq);
 	File_descriptor *fd =
@@ -501,8 +743,8 @@ int Libc::Kqueue_plugin::close(File_descriptor *fd)
 		return -1;
 
 	if (fd->context)
-		_alloc.free(fd->context, sizeof(Kqueue));
-
+		destroy(_alloc, static_cast<Registered_no_delete<Kqueue> *>(
+			reinterpret_cast<Kqueue *>(fd->context)));
 
 	file_descriptor_allocator()->free(fd);
 
@@ -563,3 +805,25 @@ int kqueue(void)
 {
 	return kqueue_plugin()->create_kqueue();
 }
+
+
+void Libc::remove_kevents(int libc_fd)
+{
+	_kqueues().for_each([&] (Kqueue &kq) { kq.remove_events(uintptr_t(libc_fd)); });
+}
+
+
+void Libc::rearm_write_kevents(int libc_fd)
+{
+	_kqueues().for_each([&] (Kqueue &kq) { kq.rearm_write_event(uintptr_t(libc_fd)); });
+}
+
+
+bool Libc::kevent_registered(int kq_fd, uintptr_t ident)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(kq_fd);
+	if (!fd || fd->plugin != kqueue_plugin())
+		return false;
+
+	return reinterpret_cast<Kqueue *>(fd->context)->registered(ident);
+}
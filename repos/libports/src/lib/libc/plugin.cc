@@ -15,6 +15,7 @@
 #include <base/log.h>
 
 /* local includes */
+#include <internal/errno.h>
 #include <internal/fd_alloc.h>
 #include <internal/plugin_registry.h>
 #include <internal/plugin.h>
@@ -197,6 +198,16 @@ DUMMY(int,     -1, enqueue_aiocb, (File_descriptor *, const struct aiocb *));
 DUMMY(int,     -1, wait_aio,      (File_descriptor *, int));
 
 
+/*
+ * Unlike the dummies above, 'transfer' sets errno because 'sendfile'
+ * reports it to the application
+ */
+ssize_t Plugin::transfer(File_descriptor *, ::off_t, File_descriptor *, ::size_t)
+{
+	return Errno(EINVAL);
+}
+
+
 /*
  * Misc
  */
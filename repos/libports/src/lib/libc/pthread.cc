@@ -15,17 +15,18 @@
 /* Genode includes */
 #include <base/log.h>
 #include <base/thread.h>
+#include <cpu_thread/client.h>
 #include <util/list.h>
 #include <libc/allocator.h>
 
 /* libc includes */
 #include <errno.h>
 #include <pthread.h>
-#include <semaphore.h>
 #include <stdio.h>  /* __isthreaded */
 #include <stdlib.h> /* malloc, free */
 
 /* libc-internal includes */
+#include <internal/futex.h>
 #include <internal/init.h>
 #include <internal/kernel.h>
 #include <internal/pthread.h>
@@ -85,6 +86,9 @@ void Libc::Pthread::Thread_object::entry()
 
 	_tls_pointer(&info, _pthread);
 
+	/* a thread taken from the worker pool resumes here */
+	_setjmp(_restart_env);
+
 	pthread_exit(_start_routine(_arg));
 }
 
@@ -168,6 +172,47 @@ void Libc::Pthread::cancel()
 }
 
 
+bool Libc::Pthread::release()
+{
+	/*
+	 * Unblock the exited thread like a detached one so that it can enter
+	 * the worker pool. A thread that was merely cancelled is still running
+	 * its start routine and must be destroyed.
+	 */
+	if (!pthread_worker_pool().enabled() || !_exited)
+		return false;
+
+	_detach_blockade.wakeup();
+	return true;
+}
+
+
+void Libc::Pthread::restart(start_routine_t start_routine, void *arg)
+{
+	_thread_object->assign(start_routine, arg);
+
+	_exiting           = false;
+	_exited            = false;
+	_retval            = PTHREAD_CANCELED;
+	thread_local_errno = 0;
+
+	for (void const *&data : _tls_data)
+		data = nullptr;
+
+	_restart_blockade.wakeup();
+}
+
+
+void Libc::Pthread::migrate(Affinity::Location location, unsigned cpu)
+{
+	Thread_capability const cap = _thread.cap();
+	if (cap.valid())
+		Cpu_thread_client(cap).affinity(location);
+
+	_cpu = cpu;
+}
+
+
 /*
  * Cleanup
  */
@@ -193,6 +238,55 @@ Libc::Pthread_cleanup &pthread_cleanup()
 }
 
 
+/*
+ * Worker pool
+ */
+
+bool Libc::Pthread_worker_pool::park(Pthread &myself)
+{
+	{
+		Mutex::Guard guard(_mutex);
+
+		if (_num_idle >= _max_idle)
+			return false;
+
+		myself._next_idle = _idle;
+		_idle = &myself;
+		_num_idle++;
+	}
+
+	myself._restart_blockade.block();
+	return true;
+}
+
+
+Libc::Pthread *Libc::Pthread_worker_pool::take(size_t stack_size)
+{
+	Mutex::Guard guard(_mutex);
+
+	for (Pthread **p = &_idle; *p; p = &(*p)->_next_idle) {
+
+		Pthread &pthread = **p;
+
+		if (pthread._stack_request < stack_size)
+			continue;
+
+		*p = pthread._next_idle;
+		pthread._next_idle = nullptr;
+		_num_idle--;
+		return &pthread;
+	}
+	return nullptr;
+}
+
+
+Libc::Pthread_worker_pool &pthread_worker_pool()
+{
+	static Libc::Pthread_worker_pool instance;
+	return instance;
+}
+
+
 /***********
  ** Mutex **
  ***********/
@@ -217,102 +311,26 @@ struct pthread_mutex_attr { pthread_mutextype type; };
  */
 class pthread_mutex : Genode::Noncopyable
 {
-	private:
-
-		struct Applicant : Genode::Noncopyable
-	{
-		pthread_t const thread;
-
-		Applicant *next { nullptr };
-
-		Libc::Blockade &blockade;
-
-		Applicant(pthread_t thread, Libc::Blockade &blockade)
-		: thread(thread), blockade(blockade)
-		{ }
-	};
-
-		Applicant *_applicants { nullptr };
-
 	protected:
 
-		pthread_t _owner      { nullptr };
-		Mutex     _data_mutex;
-
-		/* _data_mutex must be hold when calling the following methods */
-
-		void _append_applicant(Applicant *applicant)
-		{
-			Applicant **tail = &_applicants;
-
-			for (; *tail; tail = &(*tail)->next) ;
-
-			*tail = applicant;
-		}
-
-		void _remove_applicant(Applicant *applicant)
-		{
-			Applicant **a = &_applicants;
-
-			for (; *a && *a != applicant; a = &(*a)->next) ;
-
-			*a = applicant->next;
-		}
-
-		void _next_applicant_to_owner()
-		{
-			if (Applicant *next = _applicants) {
-				_remove_applicant(next);
-				_owner = next->thread;
-				next->blockade.wakeup();
-			} else {
-				_owner = nullptr;
-			}
-		}
-
-		bool _applicant_for_mutex(pthread_t thread, Libc::Blockade &blockade)
-		{
-			Applicant applicant { thread, blockade };
-
-			_append_applicant(&applicant);
-
-			_data_mutex.release();
-
-			blockade.block();
-
-			_data_mutex.acquire();
-
-			if (blockade.woken_up()) {
-				return true;
-			} else {
-				_remove_applicant(&applicant);
-				return false;
-			}
-		}
-
-		struct Missing_call_of_init_pthread_support : Exception { };
-
-		Timer_accessor & _timer_accessor()
-		{
-			if (!_timer_accessor_ptr)
-				throw Missing_call_of_init_pthread_support();
-			return *_timer_accessor_ptr;
-		}
+		Futex_mutex _lock  { };
+		pthread_t   _owner { nullptr };
 
 		/**
-		 * Enqueue current context as applicant for mutex
+		 * Acquire '_lock' until 'abs_timeout'
 		 *
-		 * Return true if mutex was acquired, false on timeout expiration.
+		 * Return true if the lock was acquired, false on timeout expiration.
 		 */
-		bool _apply_for_mutex(pthread_t thread, Libc::uint64_t timeout_ms)
+		bool _lock_timed(timespec const &abs_timeout)
 		{
-			if (Libc::Kernel::kernel().main_context()) {
-				Main_blockade blockade { timeout_ms };
-				return _applicant_for_mutex(thread, blockade);
-			} else {
-				Pthread_blockade blockade { _timer_accessor(), timeout_ms };
-				return _applicant_for_mutex(thread, blockade);
-			}
+			/* fast path without lock contention - does not check abstimeout according to spec */
+			if (_lock.try_lock())
+				return true;
+
+			return _lock.lock([&] {
+				timespec abs_now;
+				clock_gettime(CLOCK_REALTIME, &abs_now);
+				return calculate_relative_timeout_ms(abs_now, abs_timeout); });
 		}
 
 	public:
@@ -335,28 +353,12 @@ class pthread_mutex : Genode::Noncopyable
 
 struct Libc::Pthread_mutex_normal : pthread_mutex
 {
-	/* unsynchronized try */
-	int _try_lock(pthread_t thread)
-	{
-		if (!_owner) {
-			_owner = thread;
-			return 0;
-		}
-
-		return EBUSY;
-	}
-
 	int lock() override final
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
-
-		/* fast path without lock contention */
-		if (_try_lock(myself) == 0)
-			return 0;
-
-		_apply_for_mutex(myself, 0);
+		_lock.lock();
+		_owner = myself;
 
 		return 0;
 	}
@@ -365,42 +367,33 @@ struct Libc::Pthread_mutex_normal : pthread_mutex
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
-
-		/* fast path without lock contention - does not check abstimeout according to spec */
-		if (_try_lock(myself) == 0)
-			return 0;
-
-		timespec abs_now;
-		clock_gettime(CLOCK_REALTIME, &abs_now);
-
-		uint64_t const timeout_ms = calculate_relative_timeout_ms(abs_now, abs_timeout);
-		if (!timeout_ms)
+		if (!_lock_timed(abs_timeout))
 			return ETIMEDOUT;
 
-		if (_apply_for_mutex(myself, timeout_ms))
-			return 0;
-		else
-			return ETIMEDOUT;
+		_owner = myself;
+
+		return 0;
 	}
 
 	int trylock() override final
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
+		if (!_lock.try_lock())
+			return EBUSY;
+
+		_owner = myself;
 
-		return _try_lock(myself);
+		return 0;
 	}
 
 	int unlock() override final
 	{
-		Mutex::Guard guard(_data_mutex);
-
 		if (_owner != pthread_self())
 			return EPERM;
 
-		_next_applicant_to_owner();
+		_owner = nullptr;
+		_lock.unlock();
 
 		return 0;
 	}
@@ -409,29 +402,20 @@ struct Libc::Pthread_mutex_normal : pthread_mutex
 
 struct Libc::Pthread_mutex_errorcheck : pthread_mutex
 {
-	/* unsynchronized try */
-	int _try_lock(pthread_t thread)
-	{
-		if (!_owner) {
-			_owner = thread;
-			return 0;
-		}
-
-		return _owner == thread ? EDEADLK : EBUSY;
-	}
+	/*
+	 * Only the calling thread itself can have stored 'myself' as owner.
+	 * Hence, the unsynchronized comparison is safe.
+	 */
 
 	int lock() override final
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
-
-		/* fast path without lock contention (or deadlock) */
-		int const result = _try_lock(myself);
-		if (!result || result == EDEADLK)
-			return result;
+		if (_owner == myself)
+			return EDEADLK;
 
-		_apply_for_mutex(myself, 0);
+		_lock.lock();
+		_owner = myself;
 
 		return 0;
 	}
@@ -446,19 +430,24 @@ struct Libc::Pthread_mutex_errorcheck : pthread_mutex
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
+		if (_owner == myself)
+			return EDEADLK;
 
-		return _try_lock(myself);
+		if (!_lock.try_lock())
+			return EBUSY;
+
+		_owner = myself;
+
+		return 0;
 	}
 
 	int unlock() override final
 	{
-		Mutex::Guard guard(_data_mutex);
-
 		if (_owner != pthread_self())
 			return EPERM;
 
-		_next_applicant_to_owner();
+		_owner = nullptr;
+		_lock.unlock();
 
 		return 0;
 	}
@@ -469,31 +458,17 @@ struct Libc::Pthread_mutex_recursive : pthread_mutex
 {
 	unsigned _nesting_level { 0 };
 
-	/* unsynchronized try */
-	int _try_lock(pthread_t thread)
-	{
-		if (!_owner) {
-			_owner = thread;
-			return 0;
-		} else if (_owner == thread) {
-			++_nesting_level;
-			return 0;
-		}
-
-		return EBUSY;
-	}
-
 	int lock() override final
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
-
-		/* fast path without lock contention */
-		if (_try_lock(myself) == 0)
+		if (_owner == myself) {
+			++_nesting_level;
 			return 0;
+		}
 
-		_apply_for_mutex(myself, 0);
+		_lock.lock();
+		_owner = myself;
 
 		return 0;
 	}
@@ -507,37 +482,37 @@ struct Libc::Pthread_mutex_recursive : pthread_mutex
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
+		if (_owner == myself) {
+			++_nesting_level;
+			return 0;
+		}
+
+		if (!_lock.try_lock())
+			return EBUSY;
+
+		_owner = myself;
 
-		return _try_lock(myself);
+		return 0;
 	}
 
 	int unlock() override final
 	{
-		Mutex::Guard guard(_data_mutex);
-
 		if (_owner != pthread_self())
 			return EPERM;
 
-		if (_nesting_level == 0)
-			_next_applicant_to_owner();
-		else
+		if (_nesting_level > 0) {
 			--_nesting_level;
+			return 0;
+		}
+
+		_owner = nullptr;
+		_lock.unlock();
 
 		return 0;
 	}
 };
 
 
-/*
- * The pthread_cond implementation uses the POSIX semaphore API
- * internally that does not have means to set the clock. For this
- * reason the private 'sem_set_clock' function is introduced,
- * see 'semaphore.cc' for the implementation.
-*/
-extern "C" int sem_set_clock(sem_t *sem, clockid_t clock_id);
-
-
 /* TLS */
 
 class Key_allocator : public Genode::Bit_allocator<PTHREAD_KEYS_MAX>
@@ -643,6 +618,9 @@ extern "C" {
 	{
 		thread->join(retval);
 
+		if (thread->release())
+			return 0;
+
 		Libc::Allocator alloc { };
 		destroy(alloc, thread);
 
@@ -1081,40 +1059,42 @@ extern "C" {
 
 
 	/*
-	 * Implementation based on
-	 * http://web.archive.org/web/20010914175514/http://www-classic.be.com/aboutbe/benewsletter/volume_III/Issue40.html#Workshop
+	 * The condition variable is a sequence counter used as futex word.
+	 * A waiter samples the counter before releasing the mutex and blocks
+	 * as long as the counter remains unchanged. Signalling increments the
+	 * counter, which prevents lost wake-ups without a handshake between
+	 * signaller and waiter.
 	 */
 
-	struct pthread_cond
+	struct pthread_cond : Genode::Noncopyable
 	{
-		int             num_waiters;
-		int             num_signallers;
-		pthread_mutex_t counter_mutex;
-		sem_t           signal_sem;
-		sem_t           handshake_sem;
+		int volatile    sequence { 0 };
+		Futex           futex    { };
+		clockid_t const clock_id;
 
 		struct Invalid_timedwait_clock { };
 
-		void _cleanup()
+		static clockid_t _checked(clockid_t clock_id)
 		{
-			sem_destroy(&handshake_sem);
-			sem_destroy(&signal_sem);
-			pthread_mutex_destroy(&counter_mutex);
+			if (clock_id != CLOCK_REALTIME && clock_id != CLOCK_MONOTONIC)
+				throw Invalid_timedwait_clock();
+
+			return clock_id;
 		}
 
-		pthread_cond(clockid_t clock_id) : num_waiters(0), num_signallers(0)
-		{
-			pthread_mutex_init(&counter_mutex, nullptr);
-			sem_init(&signal_sem, 0, 0);
-			sem_init(&handshake_sem, 0, 0);
+		pthread_cond(clockid_t clock_id) : clock_id(_checked(clock_id)) { }
 
-			if (sem_set_clock(&signal_sem, clock_id)) {
-				_cleanup();
-				throw Invalid_timedwait_clock();
-			}
+		void signal()
+		{
+			atomic_add(sequence, 1);
+			futex.wake(1);
 		}
 
-		~pthread_cond() { _cleanup(); }
+		void broadcast()
+		{
+			atomic_add(sequence, 1);
+			futex.wake_all();
+		}
 	};
 
 
@@ -1235,39 +1215,22 @@ extern "C" {
 
 		pthread_cond *c = *cond;
 
-		pthread_mutex_lock(&c->counter_mutex);
-		c->num_waiters++;
-		pthread_mutex_unlock(&c->counter_mutex);
+		int const sequence = c->sequence;
 
 		pthread_mutex_unlock(mutex);
 
 		if (!abstime) {
-			if (sem_wait(&c->signal_sem) == -1)
-				result = errno;
+			c->futex.wait(c->sequence, sequence, 0);
 		} else {
-			if (sem_timedwait(&c->signal_sem, abstime) == -1)
-				result = errno;
-		}
+			timespec abs_now;
+			clock_gettime(c->clock_id, &abs_now);
 
-		pthread_mutex_lock(&c->counter_mutex);
-		if (c->num_signallers > 0) {
-			if (result == ETIMEDOUT) {
-				/*
-				 * Another thread may have called pthread_cond_signal(),
-				 * detected this waiter and posted 'signal_sem' concurrently.
-				 *
-				 * We can't consume this post by 'sem_wait(&c->signal_sem)'
-				 * because a third thread may have consumed the post already
-				 * above in sem_wait/timedwait(). So, we just do nothing here
-				 * and accept the spurious wakeup on next
-				 * pthread_cond_wait/timedwait().
-				 */
-			}
-			sem_post(&c->handshake_sem);
-			--c->num_signallers;
+			Libc::uint64_t const timeout_ms =
+				calculate_relative_timeout_ms(abs_now, *abstime);
+
+			if (!timeout_ms || !c->futex.wait(c->sequence, sequence, timeout_ms))
+				result = ETIMEDOUT;
 		}
-		c->num_waiters--;
-		pthread_mutex_unlock(&c->counter_mutex);
 
 		pthread_mutex_lock(mutex);
 
@@ -1296,16 +1259,7 @@ extern "C" {
 		if (*cond == PTHREAD_COND_INITIALIZER)
 			cond_init(cond, NULL);
 
-		pthread_cond *c = *cond;
-
-		pthread_mutex_lock(&c->counter_mutex);
-		if (c->num_waiters > c->num_signallers) {
-			++c->num_signallers;
-			sem_post(&c->signal_sem);
-			pthread_mutex_unlock(&c->counter_mutex);
-			sem_wait(&c->handshake_sem);
-		} else
-			pthread_mutex_unlock(&c->counter_mutex);
+		(*cond)->signal();
 
 		return 0;
 	}
@@ -1322,19 +1276,7 @@ extern "C" {
 		if (*cond == PTHREAD_COND_INITIALIZER)
 			cond_init(cond, NULL);
 
-		pthread_cond *c = *cond;
-
-		pthread_mutex_lock(&c->counter_mutex);
-		if (c->num_waiters > c->num_signallers) {
-			int still_waiting = c->num_waiters - c->num_signallers;
-			c->num_signallers = c->num_waiters;
-			for (int i = 0; i < still_waiting; i++)
-				sem_post(&c->signal_sem);
-			pthread_mutex_unlock(&c->counter_mutex);
-			for (int i = 0; i < still_waiting; i++)
-				sem_wait(&c->handshake_sem);
-		} else
-			pthread_mutex_unlock(&c->counter_mutex);
+		(*cond)->broadcast();
 
 		return 0;
 	}
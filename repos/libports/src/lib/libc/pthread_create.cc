@@ -22,7 +22,9 @@
 /* libc includes */
 #include <libc/allocator.h>
 #include <errno.h>
+#include <pthread_np.h>
 #include <stdio.h> /* __isthreaded */
+#include <sys/cpuset.h>
 
 /* libc-internal includes */
 #include <internal/init.h>
@@ -112,6 +114,8 @@ void Libc::init_pthread_support(Genode::Env &env, Node const &node,
 	                                                    String<32>("all-cpus"));
 	placement_policy().policy(policy_name);
 
+	pthread_worker_pool().max_idle(node.attribute_value("pool", 0U));
+
 	node.for_each_sub_node("thread", [&] (Node const &policy) {
 
 		if (policy.has_attribute("id") && policy.has_attribute("cpu")) {
@@ -127,6 +131,34 @@ void Libc::init_pthread_support(Genode::Env &env, Node const &node,
 }
 
 
+/**
+ * Select CPU for a thread restricted to the CPUs of 'cpuset'
+ *
+ * A Genode thread executes on exactly one CPU. If 'preferred' is part of the
+ * set, it is kept. Otherwise, the first CPU of the set is selected.
+ *
+ * \return false if the set contains no CPU of the affinity space
+ */
+static bool cpu_of_cpuset(cpuset_t const &cpuset, Affinity::Space const &space,
+                          unsigned preferred, unsigned &cpu)
+{
+	unsigned const num_cpus = min(space.total(), (unsigned)CPU_SETSIZE);
+
+	if (preferred < num_cpus && CPU_ISSET(preferred, &cpuset)) {
+		cpu = preferred;
+		return true;
+	}
+
+	for (unsigned i = 0; i < num_cpus; i++) {
+		if (CPU_ISSET(i, &cpuset)) {
+			cpu = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+
 static unsigned pthread_id()
 {
 	static Mutex mutex;
@@ -144,11 +176,25 @@ static int pthread_create_from_env(Genode::Env &env, pthread_t *thread,
                                    void *arg,
                                    size_t stack_size,
                                    char const *name,
-                                   Affinity::Location location)
+                                   Affinity::Location location,
+                                   unsigned cpu)
 {
+	/* prefer a parked thread of the worker pool over creating a new one */
+	if (Libc::Pthread *idle = pthread_worker_pool().take(stack_size)) {
+
+		if (idle->cpu() != cpu)
+			idle->migrate(location, cpu);
+
+		*thread = static_cast<pthread_t>(idle);
+
+		idle->restart(start_routine, arg);
+
+		return 0;
+	}
+
 	Libc::Allocator alloc { };
 	pthread_t thread_obj = new (alloc)
-		pthread(env, start_routine, arg, stack_size, name, location);
+		pthread(env, start_routine, arg, stack_size, name, location, cpu);
 	if (!thread_obj)
 		return EAGAIN;
 
@@ -190,10 +236,16 @@ int Libc::pthread_create(pthread_t *thread, const pthread_attr_t *attr,
 	                        : Libc::Component::stack_size();
 
 	unsigned const id { pthread_id() };
-	unsigned const cpu = placement_policy().placement(id);
 
-	String<32> const pthread_name { "pthread.", id };
 	Affinity::Space space { _geneode_env->cpu().affinity_space() };
+
+	/* an affinity defined via the attributes overrides the placement policy */
+	unsigned cpu = placement_policy().placement(id) % max(space.total(), 1U);
+	if (attr && *attr && (*attr)->cpuset_defined)
+		if (!cpu_of_cpuset((*attr)->cpuset, space, cpu, cpu))
+			return EINVAL;
+
+	String<32> const pthread_name { "pthread.", id };
 	Affinity::Location location { space.location_of_index(cpu) };
 
 	if (_verbose)
@@ -203,7 +255,7 @@ int Libc::pthread_create(pthread_t *thread, const pthread_attr_t *attr,
 		pthread_create_from_env(*_geneode_env, thread, start_routine,
 		                        arg, stack_size,
 		                        name ? : pthread_name.string(),
-		                        location);
+		                        location, cpu);
 
 	if ((result == 0) && attr && *attr &&
 	    ((*attr)->detach_state == PTHREAD_CREATE_DETACHED))
@@ -213,6 +265,71 @@ int Libc::pthread_create(pthread_t *thread, const pthread_attr_t *attr,
 }
 
 
+extern "C" int pthread_setaffinity_np(pthread_t thread, size_t cpusetsize,
+                                      const cpuset_t *cpuset)
+{
+	if (!_geneode_env || !thread || !cpuset || cpusetsize < sizeof(cpuset_t))
+		return EINVAL;
+
+	Affinity::Space const space { _geneode_env->cpu().affinity_space() };
+
+	unsigned cpu = 0;
+	if (!cpu_of_cpuset(*cpuset, space, thread->cpu(), cpu))
+		return EINVAL;
+
+	if (cpu == thread->cpu())
+		return 0;
+
+	if (_verbose)
+		log("migrate pthread ", (void *)thread, " -> cpu ", cpu);
+
+	thread->migrate(space.location_of_index(cpu), cpu);
+	return 0;
+}
+
+
+extern "C" int pthread_getaffinity_np(pthread_t thread, size_t cpusetsize,
+                                      cpuset_t *cpuset)
+{
+	if (!thread || !cpuset || cpusetsize < sizeof(cpuset_t))
+		return EINVAL;
+
+	CPU_ZERO(cpuset);
+	CPU_SET(thread->cpu(), cpuset);
+	return 0;
+}
+
+
+extern "C" int pthread_attr_setaffinity_np(pthread_attr_t *attr, size_t cpusetsize,
+                                           const cpuset_t *cpuset)
+{
+	if (!attr || !*attr || cpusetsize < sizeof(cpuset_t))
+		return EINVAL;
+
+	/* a null set restores the default placement */
+	(*attr)->cpuset_defined = (cpuset != nullptr);
+	if (cpuset)
+		CPU_COPY(cpuset, &(*attr)->cpuset);
+
+	return 0;
+}
+
+
+extern "C" int pthread_attr_getaffinity_np(const pthread_attr_t *attr, size_t cpusetsize,
+                                           cpuset_t *cpuset)
+{
+	if (!attr || !*attr || !cpuset || cpusetsize < sizeof(cpuset_t))
+		return EINVAL;
+
+	if ((*attr)->cpuset_defined)
+		CPU_COPY(&(*attr)->cpuset, cpuset);
+	else
+		CPU_FILL(cpuset);
+
+	return 0;
+}
+
+
 extern "C" int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
                               void *(*start_routine) (void *), void *arg)
 {
@@ -14,8 +14,6 @@
 
 /* Genode includes */
 #include <base/log.h>
-#include <base/mutex.h>
-#include <base/semaphore.h>
 #include <base/thread.h>
 #include <libc/allocator.h>
 
@@ -24,17 +22,15 @@
 #include <pthread.h>
 
 /* libc-internal includes */
+#include <internal/futex.h>
 #include <internal/types.h>
 
 using namespace Libc;
 
 
 /*
- * A reader-preferring implementation of a readers-writer lock as described
- * in Michael Raynal, "Concurrent Programming: Algorithms, Principles, and
- * Foundations", ISBN 978-3-642-32026-2, page 75
- *
- * https://books.google.com/books?id=0a1AAAAAQBAJ&pg=PA75 
+ * A reader-preferring readers-writer lock based on a futex word that holds
+ * the number of readers or 'WRITER' if the lock is held by a writer
  */
 
 extern "C" {
@@ -43,41 +39,68 @@ extern "C" {
 	 * This class is named 'struct pthread_rwlock' because the 'pthread_rwlock_t'
 	 * type is defined as 'struct rwlock*' in 'sys/_pthreadtypes.h'
 	 */
-	struct pthread_rwlock
+	struct pthread_rwlock : Genode::Noncopyable
 	{
 		private:
 
-			Thread    *_owner      { nullptr };
-			Mutex      _nbr_mutex  { };
-			Semaphore  _global_sem { 1 };
-			int        _nbr        { 0 };
+			enum { WRITER = -1 };
+
+			Thread       *_owner { nullptr };
+			int volatile  _state { 0 };
+			Futex         _futex { };
 
 		public:
 
-			void rdlock()
+			bool tryrdlock()
 			{
-				Mutex::Guard guard(_nbr_mutex);
-				++_nbr;
-				if (_nbr == 1) {
-					_global_sem.down();
-					_owner = nullptr;
+				for (;;) {
+					int const readers = _state;
+					if (readers == WRITER)
+						return false;
+
+					if (Genode::cmpxchg(&_state, readers, readers + 1))
+						return true;
 				}
 			}
 
-			void wrlock()
+			bool trywrlock()
 			{
-				_global_sem.down();
+				if (!Genode::cmpxchg(&_state, 0, WRITER))
+					return false;
+
 				_owner = Thread::myself();
+				return true;
+			}
+
+			void rdlock()
+			{
+				if (tryrdlock() || Futex::spin([&] { return tryrdlock(); }))
+					return;
+
+				while (!tryrdlock())
+					_futex.wait(_state, WRITER, 0);
+			}
+
+			void wrlock()
+			{
+				if (trywrlock() || Futex::spin([&] { return trywrlock(); }))
+					return;
+
+				for (;;) {
+					int const state = _state;
+					if (state == 0 && trywrlock())
+						return;
+
+					_futex.wait(_state, state, 0);
+				}
 			}
 
 			int unlock()
 			{
 				/* Read lock */
 				if (_owner == nullptr) {
-					Mutex::Guard guard(_nbr_mutex);
-					_nbr--;
-					if (_nbr == 0)
-						_global_sem.up();
+					if (atomic_add(_state, -1) == 0)
+						_futex.wake_all();
 					return 0;
 				}
 
@@ -89,7 +112,8 @@ extern "C" {
 
 				/* Write lock owned by us */
 				_owner = nullptr;
-				_global_sem.up();
+				atomic_exchange(_state, 0);
+				_futex.wake_all();
 				return 0;
 			}
 	};
@@ -187,6 +211,36 @@ extern "C" {
 		__attribute__((alias("pthread_rwlock_unlock")));
 
 
+	int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
+	{
+		if (!rwlock)
+			return EINVAL;
+
+		if (*rwlock == PTHREAD_RWLOCK_INITIALIZER)
+			rwlock_init(rwlock, NULL);
+
+		return (*rwlock)->tryrdlock() ? 0 : EBUSY;
+	}
+
+	typeof(pthread_rwlock_tryrdlock) _pthread_rwlock_tryrdlock
+		__attribute__((alias("pthread_rwlock_tryrdlock")));
+
+
+	int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
+	{
+		if (!rwlock)
+			return EINVAL;
+
+		if (*rwlock == PTHREAD_RWLOCK_INITIALIZER)
+			rwlock_init(rwlock, NULL);
+
+		return (*rwlock)->trywrlock() ? 0 : EBUSY;
+	}
+
+	typeof(pthread_rwlock_trywrlock) _pthread_rwlock_trywrlock
+		__attribute__((alias("pthread_rwlock_trywrlock")));
+
+
 	int pthread_rwlockattr_init(pthread_rwlockattr_t *attr)
 	{
 		Libc::Allocator alloc { };
@@ -224,7 +278,5 @@ extern "C" {
 	 * Unimplemented functions:
 	 *  int pthread_rwlock_timedrdlock(pthread_rwlock_t *, const struct timespec *);
 	 *  int pthread_rwlock_timedwrlock(pthread_rwlock_t *, const struct timespec *);
-	 *  int pthread_rwlock_tryrdlock(pthread_rwlock_t *);
-	 *  int pthread_rwlock_trywrlock(pthread_rwlock_t *);
 	 */
 }
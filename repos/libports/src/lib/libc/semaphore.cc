@@ -25,24 +25,13 @@
 
 /* libc-internal includes */
 #include <internal/errno.h>
-#include <internal/init.h>
-#include <internal/kernel.h>
-#include <internal/monitor.h>
+#include <internal/futex.h>
 #include <internal/time.h>
 #include <internal/types.h>
 
 using namespace Libc;
 
 
-static Timer_accessor *_timer_accessor_ptr;
-
-
-void Libc::init_semaphore_support(Timer_accessor &timer_accessor)
-{
-	_timer_accessor_ptr = &timer_accessor;
-}
-
-
 /*
  * This class is named 'struct sem' because the 'sem_t' type is
  * defined as 'struct sem*' in 'semaphore.h'
@@ -51,106 +40,24 @@ struct sem : Genode::Noncopyable
 {
 	private:
 
-		struct Applicant : Genode::Noncopyable
-		{
-			Applicant *next { nullptr };
-
-			Libc::Blockade &blockade;
-
-			Applicant(Libc::Blockade &blockade) : blockade(blockade) { }
-		};
-
-		Applicant *_applicants { nullptr };
-		int        _count;
-		Mutex      _data_mutex;
-
-		clockid_t  _clock_id { CLOCK_REALTIME };
-
-		/* _data_mutex must be hold when calling the following methods */
-
-		void _append_applicant(Applicant *applicant)
-		{
-			Applicant **tail = &_applicants;
-
-			for (; *tail; tail = &(*tail)->next) ;
-
-			*tail = applicant;
-		}
-
-		void _remove_applicant(Applicant *applicant)
-		{
-			Applicant **a = &_applicants;
-
-			for (; *a && *a != applicant; a = &(*a)->next) ;
-
-			*a = applicant->next;
-		}
-
-		void _count_up()
-		{
-			if (Applicant *next = _applicants) {
-				_remove_applicant(next);
-				next->blockade.wakeup();
-			} else {
-				++_count;
-			}
-		}
-
-		bool _applicant_for_semaphore(Libc::Blockade &blockade)
-		{
-			Applicant applicant { blockade };
-
-			_append_applicant(&applicant);
-
-			_data_mutex.release();
-
-			blockade.block();
+		/* futex word holding the semaphore counter */
+		int volatile _count;
 
-			_data_mutex.acquire();
+		Futex _futex { };
 
-			if (blockade.woken_up()) {
-				return true;
-			} else {
-				_remove_applicant(&applicant);
-				return false;
-			}
-		}
-
-		struct Missing_call_of_init_semaphore_support : Exception { };
-
-		Timer_accessor & _timer_accessor()
+		int _try_down()
 		{
-			if (!_timer_accessor_ptr)
-				throw Missing_call_of_init_semaphore_support();
-			return *_timer_accessor_ptr;
-		}
+			for (;;) {
+				int const count = _count;
+				if (count <= 0)
+					return EBUSY;
 
-		/**
-		 * Enqueue current context as applicant for semaphore
-		 *
-		 * Return true if down was successful, false on timeout expiration.
-		 */
-		bool _apply_for_semaphore(Libc::uint64_t timeout_ms)
-		{
-			if (Libc::Kernel::kernel().main_context()) {
-				Main_blockade blockade { timeout_ms };
-				return _applicant_for_semaphore(blockade);
-			} else {
-				Pthread_blockade blockade { _timer_accessor(), timeout_ms };
-				return _applicant_for_semaphore(blockade);
+				if (Genode::cmpxchg(&_count, count, count - 1))
+					return 0;
 			}
 		}
 
-		/* unsynchronized try */
-		int _try_down()
-		{
-			if (_count > 0) {
-				--_count;
-				return 0;
-			}
-
-			return EBUSY;
-		}
+		bool _spin() { return Futex::spin([&] { return _try_down() == 0; }); }
 
 	public:
 
@@ -158,81 +65,54 @@ struct sem : Genode::Noncopyable
 
 		int count() const { return _count; }
 
-		int trydown()
-		{
-			Mutex::Guard guard(_data_mutex);
-
-			return _try_down();
-		}
+		int trydown() { return _try_down(); }
 
 		int down()
 		{
-			Mutex::Guard guard(_data_mutex);
-
 			/* fast path */
-			if (_try_down() == 0)
+			if (_try_down() == 0 || _spin())
 				return 0;
 
-			_apply_for_semaphore(0);
+			while (_try_down() != 0)
+				_futex.wait(_count, 0, 0);
 
 			return 0;
 		}
 
 		int down_timed(timespec const &abs_timeout)
 		{
-			Mutex::Guard guard(_data_mutex);
-
 			/* fast path */
-			if (_try_down() == 0)
+			if (_try_down() == 0 || _spin())
 				return 0;
 
-			timespec abs_now;
-			clock_gettime(_clock_id, &abs_now);
+			while (_try_down() != 0) {
 
-			Libc::uint64_t const timeout_ms =
-				calculate_relative_timeout_ms(abs_now, abs_timeout);
-			if (!timeout_ms)
-				return ETIMEDOUT;
+				timespec abs_now;
+				clock_gettime(CLOCK_REALTIME, &abs_now);
 
-			if (_apply_for_semaphore(timeout_ms))
-				return 0;
-			else
-				return ETIMEDOUT;
+				Libc::uint64_t const timeout_ms =
+					calculate_relative_timeout_ms(abs_now, abs_timeout);
+				if (!timeout_ms)
+					return ETIMEDOUT;
+
+				_futex.wait(_count, 0, timeout_ms);
+			}
+			return 0;
 		}
 
 		int up()
 		{
-			Mutex::Guard guard(_data_mutex);
+			atomic_add(_count, 1);
 
-			_count_up();
+			_futex.wake(1);
 
 			return 0;
 		}
-
-		int set_clock(clockid_t clock_id)
-		{
-			switch (clock_id) {
-			case CLOCK_REALTIME:
-				_clock_id = CLOCK_REALTIME;
-				return 0;
-			case CLOCK_MONOTONIC:
-				_clock_id = CLOCK_MONOTONIC;
-				return 0;
-			default:
-				break;
-			}
-			return -1;
-		}
 };
 
 
 extern "C" {
 
-	int sem_set_clock(sem_t *sem, clockid_t clock_id)
-	{
-		return (*sem)->set_clock(clock_id);
-	}
-
 	int sem_close(sem_t *)
 	{
 		warning(__func__, " not implemented");
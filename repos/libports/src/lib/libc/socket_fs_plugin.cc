@@ -18,6 +18,7 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <vfs/types.h>
+#include <vfs/socket_address.h>
 #include <util/dictionary.h>
 #include <util/string.h>
 #include <libc/allocator.h>
@@ -28,11 +29,15 @@
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
 #include <unistd.h>
 #include <ctype.h>
 #include <netinet/tcp.h>
 #include <stdio.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
 #include <ifaddrs.h>
 #include <net/if.h>
 
@@ -48,6 +53,8 @@
 namespace Libc {
 	bool read_ready_from_kernel(File_descriptor *);
 	bool write_ready_from_kernel(File_descriptor *);
+
+	File_descriptor *socket_read_ready_file_descriptor(File_descriptor *);
 }
 
 
@@ -98,7 +105,6 @@ namespace Libc { namespace Socket_fs {
 	template <int> class String;
 	using Host_string = String<NI_MAXHOST>;
 	using Port_string = String<NI_MAXSERV>;
-	struct Sockaddr_string;
 
 	struct New_socket_failed : Exception { };
 	struct Address_conversion_failed : Exception { };
@@ -154,7 +160,8 @@ struct Libc::Socket_fs::Context : Plugin_context
 		Absolute_path const _path {
 			_read_socket_path().base(), _config_ptr->socket.string() };
 
-		enum Fd { DATA, PEEK, CONNECT, BIND, LISTEN, ACCEPT, LOCAL, REMOTE, MAX };
+		enum Fd { DATA, PEEK, CONNECT, BIND, LISTEN, ACCEPT, LOCAL, REMOTE,
+		          DATAGRAMS, MAX };
 
 		struct
 		{
@@ -165,9 +172,19 @@ struct Libc::Socket_fs::Context : Plugin_context
 			{ "data",    -1, nullptr }, { "peek",   -1, nullptr },
 			{ "connect", -1, nullptr }, { "bind",   -1, nullptr },
 			{ "listen",  -1, nullptr }, { "accept", -1, nullptr },
-			{ "local",   -1, nullptr }, { "remote", -1, nullptr }
+			{ "local",   -1, nullptr }, { "remote", -1, nullptr },
+			{ "datagrams", -1, nullptr }
 		};
 
+		/* the 'datagrams' file is not provided by all socket file systems */
+		bool _datagrams_missing { false };
+
+		/* limit of datagrams per read of the datagrams file */
+		unsigned _max_datagrams { 0 };
+
+		/* buffer for batched datagram I/O */
+		char  *_batch_buf      { nullptr };
+		size_t _batch_buf_size { 0 };
 
 		Proto const _proto;
 
@@ -180,18 +197,39 @@ struct Libc::Socket_fs::Context : Plugin_context
 				if (_fd[i].num != -1) fn(_fd[i].num);
 		}
 
-		void _init_fd(Fd type, int flags)
+		static int _open_flags(Fd type)
+		{
+			switch (type) {
+			case Fd::PEEK:   return O_RDONLY;
+			case Fd::BIND:   return O_WRONLY;
+			case Fd::LISTEN: return O_WRONLY;
+			case Fd::ACCEPT: return O_RDONLY;
+			default:         return O_RDWR;
+			}
+		}
+
+		/*
+		 * Control files are opened on first use, which spares most of the
+		 * opens for accepted sockets. Files whose readiness is checked from
+		 * within a monitor must be opened beforehand, i.e., 'data' at
+		 * construction, 'connect' by 'connect()', and 'accept' by 'listen()'.
+		 */
+		int _open_fd(Fd type)
 		{
+			if (_fd[type].num != -1)
+				return _fd[type].num;
+
 			Absolute_path file(_fd[type].name, _path.base());
-			int const fd = open(file.base(), flags|_fd_flags);
+			int const fd = open(file.base(), _open_flags(type)|_fd_flags);
 			if (fd == -1) {
 				error(__func__, ": ", _fd[type].name,
 				      " file not accessible at ", file,
 				      " errno=", errno);
-				throw New_socket_failed();
+				return -1;
 			}
 			_fd[type].num  = fd;
 			_fd[type].file = file_descriptor_allocator()->find_by_libc_fd(fd);
+			return fd;
 		}
 
 		bool _fd_read_ready(Fd type)
@@ -226,24 +264,20 @@ struct Libc::Socket_fs::Context : Plugin_context
 		Context(Proto proto, int handle_fd)
 		: _handle_fd(handle_fd), _proto(proto)
 		{
-			_init_fd(Fd::DATA,    O_RDWR);
-			_init_fd(Fd::PEEK,    O_RDONLY);
-			_init_fd(Fd::CONNECT, O_RDWR);
-			_init_fd(Fd::BIND,    O_WRONLY);
-			_init_fd(Fd::LISTEN,  O_WRONLY);
-			_init_fd(Fd::ACCEPT,  O_RDONLY);
-			_init_fd(Fd::LOCAL,   O_RDWR);
-			_init_fd(Fd::REMOTE,  O_RDWR);
+			if (_open_fd(Fd::DATA) == -1)
+				throw New_socket_failed();
 		}
 
 		~Context()
 		{
 			for (unsigned i = 0; i < Fd::MAX; ++i) {
-				::close(_fd[i].num);
+				if (_fd[i].num != -1)
+					::close(_fd[i].num);
 				_fd[i].num = -1;
 				_fd[i].file = nullptr;
 			}
 			::close(_handle_fd);
+			::free(_batch_buf);
 		}
 
 		Absolute_path path() const { return _path; }
@@ -257,14 +291,65 @@ struct Libc::Socket_fs::Context : Plugin_context
 			_fd_apply([flags] (int fd) { fcntl(fd, F_SETFL, flags); });
 		}
 
-		int data_fd()    { return _fd[Fd::DATA].num; }
-		int peek_fd()    { return _fd[Fd::PEEK].num; }
-		int connect_fd() { return _fd[Fd::CONNECT].num; }
-		int bind_fd()    { return _fd[Fd::BIND].num; }
-		int listen_fd()  { return _fd[Fd::LISTEN].num; }
-		int accept_fd()  { return _fd[Fd::ACCEPT].num; }
-		int local_fd()   { return _fd[Fd::LOCAL].num; }
-		int remote_fd()  { return _fd[Fd::REMOTE].num; }
+		int data_fd()    { return _open_fd(Fd::DATA); }
+		int peek_fd()    { return _open_fd(Fd::PEEK); }
+		int connect_fd() { return _open_fd(Fd::CONNECT); }
+		int bind_fd()    { return _open_fd(Fd::BIND); }
+		int listen_fd()  { return _open_fd(Fd::LISTEN); }
+		int accept_fd()  { return _open_fd(Fd::ACCEPT); }
+		int local_fd()   { return _open_fd(Fd::LOCAL); }
+		int remote_fd()  { return _open_fd(Fd::REMOTE); }
+
+		/**
+		 * Return file descriptor of the 'datagrams' file
+		 *
+		 * \return -1 if the socket file system lacks the file
+		 */
+		int datagrams_fd()
+		{
+			if (_fd[Fd::DATAGRAMS].num != -1 || _datagrams_missing)
+				return _fd[Fd::DATAGRAMS].num;
+
+			Absolute_path file(_fd[Fd::DATAGRAMS].name, _path.base());
+			struct stat st { };
+			if (stat(file.base(), &st) == -1) {
+				_datagrams_missing = true;
+				return -1;
+			}
+			return _open_fd(Fd::DATAGRAMS);
+		}
+
+		/**
+		 * Limit the number of datagrams per read of the datagrams file
+		 *
+		 * The limit is written to the file only if changed.
+		 */
+		int max_datagrams(unsigned max)
+		{
+			if (max == _max_datagrams)
+				return 0;
+
+			char value[16];
+			int const len = snprintf(value, sizeof(value), "%u", max);
+			if (write(datagrams_fd(), value, len) != len)
+				return -1;
+
+			_max_datagrams = max;
+			return 0;
+		}
+
+		/**
+		 * Return buffer of at least 'size' bytes for batched datagram I/O
+		 */
+		char *batch_buffer(size_t size)
+		{
+			if (size > _batch_buf_size) {
+				::free(_batch_buf);
+				_batch_buf      = (char *)::malloc(size);
+				_batch_buf_size = _batch_buf ? size : 0;
+			}
+			return _batch_buf;
+		}
 
 		/* request the appropriate fd to ensure the file is open */
 		bool connect_read_ready() { return _fd_read_ready(Fd::CONNECT); }
@@ -293,6 +378,22 @@ struct Libc::Socket_fs::Context : Plugin_context
 			return (_state == ACCEPT_ONLY) ? accept_read_ready() : data_read_ready();
 		}
 
+		/**
+		 * Return the file whose read-ready responses signal the
+		 * readability of the socket
+		 *
+		 * \return nullptr while the readability depends on the
+		 *         connect file
+		 */
+		File_descriptor *read_ready_file()
+		{
+			switch (_state) {
+			case ACCEPT_ONLY: return _fd[Fd::ACCEPT].file;
+			case CONNECTING:  return nullptr;
+			default:          return _fd[Fd::DATA].file;
+			}
+		}
+
 		bool write_ready()
 		{
 			if (_state == CONNECTING)
@@ -460,81 +561,10 @@ template <int CAPACITY> class Libc::Socket_fs::String
 		}
 };
 
-/*
- * Both NI_MAXHOST and NI_MAXSERV include the terminating 0, which allows
- * use to put ':' between host and port on concatenation.
- */
-struct Libc::Socket_fs::Sockaddr_string : String<NI_MAXHOST + NI_MAXSERV>
-{
-	Sockaddr_string() {	stpcpy(base(), ";0"); }
-
-	Sockaddr_string(Host_string const &host, Port_string const &port)
-	{
-		char *b = base();
-		b = stpcpy(b, host.base());
-		b = stpcpy(b, ":");
-		b = stpcpy(b, port.base());
-	}
-
-	Host_string host() const
-	{
-		Host_string host;
-
-		Genode::copy_cstring(host.base(), base(), host.capacity());
-		char *at = strstr(host.base(), ":");
-		if (!at)
-			throw Address_conversion_failed();
-		*at = 0;
-
-		return host;
-	}
-
-	Port_string port() const
-	{
-		Port_string port;
-
-		char *at = strstr(base(), ":");
-		if (!at)
-			throw Address_conversion_failed();
-
-		Genode::copy_cstring(port.base(), ++at, port.capacity());
-
-		return port;
-	}
-};
-
 
 using namespace Libc;
 
 
-static Port_string port_string(sockaddr_in const &addr)
-{
-	Port_string port;
-
-	if (getnameinfo((sockaddr *)&addr, sizeof(addr),
-	                nullptr, 0, /* no host conversion */
-	                port.base(), port.capacity(),
-	                NI_NUMERICHOST | NI_NUMERICSERV) != 0)
-		throw Address_conversion_failed();
-
-	return port;
-}
-
-
-static Host_string host_string(sockaddr_in const &addr)
-{
-	Host_string host;
-
-	if (getnameinfo((sockaddr *)&addr, sizeof(addr),
-	                host.base(), host.capacity(),
-	                nullptr, 0, /* no port conversion */
-	                NI_NUMERICHOST | NI_NUMERICSERV) != 0)
-		throw Address_conversion_failed();
-
-	return host;
-}
-
-
 static sockaddr_in sockaddr_in_struct(Host_string const &host, Port_string const &port)
 {
 	addrinfo hints;
@@ -554,20 +584,33 @@ static sockaddr_in sockaddr_in_struct(Host_string const &host, Port_string const
 }
 
 
+static Vfs::Socket_address socket_address(sockaddr const *addr)
+{
+	sockaddr_in const &in = *(sockaddr_in const *)addr;
+
+	return Vfs::Socket_address::inet(in.sin_addr.s_addr, in.sin_port);
+}
+
+
 static int read_sockaddr_in(Socket_fs::Sockaddr_functor &func,
                             struct sockaddr_in *addr, socklen_t *addrlen)
 {
 	if (!addr)                     return Errno(EFAULT);
 	if (!addrlen || *addrlen <= 0) return Errno(EINVAL);
 
+	/* open the file before checking its readiness from within the monitor */
+	int const fd = func.fd();
+	if (fd == -1) return Errno(EBADF);
+
 	if (!func.nonblocking) {
 		monitor().monitor([&] {
 			return func.read_ready_from_kernel() ? Fn::COMPLETE : Fn::INCOMPLETE;
 		});
 	}
 
-	Sockaddr_string addr_string;
-	int const n = read(func.fd(), addr_string.base(), addr_string.capacity() - 1);
+	/* the buffer size requests the address in binary form */
+	Vfs::Socket_address binary { };
+	int const n = read(fd, &binary, sizeof(binary));
 
 	if (n == -1) return Errno(errno);
 	/* 0 return value means "no packet resp. not connected" */
@@ -576,22 +619,20 @@ static int read_sockaddr_in(Socket_fs::Sockaddr_functor &func,
 		case Socket_fs::Context::Proto::UDP: return Errno(EAGAIN);
 		case Socket_fs::Context::Proto::TCP: return Errno(ENOTCONN);
 		}
-	if (n >= (int)addr_string.capacity() - 1) return Errno(EINVAL);
+	if (n != sizeof(binary) || binary.magic != Vfs::Socket_address::MAGIC)
+		return Errno(EINVAL);
 
-	addr_string.terminate(n);
-	addr_string.remove_trailing_newline();
+	sockaddr_in saddr { };
+	saddr.sin_len         = sizeof(saddr);
+	saddr.sin_family      = AF_INET;
+	saddr.sin_port        = binary.port;
+	saddr.sin_addr.s_addr = binary.addr;
 
-	try {
-		/* convert the address but do not exceed the caller's buffer */
-		sockaddr_in saddr = sockaddr_in_struct(addr_string.host(), addr_string.port());
-		::memcpy(addr, &saddr, *addrlen);
-		*addrlen = sizeof(saddr);
+	/* do not exceed the caller's buffer */
+	::memcpy(addr, &saddr, min(size_t(*addrlen), sizeof(saddr)));
+	*addrlen = sizeof(saddr);
 
-		return 0;
-	} catch (Address_conversion_failed) {
-		warning("IP address conversion failed");
-		return Errno(ENOBUFS);
-	}
+	return 0;
 }
 
 
@@ -721,17 +762,11 @@ extern "C" int socket_fs_bind(int libc_fd, sockaddr const *addr, socklen_t addrl
 		return Errno(EAFNOSUPPORT);
 	}
 
-	Sockaddr_string addr_string;
+	Vfs::Socket_address const binary = socket_address(addr);
 
 	try {
-		addr_string = Sockaddr_string(host_string(*(sockaddr_in *)addr),
-		                              port_string(*(sockaddr_in *)addr));
-	}
-	catch (Address_conversion_failed) { return Errno(EINVAL); }
-
-	try {
-		int const len = ::strlen(addr_string.base());
-		int const n   = write(context->bind_fd(), addr_string.base(), len);
+		int const len = sizeof(binary);
+		int const n   = write(context->bind_fd(), &binary, len);
 
 		/*
 		 * TODO: this should be replaced by actual SO_ERROR when support is enabled
@@ -762,9 +797,9 @@ extern "C" int socket_fs_connect(int libc_fd, sockaddr const *addr, socklen_t ad
 			if (context->state() != Context::CONNECTED)
 				return 0;
 
-			Sockaddr_string addr_string { };
-			int const len = ::strlen(addr_string.base());
-			int const n   = write(context->connect_fd(), addr_string.base(), len);
+			Vfs::Socket_address const binary = Vfs::Socket_address::unspec();
+			int const len = sizeof(binary);
+			int const n   = write(context->connect_fd(), &binary, len);
 
 			if (n != len)
 				return (context->proto() == Context::UDP) ? Errno(EIO) : Errno(EAFNOSUPPORT);
@@ -782,17 +817,15 @@ extern "C" int socket_fs_connect(int libc_fd, sockaddr const *addr, socklen_t ad
 	switch (context->state()) {
 	case Context::UNCONNECTED:
 		{
-			Sockaddr_string addr_string;
-			try {
-				addr_string = Sockaddr_string(host_string(*(sockaddr_in const *)addr),
-				                              port_string(*(sockaddr_in const *)addr));
-			}
-			catch (Address_conversion_failed) { return Errno(EINVAL); }
+			Vfs::Socket_address const binary = socket_address(addr);
+
+			/* open the connect file before its readiness is checked */
+			if (context->connect_fd() == -1) return Errno(ECONNREFUSED);
 
 			context->state(Context::CONNECTING);
 
-			int const len = ::strlen(addr_string.base());
-			int const n   = write(context->connect_fd(), addr_string.base(), len);
+			int const len = sizeof(binary);
+			int const n   = write(context->connect_fd(), &binary, len);
 
 			if (n != len) return Errno(ECONNREFUSED);
 
@@ -874,6 +907,9 @@ extern "C" int socket_fs_listen(int libc_fd, int backlog)
 	int const res = fsync(context->listen_fd());
 	if (res != 0) return res;
 
+	/* open the accept file before its readiness is checked */
+	if (context->accept_fd() == -1) return Errno(EOPNOTSUPP);
+
 	context->state(Context::ACCEPT_ONLY);
 	return 0;
 }
@@ -1060,15 +1096,11 @@ static ssize_t do_sendto(File_descriptor *fd,
 
 	try {
 		if (dest_addr && context->proto() == Context::Proto::UDP) {
-			try {
-				Sockaddr_string addr_string(host_string(*(sockaddr_in const *)dest_addr),
-				                            port_string(*(sockaddr_in const *)dest_addr));
+			Vfs::Socket_address const binary = socket_address(dest_addr);
 
-				int const len = ::strlen(addr_string.base());
-				int const n   = write(context->remote_fd(), addr_string.base(), len);
-				if (n != len) return Errno(EIO);
-			}
-			catch (Address_conversion_failed) { return Errno(EINVAL); }
+			int const len = sizeof(binary);
+			int const n   = write(context->remote_fd(), &binary, len);
+			if (n != len) return Errno(EIO);
 		}
 
 		lseek(context->data_fd(), 0, 0);
@@ -1126,6 +1158,472 @@ extern "C" ssize_t socket_fs_send(int libc_fd, void const *buf, ::size_t len, in
 }
 
 
+/*
+ * Batched datagram I/O
+ *
+ * A batch of messages of a UDP socket is transferred by a single access of
+ * the 'datagrams' file, which holds a 'Vfs::Socket_datagram' record per
+ * message. Stream sockets, and sockets of file systems without a
+ * 'datagrams' file, transfer one message per call.
+ */
+
+enum { MAX_DATAGRAM_BATCH = 64 };
+
+
+static size_t iov_size(msghdr const &msg)
+{
+	size_t size = 0;
+	for (int i = 0; i < msg.msg_iovlen; i++)
+		size += msg.msg_iov[i].iov_len;
+	return size;
+}
+
+
+static size_t scatter(msghdr const &msg, char const *src, size_t len)
+{
+	size_t copied = 0;
+	for (int i = 0; i < msg.msg_iovlen && copied < len; i++) {
+		size_t const n = min(msg.msg_iov[i].iov_len, len - copied);
+		::memcpy(msg.msg_iov[i].iov_base, src + copied, n);
+		copied += n;
+	}
+	return copied;
+}
+
+
+static size_t gather(msghdr const &msg, char *dst)
+{
+	size_t copied = 0;
+	for (int i = 0; i < msg.msg_iovlen; i++) {
+		::memcpy(dst + copied, msg.msg_iov[i].iov_base, msg.msg_iov[i].iov_len);
+		copied += msg.msg_iov[i].iov_len;
+	}
+	return copied;
+}
+
+
+/**
+ * Receive a batch of datagrams into 'msgvec'
+ *
+ * \return number of messages received, or -1 if nothing was received
+ */
+static ssize_t recv_datagrams(Socket_fs::Context &context, int datagrams_fd,
+                              mmsghdr *msgvec, unsigned vlen)
+{
+	size_t size = 0;
+	for (unsigned i = 0; i < vlen; i++)
+		size += sizeof(Vfs::Socket_datagram) + iov_size(msgvec[i].msg_hdr);
+
+	char * const buf = context.batch_buffer(size);
+	if (!buf) return Errno(ENOMEM);
+
+	if (context.max_datagrams(vlen) == -1)
+		return Errno(EIO);
+
+	lseek(datagrams_fd, 0, SEEK_SET);
+	ssize_t const bytes = read(datagrams_fd, buf, size);
+	if (bytes <= 0) {
+		if (bytes < 0) handle_wakeup_remote_peers(context);
+		return bytes < 0 ? -1 : Errno(EAGAIN);
+	}
+
+	size_t   offset = 0;
+	unsigned count  = 0;
+	while (count < vlen && size_t(bytes) - offset >= sizeof(Vfs::Socket_datagram)) {
+
+		Vfs::Socket_datagram header { };
+		::memcpy(&header, buf + offset, sizeof(header));
+		offset += sizeof(header);
+
+		msghdr &msg = msgvec[count].msg_hdr;
+
+		size_t const copied = scatter(msg, buf + offset, header.length);
+		offset += header.length;
+
+		if (msg.msg_name) {
+			sockaddr_in saddr { };
+			saddr.sin_len         = sizeof(saddr);
+			saddr.sin_family      = AF_INET;
+			saddr.sin_port        = header.addr.port;
+			saddr.sin_addr.s_addr = header.addr.addr;
+
+			::memcpy(msg.msg_name, &saddr, min(size_t(msg.msg_namelen), sizeof(saddr)));
+			msg.msg_namelen = sizeof(saddr);
+		}
+
+		/* control data is not supported */
+		msg.msg_controllen = 0;
+		msg.msg_flags      = (copied < header.length) ? MSG_TRUNC : 0;
+
+		msgvec[count].msg_len = unsigned(copied);
+		count++;
+	}
+
+	return count;
+}
+
+
+/**
+ * Receive one message
+ *
+ * A datagram is consumed by a single read. Hence, the payload is read
+ * directly into the caller's buffer only if the message has a single I/O
+ * vector. Otherwise, it is scattered from the batch buffer.
+ */
+static ssize_t recv_message(File_descriptor *fd, Socket_fs::Context &context,
+                            msghdr &msg)
+{
+	sockaddr_in addr { };
+	socklen_t   addrlen = sizeof(addr);
+	sockaddr   *src     = msg.msg_name ? (sockaddr *)&addr : nullptr;
+
+	ssize_t res = -1;
+	if (msg.msg_iovlen == 1) {
+		res = do_recvfrom(fd, msg.msg_iov[0].iov_base, msg.msg_iov[0].iov_len,
+		                  0, src, &addrlen);
+	} else {
+		size_t const size = iov_size(msg);
+		char * const buf  = context.batch_buffer(size);
+		if (!buf) return Errno(ENOMEM);
+
+		res = do_recvfrom(fd, buf, size, 0, src, &addrlen);
+		if (res > 0)
+			scatter(msg, buf, res);
+	}
+	if (res < 0) return res;
+
+	if (src) {
+		::memcpy(msg.msg_name, &addr, min(size_t(msg.msg_namelen), size_t(addrlen)));
+		msg.msg_namelen = addrlen;
+	}
+
+	/* control data is not supported */
+	msg.msg_controllen = 0;
+	msg.msg_flags      = 0;
+
+	return res;
+}
+
+
+extern "C" ssize_t socket_fs_recvmmsg(int libc_fd, mmsghdr *msgvec, ::size_t vlen,
+                                      int flags, timespec const *timeout)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+	if (!fd) return Errno(EBADF);
+
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+	if (!context) return Errno(ENOTSOCK);
+	if (!msgvec)  return Errno(EFAULT);
+
+	if (flags & ~(MSG_DONTWAIT | MSG_WAITFORONE))
+		return Errno(EINVAL);
+
+	if (timeout && (timeout->tv_sec < 0 || timeout->tv_nsec < 0
+	                                    || timeout->tv_nsec >= 1000*1000*1000))
+		return Errno(EINVAL);
+
+	if (!vlen) return 0;
+
+	vlen = min(vlen, ::size_t(MAX_DATAGRAM_BATCH));
+
+	bool nonblocking = (flags & MSG_DONTWAIT) || (context->fd_flags() & O_NONBLOCK);
+
+	/*
+	 * The timeout covers the whole call. As on Linux, it is checked only
+	 * while waiting for the next message.
+	 */
+	auto now_ms = [] {
+		timespec ts { };
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return uint64_t(ts.tv_sec)*1000 + uint64_t(ts.tv_nsec)/(1000*1000);
+	};
+
+	uint64_t const deadline_ms = timeout
+	                           ? now_ms() + uint64_t(timeout->tv_sec)*1000
+	                                      + uint64_t(timeout->tv_nsec)/(1000*1000)
+	                           : 0;
+
+	auto wait_ms = [&] () -> int {
+		if (nonblocking) return 0;
+		if (!timeout)    return -1;
+
+		uint64_t const now = now_ms();
+		return (now < deadline_ms) ? int(min(deadline_ms - now, uint64_t(INT_MAX))) : 0;
+	};
+
+	int const datagrams_fd = (context->proto() == Context::Proto::UDP)
+	                       ? context->datagrams_fd() : -1;
+
+	unsigned count = 0;
+	while (count < vlen) {
+
+		/* return as soon as one message was received */
+		if (count && (flags & MSG_WAITFORONE))
+			nonblocking = true;
+
+		pollfd pfd { .fd = libc_fd, .events = POLLIN, .revents = 0 };
+		int const ready = poll(&pfd, 1, wait_ms());
+		if (ready <= 0) {
+			if (count || ready < 0) break;
+			return Errno(EAGAIN);
+		}
+
+		if (datagrams_fd != -1) {
+			ssize_t const res = recv_datagrams(*context, datagrams_fd, msgvec + count,
+			                                   unsigned(vlen - count));
+			if (res < 0)
+				break;
+
+			count += unsigned(res);
+			continue;
+		}
+
+		ssize_t const res = recv_message(fd, *context, msgvec[count].msg_hdr);
+		if (res < 0)
+			break;
+
+		msgvec[count].msg_len = unsigned(res);
+		count++;
+	}
+
+	/* errno was set by the failed receive if no message was received */
+	return count ? ssize_t(count) : -1;
+}
+
+
+extern "C" ssize_t socket_fs_sendmmsg(int libc_fd, mmsghdr *msgvec, ::size_t vlen, int flags)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+	if (!fd) return Errno(EBADF);
+
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+	if (!context) return Errno(ENOTSOCK);
+	if (!msgvec)  return Errno(EFAULT);
+	if (!vlen)    return 0;
+
+	vlen = min(vlen, ::size_t(MAX_DATAGRAM_BATCH));
+
+	bool const udp = (context->proto() == Context::Proto::UDP);
+	if (!udp)
+		vlen = 1;
+
+	int const datagrams_fd = udp ? context->datagrams_fd() : -1;
+
+	if (datagrams_fd == -1) {
+		unsigned count = 0;
+		for (; count < vlen; count++) {
+			msghdr const &msg = msgvec[count].msg_hdr;
+
+			char * const buf = context->batch_buffer(iov_size(msg));
+			if (!buf && iov_size(msg)) {
+				errno = ENOMEM;
+				break;
+			}
+
+			ssize_t const res = do_sendto(fd, buf, gather(msg, buf), flags,
+			                              (sockaddr const *)msg.msg_name, msg.msg_namelen);
+			if (res < 0)
+				break;
+
+			msgvec[count].msg_len = unsigned(res);
+		}
+
+		/* errno was set by the failed send if no message was sent */
+		return count ? ssize_t(count) : -1;
+	}
+
+	size_t size = 0;
+	for (unsigned i = 0; i < vlen; i++)
+		size += sizeof(Vfs::Socket_datagram) + iov_size(msgvec[i].msg_hdr);
+
+	char * const buf = context->batch_buffer(size);
+	if (!buf) return Errno(ENOMEM);
+
+	size_t offset = 0;
+	for (unsigned i = 0; i < vlen; i++) {
+
+		msghdr const &msg = msgvec[i].msg_hdr;
+
+		if (msg.msg_name && msg.msg_namelen < sizeof(sockaddr_in))
+			return Errno(EINVAL);
+
+		Vfs::Socket_datagram const header {
+			.addr   = msg.msg_name ? socket_address((sockaddr const *)msg.msg_name)
+			                       : Vfs::Socket_address::unspec(),
+			.length = uint32_t(iov_size(msg)) };
+
+		::memcpy(buf + offset, &header, sizeof(header));
+		offset += sizeof(header);
+		offset += gather(msg, buf + offset);
+	}
+
+	lseek(datagrams_fd, 0, SEEK_SET);
+	ssize_t const bytes = write(datagrams_fd, buf, size);
+	if (bytes <= 0) {
+		if (bytes < 0 && errno == EAGAIN) {
+			handle_wakeup_remote_peers(*context);
+			return Errno(EAGAIN);
+		}
+		return Errno(ENETDOWN);
+	}
+
+	/* count the messages of the records sent */
+	offset = 0;
+	unsigned count = 0;
+	while (count < vlen && offset < size_t(bytes)) {
+		size_t const len = iov_size(msgvec[count].msg_hdr);
+		msgvec[count].msg_len = len;
+		offset += sizeof(Vfs::Socket_datagram) + len;
+		count++;
+	}
+
+	return count;
+}
+
+
+/**
+ * Send the content of 'iov' completely unless the socket is non-blocking
+ *
+ * \return number of bytes sent, or -1 if nothing could be sent
+ */
+static ssize_t send_iovec(File_descriptor *fd, iovec const *iov, int iovcnt)
+{
+	ssize_t sent = 0;
+
+	for (int i = 0; i < iovcnt; i++) {
+
+		char const *base = (char const *)iov[i].iov_base;
+		::size_t    len  = iov[i].iov_len;
+
+		while (len) {
+			ssize_t const n = do_sendto(fd, base, len, 0, nullptr, 0);
+			if (n <= 0)
+				return sent ? sent : -1;
+
+			sent += n;
+			base += n;
+			len  -= n;
+		}
+	}
+	return sent;
+}
+
+
+extern "C" int socket_fs_sendfile(int file_fd, int libc_fd, off_t offset,
+                                  ::size_t nbytes, sf_hdtr *hdtr,
+                                  off_t *sbytes, int)
+{
+	off_t sent = 0;
+
+	auto done = [&] (int result) {
+		if (sbytes) *sbytes = sent;
+		return result;
+	};
+
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+	if (!fd) return done(Errno(EBADF));
+
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+	if (!context) return done(Errno(ENOTSOCK));
+
+	if (context->proto() != Context::Proto::TCP) return done(Errno(EINVAL));
+
+	File_descriptor *file = file_descriptor_allocator()->find_by_libc_fd(file_fd);
+	if (!file) return done(Errno(EBADF));
+
+	if (offset < 0) return done(Errno(EINVAL));
+
+	bool const nonblocking = (context->fd_flags() & O_NONBLOCK);
+
+	/*
+	 * A non-blocking socket may stall before all data is sent, which is
+	 * reported as EAGAIN with 'sbytes' denoting the bytes sent so far.
+	 */
+	auto stalled = [&] {
+		handle_wakeup_remote_peers(*context);
+		return done(Errno(EAGAIN));
+	};
+
+	/* send 'iov' completely, return false with 'errno' set otherwise */
+	auto send_vector = [&] (iovec const *iov, int iovcnt)
+	{
+		::size_t total = 0;
+		for (int i = 0; i < iovcnt; i++)
+			total += iov[i].iov_len;
+
+		if (!total)
+			return true;
+
+		ssize_t const n = send_iovec(fd, iov, iovcnt);
+		if (n < 0)
+			return false;
+
+		sent += n;
+
+		if (n < ssize_t(total)) {
+			errno = nonblocking ? EAGAIN : EPIPE;
+			return false;
+		}
+		return true;
+	};
+
+	auto send_failed = [&] {
+		return (errno == EAGAIN) ? stalled() : done(-1); };
+
+	try {
+		if (hdtr && hdtr->headers && !send_vector(hdtr->headers, hdtr->hdr_cnt))
+			return send_failed();
+
+		/* only regular files can be sent */
+		struct stat file_stat { };
+		if (file->plugin->fstat(file, &file_stat) == -1 || !S_ISREG(file_stat.st_mode))
+			return done(Errno(EINVAL));
+
+		/* 'nbytes' of zero denotes the transfer up to the end of the file */
+		::size_t const remaining = (offset < file_stat.st_size)
+		                         ? ::size_t(file_stat.st_size - offset) : 0;
+		::size_t const count = nbytes ? min(nbytes, remaining) : remaining;
+
+		int const data_fd = context->data_fd();
+		File_descriptor *data = file_descriptor_allocator()->find_by_libc_fd(data_fd);
+		if (!data) return done(Errno(EIO));
+
+		lseek(data_fd, 0, 0);
+
+		/*
+		 * The file is transferred directly to the data file of the socket
+		 * without passing an application buffer.
+		 */
+		ssize_t const n = count ? file->plugin->transfer(file, offset, data, count) : 0;
+		if (n < 0) {
+			if (errno == EAGAIN)
+				return stalled();
+			if (errno == EIO)
+				errno = EPIPE;
+			return done(-1);
+		}
+
+		sent += n;
+
+		/*
+		 * The trailers are sent only after the complete body. A blocking
+		 * transfer stops short only if the connection failed or the file
+		 * was truncated meanwhile.
+		 */
+		if (::size_t(n) < count)
+			return nonblocking ? stalled() : done(Errno(EPIPE));
+
+		if (hdtr && hdtr->trailers && !send_vector(hdtr->trailers, hdtr->trl_cnt))
+			return send_failed();
+
+	} catch (Socket_fs::Context::Inaccessible) {
+		return done(Errno(EINVAL));
+	}
+
+	return done(0);
+}
+
+
 extern "C" int socket_fs_getsockopt(int libc_fd, int level, int optname,
                                     void *optval, socklen_t *optlen)
 {
@@ -1489,7 +1987,22 @@ int Socket_fs::Plugin::poll(Pollfd fds[], int nfds)
 				} catch (Socket_fs::Context::Inaccessible) { }
 			}
 
-			/* XXX POLLERR not supported */
+			/*
+			 * POLLHUP is reported regardless of the requested events. A
+			 * socket hangs up if its connect failed or timed out. POLLERR
+			 * is not supported because the failure of a non-blocking
+			 * connect becomes known only when 'connect()' or
+			 * 'getsockopt(SO_ERROR)' reads the connect status after POLLOUT.
+			 */
+			try {
+				Socket_fs::Context *context =
+					static_cast<Socket_fs::Context *>(fds[pollfd_index].fdo->context);
+
+				if (context->state() == Socket_fs::Context::CONNECT_ABORTED) {
+					*fds[pollfd_index].revents |= POLLHUP;
+					fd_ready = true;
+				}
+			} catch (Socket_fs::Context::Inaccessible) { }
 
 			if (fd_ready)
 				nready++;
@@ -1550,6 +2063,14 @@ int Socket_fs::Plugin::ioctl(File_descriptor *fd, unsigned long request, char *b
 }
 
 
+Libc::File_descriptor *Libc::socket_read_ready_file_descriptor(File_descriptor *fd)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+
+	return context ? context->read_ready_file() : nullptr;
+}
+
+
 Libc::Socket_fs::Plugin &Libc::Socket_fs::plugin()
 {
 	static Socket_fs::Plugin inst;
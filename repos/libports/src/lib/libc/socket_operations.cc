@@ -29,6 +29,7 @@ extern "C" {
 #include <internal/socket_fs_plugin.h>
 #include <internal/errno.h>
 #include <internal/init.h>
+#include <internal/kqueue.h>
 
 
 using namespace Libc;
@@ -161,9 +162,21 @@ __SYS_(ssize_t, recvmsg, (int libc_fd, msghdr *msg, int flags),
 })
 
 
+__SYS_(ssize_t, recvmmsg, (int libc_fd, mmsghdr *msgvec, ::size_t vlen, int flags,
+                           timespec const *timeout),
+{
+	if (_config_ptr->socket.length() > 1)
+		return socket_fs_recvmmsg(libc_fd, msgvec, vlen, flags, timeout);
+
+	return Errno(ENOTSOCK);
+})
+
+
 __SYS_(ssize_t, sendto, (int libc_fd, void const *buf, ::size_t len, int flags,
                           sockaddr const *dest_addr, socklen_t dest_addrlen),
 {
+	rearm_write_kevents(libc_fd);
+
 	if (_config_ptr->socket.length() > 1)
 		return socket_fs_sendto(libc_fd, buf, len, flags, dest_addr, dest_addrlen);
 
@@ -173,6 +186,8 @@ __SYS_(ssize_t, sendto, (int libc_fd, void const *buf, ::size_t len, int flags,
 
 extern "C" ssize_t send(int libc_fd, void const *buf, ::size_t len, int flags)
 {
+	rearm_write_kevents(libc_fd);
+
 	if (_config_ptr->socket.length() > 1)
 		return socket_fs_send(libc_fd, buf, len, flags);
 
@@ -180,6 +195,29 @@ extern "C" ssize_t send(int libc_fd, void const *buf, ::size_t len, int flags)
 }
 
 
+__SYS_(ssize_t, sendmmsg, (int libc_fd, mmsghdr *msgvec, ::size_t vlen, int flags),
+{
+	rearm_write_kevents(libc_fd);
+
+	if (_config_ptr->socket.length() > 1)
+		return socket_fs_sendmmsg(libc_fd, msgvec, vlen, flags);
+
+	return Errno(ENOTSOCK);
+})
+
+
+__SYS_(int, sendfile, (int fd, int libc_fd, off_t offset, ::size_t nbytes,
+                       sf_hdtr *hdtr, off_t *sbytes, int flags),
+{
+	rearm_write_kevents(libc_fd);
+
+	if (_config_ptr->socket.length() > 1)
+		return socket_fs_sendfile(fd, libc_fd, offset, nbytes, hdtr, sbytes, flags);
+
+	return Errno(ENOTSOCK);
+})
+
+
 extern "C" int getsockopt(int libc_fd, int level, int optname,
                           void *optval, socklen_t *optlen)
 {
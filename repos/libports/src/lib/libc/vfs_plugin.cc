@@ -45,16 +45,36 @@
 #include <internal/init.h>
 #include <internal/monitor.h>
 #include <internal/current_time.h>
+#include <internal/fd_buffer.h>
 
 
-static Libc::Monitor         *_monitor_ptr;
-static Genode::Env::Local_rm *_local_rm_ptr;
+static Libc::Monitor                   *_monitor_ptr;
+static Genode::Env::Local_rm           *_local_rm_ptr;
+static Libc::File_descriptor_allocator *_fd_alloc_ptr;
 
 
-void Libc::init_vfs_plugin(Monitor &monitor, Genode::Env::Local_rm &rm)
+void Libc::init_vfs_plugin(Monitor &monitor, Genode::Env::Local_rm &rm,
+                           File_descriptor_allocator &fd_alloc)
 {
-	_monitor_ptr = &monitor;
+	_monitor_ptr  = &monitor;
 	_local_rm_ptr = &rm;
+	_fd_alloc_ptr = &fd_alloc;
+}
+
+
+void Libc::flush_fd_buffers()
+{
+	if (!_fd_alloc_ptr)
+		return;
+
+	/* a flush empties the buffer even if the write-back fails */
+	while (File_descriptor *fd = _fd_alloc_ptr->any_pending_write_fd()) {
+		Vfs_plugin * const plugin = dynamic_cast<Vfs_plugin *>(fd->plugin);
+		if (!plugin)
+			break;
+
+		plugin->flush_buffer(*fd);
+	}
 }
 
 
@@ -140,9 +160,25 @@ static void vfs_stat_to_libc_stat_struct(Vfs::Directory_service::Stat const &src
 
 namespace Libc {
 
+	/**
+	 * Return true if 'fd' refers to a VFS handle
+	 *
+	 * The context of file descriptors of other plugins, e.g., sockets, is
+	 * no VFS handle.
+	 */
+	bool vfs_file_descriptor(File_descriptor *fd)
+	{
+		return fd && dynamic_cast<Vfs_plugin *>(fd->plugin);
+	}
+
+	static Vfs::Vfs_handle *checked_vfs_handle(File_descriptor *fd)
+	{
+		return vfs_file_descriptor(fd) ? vfs_handle(fd) : nullptr;
+	}
+
 	bool read_ready_from_kernel(File_descriptor *fd)
 	{
-		Vfs::Vfs_handle *handle = vfs_handle(fd);
+		Vfs::Vfs_handle *handle = checked_vfs_handle(fd);
 		if (!handle) return false;
 
 		handle->fs().notify_read_ready(handle);
@@ -152,19 +188,56 @@ namespace Libc {
 
 	void notify_read_ready_from_kernel(File_descriptor *fd)
 	{
-		Vfs::Vfs_handle *handle = vfs_handle(fd);
+		Vfs::Vfs_handle *handle = checked_vfs_handle(fd);
 		if (handle)
 			handle->fs().notify_read_ready(handle);
 	}
 
 	bool write_ready_from_kernel(File_descriptor *fd)
 	{
-		Vfs::Vfs_handle const *handle = vfs_handle(fd);
+		Vfs::Vfs_handle const *handle = checked_vfs_handle(fd);
 		if (!handle)
 			return false;
 
 		return handle->fs().write_ready(*handle);
 	}
+
+	Vfs::Read_ready_response_handler *
+	redirect_read_ready_from_kernel(File_descriptor *fd,
+	                                Vfs::Read_ready_response_handler &handler)
+	{
+		Vfs::Vfs_handle *handle = checked_vfs_handle(fd);
+		if (!handle)
+			return nullptr;
+
+		Vfs::Read_ready_response_handler &kernel = Libc::Kernel::kernel();
+
+		/* redirect only handles that still respond to the libc kernel */
+		bool redirectable = false;
+		handle->apply_handler([&] (Vfs::Read_ready_response_handler &h) {
+			redirectable = (&h == &kernel); });
+
+		if (!redirectable)
+			return nullptr;
+
+		handle->handler(&handler);
+		return &kernel;
+	}
+
+	void restore_read_ready_from_kernel(File_descriptor *fd,
+	                                    Vfs::Read_ready_response_handler &handler)
+	{
+		Vfs::Vfs_handle *handle = checked_vfs_handle(fd);
+		if (!handle)
+			return;
+
+		bool redirected = false;
+		handle->apply_handler([&] (Vfs::Read_ready_response_handler &h) {
+			redirected = (&h == &handler); });
+
+		if (redirected)
+			handle->handler(&Libc::Kernel::kernel());
+	}
 }
 
 
@@ -467,10 +540,119 @@ Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags)
 		fd = nullptr;
 	}
 
+	/* buffer regular files as configured via '<libc> <buffer .../>' */
+	size_t const buffer_size = fd ? _config.buffers.size(path) : 0;
+
+	if (buffer_size && !(fd->flags & O_NONBLOCK)) {
+
+		Vfs::Directory_service::Stat stat { };
+
+		bool const continuous_file =
+			(_root_fs.stat(path, stat) == Vfs::Directory_service::STAT_OK)
+			&& (stat.type == Vfs::Node_type::CONTINUOUS_FILE);
+
+		if (continuous_file) {
+			fd->buffer = new (_alloc) Fd_buffer(_alloc, buffer_size);
+
+			if (!fd->buffer->data)
+				_destroy_buffer(*fd);
+		}
+	}
+
 	return fd;
 }
 
 
+bool Libc::Vfs_plugin::_flush_buffer(File_descriptor &fd)
+{
+	Fd_buffer * const buffer = fd.buffer;
+
+	if (!buffer)
+		return true;
+
+	if (!buffer->pending_write()) {
+		buffer->reset();
+		return true;
+	}
+
+	Vfs::Vfs_handle &handle = *vfs_handle(&fd);
+
+	/* write buffered data at its original position, keeping the seek */
+	Vfs::file_size const seek = handle.seek();
+
+	handle.seek(buffer->offset);
+	ssize_t const result = _write(&fd, buffer->data, buffer->fill);
+	handle.seek(seek);
+
+	bool const complete = (result == ssize_t(buffer->fill));
+
+	if (result >= 0 && !complete)
+		errno = EIO;
+
+	buffer->reset();
+	return complete;
+}
+
+
+bool Libc::Vfs_plugin::_flush_buffer_from_kernel(File_descriptor &fd)
+{
+	using Result = Vfs::File_io_service::Write_result;
+
+	Fd_buffer * const buffer = fd.buffer;
+
+	if (!buffer || !buffer->pending_write()) {
+		if (buffer)
+			buffer->reset();
+		return true;
+	}
+
+	Vfs::Vfs_handle &handle = *vfs_handle(&fd);
+
+	Vfs::file_size const seek = handle.seek();
+	handle.seek(buffer->offset);
+
+	size_t written = 0;
+	while (written < buffer->fill) {
+
+		Const_byte_range_ptr const src { buffer->data + written,
+		                                 buffer->fill - written };
+		size_t out_count = 0;
+
+		Result const result = handle.fs().write(&handle, src, out_count);
+
+		if (result == Result::WRITE_ERR_WOULD_BLOCK) {
+			Libc::Kernel::kernel().wakeup_remote_peers();
+			Libc::Kernel::kernel().libc_env().ep().wait_and_dispatch_one_io_signal();
+			continue;
+		}
+
+		if (result != Result::WRITE_OK || !out_count)
+			break;
+
+		written += out_count;
+		handle.advance_seek(out_count);
+	}
+
+	handle.seek(seek);
+
+	bool const complete = (written == buffer->fill);
+	if (written)
+		fd.modified = true;
+
+	buffer->reset();
+	return complete;
+}
+
+
+void Libc::Vfs_plugin::_destroy_buffer(File_descriptor &fd)
+{
+	if (fd.buffer)
+		destroy(_alloc, fd.buffer);
+
+	fd.buffer = nullptr;
+}
+
+
 struct Sync
 {
 	enum { INITIAL, TIMESTAMP_UPDATED, QUEUED, COMPLETE } state { INITIAL };
@@ -525,6 +707,9 @@ int Libc::Vfs_plugin::close_from_kernel(File_descriptor *fd)
 {
 	Vfs::Vfs_handle *handle = vfs_handle(fd);
 
+	if (!_flush_buffer_from_kernel(*fd))
+		warning("buffered data of fd ", fd->libc_fd, " lost on close");
+
 	if ((fd->modified) || (fd->flags & O_CREAT)) {
 		/* XXX mtime not updated here */
 		Sync sync { *handle, { .update_mtime = false }, _current_real_time };
@@ -535,6 +720,7 @@ int Libc::Vfs_plugin::close_from_kernel(File_descriptor *fd)
 		}
 	}
 
+	_destroy_buffer(*fd);
 	handle->close();
 	_fd_alloc.free(fd);
 
@@ -546,6 +732,12 @@ int Libc::Vfs_plugin::close(File_descriptor *fd)
 {
 	Vfs::Vfs_handle *handle = vfs_handle(fd);
 
+	/* the file descriptor is closed even if the final write-back fails */
+	bool const flushed = _flush_buffer(*fd);
+	int  const flush_errno = errno;
+
+	_destroy_buffer(*fd);
+
 	Sync sync { *handle, { .update_mtime = _config.update_mtime }, _current_real_time };
 
 	monitor().monitor([&] {
@@ -559,7 +751,7 @@ int Libc::Vfs_plugin::close(File_descriptor *fd)
 		return Fn::COMPLETE;
 	});
 
-	return 0;
+	return flushed ? 0 : Errno(flush_errno);
 }
 
 
@@ -570,6 +762,10 @@ int Libc::Vfs_plugin::dup2(File_descriptor *fd,
 
 	using Result = Vfs::Directory_service::Open_result;
 
+	/* make buffered data visible to the new file descriptor */
+	if (!_flush_buffer(*fd))
+		return -1;
+
 	int result = -1;
 	monitor().monitor([&] {
 		if (_root_fs.open(fd->fd_path, fd->flags, &handle, _alloc) != Result::OPEN_OK) {
@@ -599,6 +795,10 @@ Libc::File_descriptor *Libc::Vfs_plugin::dup(File_descriptor *fd)
 
 	using Result = Vfs::Directory_service::Open_result;
 
+	/* make buffered data visible to the new file descriptor */
+	if (!_flush_buffer(*fd))
+		return nullptr;
+
 	Libc::File_descriptor *result = nullptr;
 	int result_errno = 0;
 	monitor().monitor([&] {
@@ -638,6 +838,10 @@ int Libc::Vfs_plugin::fstat(File_descriptor *fd, struct stat *buf)
 {
 	Vfs::Vfs_handle *handle = vfs_handle(fd);
 
+	/* account buffered writes in the reported file size */
+	if (fd->buffer && fd->buffer->pending_write() && !_flush_buffer(*fd))
+		return -1;
+
 	if (fd->modified) {
 		Sync sync { *handle , { .update_mtime = _config.update_mtime }, _current_real_time };
 
@@ -765,6 +969,45 @@ int Libc::Vfs_plugin::stat(char const *path, struct stat *buf)
 
 ssize_t Libc::Vfs_plugin::write(File_descriptor *fd, const void *buf,
                                 ::size_t count)
+{
+	Fd_buffer * const buffer = fd->buffer;
+
+	if (!buffer)
+		return _write(fd, buf, count);
+
+	if ((fd->flags & O_ACCMODE) == O_RDONLY)
+		return Errno(EBADF);
+
+	/* read-ahead data becomes stale by writing */
+	if (buffer->mode == Fd_buffer::Mode::READ)
+		buffer->reset();
+
+	Vfs::Vfs_handle &handle = *vfs_handle(fd);
+
+	/* the seek of 'O_APPEND' descriptors is updated by each write */
+	bool const bufferable = !(fd->flags & O_APPEND) && (count < buffer->capacity);
+
+	if (bufferable && !buffer->appendable(handle.seek(), count))
+		if (!_flush_buffer(*fd))
+			return -1;
+
+	if (!bufferable) {
+		if (!_flush_buffer(*fd))
+			return -1;
+
+		return _write(fd, buf, count);
+	}
+
+	buffer->append(handle.seek(), buf, count);
+	handle.advance_seek(count);
+	fd->modified = true;
+
+	return count;
+}
+
+
+ssize_t Libc::Vfs_plugin::_write(File_descriptor *fd, const void *buf,
+                                 ::size_t count)
 {
 	using Result = Vfs::File_io_service::Write_result;
 
@@ -891,6 +1134,68 @@ ssize_t Libc::Vfs_plugin::write(File_descriptor *fd, const void *buf,
 
 ssize_t Libc::Vfs_plugin::read(File_descriptor *fd, void *buf,
                                ::size_t count)
+{
+	Fd_buffer * const buffer = fd->buffer;
+
+	if (!buffer || (fd->flags & O_ACCMODE) == O_WRONLY)
+		return _read(fd, buf, count);
+
+	if (buffer->mode == Fd_buffer::Mode::WRITE && !_flush_buffer(*fd))
+		return -1;
+
+	Vfs::Vfs_handle &handle = *vfs_handle(fd);
+
+	::size_t out_count = 0;
+
+	while (out_count < count) {
+
+		char * const dst = (char *)buf + out_count;
+
+		::off_t  const pos       = handle.seek();
+		::size_t const remaining = count - out_count;
+		::size_t const available = buffer->readable(pos);
+
+		if (available) {
+			::size_t const n = min(remaining, available);
+
+			Genode::memcpy(dst, buffer->data + (pos - buffer->offset), n);
+			handle.advance_seek(n);
+			out_count += n;
+			continue;
+		}
+
+		/* large reads bypass the buffer */
+		if (remaining >= buffer->capacity) {
+			ssize_t const n = _read(fd, dst, remaining);
+			if (n < 0)
+				return out_count ? ssize_t(out_count) : n;
+
+			return out_count + n;
+		}
+
+		/* read ahead, leaving the seek at the application's position */
+		buffer->reset();
+
+		ssize_t const n = _read(fd, buffer->data, buffer->capacity);
+		handle.seek(pos);
+
+		if (n < 0)
+			return out_count ? ssize_t(out_count) : n;
+
+		if (n == 0)
+			break;
+
+		buffer->mode   = Fd_buffer::Mode::READ;
+		buffer->offset = pos;
+		buffer->fill   = n;
+	}
+
+	return out_count;
+}
+
+
+ssize_t Libc::Vfs_plugin::_read(File_descriptor *fd, void *buf,
+                                ::size_t count)
 {
 	if ((fd->flags & O_ACCMODE) == O_WRONLY) {
 		return Errno(EBADF);
@@ -944,6 +1249,152 @@ ssize_t Libc::Vfs_plugin::read(File_descriptor *fd, void *buf,
 }
 
 
+ssize_t Libc::Vfs_plugin::transfer(File_descriptor *src_fd, ::off_t offset,
+                                   File_descriptor *dst_fd, ::size_t count)
+{
+	using Read_result  = Vfs::File_io_service::Read_result;
+	using Write_result = Vfs::File_io_service::Write_result;
+
+	if (dst_fd->plugin != this)
+		return Errno(EINVAL);
+
+	if ((src_fd->flags & O_ACCMODE) == O_WRONLY
+	 || (dst_fd->flags & O_ACCMODE) == O_RDONLY)
+		return Errno(EBADF);
+
+	if (src_fd->flags & O_DIRECTORY)
+		return Errno(EISDIR);
+
+	if (!_flush_buffer(*src_fd) || !_flush_buffer(*dst_fd))
+		return -1;
+
+	Vfs::Vfs_handle &src = *vfs_handle(src_fd);
+	Vfs::Vfs_handle &dst = *vfs_handle(dst_fd);
+
+	/*
+	 * Write data read from 'src' to 'dst', which happens in place, i.e.,
+	 * without intermediate copy, if the file system of 'src' supports it.
+	 */
+	struct Write_to_dst : Vfs::File_io_service::Read_in_place_fn
+	{
+		Vfs::Vfs_handle &dst;
+
+		Write_result result { Write_result::WRITE_OK };
+		bool         called { false };
+
+		Write_to_dst(Vfs::Vfs_handle &dst) : dst(dst) { }
+
+		::size_t consume(Const_byte_range_ptr const &data) override
+		{
+			called = true;
+			result = Write_result::WRITE_OK;
+
+			::size_t consumed = 0;
+			while (consumed < data.num_bytes) {
+
+				::size_t n = 0;
+				result = dst.fs().write(&dst, { data.start + consumed,
+				                                data.num_bytes - consumed }, n);
+				if (result != Write_result::WRITE_OK || n == 0)
+					break;
+
+				consumed += n;
+				dst.advance_seek(n);
+			}
+			return consumed;
+		}
+	};
+
+	/* buffer for file systems that are unable to hand out data in place */
+	enum { CHUNK_SIZE = 64*1024 };
+	struct Bounce_buffer { char data[CHUNK_SIZE]; };
+
+	Bounce_buffer * const bounce = new (_alloc) Bounce_buffer;
+
+	Vfs::file_size const initial_seek { src.seek() };
+
+	bool const nonblocking = (dst_fd->flags & O_NONBLOCK);
+
+	enum class Stage { QUEUE_READ, COMPLETE_READ };
+
+	Stage    stage        { Stage::QUEUE_READ };
+	::size_t transferred  { 0 };
+	int      result_errno { 0 };
+
+	monitor().monitor([&] {
+
+		while (transferred < count) {
+
+			::size_t const chunk = min(count - transferred, ::size_t(CHUNK_SIZE));
+
+			if (stage == Stage::QUEUE_READ) {
+				src.seek(offset + transferred);
+				if (!src.fs().queue_read(&src, chunk))
+					return Fn::INCOMPLETE;
+
+				stage = Stage::COMPLETE_READ;
+			}
+
+			Write_to_dst write_to_dst { dst };
+			::size_t     consumed { 0 };
+
+			Read_result const read_result =
+				src.fs().complete_read_in_place(&src, { bounce->data, chunk },
+				                                write_to_dst, consumed);
+
+			if (read_result == Read_result::READ_QUEUED)
+				return Fn::INCOMPLETE;
+
+			stage = Stage::QUEUE_READ;
+
+			if (read_result != Read_result::READ_OK) {
+				result_errno = EIO;
+				return Fn::COMPLETE;
+			}
+
+			transferred += consumed;
+
+			/* end of file */
+			if (!write_to_dst.called)
+				return Fn::COMPLETE;
+
+			switch (write_to_dst.result) {
+			case Write_result::WRITE_OK:
+			case Write_result::WRITE_ERR_WOULD_BLOCK:
+
+				if (consumed)
+					break;
+
+				/* 'dst' stalled */
+				if (nonblocking) {
+					result_errno = EAGAIN;
+					return Fn::COMPLETE;
+				}
+				return Fn::INCOMPLETE;
+
+			case Write_result::WRITE_ERR_INVALID: result_errno = EINVAL; return Fn::COMPLETE;
+			case Write_result::WRITE_ERR_IO:      result_errno = EIO;    return Fn::COMPLETE;
+			}
+		}
+		return Fn::COMPLETE;
+	});
+
+	src.seek(initial_seek);
+
+	destroy(_alloc, bounce);
+
+	Plugin::resume_all();
+
+	if (result_errno && !transferred)
+		return Errno(result_errno);
+
+	if (transferred)
+		dst_fd->modified = true;
+
+	return transferred;
+}
+
+
 ssize_t Libc::Vfs_plugin::getdirentries(File_descriptor *fd, char *buf,
                                         ::size_t nbytes, ::off_t *basep)
 {
@@ -1954,6 +2405,9 @@ int Libc::Vfs_plugin::ioctl(File_descriptor *fd, unsigned long request, char *ar
 int Libc::Vfs_plugin::ftruncate(File_descriptor *fd, ::off_t length)
 {
 	Vfs::Vfs_handle *handle = vfs_handle(fd);
+
+	if (!_flush_buffer(*fd))
+		return -1;
 	Sync sync { *handle, { .update_mtime = _config.update_mtime }, _current_real_time };
 
 	bool succeeded = false;
@@ -2039,6 +2493,9 @@ int Libc::Vfs_plugin::fsync(File_descriptor *fd)
 {
 	Vfs::Vfs_handle *handle = vfs_handle(fd);
 
+	if (fd->buffer && fd->buffer->pending_write() && !_flush_buffer(*fd))
+		return -1;
+
 	if (!fd->modified)
 		return 0;
 
@@ -2297,6 +2754,74 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 }
 
 
+void *Libc::Vfs_plugin::_attach_file_dataspace(File_descriptor &fd,
+                                               ::size_t length, ::off_t offset,
+                                               bool writeable, int &errno_out)
+{
+	/* create another VFS handle to keep the file open as long as the mapping exists */
+
+	Vfs::Vfs_handle *reference_handle = nullptr;
+	using Result = Vfs::Directory_service::Open_result;
+	Result vfs_open_result;
+	monitor().monitor([&] {
+		vfs_open_result = _root_fs.open(fd.fd_path, fd.flags,
+		                                &reference_handle, _alloc);
+		return Fn::COMPLETE;
+	});
+
+	if (vfs_open_result != Result::OPEN_OK) {
+		errno_out = ENFILE;
+		return nullptr;
+	}
+
+	auto close_reference_handle = [&] {
+		monitor().monitor([&] {
+			reference_handle->close();
+			return Fn::COMPLETE;
+		});
+	};
+
+	Genode::Dataspace_capability ds_cap;
+
+	monitor().monitor([&] {
+		ds_cap = _root_fs.dataspace(fd.fd_path);
+		return Fn::COMPLETE;
+	});
+
+	if (!ds_cap.valid()) {
+		close_reference_handle();
+		errno_out = ENODEV;
+		return nullptr;
+	}
+
+	void * const addr = local_rm().attach(ds_cap, {
+		.size       = length,
+		.offset     = addr_t(offset),
+		.use_at     = { },
+		.at         = { },
+		.executable = { },
+		.writeable  = writeable
+	}).convert<void *>(
+		[&] (Env::Local_rm::Attachment &a) { a.deallocate = false; return a.ptr; },
+		[&] (Env::Local_rm::Error)         { return nullptr; }
+	);
+
+	if (!addr) {
+		monitor().monitor([&] {
+			_root_fs.release(fd.fd_path, ds_cap);
+			return Fn::COMPLETE;
+		});
+		close_reference_handle();
+		errno_out = ENOMEM;
+		return nullptr;
+	}
+
+	new (_alloc) Mmap_entry(_mmap_registry, addr, reference_handle,
+	                        Absolute_path(fd.fd_path), ds_cap);
+	return addr;
+}
+
+
 void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
                              File_descriptor *fd, ::off_t offset)
 {
@@ -2312,14 +2837,51 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 		return MAP_FAILED;
 	}
 
+	/* the mapping must reflect data written via 'fd' */
+	if (!_flush_buffer(*fd))
+		return MAP_FAILED;
+
+	/* stores to a shared mapping bypass the buffer, making it incoherent */
+	if ((flags & MAP_SHARED) && (prot & PROT_WRITE))
+		_destroy_buffer(*fd);
+
 	void *addr = nullptr;
 
 	if (flags & MAP_PRIVATE) {
 
 		/*
-		 * XXX attempt to obtain memory mapping via
-		 *     'Vfs::Directory_service::dataspace'.
+		 * A read-only private mapping cannot be told apart from a shared
+		 * one. So we attach the file's dataspace if the file system
+		 * provides one, which spares the copy of the file content. Should
+		 * the mapping exceed the dataspace, e.g., beyond the end of the
+		 * file, we resort to copying.
+		 *
+		 * File systems like the ram and tar file systems hand out a copy of
+		 * the whole file as dataspace. If the mapping covers only a small
+		 * part of a large file, copying just the mapped part is cheaper.
 		 */
+		auto mapping_covers_most_of_file = [&]
+		{
+			using Result = Vfs::Directory_service::Stat_result;
+
+			Vfs::Directory_service::Stat stat { };
+			Result result = Result::STAT_ERR_NO_ENTRY;
+
+			monitor().monitor([&] {
+				result = _root_fs.stat(fd->fd_path, stat);
+				return Fn::COMPLETE;
+			});
+
+			return (result == Result::STAT_OK) && (stat.size <= 4*length);
+		};
+
+		if (prot == PROT_READ && mapping_covers_most_of_file()) {
+			int dataspace_errno = 0;
+			addr = _attach_file_dataspace(*fd, length, offset, false,
+			                              dataspace_errno);
+			if (addr)
+				return addr;
+		}
 
 		addr = mem_alloc()->alloc(length, PAGE_SHIFT);
 		if (addr == (void *)-1) {
@@ -2349,62 +2911,17 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 
 	} else if (flags & MAP_SHARED) {
 
-		/* create another VFS handle to keep the file open as long as the mapping exists */
-
-		Vfs::Vfs_handle *reference_handle = nullptr;
-		using Result = Vfs::Directory_service::Open_result;
-		Result vfs_open_result;
-		monitor().monitor([&] {
-			vfs_open_result = _root_fs.open(fd->fd_path, fd->flags,
-			                                &reference_handle, _alloc);
-			return Fn::COMPLETE;
-		});
-
-		if (vfs_open_result != Result::OPEN_OK) {
-			error("mmap could not create reference VFS handle");
-			errno = ENFILE;
-			return MAP_FAILED;
-		}
-
-		Genode::Dataspace_capability ds_cap;
-
-		monitor().monitor([&] {
-			ds_cap = _root_fs.dataspace(fd->fd_path);
-			return Fn::COMPLETE;
-		});
-
-		if (!ds_cap.valid()) {
-			Genode::error("mmap got invalid dataspace capability");
-			monitor().monitor([&] {
-				reference_handle->close();
-				return Fn::COMPLETE;
-			});
-			errno = ENODEV;
-			return MAP_FAILED;
-		}
-
-		addr = local_rm().attach(ds_cap, {
-			.size       = length,
-			.offset     = addr_t(offset),
-			.use_at     = { },
-			.at         = { },
-			.executable = { },
-			.writeable  = true
-		}).convert<void *>(
-			[&] (Env::Local_rm::Attachment &a) { a.deallocate = false; return a.ptr; },
-			[&] (Env::Local_rm::Error)         { return nullptr; }
-		);
-
+		int dataspace_errno = 0;
+		addr = _attach_file_dataspace(*fd, length, offset, true, dataspace_errno);
 		if (!addr) {
-			monitor().monitor([&] {
-				reference_handle->close();
-				return Fn::COMPLETE;
-			});
-			errno = ENOMEM;
+			switch (dataspace_errno) {
+			case ENFILE: error("mmap could not create reference VFS handle"); break;
+			case ENODEV: error("mmap got invalid dataspace capability");      break;
+			default: break;
+			}
+			errno = dataspace_errno;
 			return MAP_FAILED;
 		}
-
-		new (_alloc) Mmap_entry(_mmap_registry, addr, reference_handle);
 	}
 
 	return addr;
@@ -2430,15 +2947,19 @@ int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 	if (size_at_result == Size_at_error::MISMATCHING_ADDR)
 		return Errno(EINVAL);
 
-	/* shared mapping */
+	/* shared mapping or private read-only mapping of a dataspace */
 
 	Vfs::Vfs_handle *reference_handle = nullptr;
 
 	_mmap_registry.for_each([&] (Mmap_entry &entry) {
 		if (entry.start == addr) {
 			reference_handle = entry.reference_handle;
-			destroy(_alloc, &entry);
 			local_rm().detach(addr_t(addr));
+			monitor().monitor([&] {
+				_root_fs.release(entry.path.string(), entry.ds);
+				return Fn::COMPLETE;
+			});
+			destroy(_alloc, &entry);
 		}
 	});
 
@@ -2841,6 +3362,10 @@ int Libc::Vfs_plugin::enqueue_aiocb(Libc::File_descriptor *fd, const struct aioc
 {
 	using Aio_job = Libc::File_descriptor::Aio_job;
 
+	/* asynchronous operations access the file via separate VFS handles */
+	if (!_flush_buffer(*fd))
+		return -1;
+
 	return fd->any_free_aio_job([&] (Aio_job &aio_job) {
 		aio_job.iocb  = iocb;
 		aio_job.state = Aio_job::State::PENDING;
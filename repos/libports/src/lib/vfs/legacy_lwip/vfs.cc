@@ -17,6 +17,7 @@
 #include <vfs/file_system_factory.h>
 #include <vfs/vfs_handle.h>
 #include <vfs/print.h>
+#include <vfs/socket_address.h>
 #include <timer_session/connection.h>
 #include <util/fifo.h>
 #include <base/tslab.h>
@@ -121,6 +122,65 @@ extern "C" {
 		ADDRESS_FILE_SIZE = IPADDR_STRLEN_MAX+2,
 	};
 
+	/**
+	 * Parse endpoint written in textual or binary form
+	 *
+	 * \return false if the endpoint is malformed
+	 */
+	bool parse_endpoint(Const_byte_range_ptr const &src, ip_addr_t &addr, u16_t &port)
+	{
+		bool valid = false;
+		if (Socket_address::with_binary(src.start, src.num_bytes,
+		                                [&] (Socket_address const &binary) {
+			if (binary.family != Socket_address::INET)
+				return;
+
+			Genode::uint32_t const in_addr = binary.addr;
+			u8_t const * const a = (u8_t const *)&in_addr;
+			IP_ADDR4(&addr, a[0], a[1], a[2], a[3]);
+			port  = lwip_ntohs(binary.port);
+			valid = true; }))
+			return valid;
+
+		if (src.num_bytes >= ENDPOINT_STRLEN_MAX)
+			return false;
+
+		char buf[ENDPOINT_STRLEN_MAX];
+		copy_cstring(buf, src.start, min(src.num_bytes + 1, sizeof(buf)));
+		port = u16_t(remove_port(buf));
+		return ipaddr_aton(buf, &addr);
+	}
+
+	/**
+	 * Output endpoint, in binary form if the buffer has the size of a
+	 * 'Socket_address'
+	 *
+	 * \return false if the endpoint does not fit into the buffer
+	 */
+	bool print_endpoint(Byte_range_ptr const &dst, ip_addr_t const &addr,
+	                    u16_t port, size_t &out_count)
+	{
+		if (dst.num_bytes == sizeof(Socket_address)) {
+			if (!IP_IS_V4(&addr))
+				return false;
+
+			Socket_address const binary =
+				Socket_address::inet(ip4_addr_get_u32(ip_2_ip4(&addr)),
+				                     lwip_htons(port));
+			Genode::memcpy(dst.start, &binary, sizeof(binary));
+			out_count = sizeof(binary);
+			return true;
+		}
+
+		if (dst.num_bytes < ENDPOINT_STRLEN_MAX)
+			return false;
+
+		/* TODO: [IPv6]:port */
+		out_count = Format::snprintf(dst.start, dst.num_bytes, "%s:%d\n",
+		                             ipaddr_ntoa(&addr), port);
+		return true;
+	}
+
 	struct Directory;
 }
 
@@ -918,15 +978,10 @@ class Lwip::Udp_socket_dir final :
 				break;
 
 			case Lwip_file_handle::LOCAL:
-			case Lwip_file_handle::BIND: {
-				if (dst.num_bytes < ENDPOINT_STRLEN_MAX)
+			case Lwip_file_handle::BIND:
+				if (!print_endpoint(dst, _pcb->local_ip, _pcb->local_port, out_count))
 					return Read_result::READ_ERR_INVALID;
-				char const *ip_str = ipaddr_ntoa(&_pcb->local_ip);
-				/* TODO: [IPv6]:port */
-				out_count = Format::snprintf(dst.start, dst.num_bytes, "%s:%d\n",
-				                             ip_str, _pcb->local_port);
 				return Read_result::READ_OK;
-			}
 
 			case Lwip_file_handle::CONNECT: {
 				/* check if the PCB was connected */
@@ -937,27 +992,22 @@ class Lwip::Udp_socket_dir final :
 				return Read_result::READ_OK;
 			}
 
-			case Lwip_file_handle::REMOTE:
-				if (dst.num_bytes < ENDPOINT_STRLEN_MAX) {
-					Genode::error("VFS LwIP: accept file read buffer is too small");
-					result = Read_result::READ_ERR_INVALID;
-				} else
-				if (ip_addr_isany(&_pcb->remote_ip)) {
-					_packet_queue.head([&] (Packet &pkt) {
-						char const *ip_str = ipaddr_ntoa(&pkt.addr);
-						/* TODO: IPv6 */
-						out_count = Format::snprintf(dst.start, dst.num_bytes, "%s:%d\n",
-					                                 ip_str, pkt.port);
+			case Lwip_file_handle::REMOTE: {
+				auto print = [&] (ip_addr_t const &addr, u16_t port) {
+					if (print_endpoint(dst, addr, port, out_count)) {
 						result = Read_result::READ_OK;
-					});
-				} else {
-					char const *ip_str = ipaddr_ntoa(&_pcb->remote_ip);
-					/* TODO: [IPv6]:port */
-					out_count = Format::snprintf(dst.start, dst.num_bytes, "%s:%d\n",
-					                             ip_str, _pcb->remote_port);
-					result = Read_result::READ_OK;
-				}
+						return;
+					}
+					Genode::error("VFS LwIP: remote file read buffer is too small");
+					result = Read_result::READ_ERR_INVALID;
+				};
+
+				if (ip_addr_isany(&_pcb->remote_ip))
+					_packet_queue.head([&] (Packet &pkt) { print(pkt.addr, pkt.port); });
+				else
+					print(_pcb->remote_ip, _pcb->remote_port);
 				break;
+			}
 
 			case Lwip_file_handle::LOCATION:
 				/*
@@ -1011,30 +1061,18 @@ class Lwip::Udp_socket_dir final :
 			case Lwip_file_handle::REMOTE: {
 				if (!ip_addr_isany(&_pcb->remote_ip)) {
 					return Write_result::WRITE_ERR_INVALID;
-				} else {
-					char buf[ENDPOINT_STRLEN_MAX];
-					copy_cstring(buf, src.start, min(src.num_bytes + 1, sizeof(buf)));
-
-					_to_port = remove_port(buf);
-					if (ipaddr_aton(buf, &_to_addr)) {
-						out_count = src.num_bytes;
-						return Write_result::WRITE_OK;
-					}
+				} else
+				if (parse_endpoint(src, _to_addr, _to_port)) {
+					out_count = src.num_bytes;
+					return Write_result::WRITE_OK;
 				}
 				break;
 			}
 
 			case Lwip_file_handle::BIND: {
-				if (src.num_bytes < ENDPOINT_STRLEN_MAX) {
-					char buf[ENDPOINT_STRLEN_MAX];
-					ip_addr_t addr;
-					u16_t port;
-
-					copy_cstring(buf, src.start, min(src.num_bytes + 1, sizeof(buf)));
-					port = remove_port(buf);
-					if (!ipaddr_aton(buf, &addr))
-						break;
-
+				ip_addr_t addr;
+				u16_t port;
+				if (parse_endpoint(src, addr, port)) {
 					err_t err = udp_bind(_pcb, &addr, port);
 					if (err == ERR_OK) {
 						out_count = src.num_bytes;
@@ -1046,15 +1084,7 @@ class Lwip::Udp_socket_dir final :
 			}
 
 			case Lwip_file_handle::CONNECT: {
-				if (src.num_bytes < ENDPOINT_STRLEN_MAX) {
-					char buf[ENDPOINT_STRLEN_MAX];
-
-					copy_cstring(buf, src.start, min(src.num_bytes + 1, sizeof(buf)));
-
-					_to_port = remove_port(buf);
-					if (!ipaddr_aton(buf, &_to_addr))
-						break;
-
+				if (parse_endpoint(src, _to_addr, _to_port)) {
 					err_t err = udp_connect(_pcb, &_to_addr, _to_port);
 					if (err != ERR_OK) {
 						Genode::error("lwIP: failed to connect UDP socket, error ", (int)-err);
@@ -1353,12 +1383,8 @@ class Lwip::Tcp_socket_dir final :
 
 			case Lwip_file_handle::REMOTE:
 				if (state == READY) {
-					if (dst.num_bytes < ENDPOINT_STRLEN_MAX)
+					if (!print_endpoint(dst, _pcb->remote_ip, _pcb->remote_port, out_count))
 						return Read_result::READ_ERR_INVALID;
-					char const *ip_str = ipaddr_ntoa(&_pcb->remote_ip);
-					/* TODO: [IPv6]:port */
-					out_count = Format::snprintf(dst.start, dst.num_bytes, "%s:%d\n",
-					                             ip_str, _pcb->remote_port);
 					return Read_result::READ_OK;
 				} else {
 					out_count = 0;
@@ -1415,12 +1441,8 @@ class Lwip::Tcp_socket_dir final :
 			case Lwip_file_handle::LOCAL:
 			case Lwip_file_handle::BIND:
 				if (state != CLOSED) {
-					if (dst.num_bytes < ENDPOINT_STRLEN_MAX)
+					if (!print_endpoint(dst, _pcb->local_ip, _pcb->local_port, out_count))
 						return Read_result::READ_ERR_INVALID;
-					char const *ip_str = ipaddr_ntoa(&_pcb->local_ip);
-					/* TODO: [IPv6]:port */
-					out_count = Format::snprintf(dst.start, dst.num_bytes,
-					                             "%s:%d\n", ip_str, _pcb->local_port);
 					return Read_result::READ_OK;
 				}
 				break;
@@ -1520,15 +1542,10 @@ class Lwip::Tcp_socket_dir final :
 				break;
 
 			case Lwip_file_handle::BIND:
-				if ((state == NEW) && (src.num_bytes < ENDPOINT_STRLEN_MAX)) {
-					char buf[ENDPOINT_STRLEN_MAX];
+				if (state == NEW) {
 					ip_addr_t addr;
 					u16_t port = 0;
-
-					Genode::copy_cstring(buf, src.start, min(src.num_bytes + 1, sizeof(buf)));
-
-					port = remove_port(buf);
-					if (!ipaddr_aton(buf, &addr))
+					if (!parse_endpoint(src, addr, port))
 						break;
 
 					err_t err = tcp_bind(_pcb, &addr, port);
@@ -1541,14 +1558,10 @@ class Lwip::Tcp_socket_dir final :
 				break;
 
 			case Lwip_file_handle::CONNECT:
-				if (((state == NEW) || (state == BOUND)) && (src.num_bytes < ENDPOINT_STRLEN_MAX-1)) {
-					char buf[ENDPOINT_STRLEN_MAX];
+				if ((state == NEW) || (state == BOUND)) {
 					ip_addr_t addr;
 					u16_t port = 0;
-
-					copy_cstring(buf, src.start, min(src.num_bytes + 1, sizeof(buf)));
-					port = remove_port(buf);
-					if (!ipaddr_aton(buf, &addr))
+					if (!parse_endpoint(src, addr, port))
 						break;
 
 					err_t err = tcp_connect(_pcb, &addr, port, tcp_connect_callback);
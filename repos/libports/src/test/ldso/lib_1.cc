@@ -115,6 +115,39 @@ static void lib_1_attr_destructor_2()  { log(__func__, " ", Hex(--lib_1_pod_2));
 
 static void exception() { throw 666; }
 
+
+/*
+ * Initialized pointers to local objects of the shared lib are resolved by
+ * relative relocations, which the dynamic linker applies in a fast path.
+ * The pointer to the exported 'lib_1_global_1' object needs a symbolic
+ * relocation processed after the relative ones.
+ */
+static unsigned lib_1_reloc_data[4] { 1, 2, 3, 4 };
+
+static void *lib_1_reloc_table[] {
+	&lib_1_reloc_data[0], &lib_1_reloc_data[3], (void *)&exception,
+	&lib_1_pod_2, &lib_1_global_1 };
+
+
+static void test_relative_relocations()
+{
+	void * volatile * table = lib_1_reloc_table;
+
+	void * const expected[] {
+		&lib_1_reloc_data[0], &lib_1_reloc_data[3], (void *)&exception,
+		&lib_1_pod_2, &lib_1_global_1 };
+
+	unsigned mismatches = 0;
+	for (unsigned i = 0; i < sizeof(expected)/sizeof(expected[0]); i++)
+		if (table[i] != expected[i])
+			mismatches++;
+
+	if (mismatches)
+		error("relative relocations: ", mismatches, " mismatches");
+	else
+		log("relative relocations: ok");
+}
+
 void lib_1_exception() { throw Lib_1_exception(); }
 void lib_1_good() { }
 
@@ -152,4 +185,9 @@ void lib_1_test()
 	}
 	catch(...) { log("exception in another shared lib: caught"); }
 	log("");
+
+	log("Relocations of shared lib");
+	log("-------------------------");
+	test_relative_relocations();
+	log("");
 }
@@ -0,0 +1,140 @@
+/*
+ * \brief  Test of the libc's per-file-descriptor I/O buffers
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The test accesses a file byte by byte, once within a directory configured
+ * for buffered I/O and once within an unbuffered directory. Besides reporting
+ * the duration of both variants, it checks the coherence of the buffered
+ * data with 'lseek', 'fstat', 'pread', and 'mmap'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+enum { FILE_SIZE = 256*1024 };
+
+
+static unsigned long long now_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+}
+
+
+static char pattern(off_t pos) { return (char)(pos*7 + (pos >> 8)); }
+
+
+static void check(int condition, char const *path, char const *what)
+{
+	if (condition)
+		return;
+
+	printf("Error: %s: %s\n", path, what);
+	exit(-1);
+}
+
+
+static void test_coherence(int fd, char const *path)
+{
+	struct stat st;
+	char c = 0;
+
+	/* the file size includes bytes not yet written back */
+	check(lseek(fd, 0, SEEK_SET) == 0, path, "lseek to start failed");
+	check(write(fd, "A", 1) == 1, path, "write failed");
+	check(fstat(fd, &st) == 0 && st.st_size == FILE_SIZE, path, "unexpected file size");
+
+	/* read after write at the seek position */
+	check(read(fd, &c, 1) == 1 && c == pattern(1), path, "read after write failed");
+
+	/* pread observes the buffered write */
+	check(pread(fd, &c, 1, 0) == 1 && c == 'A', path, "pread failed");
+
+	/* seek backwards into read-ahead data, then overwrite it */
+	check(lseek(fd, FILE_SIZE/2, SEEK_SET) == FILE_SIZE/2, path, "lseek failed");
+	check(read(fd, &c, 1) == 1 && c == pattern(FILE_SIZE/2), path, "read failed");
+	check(lseek(fd, -1, SEEK_CUR) == FILE_SIZE/2, path, "relative lseek failed");
+	check(write(fd, "B", 1) == 1, path, "overwrite failed");
+	check(lseek(fd, -1, SEEK_CUR) == FILE_SIZE/2, path, "relative lseek failed");
+	check(read(fd, &c, 1) == 1 && c == 'B', path, "overwritten byte not read back");
+
+	/* appending extends the file as observed via SEEK_END */
+	check(lseek(fd, 0, SEEK_END) == FILE_SIZE, path, "lseek to end failed");
+	check(write(fd, "C", 1) == 1, path, "append failed");
+	check(lseek(fd, 0, SEEK_END) == FILE_SIZE + 1, path, "file not extended");
+
+	/* a mapping of the file reflects all writes */
+	char const *map = mmap(NULL, FILE_SIZE + 1, PROT_READ, MAP_PRIVATE, fd, 0);
+	check(map != MAP_FAILED, path, "mmap failed");
+	check(map[0] == 'A' && map[FILE_SIZE/2] == 'B' && map[FILE_SIZE] == 'C',
+	      path, "mapping lacks written data");
+	munmap((void *)map, FILE_SIZE + 1);
+
+	check(fsync(fd) == 0, path, "fsync failed");
+}
+
+
+static void test(char const *path)
+{
+	int const fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	check(fd >= 0, path, "open failed");
+
+	unsigned long long const start = now_us();
+
+	for (off_t pos = 0; pos < FILE_SIZE; pos++) {
+		char const c = pattern(pos);
+		check(write(fd, &c, 1) == 1, path, "byte-wise write failed");
+	}
+
+	unsigned long long const written = now_us();
+
+	check(lseek(fd, 0, SEEK_SET) == 0, path, "lseek failed");
+
+	for (off_t pos = 0; pos < FILE_SIZE; pos++) {
+		char c = 0;
+		check(read(fd, &c, 1) == 1 && c == pattern(pos), path, "byte-wise read failed");
+	}
+
+	char c = 0;
+	check(read(fd, &c, 1) == 0, path, "missing end of file");
+
+	unsigned long long const end = now_us();
+
+	printf("%-20s write %8llu us, read %8llu us\n",
+	       path, written - start, end - written);
+
+	test_coherence(fd, path);
+
+	check(close(fd) == 0, path, "close failed");
+
+	/* the content is complete after close */
+	struct stat st;
+	check(stat(path, &st) == 0 && st.st_size == FILE_SIZE + 1, path,
+	      "unexpected file size after close");
+}
+
+
+int main(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++)
+		test(argv[i]);
+
+	printf("--- test finished ---\n");
+	return 0;
+}
@@ -22,7 +22,11 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
 #include <sys/event.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
 
 /*
  * Information about the test.
@@ -485,6 +489,323 @@ int test_queue_disabled()
 }
 
 
+/*
+ * Test the epoll compatibility layer with a readable and a writable file.
+ */
+int test_epoll()
+{
+	char const *name = "Epoll test";
+	struct epoll_event event;
+	struct epoll_event results[2];
+	int ret = -1;
+
+	int const ep     = epoll_create1(0);
+	int const rtc_fd = open("/dev/rtc", O_RDONLY);
+	int const log_fd = open("/dev/log", O_WRONLY);
+
+	if (ep == -1 || rtc_fd == -1 || log_fd == -1) {
+		printf("%s: Failed to open files: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	event.events  = EPOLLIN;
+	event.data.fd = rtc_fd;
+	if (epoll_ctl(ep, EPOLL_CTL_ADD, rtc_fd, &event)) {
+		printf("%s: Failed to add rtc: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	/* a writable file registered only for input must not be reported */
+	event.events  = EPOLLIN;
+	event.data.fd = log_fd;
+	if (epoll_ctl(ep, EPOLL_CTL_ADD, log_fd, &event)) {
+		printf("%s: Failed to add log: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	if (epoll_wait(ep, results, 2, 1) != 1 || results[0].data.fd != rtc_fd
+	 || !(results[0].events & EPOLLIN)) {
+		printf("%s: Unexpected events for rtc\n", name);
+		goto out;
+	}
+
+	/* switch the interest from the rtc to the log */
+	event.events  = EPOLLOUT;
+	event.data.fd = log_fd;
+	if (epoll_ctl(ep, EPOLL_CTL_MOD, log_fd, &event)
+	 || epoll_ctl(ep, EPOLL_CTL_DEL, rtc_fd, NULL)) {
+		printf("%s: Failed to modify interest: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	if (epoll_wait(ep, results, 2, 1) != 1 || results[0].data.fd != log_fd
+	 || !(results[0].events & EPOLLOUT)) {
+		printf("%s: Unexpected events for log\n", name);
+		goto out;
+	}
+
+	if (epoll_ctl(ep, EPOLL_CTL_DEL, rtc_fd, NULL) != -1 || errno != ENOENT) {
+		printf("%s: Deleting twice did not fail\n", name);
+		goto out;
+	}
+
+	printf("%s: Test successful.\n", name);
+	ret = 0;
+
+out:
+	if (log_fd != -1) close(log_fd);
+	if (rtc_fd != -1) close(rtc_fd);
+	if (ep     != -1) close(ep);
+
+	return ret;
+}
+
+
+/*
+ * Return the events reported for a single file descriptor, -1 on error
+ */
+static int wait_single(int ep, int fd, int timeout_ms)
+{
+	struct epoll_event result;
+
+	int const n = epoll_wait(ep, &result, 1, timeout_ms);
+	if (n == -1)
+		return -1;
+
+	if (n == 0)
+		return 0;
+
+	return (result.data.fd == fd) ? (int)result.events : -1;
+}
+
+
+/*
+ * Test the epoll compatibility layer with a pipe
+ */
+int test_epoll_pipe()
+{
+	char const *name = "Epoll pipe test";
+	struct epoll_event event;
+	int pipefd[2] = { -1, -1 };
+	char c = 'x';
+	int ret = -1;
+
+	int const ep = epoll_create1(0);
+
+	if (ep == -1 || pipe(pipefd)) {
+		printf("%s: Failed to create pipe: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	event.events  = EPOLLIN;
+	event.data.fd = pipefd[0];
+	if (epoll_ctl(ep, EPOLL_CTL_ADD, pipefd[0], &event)) {
+		printf("%s: Failed to add pipe: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	if (wait_single(ep, pipefd[0], 1) != 0) {
+		printf("%s: Empty pipe reported readable\n", name);
+		goto out;
+	}
+
+	if (epoll_ctl(ep, EPOLL_CTL_ADD, pipefd[0], &event) != -1 || errno != EEXIST) {
+		printf("%s: Adding twice did not fail with EEXIST\n", name);
+		goto out;
+	}
+
+	event.data.fd = pipefd[1];
+	if (epoll_ctl(ep, EPOLL_CTL_MOD, pipefd[1], &event) != -1 || errno != ENOENT) {
+		printf("%s: Modifying unregistered fd did not fail with ENOENT\n", name);
+		goto out;
+	}
+
+	event.events = EPOLLOUT | EPOLLET;
+	if (epoll_ctl(ep, EPOLL_CTL_ADD, pipefd[1], &event) != -1 || errno != EINVAL) {
+		printf("%s: Edge-triggered registration did not fail\n", name);
+		goto out;
+	}
+
+	if (write(pipefd[1], &c, 1) != 1
+	 || !(wait_single(ep, pipefd[0], 1000) & EPOLLIN)) {
+		printf("%s: Pipe with data not reported readable\n", name);
+		goto out;
+	}
+
+	/* a oneshot registration is reported once until re-armed */
+	event.events  = EPOLLIN | EPOLLONESHOT;
+	event.data.fd = pipefd[0];
+	if (epoll_ctl(ep, EPOLL_CTL_MOD, pipefd[0], &event)
+	 || !(wait_single(ep, pipefd[0], 1000) & EPOLLIN)
+	 || wait_single(ep, pipefd[0], 1) != 0) {
+		printf("%s: Oneshot event not reported exactly once\n", name);
+		goto out;
+	}
+
+	if (epoll_ctl(ep, EPOLL_CTL_MOD, pipefd[0], &event)
+	 || !(wait_single(ep, pipefd[0], 1000) & EPOLLIN)) {
+		printf("%s: Oneshot event not re-armed\n", name);
+		goto out;
+	}
+
+	/* end of file is reported as readable */
+	event.events = EPOLLIN;
+	if (read(pipefd[0], &c, 1) != 1
+	 || epoll_ctl(ep, EPOLL_CTL_MOD, pipefd[0], &event)
+	 || close(pipefd[1])) {
+		printf("%s: Failed to drain pipe: %s\n", name, strerror(errno));
+		goto out;
+	}
+	pipefd[1] = -1;
+
+	if (!(wait_single(ep, pipefd[0], 1000) & EPOLLIN)
+	 || read(pipefd[0], &c, 1) != 0) {
+		printf("%s: End of file not reported\n", name);
+		goto out;
+	}
+
+	/* closing a file descriptor removes its registration */
+	close(pipefd[0]);
+	pipefd[0] = -1;
+	if (pipe(pipefd)) {
+		printf("%s: Failed to create pipe: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	event.data.fd = pipefd[0];
+	if (epoll_ctl(ep, EPOLL_CTL_ADD, pipefd[0], &event)) {
+		printf("%s: Registration survived close: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	printf("%s: Test successful.\n", name);
+	ret = 0;
+
+out:
+	if (pipefd[1] != -1) close(pipefd[1]);
+	if (pipefd[0] != -1) close(pipefd[0]);
+	if (ep        != -1) close(ep);
+
+	return ret;
+}
+
+
+/*
+ * Connect non-blocking to 'port' of 'server' and register for output
+ */
+static int connect_nonblocking(int ep, char const *server, unsigned port)
+{
+	struct sockaddr_in addr;
+	struct epoll_event event;
+
+	int const fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd == -1)
+		return -1;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons(port);
+	addr.sin_addr.s_addr = inet_addr(server);
+
+	event.events  = EPOLLOUT;
+	event.data.fd = fd;
+
+	if (fcntl(fd, F_SETFL, O_NONBLOCK)
+	 || (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) && errno != EINPROGRESS)
+	 || epoll_ctl(ep, EPOLL_CTL_ADD, fd, &event)) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+
+/*
+ * Test the epoll compatibility layer with sockets
+ *
+ * The server at 'server' is expected to echo the data received on port 80
+ * and to have no listener on port 81.
+ */
+int test_epoll_socket(char const *server)
+{
+	char const *name = "Epoll socket test";
+	struct epoll_event event;
+	int so_error = 0;
+	socklen_t len = sizeof(so_error);
+	char c = 'x';
+	int ret = -1;
+
+	int const ep = epoll_create1(0);
+	int fd       = -1;
+	int refused  = -1;
+
+	/* the server may not be ready yet, so the connect is retried */
+	for (int attempt = 0; ep != -1 && attempt < 10; attempt++) {
+
+		fd = connect_nonblocking(ep, server, 80);
+		if (fd == -1)
+			break;
+
+		if ((wait_single(ep, fd, 5000) & EPOLLOUT)
+		 && !getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len) && !so_error)
+			break;
+
+		close(fd);
+		fd = -1;
+		sleep(1);
+	}
+
+	if (ep == -1 || fd == -1) {
+		printf("%s: Failed to connect: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	event.events  = EPOLLIN;
+	event.data.fd = fd;
+	if (epoll_ctl(ep, EPOLL_CTL_MOD, fd, &event)
+	 || wait_single(ep, fd, 1) != 0) {
+		printf("%s: Socket without data reported readable\n", name);
+		goto out;
+	}
+
+	if (write(fd, &c, 1) != 1
+	 || !(wait_single(ep, fd, 5000) & EPOLLIN)
+	 || read(fd, &c, 1) != 1) {
+		printf("%s: Echoed data not reported readable\n", name);
+		goto out;
+	}
+
+	if (epoll_ctl(ep, EPOLL_CTL_DEL, fd, NULL)) {
+		printf("%s: Failed to delete socket: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	/* a failed connect is reported as hangup */
+	refused = connect_nonblocking(ep, server, 81);
+	if (refused == -1 || !(wait_single(ep, refused, 5000) & EPOLLOUT)
+	 || getsockopt(refused, SOL_SOCKET, SO_ERROR, &so_error, &len)
+	 || so_error != ECONNREFUSED) {
+		printf("%s: Refused connect not reported\n", name);
+		goto out;
+	}
+
+	if (!(wait_single(ep, refused, 1000) & EPOLLHUP)) {
+		printf("%s: Hangup not reported\n", name);
+		goto out;
+	}
+
+	printf("%s: Test successful.\n", name);
+	ret = 0;
+
+out:
+	if (refused != -1) close(refused);
+	if (fd      != -1) close(fd);
+	if (ep      != -1) close(ep);
+
+	return ret;
+}
+
+
 int main(int argc, char **argv)
 {
 	int retval = 0;
@@ -497,6 +818,12 @@ int main(int argc, char **argv)
 	retval += test_disable();
 	retval += test_enable();
 	retval += test_queue_disabled();
+	retval += test_epoll();
+	retval += test_epoll_pipe();
+
+	/* the socket test is enabled by passing the address of an echo server */
+	if (argc > 2)
+		retval += test_epoll_socket(argv[2]);
 
 	if (!retval)
 		printf("--- test succeeded ---\n");
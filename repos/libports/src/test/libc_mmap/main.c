@@ -0,0 +1,113 @@
+/*
+ * \brief  Benchmark of private file mappings
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The test maps the file given as argument privately, once read-only and
+ * once writeable, and measures the duration of the 'mmap' call and of
+ * touching each page of the mapping.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+enum { PAGE_SIZE = 4096 };
+
+
+static unsigned long long now_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+}
+
+
+static int measure(int fd, size_t size, int prot)
+{
+	char const * const name = (prot & PROT_WRITE) ? "read-write" : "read-only";
+
+	unsigned long long const start = now_us();
+
+	unsigned char * const ptr = mmap(NULL, size, prot, MAP_PRIVATE, fd, 0);
+	if (ptr == MAP_FAILED) {
+		perror("mmap failed");
+		return -1;
+	}
+
+	unsigned long long const mapped = now_us();
+
+	unsigned long sum = 0;
+	for (size_t offset = 0; offset < size; offset += PAGE_SIZE)
+		sum += ptr[offset];
+
+	unsigned long long const touched = now_us();
+
+	/* modifications must not reach the file */
+	if (prot & PROT_WRITE)
+		ptr[0] = (unsigned char)~ptr[0];
+
+	if (munmap(ptr, size)) {
+		perror("munmap failed");
+		return -1;
+	}
+
+	printf("%s: mmap of %zu MiB took %llu us, touching all pages took %llu us"
+	       " (checksum %lu)\n", name, size >> 20, mapped - start,
+	       touched - mapped, sum);
+
+	return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc != 2) {
+		fprintf(stderr, "usage: %s <file>\n", argv[0]);
+		return -1;
+	}
+
+	int const fd = open(argv[1], O_RDONLY);
+	if (fd < 0) {
+		perror("open failed");
+		return -1;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st)) {
+		perror("fstat failed");
+		return -1;
+	}
+
+	size_t const size = st.st_size & ~(size_t)(PAGE_SIZE - 1);
+
+	unsigned char first = 0;
+	if (pread(fd, &first, 1, 0) != 1) {
+		perror("pread failed");
+		return -1;
+	}
+
+	if (measure(fd, size, PROT_READ) || measure(fd, size, PROT_READ | PROT_WRITE))
+		return -1;
+
+	/* re-check the file content after the writeable private mapping */
+	unsigned char check = 0;
+	if (pread(fd, &check, 1, 0) != 1 || check != first) {
+		fprintf(stderr, "private mapping modified the file\n");
+		return -1;
+	}
+
+	close(fd);
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_mmap
+SRC_C  = main.c
+LIBS   = posix
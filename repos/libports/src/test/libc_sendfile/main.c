@@ -0,0 +1,360 @@
+/*
+ * \brief  Libc sendfile test
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The sender transmits a file three times over a TCP connection, first via a
+ * 'read'/'send' loop, then via 'sendfile' with the length prefix passed as
+ * header, and finally via 'sendfile' on a non-blocking socket with a trailer
+ * in addition. The receiver checks the received content against its own
+ * copy of the file and reports the throughput of each phase. In the last
+ * phase, it delays reading so that the sender stalls and has to resume the
+ * transfer from the number of bytes reported by 'sendfile'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+enum { PORT = 80, BUF_SIZE = 64*1024, NUM_PHASES = 3 };
+
+static uint64_t const TRAILER = 0x656c6966646e6573ULL;
+
+static char buf[BUF_SIZE];
+
+
+static unsigned long long now_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+}
+
+
+static char const *phase_name(unsigned phase)
+{
+	switch (phase) {
+	case 0:  return "read/send";
+	case 1:  return "sendfile";
+	default: return "non-blocking sendfile";
+	}
+}
+
+
+static int send_all(int sock, void const *ptr, size_t len)
+{
+	char const *p = ptr;
+	while (len) {
+		ssize_t const n = send(sock, p, len, 0);
+		if (n < 1) {
+			perror("send failed");
+			return -1;
+		}
+		p += n; len -= n;
+	}
+	return 0;
+}
+
+
+static int send_copied(int sock, int fd, uint64_t size)
+{
+	if (send_all(sock, &size, sizeof(size)))
+		return -1;
+
+	for (off_t offset = 0; ; ) {
+		ssize_t const n = pread(fd, buf, sizeof(buf), offset);
+		if (n < 0) {
+			perror("pread failed");
+			return -1;
+		}
+		if (n == 0)
+			return 0;
+
+		if (send_all(sock, buf, n))
+			return -1;
+
+		offset += n;
+	}
+}
+
+
+static int send_file(int sock, int fd, uint64_t size)
+{
+	struct iovec   header = { .iov_base = &size, .iov_len = sizeof(size) };
+	struct sf_hdtr hdtr   = { .headers = &header, .hdr_cnt = 1,
+	                          .trailers = NULL, .trl_cnt = 0 };
+
+	off_t sent = 0;
+	if (sendfile(fd, sock, 0, 0, &hdtr, &sent, 0)) {
+		perror("sendfile failed");
+		return -1;
+	}
+
+	if ((uint64_t)sent != sizeof(size) + size) {
+		fprintf(stderr, "sendfile sent %lld of %llu bytes\n",
+		        (long long)sent, (unsigned long long)(sizeof(size) + size));
+		return -1;
+	}
+	return 0;
+}
+
+
+/*
+ * Send header, file, and trailer via a non-blocking socket
+ *
+ * Whenever 'sendfile' stalls, the transfer is resumed by skipping the
+ * number of bytes reported via 'sbytes'. The 'nbytes' argument is always
+ * zero, which denotes the transfer up to the end of the file.
+ */
+static int send_file_nonblocking(int sock, int fd, uint64_t size)
+{
+	uint64_t const trailer = TRAILER;
+
+	off_t const total = sizeof(size) + size + sizeof(trailer);
+
+	int const flags = fcntl(sock, F_GETFL);
+	if (flags == -1 || fcntl(sock, F_SETFL, flags | O_NONBLOCK) == -1) {
+		perror("fcntl failed");
+		return -1;
+	}
+
+	unsigned stalls = 0;
+
+	for (off_t done = 0; done < total; ) {
+
+		off_t const header_done  = (done < (off_t)sizeof(size)) ? done : (off_t)sizeof(size);
+		off_t const body_done    = (done - header_done < (off_t)size)
+		                         ? done - header_done : (off_t)size;
+		off_t const trailer_done = done - header_done - body_done;
+
+		struct iovec header_iov = {
+			.iov_base = (char *)&size + header_done,
+			.iov_len  = sizeof(size) - header_done };
+
+		struct iovec trailer_iov = {
+			.iov_base = (char *)&trailer + trailer_done,
+			.iov_len  = sizeof(trailer) - trailer_done };
+
+		struct sf_hdtr hdtr = { .headers  = &header_iov,  .hdr_cnt = 1,
+		                        .trailers = &trailer_iov, .trl_cnt = 1 };
+
+		off_t sent = 0;
+		if (sendfile(fd, sock, body_done, 0, &hdtr, &sent, 0) == 0) {
+			if (done + sent != total) {
+				fprintf(stderr, "sendfile returned after %lld of %lld bytes\n",
+				        (long long)(done + sent), (long long)total);
+				return -1;
+			}
+			done += sent;
+			break;
+		}
+
+		if (errno != EAGAIN) {
+			perror("sendfile failed");
+			return -1;
+		}
+
+		done += sent;
+		stalls++;
+
+		struct pollfd pfd = { .fd = sock, .events = POLLOUT, .revents = 0 };
+		if (poll(&pfd, 1, -1) != 1) {
+			perror("poll failed");
+			return -1;
+		}
+	}
+
+	if (fcntl(sock, F_SETFL, flags) == -1) {
+		perror("fcntl failed");
+		return -1;
+	}
+
+	printf("non-blocking sendfile stalled %u times\n", stalls);
+
+	if (!stalls) {
+		fprintf(stderr, "non-blocking sendfile never stalled\n");
+		return -1;
+	}
+	return 0;
+}
+
+
+static int test_send(char const *host, int fd, uint64_t size)
+{
+	/* give the receiver time to listen */
+	usleep(2000000);
+
+	int const sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (sock < 0) {
+		perror("`socket` failed");
+		return -1;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = inet_addr(host);
+	addr.sin_port        = htons(PORT);
+
+	if (connect(sock, (struct sockaddr *)&addr, sizeof(addr))) {
+		perror("`connect` failed");
+		return -1;
+	}
+
+	for (unsigned phase = 0; phase < NUM_PHASES; phase++) {
+
+		unsigned long long const start = now_us();
+
+		int const res = (phase == 0) ? send_copied(sock, fd, size)
+		              : (phase == 1) ? send_file(sock, fd, size)
+		              :                send_file_nonblocking(sock, fd, size);
+		if (res)
+			return -1;
+
+		printf("sent %s: %llu bytes in %llu us\n", phase_name(phase),
+		       (unsigned long long)size, now_us() - start);
+	}
+
+	/* let the receiver drain the connection before closing */
+	usleep(2000000);
+	close(sock);
+	return 0;
+}
+
+
+static int recv_all(int sock, void *ptr, size_t len)
+{
+	char *p = ptr;
+	while (len) {
+		ssize_t const n = recv(sock, p, len, 0);
+		if (n < 1) {
+			perror("recv failed");
+			return -1;
+		}
+		p += n; len -= n;
+	}
+	return 0;
+}
+
+
+static int test_recv(int fd)
+{
+	int const sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (sock < 0) {
+		perror("`socket` failed");
+		return -1;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = INADDR_ANY;
+	addr.sin_port        = htons(PORT);
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) || listen(sock, 1)) {
+		perror("`bind` or `listen` failed");
+		return -1;
+	}
+
+	int const client = accept(sock, NULL, NULL);
+	if (client < 0) {
+		perror("`accept` failed");
+		return -1;
+	}
+
+	static char expected[BUF_SIZE];
+
+	for (unsigned phase = 0; phase < NUM_PHASES; phase++) {
+
+		uint64_t size = 0;
+		if (recv_all(client, &size, sizeof(size)))
+			return -1;
+
+		/* let the non-blocking sender stall */
+		if (phase == 2)
+			usleep(1000000);
+
+		unsigned long long const start = now_us();
+
+		for (uint64_t offset = 0; offset < size; ) {
+
+			size_t const len = (size - offset < sizeof(buf))
+			                 ? (size_t)(size - offset) : sizeof(buf);
+
+			if (recv_all(client, buf, len))
+				return -1;
+
+			if (pread(fd, expected, len, offset) != (ssize_t)len
+			 || memcmp(buf, expected, len)) {
+				fprintf(stderr, "%s: mismatch at offset %llu\n",
+				        phase_name(phase), (unsigned long long)offset);
+				return -1;
+			}
+			offset += len;
+		}
+
+		unsigned long long const duration = now_us() - start;
+
+		/* the trailer must follow the complete file */
+		if (phase == 2) {
+			uint64_t trailer = 0;
+			if (recv_all(client, &trailer, sizeof(trailer)))
+				return -1;
+
+			if (trailer != TRAILER) {
+				fprintf(stderr, "%s: trailer mismatch\n", phase_name(phase));
+				return -1;
+			}
+		}
+
+		printf("received %s: %llu bytes, %llu KiB/s\n", phase_name(phase),
+		       (unsigned long long)size,
+		       (size*1000000ULL/1024)/(duration ? duration : 1));
+	}
+
+	close(client);
+	return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+	int const receiver = (argc == 2 && strcmp(argv[0], "recv") == 0);
+	int const sender   = (argc == 3 && strcmp(argv[0], "send") == 0);
+
+	if (!receiver && !sender) {
+		fprintf(stderr, "usage: recv <file> | send <host> <file>\n");
+		return -1;
+	}
+
+	char const * const path = argv[argc - 1];
+
+	int const fd = open(path, O_RDONLY);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st)) {
+		perror("could not open file");
+		return -1;
+	}
+
+	return receiver ? test_recv(fd) : test_send(argv[1], fd, st.st_size);
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_sendfile
+SRC_C  = main.c
+LIBS   = posix
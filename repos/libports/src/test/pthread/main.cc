@@ -14,6 +14,7 @@
 
 /* libc include */
 #include <pthread.h>
+#include <pthread_np.h>
 #include <semaphore.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -21,6 +22,8 @@
 #include <unistd.h>
 #include <string.h>
 #include <errno.h>
+#include <time.h>
+#include <sys/cpuset.h>
 
 /* Genode includes */
 #include <base/log.h>
@@ -1194,6 +1197,102 @@ static void test_thread_local_destructor()
 }
 
 
+static void *thread_affinity_func(void *arg)
+{
+	cpuset_t *cpuset = (cpuset_t *)arg;
+
+	if (pthread_getaffinity_np(pthread_self(), sizeof(*cpuset), cpuset) != 0)
+		CPU_ZERO(cpuset);
+
+	return nullptr;
+}
+
+
+static void test_affinity()
+{
+	printf("main thread: test CPU affinity\n");
+
+	cpuset_t cpuset;
+	CPU_ZERO(&cpuset);
+
+	if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != EINVAL) {
+		printf("error: empty CPU set not rejected\n");
+		exit(-1);
+	}
+
+	CPU_SET(0, &cpuset);
+
+	if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+		printf("error: pthread_setaffinity_np() failed\n");
+		exit(-1);
+	}
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+
+	cpuset_t reported;
+	CPU_ZERO(&reported);
+
+	pthread_t t;
+	pthread_create(&t, &attr, thread_affinity_func, &reported);
+	pthread_join(t, nullptr);
+	pthread_attr_destroy(&attr);
+
+	if (!CPU_ISSET(0, &reported) || CPU_COUNT(&reported) != 1) {
+		printf("error: pthread does not execute on the requested CPU\n");
+		exit(-1);
+	}
+}
+
+
+static void *thread_create_latency_func(void *arg)
+{
+	return arg;
+}
+
+
+/*
+ * Measure the latency of creating and joining short-lived pthreads, which
+ * benefits from the '<pthread pool="..."/>' configuration of the libc.
+ */
+static void test_create_latency()
+{
+	enum { ROUNDS = 1000 };
+
+	auto now_us = [] {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec*1'000'000ull + ts.tv_nsec/1000;
+	};
+
+	unsigned long long const start = now_us();
+
+	for (uintptr_t i = 0; i < ROUNDS; i++) {
+
+		pthread_t  t;
+		void      *retval;
+
+		if (pthread_create(&t, 0, thread_create_latency_func, (void*)i) != 0) {
+			printf("error: pthread_create() failed\n");
+			exit(-1);
+		}
+
+		pthread_join(t, &retval);
+
+		if (retval != (void*)i) {
+			printf("error: return value does not match\n");
+			exit(-1);
+		}
+	}
+
+	unsigned long long const duration = now_us() - start;
+
+	printf("main thread: created and joined %u pthreads in %llu us (%llu us each)\n",
+	       (unsigned)ROUNDS, duration, duration/ROUNDS);
+}
+
+
 /* test_pthread_once() counters */
 static int volatile once_init, once_round, once_round_complete;
 
@@ -1364,6 +1463,8 @@ int main(int argc, char **argv)
 	test_tls();
 	test_thread_local_destructor();
 	test_pthread_once();
+	test_affinity();
+	test_create_latency();
 
 	printf("--- returning from main ---\n");
 	return 0;
@@ -0,0 +1,168 @@
+/*
+ * \brief  Contention benchmark of pthread synchronization primitives
+ * \author agent
+ * \date   2026-10-18
+ *
+ * For 1 to 16 threads, the benchmark measures the throughput of
+ *
+ * - a mutex protecting a shared counter,
+ * - a readers-writer lock with one write access per 16 read accesses, and
+ * - a condition variable passing a token around all threads.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+enum { MAX_THREADS = 16, OPS_PER_THREAD = 100000, TOKEN_ROUNDS = 2000 };
+
+
+static unsigned long long now_us()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+}
+
+
+struct Shared
+{
+	pthread_mutex_t  mutex   = PTHREAD_MUTEX_INITIALIZER;
+	pthread_rwlock_t rwlock  = PTHREAD_RWLOCK_INITIALIZER;
+	pthread_cond_t   cond    = PTHREAD_COND_INITIALIZER;
+
+	unsigned long counter     = 0;
+	unsigned long turn        = 0;
+	unsigned      num_threads = 0;
+};
+
+
+struct Worker
+{
+	Shared   *shared;
+	unsigned  index;
+};
+
+
+static void *mutex_func(void *arg)
+{
+	Shared &shared = *((Worker *)arg)->shared;
+
+	for (unsigned i = 0; i < OPS_PER_THREAD; i++) {
+		pthread_mutex_lock(&shared.mutex);
+		shared.counter++;
+		pthread_mutex_unlock(&shared.mutex);
+	}
+	return nullptr;
+}
+
+
+static void *rwlock_func(void *arg)
+{
+	Shared &shared = *((Worker *)arg)->shared;
+
+	unsigned long volatile sum = 0;
+
+	for (unsigned i = 0; i < OPS_PER_THREAD; i++) {
+		if (i % 16 == 0) {
+			pthread_rwlock_wrlock(&shared.rwlock);
+			shared.counter++;
+		} else {
+			pthread_rwlock_rdlock(&shared.rwlock);
+			sum = sum + shared.counter;
+		}
+		pthread_rwlock_unlock(&shared.rwlock);
+	}
+	return nullptr;
+}
+
+
+static void *cond_func(void *arg)
+{
+	Worker &worker = *(Worker *)arg;
+	Shared &shared = *worker.shared;
+
+	pthread_mutex_lock(&shared.mutex);
+
+	for (unsigned i = 0; i < TOKEN_ROUNDS; i++) {
+
+		while (shared.turn % shared.num_threads != worker.index)
+			pthread_cond_wait(&shared.cond, &shared.mutex);
+
+		shared.turn++;
+		shared.counter++;
+		pthread_cond_broadcast(&shared.cond);
+	}
+
+	pthread_mutex_unlock(&shared.mutex);
+	return nullptr;
+}
+
+
+static void measure(char const *name, void *(*func)(void *),
+                    unsigned num_threads, unsigned long expected_ops)
+{
+	Shared shared { };
+	shared.num_threads = num_threads;
+
+	Worker    workers[MAX_THREADS] { };
+	pthread_t threads[MAX_THREADS];
+
+	unsigned long long const start = now_us();
+
+	for (unsigned i = 0; i < num_threads; i++) {
+		workers[i] = Worker { &shared, i };
+		if (pthread_create(&threads[i], nullptr, func, &workers[i])) {
+			printf("Error: pthread_create failed\n");
+			exit(-1);
+		}
+	}
+
+	for (unsigned i = 0; i < num_threads; i++)
+		pthread_join(threads[i], nullptr);
+
+	unsigned long long const duration = now_us() - start;
+
+	pthread_cond_destroy(&shared.cond);
+	pthread_rwlock_destroy(&shared.rwlock);
+	pthread_mutex_destroy(&shared.mutex);
+
+	if (shared.counter != expected_ops) {
+		printf("Error: %s counted %lu operations, expected %lu\n",
+		       name, shared.counter, expected_ops);
+		exit(-1);
+	}
+
+	unsigned long const total_ops = (func == cond_func)
+	                              ? shared.counter
+	                              : (unsigned long)num_threads*OPS_PER_THREAD;
+
+	printf("%-6s threads=%2u: %8lu ops in %8llu us, %9llu ops/s\n",
+	       name, num_threads, total_ops, duration,
+	       total_ops*1000000ULL/(duration ? duration : 1));
+}
+
+
+int main(int, char **)
+{
+	printf("--- pthread contention benchmark ---\n");
+
+	for (unsigned n = 1; n <= MAX_THREADS; n *= 2) {
+		measure("mutex",  mutex_func,  n, (unsigned long)n*OPS_PER_THREAD);
+		measure("rwlock", rwlock_func, n, (unsigned long)n*((OPS_PER_THREAD + 15)/16));
+		measure("cond",   cond_func,   n, (unsigned long)n*TOKEN_ROUNDS);
+	}
+
+	printf("--- pthread contention benchmark finished ---\n");
+	return 0;
+}
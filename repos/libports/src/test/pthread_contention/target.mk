@@ -0,0 +1,3 @@
+TARGET = test-pthread_contention
+SRC_CC = main.cc
+LIBS   = posix
@@ -0,0 +1,229 @@
+/*
+ * \brief  Libc UDP packets-per-second benchmark
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The sender transmits a stream of small datagrams per phase, the receiver
+ * reports the rate of received datagrams. The first phase transfers one
+ * datagram per 'sendto'/'recvfrom' call, the second phase uses batches of
+ * 'sendmmsg'/'recvmmsg'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+enum {
+	PORT         = 7,
+	PAYLOAD      = 64,
+	NUM_PACKETS  = 100000,
+	BATCH        = 32,
+	NUM_PHASES   = 2,
+	END_MARKERS  = 10,
+};
+
+struct packet
+{
+	unsigned char phase;
+	unsigned char end;
+	unsigned char payload[PAYLOAD - 2];
+};
+
+
+static unsigned phase_batch(unsigned phase) { return phase == 0 ? 1 : BATCH; }
+
+
+static unsigned long long now_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+}
+
+
+static int send_packets(int sock, struct sockaddr_in *addr,
+                        struct packet *packets, unsigned count, unsigned batch)
+{
+	if (batch == 1)
+		return sendto(sock, packets, sizeof(*packets), 0,
+		              (struct sockaddr *)addr, sizeof(*addr)) < 0 ? -1 : 1;
+
+	struct iovec   iov[BATCH];
+	struct mmsghdr msgs[BATCH];
+
+	memset(msgs, 0, sizeof(msgs));
+	for (unsigned i = 0; i < count; i++) {
+		iov[i].iov_base              = &packets[i];
+		iov[i].iov_len               = sizeof(packets[i]);
+		msgs[i].msg_hdr.msg_iov      = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen   = 1;
+		msgs[i].msg_hdr.msg_name     = addr;
+		msgs[i].msg_hdr.msg_namelen  = sizeof(*addr);
+	}
+	return sendmmsg(sock, msgs, count, 0);
+}
+
+
+static int test_send(char const *host)
+{
+	/* give the receiver time to bind */
+	usleep(2000000);
+
+	int const sock = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0) {
+		perror("`socket` failed");
+		return ~0;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = inet_addr(host);
+	addr.sin_port        = htons(PORT);
+
+	static struct packet packets[BATCH];
+
+	for (unsigned phase = 0; phase < NUM_PHASES; phase++) {
+
+		unsigned const batch = phase_batch(phase);
+
+		memset(packets, 0, sizeof(packets));
+		for (unsigned i = 0; i < BATCH; i++)
+			packets[i].phase = phase;
+
+		unsigned long long const start = now_us();
+
+		for (unsigned sent = 0; sent < NUM_PACKETS; ) {
+			int const n = send_packets(sock, &addr, packets, batch, batch);
+			if (n < 0) {
+				perror("send failed");
+				return ~0;
+			}
+			sent += n;
+		}
+
+		unsigned long long const duration = now_us() - start;
+
+		printf("sent phase %u (batch %u): %u packets in %llu us, %llu packets/s\n",
+		       phase, batch, NUM_PACKETS, duration,
+		       NUM_PACKETS*1000000ULL/(duration ? duration : 1));
+
+		/* end markers may get lost like any other datagram */
+		packets[0].end = 1;
+		for (unsigned i = 0; i < END_MARKERS; i++) {
+			send_packets(sock, &addr, packets, 1, 1);
+			usleep(100000);
+		}
+		packets[0].end = 0;
+	}
+
+	return 0;
+}
+
+
+static int test_recv(void)
+{
+	int const sock = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0) {
+		perror("`socket` failed");
+		return ~0;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = INADDR_ANY;
+	addr.sin_port        = htons(PORT);
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr))) {
+		perror("`bind` failed");
+		return ~0;
+	}
+
+	static struct packet packets[BATCH];
+	struct iovec   iov[BATCH];
+	struct mmsghdr msgs[BATCH];
+
+	for (unsigned phase = 0; phase < NUM_PHASES; phase++) {
+
+		unsigned const batch = phase_batch(phase);
+
+		unsigned long received = 0;
+		unsigned long long start = 0;
+		int end = 0;
+
+		while (!end) {
+
+			int n = 0;
+			if (batch == 1) {
+				n = recvfrom(sock, &packets[0], sizeof(packets[0]), 0, NULL, NULL) < 0 ? -1 : 1;
+			} else {
+				memset(msgs, 0, sizeof(msgs));
+				for (unsigned i = 0; i < batch; i++) {
+					iov[i].iov_base            = &packets[i];
+					iov[i].iov_len             = sizeof(packets[i]);
+					msgs[i].msg_hdr.msg_iov    = &iov[i];
+					msgs[i].msg_hdr.msg_iovlen = 1;
+				}
+				n = recvmmsg(sock, msgs, batch, MSG_WAITFORONE, NULL);
+			}
+
+			if (n < 0) {
+				perror("receive failed");
+				return ~0;
+			}
+
+			for (int i = 0; i < n; i++) {
+
+				/* ignore left-over end markers of the previous phase */
+				if (packets[i].phase != phase)
+					continue;
+
+				if (packets[i].end) {
+					end = 1;
+					break;
+				}
+
+				if (!received)
+					start = now_us();
+
+				received++;
+			}
+		}
+
+		unsigned long long const duration = now_us() - start;
+
+		printf("received phase %u (batch %u): %lu of %u packets, %llu packets/s\n",
+		       phase, batch, received, (unsigned)NUM_PACKETS,
+		       received*1000000ULL/(duration ? duration : 1));
+	}
+
+	return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc == 1 && strcmp(argv[0], "recv") == 0)
+		return test_recv();
+
+	if (argc == 2 && strcmp(argv[0], "send") == 0)
+		return test_send(argv[1]);
+
+	fprintf(stderr, "usage: recv | send <host>\n");
+	return ~0;
+}
@@ -0,0 +1,3 @@
+TARGET  = test-udp_pps
+LIBS   += posix libc
+SRC_C  += main.c
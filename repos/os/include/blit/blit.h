@@ -66,6 +66,21 @@ namespace Blit {
 	{
 		Slow::Blend::xrgb_a(dst, n, pixel, alpha);
 	}
+
+	/**
+	 * Convert texture to the pixel format of the surface by applying dithering
+	 *
+	 * The texture is placed at 'pos' within the surface. The surface pixel
+	 * type can be 'Pixel_rgb565', 'Pixel_rgb888', or 'Pixel_alpha8'. In
+	 * the latter case, the alpha channel of the texture is converted. Only
+	 * the clipping area of the surface is affected.
+	 */
+	template <typename PT>
+	static inline void dither(Surface<PT> &surface, Texture<Pixel_rgb888> const &texture,
+	                          Point pos)
+	{
+		_dither<Slow>(surface, texture, pos);
+	}
 }
 
 #endif /* _INCLUDE__BLIT_H_ */
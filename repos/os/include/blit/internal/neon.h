@@ -174,6 +174,7 @@ struct Blit::Neon
 	struct B2f;
 	struct B2f_flip;
 	struct Blend;
+	struct Dither;
 };
 
 
@@ -397,4 +398,78 @@ void Blit::Neon::Blend::xrgb_a(uint32_t *dst, unsigned n,
 		*dst = _mix(*dst, *pixel, *alpha);
 }
 
+
+struct Blit::Neon::Dither
+{
+	static inline void rgb565(uint16_t *, unsigned, uint32_t const *, Dither_row const &, unsigned);
+	static inline void xrgb  (uint32_t *, unsigned, uint32_t const *, Dither_row const &, unsigned);
+	static inline void alpha8(uint8_t  *, unsigned, uint8_t  const *, Dither_row const &, unsigned);
+
+	/**
+	 * Load 8 pixels as separate b, g, r, x planes and apply dither values
+	 */
+	__attribute__((optimize("-O3")))
+	static inline uint8x8x4_t _load_sub_8(uint32_t const *src, uint8_t const *dither)
+	{
+		uint8x8x4_t     p = vld4_u8((uint8_t const *)src);
+		uint8x8_t const d = vld1_u8(dither);
+
+		for (unsigned i = 0; i < 3; i++)
+			p.val[i] = vqsub_u8(p.val[i], d);
+
+		return p;
+	}
+};
+
+
+__attribute__((optimize("-O3")))
+void Blit::Neon::Dither::rgb565(uint16_t *dst, unsigned n, uint32_t const *src,
+                                Dither_row const &row, unsigned x)
+{
+	for (; n > 7; n -= 8, dst += 8, src += 8, x += 8) {
+
+		uint8x8x4_t const p = _load_sub_8(src, row.at(x));
+
+		uint16x8_t const
+			r = vshll_n_u8(vand_u8(p.val[2], vdup_n_u8(0xf8)), 8),
+			g = vshll_n_u8(vand_u8(p.val[1], vdup_n_u8(0xfc)), 3),
+			b = vmovl_u8(vshr_n_u8(p.val[0], 3));
+
+		vst1q_u16(dst, vorrq_u16(vorrq_u16(r, g), b));
+	}
+
+	for (; n--; x++)
+		*dst++ = row.rgb565(*src++, x);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Neon::Dither::xrgb(uint32_t *dst, unsigned n, uint32_t const *src,
+                              Dither_row const &row, unsigned x)
+{
+	for (; n > 7; n -= 8, dst += 8, src += 8, x += 8) {
+
+		uint8x8x4_t p = _load_sub_8(src, row.at(x));
+
+		p.val[3] = vdup_n_u8(0);
+
+		vst4_u8((uint8_t *)dst, p);
+	}
+
+	for (; n--; x++)
+		*dst++ = row.xrgb(*src++, x);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Neon::Dither::alpha8(uint8_t *dst, unsigned n, uint8_t const *src,
+                                Dither_row const &row, unsigned x)
+{
+	for (; n > 15; n -= 16, dst += 16, src += 16, x += 16)
+		vst1q_u8(dst, vqsubq_u8(vld1q_u8(src), vld1q_u8(row.at(x))));
+
+	for (; n--; x++)
+		*dst++ = row.alpha8(*src++, x);
+}
+
 #endif /* _INCLUDE__BLIT__INTERNAL__NEON_H_ */
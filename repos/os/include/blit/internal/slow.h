@@ -45,6 +45,7 @@ struct Blit::Slow
 	struct B2f;
 	struct B2f_flip;
 	struct Blend;
+	struct Dither;
 };
 
 
@@ -158,4 +159,39 @@ void Blit::Slow::Blend::xrgb_a(uint32_t *dst, unsigned n,
 		*dst = _mix(*dst, *pixel, *alpha);
 }
 
+
+struct Blit::Slow::Dither
+{
+	static inline void rgb565(uint16_t *, unsigned, uint32_t const *, Dither_row const &, unsigned);
+	static inline void xrgb  (uint32_t *, unsigned, uint32_t const *, Dither_row const &, unsigned);
+	static inline void alpha8(uint8_t  *, unsigned, uint8_t  const *, Dither_row const &, unsigned);
+};
+
+
+__attribute__((optimize("-O3")))
+void Blit::Slow::Dither::rgb565(uint16_t *dst, unsigned n, uint32_t const *src,
+                                Dither_row const &row, unsigned x)
+{
+	for (; n--; x++)
+		*dst++ = row.rgb565(*src++, x);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Slow::Dither::xrgb(uint32_t *dst, unsigned n, uint32_t const *src,
+                              Dither_row const &row, unsigned x)
+{
+	for (; n--; x++)
+		*dst++ = row.xrgb(*src++, x);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Slow::Dither::alpha8(uint8_t *dst, unsigned n, uint8_t const *src,
+                                Dither_row const &row, unsigned x)
+{
+	for (; n--; x++)
+		*dst++ = row.alpha8(*src++, x);
+}
+
 #endif /* _INCLUDE__BLIT__INTERNAL__SLOW_H_ */
@@ -158,6 +158,7 @@ struct Blit::Sse4
 	struct B2f;
 	struct B2f_flip;
 	struct Blend;
+	struct Dither;
 };
 
 
@@ -391,4 +392,105 @@ void Blit::Sse4::Blend::xrgb_a(uint32_t *dst, unsigned n,
 		*dst = _mix(*dst, *pixel, *alpha);
 }
 
+
+struct Blit::Sse4::Dither
+{
+	static inline void rgb565(uint16_t *, unsigned, uint32_t const *, Dither_row const &, unsigned);
+	static inline void xrgb  (uint32_t *, unsigned, uint32_t const *, Dither_row const &, unsigned);
+	static inline void alpha8(uint8_t  *, unsigned, uint8_t  const *, Dither_row const &, unsigned);
+
+	struct Masks
+	{
+		/* masks for distributing 8 dither values to the r, g, b bytes of 2x4 pixels */
+		__m128i const d0123 = _mm_set_epi8(-1, 3, 3, 3, -1, 2, 2, 2, -1, 1, 1, 1, -1, 0, 0, 0);
+		__m128i const d4567 = _mm_set_epi8(-1, 7, 7, 7, -1, 6, 6, 6, -1, 5, 5, 5, -1, 4, 4, 4);
+
+		__m128i const r = _mm_set1_epi32(0xf800);
+		__m128i const g = _mm_set1_epi32(0x07e0);
+		__m128i const b = _mm_set1_epi32(0x001f);
+	};
+
+	/**
+	 * Apply dither values to 2x4 pixels, leaving the upper byte untouched
+	 */
+	__attribute__((optimize("-O3")))
+	static inline void _sub_8(__m128i &p0, __m128i &p1, uint8_t const *dither,
+	                          Masks const &masks)
+	{
+		__m128i const d = _mm_loadl_epi64((__m128i const *)dither);
+
+		p0 = _mm_subs_epu8(p0, _mm_shuffle_epi8(d, masks.d0123));
+		p1 = _mm_subs_epu8(p1, _mm_shuffle_epi8(d, masks.d4567));
+	}
+
+	/**
+	 * Convert 4 xrgb pixels to rgb565 values in the lower 16 bits of each lane
+	 */
+	__attribute__((optimize("-O3")))
+	static inline __m128i _rgb565_4(__m128i const p, Masks const &masks)
+	{
+		return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 8), masks.r),
+		                                 _mm_and_si128(_mm_srli_epi32(p, 5), masks.g)),
+		                                 _mm_and_si128(_mm_srli_epi32(p, 3), masks.b));
+	}
+};
+
+
+__attribute__((optimize("-O3")))
+void Blit::Sse4::Dither::rgb565(uint16_t *dst, unsigned n, uint32_t const *src,
+                                Dither_row const &row, unsigned x)
+{
+	Masks const masks { };
+
+	for (; n > 7; n -= 8, dst += 8, src += 8, x += 8) {
+		__m128i p0 = _mm_loadu_si128((__m128i const *)src),
+		        p1 = _mm_loadu_si128((__m128i const *)src + 1);
+
+		_sub_8(p0, p1, row.at(x), masks);
+
+		_mm_storeu_si128((__m128i *)dst, _mm_packus_epi32(_rgb565_4(p0, masks),
+		                                                  _rgb565_4(p1, masks)));
+	}
+
+	for (; n--; x++)
+		*dst++ = row.rgb565(*src++, x);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Sse4::Dither::xrgb(uint32_t *dst, unsigned n, uint32_t const *src,
+                              Dither_row const &row, unsigned x)
+{
+	Masks const masks { };
+
+	__m128i const rgb = _mm_set1_epi32(0xffffff);
+
+	for (; n > 7; n -= 8, dst += 8, src += 8, x += 8) {
+		__m128i p0 = _mm_loadu_si128((__m128i const *)src),
+		        p1 = _mm_loadu_si128((__m128i const *)src + 1);
+
+		_sub_8(p0, p1, row.at(x), masks);
+
+		_mm_storeu_si128((__m128i *)dst,     _mm_and_si128(p0, rgb));
+		_mm_storeu_si128((__m128i *)dst + 1, _mm_and_si128(p1, rgb));
+	}
+
+	for (; n--; x++)
+		*dst++ = row.xrgb(*src++, x);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Sse4::Dither::alpha8(uint8_t *dst, unsigned n, uint8_t const *src,
+                                Dither_row const &row, unsigned x)
+{
+	for (; n > 15; n -= 16, dst += 16, src += 16, x += 16)
+		_mm_storeu_si128((__m128i *)dst,
+		                 _mm_subs_epu8(_mm_loadu_si128((__m128i const *)src),
+		                               _mm_loadu_si128((__m128i const *)row.at(x))));
+
+	for (; n--; x++)
+		*dst++ = row.alpha8(*src++, x);
+}
+
 #endif /* _INCLUDE__BLIT__INTERNAL__SSE3_H_ */
@@ -18,6 +18,9 @@
 #include <os/texture.h>
 #include <os/surface.h>
 #include <os/pixel_rgb888.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_alpha8.h>
+#include <util/dither_matrix.h>
 
 namespace Blit {
 
@@ -129,6 +132,118 @@ namespace Blit {
 
 		surface.flush_pixels(dst_rect);
 	}
+
+	/**
+	 * Ordered-dither offsets of one pixel line
+	 *
+	 * The 16 values of a row of the dither matrix are stored twice so that
+	 * SIMD kernels can load up to 16 consecutive values starting at any
+	 * x position.
+	 */
+	struct Dither_row
+	{
+		uint8_t v[32];
+
+		Dither_row(unsigned y)
+		{
+			Dither_matrix::Row const row = Dither_matrix::row(y);
+			for (unsigned i = 0; i < 32; i++)
+				v[i] = uint8_t(row.value(i) >> 4);
+		}
+
+		uint8_t const *at(unsigned x) const { return &v[x & 0xf]; }
+
+		static uint8_t _sub(unsigned c, unsigned v) { return uint8_t(c > v ? c - v : 0); }
+
+		/*
+		 * Scalar conversion of a single pixel at position x, used as reference
+		 * and for the remainder of lines processed by SIMD kernels
+		 */
+
+		uint16_t rgb565(uint32_t p, unsigned x) const
+		{
+			unsigned const d = *at(x),
+			               r = _sub((p >> 16) & 0xff, d),
+			               g = _sub((p >>  8) & 0xff, d),
+			               b = _sub( p        & 0xff, d);
+
+			return uint16_t(((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3));
+		}
+
+		uint32_t xrgb(uint32_t p, unsigned x) const
+		{
+			unsigned const d = *at(x);
+
+			return (_sub((p >> 16) & 0xff, d) << 16)
+			     | (_sub((p >>  8) & 0xff, d) <<  8)
+			     |  _sub( p        & 0xff, d);
+		}
+
+		uint8_t alpha8(uint8_t a, unsigned x) const { return _sub(a, *at(x)); }
+	};
+
+	template <typename OP>
+	static inline void _dither_line(Pixel_rgb565 *dst, Pixel_rgb888 const *src,
+	                                uint8_t const *, unsigned n,
+	                                Dither_row const &row, unsigned x)
+	{
+		OP::Dither::rgb565((uint16_t *)dst, n, (uint32_t const *)src, row, x);
+	}
+
+	template <typename OP>
+	static inline void _dither_line(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                                uint8_t const *, unsigned n,
+	                                Dither_row const &row, unsigned x)
+	{
+		OP::Dither::xrgb((uint32_t *)dst, n, (uint32_t const *)src, row, x);
+	}
+
+	template <typename OP>
+	static inline void _dither_line(Pixel_alpha8 *dst, Pixel_rgb888 const *,
+	                                uint8_t const *alpha, unsigned n,
+	                                Dither_row const &row, unsigned x)
+	{
+		OP::Dither::alpha8((uint8_t *)dst, n, alpha, row, x);
+	}
+
+	template <typename OP, typename PT>
+	static inline void _dither(Surface<PT>                 &surface,
+	                           Texture<Pixel_rgb888> const &texture, Point pos)
+	{
+		bool const alpha_surface = (PT::format() == Surface_base::ALPHA8);
+
+		if (alpha_surface && !texture.alpha()) {
+			warning("dithering of alpha values requires texture with alpha channel");
+			return;
+		}
+
+		Rect const rect = Rect::intersect(surface.clip(), Rect { pos, texture.size() });
+		if (!rect.valid())
+			return;
+
+		unsigned const dst_w = surface.size().w,
+		               src_w = texture.size().w;
+
+		Point const src_p1 = rect.p1() - pos;
+
+		size_t const src_offset = size_t(src_p1.y)*src_w + src_p1.x;
+
+		PT                 *dst   = surface.addr() + size_t(rect.y1())*dst_w + rect.x1();
+		Pixel_rgb888 const *src   = texture.pixel() + src_offset;
+		uint8_t      const *alpha = texture.alpha() ? texture.alpha() + src_offset : nullptr;
+
+		for (int y = rect.y1(); y <= rect.y2(); y++) {
+
+			_dither_line<OP>(dst, src, alpha, rect.w(), Dither_row(y), rect.x1());
+
+			dst += dst_w;
+			src += src_w;
+			if (alpha)
+				alpha += src_w;
+		}
+
+		surface.flush_pixels(rect);
+	}
 }
 
 
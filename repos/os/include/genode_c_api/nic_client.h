@@ -50,6 +50,52 @@ struct genode_nic_client *genode_nic_client_create(char const *label);
 void   genode_nic_client_destroy(struct genode_nic_client *);
 
 
+/*************
+ ** Offload **
+ *************/
+
+/**
+ * Offload features, see 'nic_session/offload.h'
+ */
+struct genode_nic_offload_features
+{
+	bool csum;
+	bool gso;
+};
+
+enum {
+	GENODE_NIC_OFFLOAD_CSUM_NEEDED = 1,
+	GENODE_NIC_OFFLOAD_CSUM_VALID  = 2,
+	GENODE_NIC_OFFLOAD_GSO_TCPV4   = 4,
+
+	GENODE_NIC_OFFLOAD_MAX_FRAME_SIZE = 64*1024,
+};
+
+/**
+ * Per-packet offload metadata
+ */
+struct genode_nic_offload
+{
+	unsigned char  flags;
+	unsigned short gso_size;
+	unsigned short csum_start;
+	unsigned short csum_offset;
+};
+
+/**
+ * Create NIC client that accepts the given offload metadata on reception
+ */
+struct genode_nic_client *
+genode_nic_client_create_offload(char const *label,
+                                 struct genode_nic_offload_features);
+
+/**
+ * Retrieve offload features accepted by the server for transmission
+ */
+struct genode_nic_offload_features
+genode_nic_client_offload(struct genode_nic_client *);
+
+
 /*************
  ** Session **
  *************/
@@ -87,6 +133,19 @@ bool genode_nic_client_tx_packet(struct genode_nic_client *,
                                  genode_nic_client_tx_packet_content_t,
                                  struct genode_nic_client_tx_packet_context *);
 
+/**
+ * Process transmission of a packet with offload metadata
+ *
+ * \param max_len  maximum frame size, up to GENODE_NIC_OFFLOAD_MAX_FRAME_SIZE
+ *
+ * \return true if progress was made
+ */
+bool genode_nic_client_tx_offload_packet(struct genode_nic_client *,
+                                         unsigned long max_len,
+                                         struct genode_nic_offload const *,
+                                         genode_nic_client_tx_packet_content_t,
+                                         struct genode_nic_client_tx_packet_context *);
+
 
 /******************************************
  ** Receive packets from the NIC session **
@@ -110,6 +169,19 @@ bool genode_nic_client_rx(struct genode_nic_client *,
                           genode_nic_client_rx_one_packet_t rx_one_packet,
                           struct genode_nic_client_rx_context *);
 
+typedef genode_nic_client_rx_result_t (*genode_nic_client_rx_one_offload_packet_t)
+	(struct genode_nic_client_rx_context *, char const *ptr, unsigned long len,
+	 struct genode_nic_offload const *);
+
+/**
+ * Process packet reception including offload metadata
+ *
+ * \return true if progress was made
+ */
+bool genode_nic_client_rx_offload(struct genode_nic_client *,
+                                  genode_nic_client_rx_one_offload_packet_t,
+                                  struct genode_nic_client_rx_context *);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
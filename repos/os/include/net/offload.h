@@ -0,0 +1,134 @@
+/*
+ * \brief  Software fallbacks for NIC offload metadata
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Whenever a receiver of offload metadata cannot delegate the work to the
+ * next hop or to a device, it falls back to these utilities.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NET__OFFLOAD_H_
+#define _NET__OFFLOAD_H_
+
+/* Genode includes */
+#include <nic_session/offload.h>
+#include <net/ipv4.h>
+#include <util/misc_math.h>
+
+namespace Net {
+
+	/**
+	 * Complete the partial L4 checksum of a frame with 'CSUM_NEEDED' metadata
+	 *
+	 * For IPv4 frames, the checksum covers the L4 data up to the end given by
+	 * the IPv4 total length, which excludes link-layer padding.
+	 *
+	 * \return false if the checksum location lies outside of the frame
+	 */
+	bool complete_checksum(Nic::Offload::Header const &header,
+	                       void                       *frame_base,
+	                       Genode::size_t              frame_size);
+
+	/**
+	 * Replace the L4 checksum of an IPv4 frame by the pseudo-header checksum
+	 *
+	 * \param l4_offset  frame offset of the TCP or UDP header
+	 * \param l4_size    size of the TCP or UDP packet including its header
+	 * \return           'CSUM_NEEDED' metadata for completing the checksum
+	 */
+	Nic::Offload::Header prepare_partial_checksum(void                 *frame_base,
+	                                              Genode::size_t        l4_offset,
+	                                              Genode::size_t        l4_size,
+	                                              Ipv4_packet::Protocol protocol,
+	                                              Ipv4_address          src,
+	                                              Ipv4_address          dst);
+
+	class Tcp_segmenter;
+}
+
+
+/**
+ * Splitter of a large TCP/IPv4 frame into MTU-sized segments
+ *
+ * Each segment receives a copy of the Ethernet, IPv4, and TCP headers of the
+ * large frame with the IPv4 length, identification, and checksum as well as
+ * the TCP sequence number, flags, and checksum adjusted.
+ */
+class Net::Tcp_segmenter
+{
+	public:
+
+		enum class Checksum {
+
+			/* compute the TCP checksum of each segment */
+			COMPLETE,
+
+			/* leave the pseudo-header checksum for 'CSUM_NEEDED' */
+			PARTIAL
+		};
+
+	private:
+
+		Genode::uint8_t const *_frame;
+		Genode::size_t         _ip_offset    { 0 };
+		Genode::size_t         _tcp_offset   { 0 };
+		Genode::size_t         _hdr_size     { 0 };
+		Genode::size_t         _payload_size { 0 };
+		Genode::size_t   const _mss;
+		bool                   _valid        { false };
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param mss  maximum number of TCP payload bytes per segment
+		 */
+		Tcp_segmenter(void const *frame_base, Genode::size_t frame_size,
+		              Genode::size_t mss);
+
+		/**
+		 * Return true if the frame is an unfragmented TCP/IPv4 frame
+		 */
+		bool valid() const { return _valid; }
+
+		unsigned num_segments() const
+		{
+			if (!_valid || !_payload_size)
+				return _valid ? 1 : 0;
+
+			return (unsigned)((_payload_size + _mss - 1) / _mss);
+		}
+
+		Genode::size_t segment_size(unsigned i) const
+		{
+			Genode::size_t const offset = i*_mss;
+			return _hdr_size + Genode::min(_mss, _payload_size - offset);
+		}
+
+		/**
+		 * Write segment 'i' to 'dst', which must hold 'segment_size(i)' bytes
+		 *
+		 * \return  offload metadata of the segment
+		 */
+		Nic::Offload::Header write_segment(unsigned i, void *dst,
+		                                   Checksum checksum) const;
+
+		/**
+		 * Call 'fn' for each segment with its index and size
+		 */
+		void for_each_segment(auto const &fn) const
+		{
+			for (unsigned i = 0; i < num_segments(); i++)
+				fn(i, segment_size(i));
+		}
+};
+
+#endif /* _NET__OFFLOAD_H_ */
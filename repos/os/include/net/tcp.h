@@ -98,8 +98,14 @@ class Net::Tcp_packet
 		bool     ack()         const { return Flags::Ack::get(flags()); };
 		bool     urg()         const { return Flags::Urg::get(flags()); };
 
-		void src_port(Port p) { _src_port = host_to_big_endian(p.value); }
-		void dst_port(Port p) { _dst_port = host_to_big_endian(p.value); }
+		void src_port(Port p)    { _src_port = host_to_big_endian(p.value); }
+		void dst_port(Port p)    { _dst_port = host_to_big_endian(p.value); }
+		void seq_nr(uint32_t v)  { _seq_nr   = host_to_big_endian(v); }
+		void flags(uint16_t v)   { _flags    = host_to_big_endian(v); }
+
+		void fin(bool v) { uint16_t f = flags(); Flags::Fin::set(f, v); flags(f); }
+		void psh(bool v) { uint16_t f = flags(); Flags::Psh::set(f, v); flags(f); }
+		void cwr(bool v) { uint16_t f = flags(); Flags::Cwr::set(f, v); flags(f); }
 
 		void src_port(Port p, Internet_checksum_diff &icd);
 		void dst_port(Port p, Internet_checksum_diff &icd);
@@ -18,6 +18,7 @@
 
 #include <os/packet_allocator.h>
 #include <base/log.h>
+#include <nic_session/offload.h>
 
 namespace Nic { struct Packet_allocator; }
 
@@ -38,6 +39,9 @@ namespace Nic { struct Packet_allocator; }
  * Genode::Packet_allocator. As DEFAULT_PACKET_SIZE is used for the
  * transmission-buffer calculation we could not change it without breaking the
  * API. OFFSET_PACKET_SIZE reflects the actual (usable) packet-buffer size.
+ *
+ * Packets of sessions with offloading may carry frames of up to
+ * 'Offload::MAX_FRAME_SIZE' bytes, which span multiple blocks.
  */
 struct Nic::Packet_allocator : Genode::Packet_allocator
 {
@@ -49,6 +53,9 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 
 	using size_t = Genode::size_t;
 
+	static constexpr size_t MAX_PACKET_SIZE =
+		Offload::MAX_FRAME_SIZE + sizeof(Offload::Header);
+
 	/**
 	 * Constructor
 	 *
@@ -59,7 +66,7 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 
 	Result try_alloc(size_t size) override
 	{
-		if (!size || size > OFFSET_PACKET_SIZE) {
+		if (!size || size > MAX_PACKET_SIZE) {
 			Genode::error("unsupported NIC packet size ", size);
 			return Error::DENIED;
 		}
@@ -83,7 +90,7 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 
 	void free(void *addr, size_t size) override
 	{
-		if (!size || size > OFFSET_PACKET_SIZE) {
+		if (!size || size > MAX_PACKET_SIZE) {
 			Genode::error("unsupported NIC packet size ", size);
 			return;
 		}
@@ -21,6 +21,7 @@
 #include <packet_stream_tx/packet_stream_tx.h>
 #include <packet_stream_rx/packet_stream_rx.h>
 #include <net/mac_address.h>
+#include <nic_session/offload.h>
 
 namespace Nic {
 
@@ -116,6 +117,14 @@ struct Nic::Session : Genode::Session
 	 */
 	virtual void link_state_sigh(Genode::Signal_context_capability sigh) = 0;
 
+	/**
+	 * Request offload features accepted by the server
+	 *
+	 * If the result is non-empty, all packets of the session are prefixed
+	 * with an 'Offload::Header'.
+	 */
+	virtual Offload::Features offload() { return { }; }
+
 	/*******************
 	 ** RPC interface **
 	 *******************/
@@ -126,9 +135,11 @@ struct Nic::Session : Genode::Session
 	GENODE_RPC(Rpc_link_state, bool, link_state);
 	GENODE_RPC(Rpc_link_state_sigh, void, link_state_sigh,
 	           Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_offload, Offload::Features, offload);
 
 	GENODE_RPC_INTERFACE(Rpc_mac_address, Rpc_link_state,
-	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap);
+	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap,
+	                     Rpc_offload);
 };
 
 #endif /* _INCLUDE__NIC_SESSION__NIC_SESSION_H_ */
@@ -0,0 +1,117 @@
+/*
+ * \brief  Offload metadata of NIC and uplink sessions
+ * \author agent
+ * \date   2026-10-18
+ *
+ * By default, packets of NIC and uplink sessions carry plain Ethernet frames.
+ * A client that is able to handle offload metadata announces the metadata it
+ * accepts within the packets it receives via the 'offload_csum' and
+ * 'offload_gso' session arguments. A server that supports offloading responds
+ * with the features it accepts in turn, reported by the 'offload' RPC
+ * function. If the reported feature set is non-empty, each packet of the
+ * session - in both directions - starts with an 'Offload::Header' followed by
+ * the Ethernet frame. A sender must not set header flags that are not
+ * accepted by the receiving side.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__NIC_SESSION__OFFLOAD_H_
+#define _INCLUDE__NIC_SESSION__OFFLOAD_H_
+
+#include <base/stdint.h>
+#include <base/output.h>
+#include <util/arg_string.h>
+
+namespace Nic { struct Offload; }
+
+
+struct Nic::Offload
+{
+	/**
+	 * Upper bound of frames carried by 'GSO_TCPV4' packets
+	 */
+	static constexpr Genode::size_t MAX_FRAME_SIZE = 64*1024;
+
+	struct Features
+	{
+		/*
+		 * Packets may carry partial checksums ('CSUM_NEEDED') or the
+		 * information that the checksums were verified ('CSUM_VALID')
+		 */
+		bool csum;
+
+		/*
+		 * Packets may carry TCP/IPv4 frames beyond the MTU ('GSO_TCPV4')
+		 */
+		bool gso;
+
+		bool any() const { return csum || gso; }
+
+		/**
+		 * Obtain features requested via session arguments
+		 */
+		static Features from_args(char const *args)
+		{
+			using Genode::Arg_string;
+			return { .csum = Arg_string::find_arg(args, "offload_csum").bool_value(false),
+			         .gso  = Arg_string::find_arg(args, "offload_gso").bool_value(false) };
+		}
+
+		Features operator & (Features const &other) const
+		{
+			return { .csum = csum && other.csum, .gso = gso && other.gso };
+		}
+
+		void print(Genode::Output &out) const
+		{
+			Genode::print(out, "csum=", csum, " gso=", gso);
+		}
+	};
+
+	struct Header
+	{
+		enum Flags : Genode::uint8_t
+		{
+			/*
+			 * The L4 checksum field at 'csum_start + csum_offset' holds
+			 * the folded checksum of the pseudo header only. The receiver
+			 * completes it by computing the internet checksum over the
+			 * frame starting at 'csum_start'.
+			 */
+			CSUM_NEEDED = 1,
+
+			/*
+			 * The sender verified the L3 and L4 checksums of the frame
+			 */
+			CSUM_VALID = 2,
+
+			/*
+			 * The frame is a TCP/IPv4 segment with more than 'gso_size'
+			 * payload bytes. The receiver splits it into segments of at
+			 * most 'gso_size' payload bytes each and computes their
+			 * checksums. The checksum fields of the large frame are
+			 * meaningless.
+			 */
+			GSO_TCPV4 = 4,
+		};
+
+		Genode::uint8_t  flags;
+		Genode::uint8_t  reserved;
+		Genode::uint16_t gso_size;     /* maximum TCP payload per segment */
+		Genode::uint16_t csum_start;   /* frame offset of the L4 header */
+		Genode::uint16_t csum_offset;  /* offset of the checksum field in L4 header */
+
+		bool csum_needed() const { return flags & CSUM_NEEDED; }
+		bool csum_valid()  const { return flags & CSUM_VALID; }
+		bool gso_tcpv4()   const { return flags & GSO_TCPV4; }
+
+	} __attribute__((packed));
+};
+
+#endif /* _INCLUDE__NIC_SESSION__OFFLOAD_H_ */
@@ -18,10 +18,48 @@
 #include <util/dither_matrix.h>
 #include <os/surface.h>
 #include <os/texture.h>
+#include <blit/blit.h>
 
 
 struct Dither_painter
 {
+	/*
+	 * Conversions of the common pixel formats are performed by the
+	 * vectorized kernels of the blit library
+	 */
+
+	static bool _blit(auto &, auto const &, Genode::Surface_base::Point) { return false; }
+
+	template <typename PT>
+	static bool _blit_rgb888(Genode::Surface<PT>                         &surface,
+	                         Genode::Texture<Genode::Pixel_rgb888> const &texture,
+	                         Genode::Surface_base::Point                  pos)
+	{
+		Blit::dither(surface, texture, pos);
+		return true;
+	}
+
+	static bool _blit(Genode::Surface<Genode::Pixel_rgb565>       &surface,
+	                  Genode::Texture<Genode::Pixel_rgb888> const &texture,
+	                  Genode::Surface_base::Point                  pos)
+	{
+		return _blit_rgb888(surface, texture, pos);
+	}
+
+	static bool _blit(Genode::Surface<Genode::Pixel_rgb888>       &surface,
+	                  Genode::Texture<Genode::Pixel_rgb888> const &texture,
+	                  Genode::Surface_base::Point                  pos)
+	{
+		return _blit_rgb888(surface, texture, pos);
+	}
+
+	static bool _blit(Genode::Surface<Genode::Pixel_alpha8>       &surface,
+	                  Genode::Texture<Genode::Pixel_rgb888> const &texture,
+	                  Genode::Surface_base::Point                  pos)
+	{
+		return texture.alpha() && _blit_rgb888(surface, texture, pos);
+	}
+
 	/*
 	 * Surface and texture must have the same size
 	 */
@@ -30,6 +68,9 @@ struct Dither_painter
 	                         Genode::Texture<SRC_PT>     const &texture,
 	                         Genode::Surface_base::Point const &pos)
 	{
+		if (_blit(surface, texture, pos))
+			return;
+
 		Genode::Surface_base::Rect const clipped = surface.clip();
 
 		if (!clipped.valid()) return;
@@ -37,13 +78,13 @@ struct Dither_painter
 		using Genode::min;
 		using Genode::max;
 
-		unsigned const dst_x = max(pos.x(), clipped.x1());
-		unsigned const dst_y = max(pos.y(), clipped.y1());
+		unsigned const dst_x = max(pos.x, clipped.x1());
+		unsigned const dst_y = max(pos.y, clipped.y1());
 
-		unsigned const dst_line_len = surface.size().w();
+		unsigned const dst_line_len = surface.size().w;
 		unsigned const dst_offset = dst_line_len*dst_y + dst_x;
 
-		unsigned const src_line_len = texture.size().w();
+		unsigned const src_line_len = texture.size().w;
 		unsigned const src_offset = src_line_len*clipped.y1() + clipped.x1();
 
 		DST_PT              *dst,       *dst_line       = surface.addr()  + dst_offset;
@@ -51,8 +92,8 @@ struct Dither_painter
 		unsigned char const *src_alpha, *src_alpha_line = texture.alpha() + src_offset;
 		bool          const  src_has_alpha = texture.alpha() != nullptr;
 
-		unsigned const x_max = min((unsigned)clipped.x2(), dst_x + texture.size().w() - 1);
-		unsigned const y_max = min((unsigned)clipped.y2(), dst_y + texture.size().h() - 1);
+		unsigned const x_max = min((unsigned)clipped.x2(), dst_x + texture.size().w - 1);
+		unsigned const y_max = min((unsigned)clipped.y2(), dst_y + texture.size().h - 1);
 
 		for (unsigned y = dst_y; y <= y_max; y++) {
 
@@ -154,7 +154,8 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 			addr_t max = ~0UL;
 
 			do {
-				for (addr_t i = _next & ~(cnt - 1); i < max; i += cnt) {
+				/* search naturally aligned ranges, 'cnt' need not be a power of two */
+				for (addr_t i = (_next / cnt) * cnt; i < max; i += cnt) {
 
 					bool occupied = false, done = false, denied = false;
 
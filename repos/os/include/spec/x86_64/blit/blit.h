@@ -31,6 +31,13 @@ namespace Blit {
 	}
 
 	static inline void blend_xrgb_a(auto &&... args) { Sse4::Blend::xrgb_a(args...); }
+
+	template <typename PT>
+	static inline void dither(Surface<PT> &surface, Texture<Pixel_rgb888> const &texture,
+	                          Point pos)
+	{
+		_dither<Sse4>(surface, texture, pos);
+	}
 }
 
 #endif /* _INCLUDE__SPEC__X86_64__BLIT_H_ */
@@ -26,11 +26,53 @@ namespace Terminal { template <typename> class Cell_array; }
  *              about the glyph and its attributes
  *
  * The 'CELL' type must have a default constructor and has to provide the
- * methods 'set_cursor()' and 'clear_cursor'.
+ * methods 'set_cursor()', 'clear_cursor', and 'has_cursor()'.
+ *
+ * Modifications are tracked at the granularity of cells. For each line, the
+ * range of modified columns is recorded. If scroll tracking is enabled,
+ * scroll operations do not invalidate the scrolled lines. Instead, the
+ * dirty state is moved along with the lines and the scroll operation is
+ * recorded such that the user of the cell array can implement it as a
+ * block move of already rendered pixels (see 'consume_scroll').
  */
 template <typename CELL>
 class Terminal::Cell_array
 {
+	public:
+
+		/**
+		 * Range of modified columns within a line
+		 */
+		struct Dirty_columns
+		{
+			unsigned first = ~0U, last = 0;
+
+			bool any() const { return first <= last; }
+
+			void mark(unsigned column)
+			{
+				first = min(first, column);
+				last  = max(last,  column);
+			}
+
+			void mark_all(unsigned num_cols) { first = 0; last = num_cols - 1; }
+
+			void clear() { first = ~0U; last = 0; }
+		};
+
+		/**
+		 * Scroll operation not yet reflected by the rendered pixels
+		 *
+		 * A positive 'lines' value refers to scrolling up, a negative value
+		 * to scrolling down.
+		 */
+		struct Scroll
+		{
+			int start, end, lines;
+
+			unsigned height() const { return unsigned(end - start + 1); }
+		};
+
 	private:
 
 		/*
@@ -43,7 +85,13 @@ class Terminal::Cell_array
 		unsigned   _num_lines;
 		Allocator &_alloc;
 		CELL     **_array      = nullptr;
-		bool      *_line_dirty = nullptr;
+
+		Dirty_columns *_line_dirty = nullptr;
+
+		bool _track_scrolling = false;
+		bool _scroll_pending  = false;
+
+		Scroll _scroll { 0, 0, 0 };
 
 		using Char_cell_line = CELL *;
 
@@ -56,27 +104,64 @@ class Terminal::Cell_array
 		void _mark_lines_as_dirty(int start, int end)
 		{
 			for (int line = start; line <= end; line++)
-				_line_dirty[line] = true;
+				_line_dirty[line].mark_all(_num_cols);
 		}
 
-		void _scroll_vertically(int start, int end, bool up)
+		template <typename T>
+		static void _rotate(T *array, int start, int end, bool up)
 		{
-			/* rotate lines of the scroll region */
-			Char_cell_line yanked_line = _array[up ? start : end];
+			T const yanked = array[up ? start : end];
 
 			if (up) {
 				for (int line = start; line <= end - 1; line++)
-					_array[line] = _array[line + 1];
+					array[line] = array[line + 1];
 			} else {
 				for (int line = end; line >= start + 1; line--)
-					_array[line] = _array[line - 1];
+					array[line] = array[line - 1];
 			}
 
-			_clear_line(yanked_line);
+			array[up ? end : start] = yanked;
+		}
+
+		void _record_scroll(int start, int end, bool up)
+		{
+			/*
+			 * A pending scroll of a different region cannot be merged with
+			 * the new one. Fall back to redrawing the old region entirely.
+			 */
+			if (_scroll_pending && (_scroll.start != start || _scroll.end != end)) {
+				_mark_lines_as_dirty(_scroll.start, _scroll.end);
+				_scroll_pending = false;
+			}
 
-			_array[up ? end: start] = yanked_line;
+			if (!_scroll_pending) {
+				_scroll = Scroll { start, end, 0 };
+				_scroll_pending = true;
+			}
 
-			_mark_lines_as_dirty(start, end);
+			_scroll.lines += up ? 1 : -1;
+		}
+
+		void _scroll_vertically(int start, int end, bool up)
+		{
+			if (start < 0 || start > end || end >= (int)_num_lines)
+				return;
+
+			if (_track_scrolling)
+				_record_scroll(start, end, up);
+
+			/* rotate lines of the scroll region along with their dirty state */
+			_rotate(_array,      start, end, up);
+			_rotate(_line_dirty, start, end, up);
+
+			int const exposed_line = up ? end : start;
+
+			_clear_line(_array[exposed_line]);
+
+			if (_track_scrolling)
+				_line_dirty[exposed_line].mark_all(_num_cols);
+			else
+				_mark_lines_as_dirty(start, end);
 		}
 
 	public:
@@ -89,7 +174,7 @@ class Terminal::Cell_array
 		{
 			_array = new (alloc) Char_cell_line[num_lines];
 
-			_line_dirty = new (alloc) bool[num_lines];
+			_line_dirty = new (alloc) Dirty_columns[num_lines];
 			mark_all_lines_as_dirty();
 
 			for (unsigned i = 0; i < num_lines; i++)
@@ -99,7 +184,7 @@ class Terminal::Cell_array
 		static size_t bytes_needed(unsigned num_cols, unsigned num_lines)
 		{
 			return sizeof(Char_cell_line[num_lines])
-			     + sizeof(bool[num_lines])
+			     + sizeof(Dirty_columns[num_lines])
 			     + sizeof(CELL[num_cols])*num_lines;
 		}
 
@@ -112,16 +197,27 @@ class Terminal::Cell_array
 			destroy(_alloc, _array);
 		}
 
+		/**
+		 * Enable recording of scroll operations
+		 *
+		 * When enabled, the user of the cell array is expected to call
+		 * 'consume_scroll' before redrawing the dirty cells.
+		 */
+		void track_scrolling(bool enabled) { _track_scrolling = enabled; }
+
 		void mark_all_lines_as_dirty()
 		{
 			for (unsigned i = 0; i < _num_lines; i++)
-				_line_dirty[i] = true;
+				_line_dirty[i].mark_all(_num_cols);
+
+			/* the pending scroll becomes irrelevant when redrawing all lines */
+			_scroll_pending = false;
 		}
 
 		void set_cell(int column, int line, CELL cell)
 		{
 			_array[line][column] = cell;
-			_line_dirty[line] = true;
+			_line_dirty[line].mark(column);
 		}
 
 		CELL get_cell(int column, int line) const
@@ -141,16 +237,34 @@ class Terminal::Cell_array
 			mark_all_lines_as_dirty();
 		}
 
-		bool line_dirty(int line) { return _line_dirty[line]; }
+		bool line_dirty(int line) const { return _line_dirty[line].any(); }
+
+		Dirty_columns dirty_columns(int line) const { return _line_dirty[line]; }
 
 		void mark_line_as_clean(int line)
 		{
-			_line_dirty[line] = false;
+			_line_dirty[line].clear();
 		}
 
 		void mark_line_as_dirty(int line)
 		{
-			_line_dirty[line] = true;
+			_line_dirty[line].mark_all(_num_cols);
+		}
+
+		/**
+		 * Call 'fn' with the pending 'Scroll' operation, if any
+		 *
+		 * The pending scroll operation is reset by this method.
+		 */
+		void consume_scroll(auto const &fn)
+		{
+			if (!_scroll_pending)
+				return;
+
+			_scroll_pending = false;
+
+			if (_scroll.lines != 0)
+				fn(_scroll);
 		}
 
 		void scroll_up(int region_start, int region_end)
@@ -179,13 +293,21 @@ class Terminal::Cell_array
 
 			CELL &cell = _array[pos.y][pos.x];
 
+			/*
+			 * The cell is marked as dirty whenever the cursor state changes
+			 * because the rendered cursor would otherwise travel along with
+			 * a scrolled line.
+			 */
+			if (cell.has_cursor() != enable)
+				mark_dirty = true;
+
 			if (enable)
 				cell.set_cursor();
 			else
 				cell.clear_cursor();
 
 			if (mark_dirty)
-				_line_dirty[pos.y] = true;
+				_line_dirty[pos.y].mark(pos.x);
 		}
 
 		unsigned num_cols()  const { return _num_cols; }
@@ -29,6 +29,7 @@ class Trace_buffer
 		Genode::Trace::Buffer        &_buffer;
 		Entry                         _curr { Entry::invalid() };
 		unsigned long long            _lost_count { 0 };
+		unsigned long long            _next_sequence { 0 };
 
 	public:
 
@@ -44,12 +45,8 @@ class Trace_buffer
 			if (!_buffer.initialized())
 				return;
 
-			bool lost = _buffer.lost_entries() != _lost_count;
-			if (lost) {
-				warning("lost ", _buffer.lost_entries() - _lost_count,
-				        ", entries; you might want to raise buffer size");
-				_lost_count = (unsigned)_buffer.lost_entries();
-			}
+			unsigned long long lost          = 0;
+			unsigned long long next_sequence = _next_sequence;
 
 			Entry entry { _curr };
 
@@ -70,15 +67,41 @@ class Trace_buffer
 				if (entry.empty())
 					continue;
 
+				/* skip stale entries that were processed already */
+				if (entry.sequence() < next_sequence)
+					continue;
+
+				/* account for entries overwritten before we got to read them */
+				if (entry.sequence() > next_sequence)
+					lost += entry.sequence() - next_sequence;
+
+				next_sequence = entry.sequence();
+
 				/* functor may return false to continue processing later on */
 				if (!fn(entry))
 					break;
+
+				next_sequence++;
 			}
 
+			if (!update)
+				return;
+
 			/* remember the next to be processed entry in _curr */
-			if (update) _curr = entry;
+			_curr          = entry;
+			_next_sequence = next_sequence;
+
+			if (lost) {
+				warning("lost ", lost, " entries; you might want to raise buffer size");
+				_lost_count += lost;
+			}
 		}
 
+		/**
+		 * Return number of entries overwritten before being processed
+		 */
+		unsigned long long lost_entries() const { return _lost_count; }
+
 		void * address() const { return &_buffer; }
 
 		bool empty() const { return !_buffer.initialized() || _curr.head(); }
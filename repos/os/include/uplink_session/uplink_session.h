@@ -18,6 +18,7 @@
 #include <session/session.h>
 #include <packet_stream_tx/packet_stream_tx.h>
 #include <packet_stream_rx/packet_stream_rx.h>
+#include <nic_session/offload.h>
 
 namespace Uplink {
 
@@ -27,6 +28,8 @@ namespace Uplink {
 	using Genode::Packet_stream_source;
 
 	using Packet_descriptor = Genode::Packet_descriptor;
+
+	using Offload = Nic::Offload;
 }
 
 
@@ -96,6 +99,14 @@ struct Uplink::Session : Genode::Session
 	 */
 	virtual Rx::Sink *rx() { return 0; }
 
+	/**
+	 * Request offload features accepted by the server
+	 *
+	 * If the result is non-empty, all packets of the session are prefixed
+	 * with an 'Offload::Header'.
+	 */
+	virtual Offload::Features offload() { return { }; }
+
 
 	/*******************
 	 ** RPC interface **
@@ -103,8 +114,9 @@ struct Uplink::Session : Genode::Session
 
 	GENODE_RPC(Rpc_tx_cap, Genode::Capability<Tx>, _tx_cap);
 	GENODE_RPC(Rpc_rx_cap, Genode::Capability<Rx>, _rx_cap);
+	GENODE_RPC(Rpc_offload, Offload::Features, offload);
 
-	GENODE_RPC_INTERFACE(Rpc_tx_cap, Rpc_rx_cap);
+	GENODE_RPC_INTERFACE(Rpc_tx_cap, Rpc_rx_cap, Rpc_offload);
 };
 
 #endif /* _UPLINK_SESSION__UPLINK_SESSION_H_ */
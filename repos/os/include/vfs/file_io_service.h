@@ -58,6 +58,47 @@ struct Vfs::File_io_service : Interface
 	virtual Read_result complete_read(Vfs_handle *, Byte_range_ptr const &dst,
 	                                  size_t &out_count) = 0;
 
+	/**
+	 * Interface for consuming data read in place
+	 */
+	struct Read_in_place_fn : Interface
+	{
+		/**
+		 * Consume data
+		 *
+		 * \return number of consumed bytes
+		 */
+		virtual size_t consume(Const_byte_range_ptr const &) = 0;
+	};
+
+	/**
+	 * Complete queued read by handing out the data in place
+	 *
+	 * Rather than copying the data to a buffer of the caller, the file
+	 * system passes its own buffer to 'fn', e.g., the bulk buffer of a
+	 * file-system session. This way, data can be transferred to another
+	 * handle without an intermediate copy. The data is valid during the
+	 * call of 'fn' only. At the end of the file, 'fn' is not called.
+	 *
+	 * \param bounce     buffer used by file systems that cannot hand out
+	 *                   their data in place, also limiting the number of
+	 *                   bytes passed to 'fn'
+	 * \param out_count  number of bytes consumed by 'fn'
+	 */
+	virtual Read_result complete_read_in_place(Vfs_handle           *vfs_handle,
+	                                           Byte_range_ptr const &bounce,
+	                                           Read_in_place_fn     &fn,
+	                                           size_t               &out_count)
+	{
+		size_t read_count = 0;
+		Read_result const result = complete_read(vfs_handle, bounce, read_count);
+
+		out_count = (result == READ_OK && read_count)
+		          ? fn.consume(Const_byte_range_ptr(bounce.start, read_count))
+		          : 0;
+		return result;
+	}
+
 	/**
 	 * Return true if the handle has readable data
 	 */
@@ -0,0 +1,89 @@
+/*
+ * \brief  Binary records exchanged with the socket file system
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The control files of the socket file system ('bind', 'connect', 'remote',
+ * 'local') take and yield textual addresses of the form "a.b.c.d:port".
+ * Alternatively, a 'Socket_address' can be written to the 'bind', 'connect',
+ * and 'remote' files. Reading the 'local' or 'remote' file with a buffer of
+ * exactly 'sizeof(Socket_address)' bytes yields the address in binary form.
+ * This way, the C runtime spares the formatting and parsing of addresses
+ * for each connection.
+ *
+ * The 'datagrams' file of a datagram socket transfers batches of datagrams.
+ * Each datagram is represented by a 'Socket_datagram' header immediately
+ * followed by the payload. A read yields as many records as available, fit
+ * into the buffer without truncation, and do not exceed the limit written to
+ * the file in textual form. A write sends the contained records in order and
+ * returns the number of bytes of the records sent.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__VFS__SOCKET_ADDRESS_H_
+#define _INCLUDE__VFS__SOCKET_ADDRESS_H_
+
+#include <base/fixed_stdint.h>
+#include <util/string.h>
+
+namespace Vfs {
+	struct Socket_address;
+	struct Socket_datagram;
+}
+
+
+struct Vfs::Socket_address
+{
+	/* first byte, which never starts a textual address */
+	static constexpr Genode::uint8_t MAGIC = 0xfe;
+
+	enum Family : Genode::uint8_t { UNSPEC = 0, INET = 1 };
+
+	Genode::uint8_t  magic;
+	Genode::uint8_t  family;
+	Genode::uint16_t port;  /* network byte order */
+	Genode::uint32_t addr;  /* network byte order */
+
+	static Socket_address inet(Genode::uint32_t addr, Genode::uint16_t port)
+	{
+		return { .magic = MAGIC, .family = INET, .port = port, .addr = addr };
+	}
+
+	static Socket_address unspec()
+	{
+		return { .magic = MAGIC, .family = UNSPEC, .port = 0, .addr = 0 };
+	}
+
+	/**
+	 * Call 'fn' with the address contained in 'buf' if in binary form
+	 *
+	 * \return true if 'buf' holds a binary address
+	 */
+	static bool with_binary(char const *buf, Genode::size_t len, auto const &fn)
+	{
+		if (len != sizeof(Socket_address) || Genode::uint8_t(buf[0]) != MAGIC)
+			return false;
+
+		Socket_address addr { };
+		Genode::memcpy(&addr, buf, sizeof(addr));
+		fn(addr);
+		return true;
+	}
+
+} __attribute__((packed));
+
+
+struct Vfs::Socket_datagram
+{
+	Socket_address   addr;    /* sender or destination, 'UNSPEC' for default */
+	Genode::uint32_t length;  /* number of payload bytes following the header */
+
+} __attribute__((packed));
+
+#endif /* _INCLUDE__VFS__SOCKET_ADDRESS_H_ */
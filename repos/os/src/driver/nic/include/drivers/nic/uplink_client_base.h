@@ -47,6 +47,9 @@ class Genode::Uplink_client_base : Noncopyable
 		Signal_handler<Uplink_client_base>  _conn_tx_ack_avail_handler       { _env.ep(), *this, &Uplink_client_base::_conn_tx_handle_ack_avail };
 		Signal_handler<Uplink_client_base>  _conn_tx_ready_to_submit_handler { _env.ep(), *this, &Uplink_client_base::_conn_tx_handle_ready_to_submit };
 		Packet_descriptor                   _save                            { };
+		Nic::Offload::Features              _conn_offload                    { };
+
+		static constexpr size_t OFFLOAD_HDR_SIZE = sizeof(Nic::Offload::Header);
 
 
 		/*****************************************
@@ -98,11 +101,20 @@ class Genode::Uplink_client_base : Noncopyable
 				if (conn_rx_pkt.size() > 0 &&
 				    _conn->rx()->packet_valid(conn_rx_pkt)) {
 
-					const char *const conn_rx_pkt_base {
+					const char *conn_rx_pkt_base {
 						_conn->rx()->packet_content(conn_rx_pkt) };
 
-					switch (_drv_transmit_pkt(conn_rx_pkt_base,
-					                          conn_rx_pkt.size())) {
+					size_t conn_rx_pkt_size { conn_rx_pkt.size() };
+
+					Nic::Offload::Header offload { };
+					if (_conn_offload.any() && conn_rx_pkt_size > OFFLOAD_HDR_SIZE) {
+						memcpy(&offload, conn_rx_pkt_base, OFFLOAD_HDR_SIZE);
+						conn_rx_pkt_base += OFFLOAD_HDR_SIZE;
+						conn_rx_pkt_size -= OFFLOAD_HDR_SIZE;
+					}
+
+					switch (_drv_transmit_offload_pkt(conn_rx_pkt_base,
+					                                  conn_rx_pkt_size, offload)) {
 
 					case Transmit_result::ACCEPTED:
 
@@ -149,18 +161,32 @@ class Genode::Uplink_client_base : Noncopyable
 		void _drv_rx_handle_pkt_try(size_t  conn_tx_pkt_size,
 		                            auto && fn_tx_write)
 		{
-			_drv_rx_handle_pkt_gen(conn_tx_pkt_size, fn_tx_write, true);
+			_drv_rx_handle_pkt_gen(conn_tx_pkt_size, { }, fn_tx_write, true);
 		}
 
 		void _drv_rx_handle_pkt(size_t  conn_tx_pkt_size,
 		                        auto && fn_tx_write)
 		{
-			_drv_rx_handle_pkt_gen(conn_tx_pkt_size, fn_tx_write, false);
+			_drv_rx_handle_pkt_gen(conn_tx_pkt_size, { }, fn_tx_write, false);
 		}
 
-		void _drv_rx_handle_pkt_gen(size_t  conn_tx_pkt_size,
-		                            auto && write_to_conn_tx_pkt,
-		                            bool try_pattern)
+		/**
+		 * Forward received packet along with offload metadata
+		 *
+		 * The metadata is dropped if the Uplink connection does not use
+		 * offloading. Only flags accepted by the Uplink server must be set.
+		 */
+		void _drv_rx_handle_pkt(size_t                      conn_tx_pkt_size,
+		                        Nic::Offload::Header const &offload,
+		                        auto                     && fn_tx_write)
+		{
+			_drv_rx_handle_pkt_gen(conn_tx_pkt_size, offload, fn_tx_write, false);
+		}
+
+		void _drv_rx_handle_pkt_gen(size_t                      conn_tx_pkt_size,
+		                            Nic::Offload::Header const &offload,
+		                            auto                     && write_to_conn_tx_pkt,
+		                            bool                        try_pattern)
 		{
 			if (!_conn.constructed()) {
 				return;
@@ -170,21 +196,29 @@ class Genode::Uplink_client_base : Noncopyable
 			if (!_conn->tx()->ready_to_submit()) {
 				return;
 			}
+			size_t const hdr_size { _conn_offload.any() ? OFFLOAD_HDR_SIZE : 0 };
+
+			conn_tx_pkt_size += hdr_size;
 			try {
 				Packet_descriptor conn_tx_pkt {
 					_conn->tx()->alloc_packet(conn_tx_pkt_size) };
 
-				void *conn_tx_pkt_base {
+				char *conn_tx_pkt_base {
 					_conn->tx()->packet_content(conn_tx_pkt) };
 
+				if (hdr_size)
+					memcpy(conn_tx_pkt_base, &offload, hdr_size);
+
 				size_t adjusted_conn_tx_pkt_size {
-					conn_tx_pkt_size };
+					conn_tx_pkt_size - hdr_size };
 
 				Write_result write_result {
 					write_to_conn_tx_pkt(
-						conn_tx_pkt_base,
+						conn_tx_pkt_base + hdr_size,
 						adjusted_conn_tx_pkt_size) };
 
+				adjusted_conn_tx_pkt_size += hdr_size;
+
 				switch (write_result) {
 				case Write_result::WRITE_SUCCEEDED:
 
@@ -246,7 +280,10 @@ class Genode::Uplink_client_base : Noncopyable
 				_drv_mac_addr_used = true;
 				_conn.construct(
 					_env, &_conn_pkt_alloc, BUF_SIZE, BUF_SIZE,
-					_drv_mac_addr);
+					_drv_mac_addr, Uplink::Connection::Label(),
+					_drv_offload());
+
+				_conn_offload = _conn->offload();
 
 				/* install signal handlers at connection */
 				_conn->rx_channel()->sigh_ready_to_ack(
@@ -272,6 +309,25 @@ class Genode::Uplink_client_base : Noncopyable
 		_drv_transmit_pkt(const char *conn_rx_pkt_base,
 		                  size_t      conn_rx_pkt_size) = 0;
 
+		/**
+		 * Transmit packet with offload metadata
+		 *
+		 * Drivers that accept offload metadata must override this method.
+		 * The metadata carries only flags requested via '_drv_offload'.
+		 */
+		virtual Transmit_result
+		_drv_transmit_offload_pkt(const char                 *conn_rx_pkt_base,
+		                          size_t                      conn_rx_pkt_size,
+		                          Nic::Offload::Header const &)
+		{
+			return _drv_transmit_pkt(conn_rx_pkt_base, conn_rx_pkt_size);
+		}
+
+		/**
+		 * Offload metadata accepted by the driver for transmission
+		 */
+		virtual Nic::Offload::Features _drv_offload() const { return { }; }
+
 		virtual void _custom_conn_rx_handle_packet_avail()
 		{
 			class Unexpected_call { };
@@ -18,6 +18,7 @@
 #include <base/log.h>
 #include <base/signal.h>
 #include <nic_session/nic_session.h>
+#include <net/offload.h>
 #include <util/misc_math.h>
 #include <util/register.h>
 #include <virtio/queue.h>
@@ -46,6 +47,7 @@ class Virtio_nic::Device : Noncopyable
 			enum Flags : Genode::uint16_t
 			{
 				NEEDS_CSUM = 1,
+				DATA_VALID = 2,
 			};
 
 			enum GSO : Genode::uint16_t
@@ -77,6 +79,8 @@ class Virtio_nic::Device : Noncopyable
 		{
 			Nic::Mac_address mac = { };
 			bool link_status_available = false;
+			bool csum = false;        /* device completes checksums on transmit */
+			bool guest_csum = false;  /* device reports checksum state on receive */
 		};
 
 		/**
@@ -227,6 +231,16 @@ class Virtio_nic::Device : Noncopyable
 				hw_features.link_status_available = true;
 			}
 
+			if (Features::CSUM::get(device_features)) {
+				Features::CSUM::set(driver_features);
+				hw_features.csum = true;
+			}
+
+			if (Features::GUEST_CSUM::get(device_features)) {
+				Features::GUEST_CSUM::set(driver_features);
+				hw_features.guest_csum = true;
+			}
+
 			_device.set_features(0, (uint32_t)driver_features);
 			_device.set_features(1, (uint32_t)(driver_features >> 32));
 
@@ -341,10 +355,10 @@ class Virtio_nic::Device : Noncopyable
 			_device.irq_ack();
 		}
 
-		bool tx_vq_write_pkt(char     const *pkt_base,
-		                     Genode::size_t  pkt_size)
+		bool tx_vq_write_pkt(char              const *pkt_base,
+		                     Genode::size_t           pkt_size,
+		                     Virtio_net_header const &hdr)
 		{
-			Virtio_net_header hdr;
 			return _tx_vq.write_data(hdr, pkt_base, pkt_size);
 		}
 
@@ -409,6 +423,8 @@ class Virtio_nic::Device : Noncopyable
 			return _hw_features.mac;
 		}
 
+		bool hw_csum() const { return _hw_features.csum; }
+
 		void init(Genode::Signal_context_capability irq_handler)
 		{
 			_setup_virtio_queues();
@@ -425,25 +441,114 @@ class Virtio_nic::Uplink_client : public Virtio_nic::Device,
 
 		Signal_handler<Uplink_client> _irq_handler;
 
+		/* buffer for the segments of large TCP frames */
+		char _segment[Nic::Packet_allocator::OFFSET_PACKET_SIZE] { };
+
 		void _receive()
 		{
 			rx_vq_read_pkt(
-				[&] (Virtio_net_header const &,
+				[&] (Virtio_net_header const &hdr,
 				     char              const *data,
 				     size_t                   size)
 			{
+				Nic::Offload::Header offload { };
+
+				bool const needs_csum = hdr.flags & Virtio_net_header::NEEDS_CSUM;
+				if (needs_csum) {
+					offload.flags       = Nic::Offload::Header::CSUM_NEEDED;
+					offload.csum_start  = hdr.csum_start;
+					offload.csum_offset = hdr.csum_offset;
+				}
+				if (hdr.flags & Virtio_net_header::DATA_VALID)
+					offload.flags |= Nic::Offload::Header::CSUM_VALID;
+
+				bool const complete = needs_csum && !_conn_offload.csum;
+				if (!_conn_offload.csum)
+					offload = { };
+
 				_drv_rx_handle_pkt(
-					size,
+					size, offload,
 					[&] (void   *conn_tx_pkt_base,
 						 size_t &conn_tx_pkt_size)
 				{
 					memcpy(conn_tx_pkt_base, data, conn_tx_pkt_size);
+
+					if (complete && !Net::complete_checksum(
+						{ .flags = Nic::Offload::Header::CSUM_NEEDED,
+						  .reserved = 0, .gso_size = 0,
+						  .csum_start = hdr.csum_start,
+						  .csum_offset = hdr.csum_offset },
+						conn_tx_pkt_base, conn_tx_pkt_size))
+						return Write_result::WRITE_FAILED;
+
 					return Write_result::WRITE_SUCCEEDED;
 				});
 				return true;
 			});
 		}
 
+		Transmit_result _transmit(char              const *base,
+		                          size_t                   size,
+		                          Virtio_net_header const &hdr)
+		{
+			rx_vq_ack_pkts();
+			if (!tx_vq_write_pkt(base, size, hdr)) {
+				/*
+				 * VirtIO transmit queue is full, flush it and retry sending the pkt.
+				 */
+				tx_vq_flush();
+
+				if (!tx_vq_write_pkt(base, size, hdr)) {
+					warning("Failed to send packet after flushing VirtIO queue!");
+					return Transmit_result::REJECTED;
+				}
+			}
+
+			return Transmit_result::ACCEPTED;
+		}
+
+		static Virtio_net_header _virtio_net_header(Nic::Offload::Header const &offload)
+		{
+			Virtio_net_header hdr { };
+			if (offload.csum_needed()) {
+				hdr.flags       = Virtio_net_header::NEEDS_CSUM;
+				hdr.csum_start  = offload.csum_start;
+				hdr.csum_offset = offload.csum_offset;
+			}
+			return hdr;
+		}
+
+		/**
+		 * Split large TCP frame, letting the device compute the checksums
+		 */
+		Transmit_result _transmit_segments(char const *base, size_t size,
+		                                   size_t mss)
+		{
+			Net::Tcp_segmenter const segmenter(base, size, mss);
+			if (!segmenter.valid())
+				return Transmit_result::REJECTED;
+
+			using Checksum = Net::Tcp_segmenter::Checksum;
+			Checksum const checksum = hw_csum() ? Checksum::PARTIAL
+			                                    : Checksum::COMPLETE;
+			Transmit_result result = Transmit_result::ACCEPTED;
+			segmenter.for_each_segment([&] (unsigned i, size_t seg_size) {
+
+				if (result != Transmit_result::ACCEPTED)
+					return;
+
+				if (seg_size > sizeof(_segment)) {
+					result = Transmit_result::REJECTED;
+					return;
+				}
+				Nic::Offload::Header const offload =
+					segmenter.write_segment(i, _segment, checksum);
+
+				result = _transmit(_segment, seg_size, _virtio_net_header(offload));
+			});
+			return result;
+		}
+
 		void _handle_irq()
 		{
 			drv_handle_irq([&] () {
@@ -465,20 +570,30 @@ class Virtio_nic::Uplink_client : public Virtio_nic::Device,
 		_drv_transmit_pkt(const char *conn_rx_pkt_base,
 		                  size_t      conn_rx_pkt_size) override
 		{
-			rx_vq_ack_pkts();
-			if (!tx_vq_write_pkt(conn_rx_pkt_base, conn_rx_pkt_size)) {
-				/*
-				 * VirtIO transmit queue is full, flush it and retry sending the pkt.
-				 */
-				tx_vq_flush();
+			return _transmit(conn_rx_pkt_base, conn_rx_pkt_size, { });
+		}
 
-				if (!tx_vq_write_pkt(conn_rx_pkt_base, conn_rx_pkt_size)) {
-					warning("Failed to send packet after flushing VirtIO queue!");
-					return Transmit_result::REJECTED;
-				}
-			}
+		Transmit_result
+		_drv_transmit_offload_pkt(const char                 *conn_rx_pkt_base,
+		                          size_t                      conn_rx_pkt_size,
+		                          Nic::Offload::Header const &offload) override
+		{
+			if (offload.gso_tcpv4())
+				return _transmit_segments(conn_rx_pkt_base, conn_rx_pkt_size,
+				                          offload.gso_size);
 
-			return Transmit_result::ACCEPTED;
+			return _transmit(conn_rx_pkt_base, conn_rx_pkt_size,
+			                 _virtio_net_header(offload));
+		}
+
+		/*
+		 * Large TCP frames are split by the driver, which spares their
+		 * traversal of the Uplink server per segment. Partial checksums are
+		 * accepted only if the device completes them.
+		 */
+		Nic::Offload::Features _drv_offload() const override
+		{
+			return { .csum = hw_csum(), .gso = true };
 		}
 
 		void _drv_finish_transmitted_pkts() override
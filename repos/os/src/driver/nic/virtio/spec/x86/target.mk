@@ -1,7 +1,7 @@
 TARGET     = virtio_pci_nic
 REQUIRES   = x86
 SRC_CC     = pci_device.cc
-LIBS       = base nic_driver
+LIBS       = base nic_driver net
 INC_DIR    = $(REP_DIR)/src/driver/nic/virtio
 CONFIG_XSD = ../../config.xsd
 
@@ -53,19 +53,27 @@ struct genode_nic_client : private Noncopyable, private Interface
 
 		Session_label const _session_label;
 
-		Nic::Connection _connection { _env, &_packet_alloc,
-		                              BUF_SIZE, BUF_SIZE,
-		                              _session_label.string() };
+		Nic::Connection _connection;
+
+		/* offload metadata accepted by the server */
+		Nic::Offload::Features const _offload { _connection.offload() };
+
+		static constexpr size_t HDR_SIZE = sizeof(Nic::Offload::Header);
+
+		size_t _hdr_size() const { return _offload.any() ? HDR_SIZE : 0; }
 
 	public:
 
 		genode_nic_client(Env &env, Allocator &alloc,
 		                  Signal_context_capability sigh,
 		                  Signal_context_capability link_sigh,
-		                  Session_label const &session_label)
+		                  Session_label const &session_label,
+		                  Nic::Offload::Features const offload)
 		:
 			_env(env), _alloc(alloc),
-			_session_label(session_label)
+			_session_label(session_label),
+			_connection(_env, &_packet_alloc, BUF_SIZE, BUF_SIZE,
+			            _session_label.string(), offload)
 		{
 			_connection.link_state_sigh(link_sigh);
 			_connection.rx_channel()->sigh_ready_to_ack   (sigh);
@@ -80,8 +88,11 @@ struct genode_nic_client : private Noncopyable, private Interface
 			_connection.tx()->wakeup();
 		}
 
+		Nic::Offload::Features offload() const { return _offload; }
+
 		template <typename FN>
-		bool tx_one_packet(FN const &fn)
+		bool tx_one_packet(size_t max_bytes, Nic::Offload::Header const &offload,
+		                   FN const &fn)
 		{
 			bool progress = false;
 
@@ -106,17 +117,19 @@ struct genode_nic_client : private Noncopyable, private Interface
 			using Packet_descriptor = Nic::Packet_descriptor;
 
 			Packet_descriptor packet { };
-			size_t const max_bytes = Nic::Packet_allocator::OFFSET_PACKET_SIZE;
-
+			size_t const hdr_size = _hdr_size();
 
-			tx_source.alloc_packet_attempt(max_bytes).with_result(
+			tx_source.alloc_packet_attempt(hdr_size + max_bytes).with_result(
 				[&] (Packet_descriptor packet)
 				{
-					char * const dst_ptr = tx_source.packet_content(packet);
+					char * const dst_ptr = tx_source.packet_content(packet) + hdr_size;
 					size_t const payload_bytes = min(max_bytes, fn(dst_ptr, max_bytes));
 
+					if (hdr_size)
+						memcpy(dst_ptr - hdr_size, &offload, hdr_size);
+
 					/* imprint payload size into packet descriptor */
-					packet = Packet_descriptor(packet.offset(), payload_bytes);
+					packet = Packet_descriptor(packet.offset(), hdr_size + payload_bytes);
 
 					tx_source.try_submit_packet(packet);
 					progress = true;
@@ -146,14 +159,26 @@ struct genode_nic_client : private Noncopyable, private Interface
 
 				Packet_descriptor const packet = rx_sink.peek_packet();
 
-				bool const packet_valid = rx_sink.packet_valid(packet)
-				                       && (packet.offset() >= 0);
+				bool packet_valid = rx_sink.packet_valid(packet)
+				                 && (packet.offset() >= 0);
 
 				char const *content = rx_sink.packet_content(packet);
+				size_t      size    = packet.size();
+
+				Nic::Offload::Header offload { };
+				if (packet_valid && _offload.any()) {
+					if (size > HDR_SIZE) {
+						memcpy(&offload, content, HDR_SIZE);
+						content += HDR_SIZE;
+						size    -= HDR_SIZE;
+					} else {
+						packet_valid = false;
+					}
+				}
 
 				genode_nic_client_rx_result_t const
 					response = packet_valid
-					         ? fn(content, packet.size())
+					         ? fn(content, size, offload)
 					         : GENODE_NIC_CLIENT_RX_REJECTED;
 
 				bool progress = false;
@@ -228,8 +253,28 @@ bool genode_nic_client_tx_packet(genode_nic_client *nic_client_ptr,
                                  genode_nic_client_tx_packet_content_t tx_packet_content_cb,
                                  genode_nic_client_tx_packet_context *ctx_ptr)
 {
-	return nic_client_ptr->tx_one_packet([&] (char *dst, size_t len) {
-		return tx_packet_content_cb(ctx_ptr, dst, len); });
+	return nic_client_ptr->tx_one_packet(Nic::Packet_allocator::OFFSET_PACKET_SIZE, { },
+		[&] (char *dst, size_t len) {
+			return tx_packet_content_cb(ctx_ptr, dst, len); });
+}
+
+
+bool genode_nic_client_tx_offload_packet(genode_nic_client *nic_client_ptr,
+                                         unsigned long max_len,
+                                         genode_nic_offload const *offload_ptr,
+                                         genode_nic_client_tx_packet_content_t tx_packet_content_cb,
+                                         genode_nic_client_tx_packet_context *ctx_ptr)
+{
+	Nic::Offload::Header const offload {
+		.flags       = offload_ptr->flags,
+		.reserved    = 0,
+		.gso_size    = offload_ptr->gso_size,
+		.csum_start  = offload_ptr->csum_start,
+		.csum_offset = offload_ptr->csum_offset };
+
+	return nic_client_ptr->tx_one_packet(min(max_len, Nic::Offload::MAX_FRAME_SIZE), offload,
+		[&] (char *dst, size_t len) {
+			return tx_packet_content_cb(ctx_ptr, dst, len); });
 }
 
 
@@ -237,8 +282,56 @@ bool genode_nic_client_rx(struct genode_nic_client *nic_client_ptr,
                           genode_nic_client_rx_one_packet_t rx_one_packet_cb,
                           struct genode_nic_client_rx_context *ctx_ptr)
 {
-	return nic_client_ptr->for_each_rx_packet([&] (char const *ptr, size_t len) {
-		return rx_one_packet_cb(ctx_ptr, ptr, len); });
+	return nic_client_ptr->for_each_rx_packet(
+		[&] (char const *ptr, size_t len, Nic::Offload::Header const &) {
+			return rx_one_packet_cb(ctx_ptr, ptr, len); });
+}
+
+
+bool genode_nic_client_rx_offload(struct genode_nic_client *nic_client_ptr,
+                                  genode_nic_client_rx_one_offload_packet_t rx_one_packet_cb,
+                                  struct genode_nic_client_rx_context *ctx_ptr)
+{
+	return nic_client_ptr->for_each_rx_packet(
+		[&] (char const *ptr, size_t len, Nic::Offload::Header const &header) {
+
+			genode_nic_offload const offload {
+				.flags       = header.flags,
+				.gso_size    = header.gso_size,
+				.csum_start  = header.csum_start,
+				.csum_offset = header.csum_offset };
+
+			return rx_one_packet_cb(ctx_ptr, ptr, len, &offload); });
+}
+
+
+genode_nic_offload_features genode_nic_client_offload(genode_nic_client *nic_client_ptr)
+{
+	Nic::Offload::Features const features = nic_client_ptr->offload();
+
+	return { .csum = features.csum, .gso = features.gso };
+}
+
+
+struct genode_nic_client *
+genode_nic_client_create_offload(char const *label,
+                                 genode_nic_offload_features features)
+{
+	if (!statics().env_ptr || !statics().alloc_ptr) {
+		error("genode_nic_client_create: missing call of genode_nic_client_init");
+		return nullptr;
+	}
+
+	try {
+		return new (*statics().alloc_ptr)
+			Registered<genode_nic_client>(statics().nic_clients, *statics().env_ptr,
+			                              *statics().alloc_ptr,
+			                              statics().sigh, statics().link_sigh,
+			                              Session_label(label),
+			                              Nic::Offload::Features {
+			                                  .csum = features.csum,
+			                                  .gso  = features.gso });
+	} catch (...) { return nullptr; }
 }
 
 
@@ -254,7 +347,8 @@ struct genode_nic_client *genode_nic_client_create(char const *label)
 			Registered<genode_nic_client>(statics().nic_clients, *statics().env_ptr,
 			                              *statics().alloc_ptr,
 			                              statics().sigh, statics().link_sigh,
-			                              Session_label(label));
+			                              Session_label(label),
+			                              Nic::Offload::Features { });
 	} catch (...) { return nullptr; }
 }
 
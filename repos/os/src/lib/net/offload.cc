@@ -0,0 +1,179 @@
+/*
+ * \brief  Software fallbacks for NIC offload metadata
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <net/offload.h>
+#include <net/ethernet.h>
+#include <net/ipv4.h>
+#include <net/tcp.h>
+#include <net/internet_checksum.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+/* offsets of the checksum fields within the L4 headers */
+enum { TCP_CSUM_OFFSET = 16, UDP_CSUM_OFFSET = 6 };
+
+
+bool Net::complete_checksum(Nic::Offload::Header const &header,
+                            void                       *frame_base,
+                            size_t                      frame_size)
+{
+	size_t const start = header.csum_start;
+	size_t const field = start + header.csum_offset;
+
+	if (field + sizeof(uint16_t) > frame_size)
+		return false;
+
+	uint8_t * const frame = (uint8_t *)frame_base;
+
+	/*
+	 * Link-layer padding of short frames must not enter the checksum, so the
+	 * L4 data of IPv4 frames ends where the IPv4 total length says.
+	 */
+	size_t end = frame_size;
+	size_t const ip_offset = sizeof(Ethernet_frame);
+	if (frame_size >= ip_offset + sizeof(Ipv4_packet)
+	 && ((Ethernet_frame const *)frame)->type() == Ethernet_frame::Type::IPV4) {
+
+		size_t const ip_end = ip_offset
+		                    + ((Ipv4_packet const *)(frame + ip_offset))->total_length();
+
+		if (ip_end > frame_size || field + sizeof(uint16_t) > ip_end)
+			return false;
+
+		end = ip_end;
+	}
+
+	/*
+	 * The checksum field holds the folded pseudo-header sum, which is thereby
+	 * included when summing up the L4 data.
+	 */
+	uint16_t checksum =
+		internet_checksum((Packed_uint16 *)(frame + start), end - start);
+
+	/* a zero UDP checksum would denote the absence of a checksum */
+	if (!checksum && header.csum_offset == UDP_CSUM_OFFSET)
+		checksum = 0xffff;
+
+	memcpy(frame + field, &checksum, sizeof(checksum));
+	return true;
+}
+
+
+Nic::Offload::Header Net::prepare_partial_checksum(void                 *frame_base,
+                                                   size_t                l4_offset,
+                                                   size_t                l4_size,
+                                                   Ipv4_packet::Protocol protocol,
+                                                   Ipv4_address          src,
+                                                   Ipv4_address          dst)
+{
+	uint8_t * const l4 = (uint8_t *)frame_base + l4_offset;
+
+	uint16_t const csum_offset = (protocol == Ipv4_packet::Protocol::TCP)
+	                           ? TCP_CSUM_OFFSET : UDP_CSUM_OFFSET;
+
+	uint16_t const pseudo = (uint16_t)~internet_checksum_pseudo_ip(
+		(Packed_uint16 *)l4, 0, host_to_big_endian((uint16_t)l4_size),
+		protocol, src, dst);
+
+	memcpy(l4 + csum_offset, &pseudo, sizeof(pseudo));
+
+	return { .flags       = Nic::Offload::Header::CSUM_NEEDED,
+	         .reserved    = 0,
+	         .gso_size    = 0,
+	         .csum_start  = (uint16_t)l4_offset,
+	         .csum_offset = csum_offset };
+}
+
+
+Tcp_segmenter::Tcp_segmenter(void const *frame_base, size_t frame_size,
+                             size_t mss)
+:
+	_frame((uint8_t const *)frame_base), _mss(mss)
+{
+	_ip_offset = sizeof(Ethernet_frame);
+	if (!_mss || frame_size < _ip_offset + sizeof(Ipv4_packet))
+		return;
+
+	Ethernet_frame const &eth = *(Ethernet_frame const *)_frame;
+	if (eth.type() != Ethernet_frame::Type::IPV4)
+		return;
+
+	Ipv4_packet const &ip = *(Ipv4_packet const *)(_frame + _ip_offset);
+	size_t const ip_hdr_size = ip.header_length()*4;
+	size_t const ip_size     = ip.total_length();
+
+	if (ip.protocol() != Ipv4_packet::Protocol::TCP
+	 || ip.more_fragments() || ip.fragment_offset()
+	 || ip_hdr_size < sizeof(Ipv4_packet)
+	 || ip_size > frame_size - _ip_offset)
+		return;
+
+	_tcp_offset = _ip_offset + ip_hdr_size;
+	if (ip_size < ip_hdr_size + sizeof(Tcp_packet))
+		return;
+
+	Tcp_packet const &tcp = *(Tcp_packet const *)(_frame + _tcp_offset);
+	size_t const tcp_hdr_size = tcp.data_offset()*4;
+
+	if (tcp_hdr_size < sizeof(Tcp_packet) || ip_hdr_size + tcp_hdr_size > ip_size)
+		return;
+
+	_hdr_size     = _tcp_offset + tcp_hdr_size;
+	_payload_size = ip_size - ip_hdr_size - tcp_hdr_size;
+	_valid        = true;
+}
+
+
+Nic::Offload::Header
+Tcp_segmenter::write_segment(unsigned i, void *dst, Checksum checksum) const
+{
+	size_t const offset    = i*_mss;
+	size_t const seg_size  = segment_size(i);
+	bool   const last      = (i + 1 == num_segments());
+	uint8_t    * const seg = (uint8_t *)dst;
+
+	memcpy(seg, _frame, _hdr_size);
+	memcpy(seg + _hdr_size, _frame + _hdr_size + offset, seg_size - _hdr_size);
+
+	Ipv4_packet &ip  = *(Ipv4_packet *)(seg + _ip_offset);
+	Tcp_packet  &tcp = *(Tcp_packet  *)(seg + _tcp_offset);
+
+	ip.total_length(seg_size - _ip_offset);
+	ip.identification((uint16_t)(ip.identification() + i));
+	ip.update_checksum();
+
+	tcp.seq_nr(tcp.seq_nr() + (uint32_t)offset);
+
+	/* congestion-window reduction applies to the first segment only */
+	if (i > 0)
+		tcp.cwr(false);
+
+	/* push and finish apply to the last segment only */
+	if (!last) {
+		tcp.psh(false);
+		tcp.fin(false);
+	}
+
+	size_t const tcp_size = seg_size - _tcp_offset;
+
+	if (checksum == Checksum::PARTIAL)
+		return prepare_partial_checksum(seg, _tcp_offset, tcp_size,
+		                                Ipv4_packet::Protocol::TCP,
+		                                ip.src(), ip.dst());
+
+	tcp.update_checksum(ip.src(), ip.dst(), tcp_size);
+	return { };
+}
@@ -210,6 +210,37 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				return result;
 			}
 
+			Read_result _complete_read_in_place(size_t max_count,
+			                                    Read_in_place_fn &fn,
+			                                    size_t &out_count)
+			{
+				if (queued_read_state != Handle_state::Queued_state::ACK)
+					return READ_QUEUED;
+
+				::File_system::Session::Tx::Source &source = *_vfs_fs._fs.tx();
+
+				::File_system::Packet_descriptor const
+					packet = queued_read_packet;
+
+				Read_result result = packet.succeeded() ? READ_OK : READ_ERR_IO;
+
+				/* hand out the content of the bulk buffer */
+				if (result == READ_OK) {
+					size_t const read_num_bytes = min(packet.length(), max_count);
+
+					if (read_num_bytes)
+						out_count = fn.consume(Const_byte_range_ptr(
+							source.packet_content(packet), read_num_bytes));
+				}
+
+				queued_read_state  = Handle_state::Queued_state::IDLE;
+				queued_read_packet = ::File_system::Packet_descriptor();
+
+				source.release_packet(packet);
+
+				return result;
+			}
+
 			Fs_vfs_handle(File_system &fs, Allocator &alloc,
 			              int status_flags, Handle_space &space,
 			              ::File_system::Node_handle node_handle,
@@ -236,6 +267,19 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				return READ_ERR_INVALID;
 			}
 
+			virtual Read_result complete_read_in_place(Byte_range_ptr const &bounce,
+			                                           Read_in_place_fn &fn,
+			                                           size_t &out_count)
+			{
+				size_t read_count = 0;
+				Read_result const result = complete_read(bounce, read_count);
+
+				if (result == READ_OK && read_count)
+					out_count = fn.consume(Const_byte_range_ptr(bounce.start, read_count));
+
+				return result;
+			}
+
 			bool queue_sync()
 			{
 				if (queued_sync_state != Handle_state::Queued_state::IDLE)
@@ -325,6 +369,13 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			{
 				return _complete_read(dst, out_count);
 			}
+
+			Read_result complete_read_in_place(Byte_range_ptr const &bounce,
+			                                   Read_in_place_fn &fn,
+			                                   size_t &out_count) override
+			{
+				return _complete_read_in_place(bounce.num_bytes, fn, out_count);
+			}
 		};
 
 		struct Fs_vfs_dir_handle : Fs_vfs_handle
@@ -915,6 +966,18 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			return handle->complete_read(dst, out_count);
 		}
 
+		Read_result complete_read_in_place(Vfs_handle           *vfs_handle,
+		                                   Byte_range_ptr const &bounce,
+		                                   Read_in_place_fn     &fn,
+		                                   size_t               &out_count) override
+		{
+			out_count = 0;
+
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			return handle->complete_read_in_place(bounce, fn, out_count);
+		}
+
 		bool read_ready(Vfs_handle const &vfs_handle) const override
 		{
 			Fs_vfs_handle const &handle = static_cast<Fs_vfs_handle const &>(vfs_handle);
@@ -27,6 +27,7 @@
 #include <vfs/file_io_service.h>
 #include <vfs/file_system_factory.h>
 #include <vfs/vfs_handle.h>
+#include <vfs/socket_address.h>
 #include <timer_session/connection.h>
 
 #include "vfs_ip.h"
@@ -146,6 +147,7 @@ namespace Vfs_ip {
 	class Ip_local_file;
 	class Ip_remote_file;
 	class Ip_peek_file;
+	class Ip_datagrams_file;
 
 	class Ip_sockopt_dir;
 	class Ip_socket_dir;
@@ -420,6 +422,55 @@ class Vfs_ip::Ip_file : public Vfs_ip::File
 
 		Errno _write_err = GENODE_ENONE;
 
+		/**
+		 * Obtain socket address written in textual or binary form
+		 *
+		 * \return false if the address is malformed
+		 */
+		static bool _sockaddr(Ip_vfs_file_handle &handle,
+		                      Const_byte_range_ptr const &src,
+		                      genode_sockaddr &addr)
+		{
+			if (Socket_address::with_binary(src.start, src.num_bytes,
+			                                [&] (Socket_address const &binary) {
+				addr.family  = (binary.family == Socket_address::INET)
+				             ? AF_INET : AF_UNSPEC;
+				addr.in.port = binary.port;
+				addr.in.addr = binary.addr; }))
+				return true;
+
+			if (!handle.write_content_line(src)) return false;
+
+			long const port = get_port(handle.content_buffer);
+			if (port == -1) return false;
+
+			addr.family  = get_family(handle.content_buffer) == 0 ? AF_UNSPEC : AF_INET;
+			addr.in.port = host_to_big_endian<genode_uint16_t>(uint16_t(port));
+			addr.in.addr = get_addr(handle.content_buffer);
+			return true;
+		}
+
+		/**
+		 * Output socket address, in binary form if the buffer has the
+		 * size of a 'Socket_address'
+		 */
+		static long _read_sockaddr(Byte_range_ptr const &dst,
+		                           genode_sockaddr const &addr)
+		{
+			if (dst.num_bytes == sizeof(Socket_address)) {
+				Socket_address const binary =
+					Socket_address::inet(addr.in.addr, addr.in.port);
+				Genode::memcpy(dst.start, &binary, sizeof(binary));
+				return sizeof(binary);
+			}
+
+			unsigned char const *a = (unsigned char *)&addr.in.addr;
+			unsigned char const *p = (unsigned char *)&addr.in.port;
+			return Format::snprintf(dst.start, dst.num_bytes,
+			                        "%d.%d.%d.%d:%u\n",
+			                        a[0], a[1], a[2], a[3], (p[0]<<8)|(p[1]<<0));
+		}
+
 	public:
 
 		Ip_file(Ip::Socket_dir &p, genode_socket_handle &s, char const *name)
@@ -545,6 +596,144 @@ class Vfs_ip::Ip_peek_file final : public Vfs_ip::Ip_file
 };
 
 
+/**
+ * Batched transfer of datagrams, see 'vfs/socket_address.h'
+ */
+class Vfs_ip::Ip_datagrams_file final : public Vfs_ip::Ip_file
+{
+	private:
+
+		unsigned long _max_datagrams = ~0UL;
+
+		bool _dgram() { return _parent.parent().type() == Ip::Protocol_dir::TYPE_DGRAM; }
+
+	public:
+
+		Ip_datagrams_file(Ip::Socket_dir &p, genode_socket_handle &s)
+		: Ip_file(p, s, "datagrams") { }
+
+		/********************
+		 ** File interface **
+		 ********************/
+
+		bool read_ready() const override
+		{
+			return genode_socket_poll(&_sock) & genode_socket_pollin_set();
+		}
+
+		bool write_ready() const override
+		{
+			return genode_socket_poll(&_sock) & genode_socket_pollout_set();
+		}
+
+		long write(Ip_vfs_file_handle &handle,
+		           Const_byte_range_ptr const &src,
+		           file_size /* ignored */) override
+		{
+			if (!_dgram() || !src.num_bytes) return -1;
+
+			/* textual limit of datagrams per read */
+			if (Genode::uint8_t(src.start[0]) != Socket_address::MAGIC) {
+				if (!handle.write_content_line(src)) return -1;
+
+				unsigned long max = 0;
+				Genode::ascii_to_unsigned(handle.content_buffer, max, 10);
+				if (!max) return -1;
+
+				_max_datagrams = max;
+				return src.num_bytes;
+			}
+
+			size_t offset = 0;
+			Errno  err    = GENODE_ENONE;
+
+			while (src.num_bytes - offset >= sizeof(Socket_datagram)) {
+
+				Socket_datagram header { };
+				Genode::memcpy(&header, src.start + offset, sizeof(header));
+
+				size_t const payload = src.num_bytes - offset - sizeof(header);
+				if (header.addr.magic != Socket_address::MAGIC || header.length > payload)
+					break;
+
+				genode_sockaddr addr { .family = AF_INET };
+				addr.in.port = header.addr.port;
+				addr.in.addr = header.addr.addr;
+
+				Msg_header msg_send { src.start + offset + sizeof(header), header.length };
+				msg_send.name((header.addr.family == Socket_address::UNSPEC)
+				              ? _parent.remote_addr() : addr);
+
+				unsigned long bytes_sent = 0;
+				err = genode_socket_sendmsg(&_sock, msg_send.header(), &bytes_sent);
+				if (err != GENODE_ENONE)
+					break;
+
+				offset += sizeof(header) + header.length;
+			}
+
+			/* report errors only if no datagram could be sent */
+			if (offset) {
+				_write_err = GENODE_ENONE;
+				return offset;
+			}
+
+			_write_err = err;
+
+			if (_write_err == GENODE_EAGAIN)
+				throw Would_block();
+
+			return -1;
+		}
+
+		long read(Ip_vfs_file_handle &,
+		          Byte_range_ptr const &dst,
+		          file_size /* ignored */) override
+		{
+			if (!_dgram() || dst.num_bytes <= sizeof(Socket_datagram))
+				return -1;
+
+			size_t        offset = 0;
+			unsigned long count  = 0;
+
+			while (count < _max_datagrams
+			    && dst.num_bytes - offset > sizeof(Socket_datagram)) {
+
+				char * const payload  = dst.start + offset + sizeof(Socket_datagram);
+				size_t const capacity = dst.num_bytes - offset - sizeof(Socket_datagram);
+
+				genode_sockaddr addr { .family = AF_INET };
+				Msg_header msg_recv { addr, payload, capacity };
+				unsigned long bytes = 0;
+
+				/* truncate the first datagram only, leave others for the next read */
+				if (count
+				 && (genode_socket_recvmsg(&_sock, msg_recv.header(), &bytes, true) != GENODE_ENONE
+				  || bytes >= capacity))
+					break;
+
+				Errno const err = genode_socket_recvmsg(&_sock, msg_recv.header(), &bytes, false);
+				if (err == GENODE_EAGAIN && !count)
+					throw Would_block();
+
+				if (err != GENODE_ENONE)
+					break;
+
+				Socket_datagram const header {
+					.addr   = Socket_address::inet(addr.in.addr, addr.in.port),
+					.length = Genode::uint32_t(bytes) };
+
+				Genode::memcpy(dst.start + offset, &header, sizeof(header));
+
+				offset += sizeof(header) + bytes;
+				count++;
+			}
+
+			return count ? long(offset) : -1;
+		}
+};
+
+
 class Vfs_ip::Ip_bind_file final : public Vfs_ip::Ip_file
 {
 	public:
@@ -560,16 +749,11 @@ class Vfs_ip::Ip_bind_file final : public Vfs_ip::Ip_file
 		           Const_byte_range_ptr const &src,
 		           file_size /* ignored */) override
 		{
-			if (!handle.write_content_line(src)) return -1;
-
-			long port = get_port(handle.content_buffer);
-			if (port == -1) return -1;
+			genode_sockaddr addr;
+			if (!_sockaddr(handle, src, addr)) return -1;
 
 			/* port is free, try to bind it */
-			genode_sockaddr addr;
-			addr.family  = AF_INET;
-			addr.in.port = host_to_big_endian<genode_uint16_t>(uint16_t(port));
-			addr.in.addr = get_addr(handle.content_buffer);
+			addr.family = AF_INET;
 
 			_write_err = genode_socket_bind(&_sock, &addr);
 			if (_write_err != GENODE_ENONE) return -1;
@@ -672,16 +856,8 @@ class Vfs_ip::Ip_connect_file final : public Vfs_ip::Ip_file
 		           Const_byte_range_ptr const &src,
 		           file_size /* ignored */) override
 		{
-			if (!handle.write_content_line(src)) return -1;
-
-			long const port = get_port(handle.content_buffer);
-			long const family = get_family(handle.content_buffer);
-			if (port == -1) return -1;
-
 			genode_sockaddr addr;
-			addr.family  = family == 0 ? AF_UNSPEC : AF_INET;
-			addr.in.port = host_to_big_endian<genode_uint16_t>(uint16_t(port));
-			addr.in.addr = get_addr(handle.content_buffer);
+			if (!_sockaddr(handle, src, addr)) return -1;
 
 			_write_err = genode_socket_connect(&_sock, &addr);
 
@@ -712,8 +888,8 @@ class Vfs_ip::Ip_connect_file final : public Vfs_ip::Ip_file
 			}
 
 			genode_sockaddr &remote_addr = _parent.remote_addr();
-			remote_addr.in.port          = host_to_big_endian<genode_uint16_t>(uint16_t(port));
-			remote_addr.in.addr          = get_addr(handle.content_buffer);
+			remote_addr.in.port          = addr.in.port;
+			remote_addr.in.addr          = addr.in.addr;
 			remote_addr.family           = AF_INET;
 
 			_parent.connect(true);
@@ -767,17 +943,14 @@ class Vfs_ip::Ip_local_file final : public Vfs_ip::Ip_file
 		                   Byte_range_ptr const &dst,
 		                   file_size /* ignored */) override
 		{
-			if (dst.num_bytes < sizeof(handle.content_buffer))
+			if (dst.num_bytes != sizeof(Socket_address)
+			 && dst.num_bytes < sizeof(handle.content_buffer))
 				return -1;
 
 			genode_sockaddr addr;
 			if (genode_socket_getsockname(&_sock, &addr) != GENODE_ENONE) return -1;
 
-			unsigned char const *a = (unsigned char *)&addr.in.addr;
-			unsigned char const *p = (unsigned char *)&addr.in.port;
-			return Format::snprintf(dst.start, dst.num_bytes,
-			                        "%d.%d.%d.%d:%u\n",
-			                        a[0], a[1], a[2], a[3], (p[0]<<8)|(p[1]<<0));
+			return _read_sockaddr(dst, addr);
 		}
 };
 
@@ -836,25 +1009,19 @@ class Vfs_ip::Ip_remote_file final : public Vfs_ip::Ip_file
 				break;
 			}
 
-			unsigned char const *a = (unsigned char *)&addr.in.addr;
-			unsigned char const *p = (unsigned char *)&addr.in.port;
-			return Format::snprintf(dst.start, dst.num_bytes,
-			                        "%d.%d.%d.%d:%u\n",
-			                        a[0], a[1], a[2], a[3], (p[0]<<8)|(p[1]<<0));
+			return _read_sockaddr(dst, addr);
 		}
 
 		long write(Ip_vfs_file_handle &handle,
 		           Const_byte_range_ptr const &src,
 		           file_size /* ignored */) override
 		{
-			if (!handle.write_content_line(src)) return -1;
-
-			long const port = get_port(handle.content_buffer);
-			if (port == -1) return -1;
+			genode_sockaddr addr;
+			if (!_sockaddr(handle, src, addr)) return -1;
 
 			genode_sockaddr &remote_addr = _parent.remote_addr();
-			remote_addr.in.port          = host_to_big_endian<genode_uint16_t>(uint16_t(port));
-			remote_addr.in.addr          = get_addr(handle.content_buffer);
+			remote_addr.in.port          = addr.in.port;
+			remote_addr.in.addr          = addr.in.addr;
 			remote_addr.family           = AF_INET;
 
 			return src.num_bytes;
@@ -949,7 +1116,7 @@ class Vfs_ip::Ip_socket_dir final : public Ip::Socket_dir
 
 		enum {
 			ACCEPT_NODE, BIND_NODE, CONNECT_NODE,
-			DATA_NODE, PEEK_NODE,
+			DATA_NODE, PEEK_NODE, DATAGRAMS_NODE,
 			LOCAL_NODE, LISTEN_NODE, REMOTE_NODE,
 			ACCEPT_SOCKET_NODE,
 			MAX_FILES
@@ -973,14 +1140,15 @@ class Vfs_ip::Ip_socket_dir final : public Ip::Socket_dir
 			return num;
 		}
 
-		Ip_accept_file  _accept_file  { *this, _sock };
-		Ip_bind_file    _bind_file    { *this, _sock };
-		Ip_connect_file _connect_file { *this, _sock };
-		Ip_data_file    _data_file    { *this, _sock };
-		Ip_peek_file    _peek_file    { *this, _sock };
-		Ip_listen_file  _listen_file  { *this, _sock };
-		Ip_local_file   _local_file   { *this, _sock };
-		Ip_remote_file  _remote_file  { *this, _sock };
+		Ip_accept_file    _accept_file    { *this, _sock };
+		Ip_bind_file      _bind_file      { *this, _sock };
+		Ip_connect_file   _connect_file   { *this, _sock };
+		Ip_data_file      _data_file      { *this, _sock };
+		Ip_peek_file      _peek_file      { *this, _sock };
+		Ip_datagrams_file _datagrams_file { *this, _sock };
+		Ip_listen_file    _listen_file    { *this, _sock };
+		Ip_local_file     _local_file     { *this, _sock };
+		Ip_remote_file    _remote_file    { *this, _sock };
 
 		Ip_sockopt_dir _sockopt_fs { _env, _sock };
 
@@ -1014,14 +1182,15 @@ class Vfs_ip::Ip_socket_dir final : public Ip::Socket_dir
 
 			for (Vfs_ip::File * &file : _files) file = nullptr;
 
-			_files[ACCEPT_NODE]  = &_accept_file;
-			_files[BIND_NODE]    = &_bind_file;
-			_files[CONNECT_NODE] = &_connect_file;
-			_files[DATA_NODE]    = &_data_file;
-			_files[PEEK_NODE]    = &_peek_file;
-			_files[LISTEN_NODE]  = &_listen_file;
-			_files[LOCAL_NODE]   = &_local_file;
-			_files[REMOTE_NODE]  = &_remote_file;
+			_files[ACCEPT_NODE]    = &_accept_file;
+			_files[BIND_NODE]      = &_bind_file;
+			_files[CONNECT_NODE]   = &_connect_file;
+			_files[DATA_NODE]      = &_data_file;
+			_files[PEEK_NODE]      = &_peek_file;
+			_files[DATAGRAMS_NODE] = &_datagrams_file;
+			_files[LISTEN_NODE]    = &_listen_file;
+			_files[LOCAL_NODE]     = &_local_file;
+			_files[REMOTE_NODE]    = &_remote_file;
 		}
 
 		~Ip_socket_dir()
@@ -1031,6 +1200,7 @@ class Vfs_ip::Ip_socket_dir final : public Ip::Socket_dir
 			_connect_file.dissolve_handles();
 			_data_file.dissolve_handles();
 			_peek_file.dissolve_handles();
+			_datagrams_file.dissolve_handles();
 			_listen_file.dissolve_handles();
 			_local_file.dissolve_handles();
 			_remote_file.dissolve_handles();
@@ -1827,6 +1997,13 @@ class Vfs_ip::Ip_file_system : public  Vfs::File_system,
 				return STAT_OK;
 			}
 
+			if (dynamic_cast<Ip_datagrams_file*>(node)) {
+				out.type = Node_type::CONTINUOUS_FILE;
+				out.rwx  = Node_rwx::rw();
+				out.size = 0;
+				return STAT_OK;
+			}
+
 			if (dynamic_cast<Vfs_ip::File*>(node)) {
 				out.type = Node_type::TRANSACTIONAL_FILE;
 				out.rwx  = Node_rwx::rw();
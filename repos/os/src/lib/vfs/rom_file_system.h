@@ -16,6 +16,7 @@
 
 #include <base/attached_rom_dataspace.h>
 #include <base/registry.h>
+#include <rom_session/connection.h>
 #include <vfs/file_system.h>
 
 namespace Vfs { class Rom_file_system; }
@@ -29,6 +30,8 @@ class Vfs::Rom_file_system : public Single_file_system
 
 		Genode::Env &_env;
 
+		Genode::Allocator &_alloc;
+
 		Vfs::Env::User &_vfs_user;
 
 		using Label = String<64>;
@@ -77,7 +80,10 @@ class Vfs::Rom_file_system : public Single_file_system
 					_rom(rom), _content_size(content_size)
 				{ }
 
-				Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
+				/**
+				 * Return dataspace content at the seek position, up to 'count' bytes
+				 */
+				Const_byte_range_ptr _content(size_t count) const
 				{
 					/* file read limit is the size of the dataspace */
 					size_t const max_size = _content_size;
@@ -86,23 +92,32 @@ class Vfs::Rom_file_system : public Single_file_system
 					size_t const read_offset = size_t(seek());
 
 					/* maximum read offset, clamped to dataspace size */
-					size_t const end_offset = min(dst.num_bytes + read_offset, max_size);
-
-					/* check if end of file is reached */
-					if (read_offset >= end_offset) {
-						out_count = 0;
-						return READ_OK;
-					}
+					size_t const end_offset = min(count + read_offset, max_size);
 
 					/* source address within the dataspace */
 					char const *src = _rom.local_addr<char>() + read_offset;
 
+					return { src, (read_offset < end_offset) ? end_offset - read_offset : 0 };
+				}
+
+				Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
+				{
+					Const_byte_range_ptr const src = _content(dst.num_bytes);
+
 					/* copy-out bytes from ROM dataspace */
-					size_t const num_bytes = end_offset - read_offset;
+					memcpy(dst.start, src.start, src.num_bytes);
 
-					memcpy(dst.start, src, num_bytes);
+					out_count = src.num_bytes;
+					return READ_OK;
+				}
+
+				Read_result read_in_place(size_t count, Read_in_place_fn &fn,
+				                          size_t &out_count)
+				{
+					Const_byte_range_ptr const src = _content(count);
 
-					out_count = num_bytes;
+					/* pass bytes of the ROM dataspace without copying */
+					out_count = src.num_bytes ? fn.consume(src) : 0;
 					return READ_OK;
 				}
 
@@ -132,13 +147,36 @@ class Vfs::Rom_file_system : public Single_file_system
 		Genode::Constructible<Genode::Io_signal_handler<Rom_file_system>>
 			_rom_changed_handler { };
 
+		/**
+		 * ROM session backing a dataspace handed out via 'dataspace'
+		 *
+		 * The ROM server may revoke the dataspace of '_rom' once it is
+		 * updated. Hence, each dataspace handed out stems from a ROM session
+		 * of its own, which is never updated and thereby keeps the
+		 * dataspace alive until it is released.
+		 */
+		struct Pinned_rom : Genode::Registry<Pinned_rom>::Element
+		{
+			Genode::Rom_connection             rom;
+			Genode::Dataspace_capability const ds { rom.dataspace() };
+
+			Pinned_rom(Genode::Registry<Pinned_rom> &registry,
+			           Genode::Env &env, Label const &label)
+			:
+				Genode::Registry<Pinned_rom>::Element(registry, *this),
+				rom(env, label.string())
+			{ }
+		};
+
+		Genode::Registry<Pinned_rom> _pinned_roms { };
+
 	public:
 
 		Rom_file_system(Vfs::Env &env, Node const &config)
 		:
 			Single_file_system(Node_type::CONTINUOUS_FILE, name(),
 			                   Node_rwx::ro(), config),
-			_env(env.env()), _vfs_user(env.user()),
+			_env(env.env()), _alloc(env.alloc()), _vfs_user(env.user()),
 
 			/* use 'label' attribute if present, fall back to 'name' if not */
 			_label(config.attribute_value("label",
@@ -147,6 +185,12 @@ class Vfs::Rom_file_system : public Single_file_system
 			_binary(config.attribute_value("binary", true))
 		{ }
 
+		~Rom_file_system()
+		{
+			_pinned_roms.for_each([&] (Pinned_rom &pinned) {
+				Genode::destroy(_alloc, &pinned); });
+		}
+
 		static char const *name()   { return "rom"; }
 		char const *type() override { return "rom"; }
 
@@ -177,13 +221,43 @@ class Vfs::Rom_file_system : public Single_file_system
 			if (!_single_file(path))
 				return Genode::Dataspace_capability();
 
-			return _rom.cap();
+			try {
+				Pinned_rom &pinned = *new (_alloc)
+					Pinned_rom(_pinned_roms, _env, _label);
+
+				if (pinned.ds.valid())
+					return pinned.ds;
+
+				Genode::destroy(_alloc, &pinned);
+			}
+			catch (Genode::Out_of_ram)     { }
+			catch (Genode::Out_of_caps)    { }
+			catch (Genode::Service_denied) { }
+
+			return Genode::Dataspace_capability();
+		}
+
+		void release(char const *, Dataspace_capability ds_cap) override
+		{
+			_pinned_roms.for_each([&] (Pinned_rom &pinned) {
+				if (pinned.ds == ds_cap)
+					Genode::destroy(_alloc, &pinned); });
 		}
 
 		/********************************
 		 ** File I/O service interface **
 		 ********************************/
 
+		Read_result complete_read_in_place(Vfs_handle           *vfs_handle,
+		                                   Byte_range_ptr const &bounce,
+		                                   Read_in_place_fn     &fn,
+		                                   size_t               &out_count) override
+		{
+			Rom_vfs_handle *handle = static_cast<Rom_vfs_handle *>(vfs_handle);
+
+			return handle->read_in_place(bounce.num_bytes, fn, out_count);
+		}
+
 		Stat_result stat(char const *path, Stat &out) override
 		{
 			Stat_result const result = Single_file_system::stat(path, out);
@@ -218,7 +218,13 @@ void Nic_perf::Interface::handle_packet_stream()
 		Packet_descriptor const packet_from_client = _sink.try_get_packet();
 
 		if (_sink.packet_valid(packet_from_client)) {
-			_handle_eth(_sink.packet_content(packet_from_client), packet_from_client.size());
+
+			/* received offload metadata is of no interest for measuring */
+			size_t const hdr_size = _offload_hdr_size();
+			if (packet_from_client.size() > hdr_size)
+				_handle_eth(_sink.packet_content(packet_from_client) + hdr_size,
+				            packet_from_client.size() - hdr_size);
+
 			if (!_sink.try_ack_packet(packet_from_client))
 				break;
 		}
@@ -240,9 +246,12 @@ void Nic_perf::Interface::handle_packet_stream()
 		if (!_source.ready_to_submit())
 			break;
 
+		Nic::Offload::Header offload { };
+
 		bool okay =
-			send(_generator.size(), [&] (void * pkt_base, Size_guard &size_guard) {
-				_generator.generate(pkt_base, size_guard, _mac, _ip);
+			send(_generator.size(), offload, [&] (void * pkt_base, Size_guard &size_guard) {
+				offload = _generator.generate(pkt_base, size_guard, _mac, _ip,
+				                              _offload.csum);
 			});
 
 		if (!okay)
@@ -24,6 +24,7 @@
 #include <os/packet_stream.h>
 #include <net/dhcp.h>
 #include <nic_session/nic_session.h>
+#include <nic_session/offload.h>
 #include <timer_session/connection.h>
 
 namespace Nic_perf {
@@ -63,6 +64,14 @@ class Nic_perf::Interface
 		Constructible<Dhcp_client>  _dhcp_client { };
 		Timer::Connection          &_timer;
 
+		/* offload metadata accepted by the peer, prepended to each packet */
+		Nic::Offload::Features const _offload;
+
+		static constexpr size_t OFFLOAD_HDR_SIZE = sizeof(Nic::Offload::Header);
+
+		size_t _offload_hdr_size() const {
+			return _offload.any() ? OFFLOAD_HDR_SIZE : 0; }
+
 		static Ipv4_address _subnet_mask()
 		{
 			uint8_t buf[] = { 0xff, 0xff, 0xff, 0 };
@@ -84,7 +93,8 @@ class Nic_perf::Interface
 		          Mac_address          mac,
 		          Source              &source,
 		          Sink                &sink,
-		          Timer::Connection   &timer)
+		          Timer::Connection   &timer,
+		          Nic::Offload::Features offload = { })
 		: _element(registry, *this),
 		  _label(label),
 		  _stats(_label),
@@ -93,7 +103,8 @@ class Nic_perf::Interface
 		  _default_mac(mac),
 		  _source(source),
 		  _sink(sink),
-		  _timer(timer)
+		  _timer(timer),
+		  _offload(offload)
 		{ apply_config(policy); }
 
 		void apply_config(Node const &config)
@@ -130,18 +141,30 @@ class Nic_perf::Interface
 
 		void handle_packet_stream();
 
+		/**
+		 * Send packet with offload metadata
+		 *
+		 * The metadata is copied after calling 'write_to_pkt', which may
+		 * thereby still modify it.
+		 */
 		template <typename FUNC>
-		bool send(size_t pkt_size, FUNC && write_to_pkt)
+		bool send(size_t pkt_size, Nic::Offload::Header const &offload,
+		          FUNC && write_to_pkt)
 		{
 			if (!pkt_size)
 				return false;
 
+			size_t const hdr_size = _offload_hdr_size();
+
 			try {
-				Packet_descriptor  pkt      = _source.alloc_packet(pkt_size);
-				void              *pkt_base = _source.packet_content(pkt);
+				Packet_descriptor  pkt      = _source.alloc_packet(hdr_size + pkt_size);
+				char              *pkt_base = _source.packet_content(pkt);
 
 				Size_guard size_guard { pkt_size };
-				write_to_pkt(pkt_base, size_guard);
+				write_to_pkt(pkt_base + hdr_size, size_guard);
+
+				if (hdr_size)
+					memcpy(pkt_base, &offload, hdr_size);
 
 				_source.try_submit_packet(pkt);
 			} catch (...) { return false; }
@@ -150,6 +173,10 @@ class Nic_perf::Interface
 
 			return true;
 		}
+
+		template <typename FUNC>
+		bool send(size_t pkt_size, FUNC && write_to_pkt) {
+			return send(pkt_size, Nic::Offload::Header { }, write_to_pkt); }
 };
 
 #endif /* _INTERFACE_H_ */
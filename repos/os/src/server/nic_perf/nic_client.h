@@ -36,7 +36,7 @@ class Nic_perf::Nic_client
 
 		Env                       &_env;
 		Nic::Packet_allocator      _pkt_alloc;
-		Nic::Connection            _nic { _env, &_pkt_alloc, BUF_SIZE, BUF_SIZE };
+		Nic::Connection            _nic;
 		Interface                  _interface;
 
 		Signal_handler<Nic_client> _packet_stream_handler
@@ -55,8 +55,11 @@ class Nic_perf::Nic_client
 		:
 			_env(env),
 			_pkt_alloc(&alloc),
+			_nic(_env, &_pkt_alloc, BUF_SIZE, BUF_SIZE, Nic::Connection::Label(),
+			     { .csum = policy.attribute_value("offload_csum", false),
+			       .gso  = false }),
 			_interface(registry, "nic-client", policy, false, Mac_address(),
-			           *_nic.tx(), *_nic.rx(), timer)
+			           *_nic.tx(), *_nic.rx(), timer, _nic.offload())
 		{
 			_nic.rx_channel()->sigh_ready_to_ack(_packet_stream_handler);
 			_nic.rx_channel()->sigh_packet_avail(_packet_stream_handler);
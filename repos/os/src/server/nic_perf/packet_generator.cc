@@ -15,6 +15,9 @@
 #include <packet_generator.h>
 #include <interface.h>
 
+/* Genode includes */
+#include <net/offload.h>
+
 void Nic_perf::Packet_generator::_handle_timeout(Genode::Duration)
 {
 	/* re-issue ARP request */
@@ -67,10 +70,12 @@ void Nic_perf::Packet_generator::_generate_arp_request(void               *pkt_b
 }
 
 
-void Nic_perf::Packet_generator::_generate_test_packet(void               *pkt_base,
-                                                       Size_guard         &size_guard,
-                                                       Mac_address  const &from_mac,
-                                                       Ipv4_address const &from_ip)
+Nic::Offload::Header
+Nic_perf::Packet_generator::_generate_test_packet(void               *pkt_base,
+                                                  Size_guard         &size_guard,
+                                                  Mac_address  const &from_mac,
+                                                  Ipv4_address const &from_ip,
+                                                  bool                partial_csum)
 {
 	if (from_ip == Ipv4_address()) {
 		error("Ip address not set");
@@ -106,21 +111,30 @@ void Nic_perf::Packet_generator::_generate_test_packet(void               *pkt_b
 
 	/* fill in length fields and checksums */
 	udp.length(size_guard.head_size() - udp_off);
-	udp.update_checksum(ip.src(), ip.dst());
 	ip.total_length(size_guard.head_size() - ip_off);
 	ip.update_checksum();
+
+	if (partial_csum)
+		return prepare_partial_checksum(pkt_base, udp_off, udp.length(),
+		                                Ipv4_packet::Protocol::UDP,
+		                                ip.src(), ip.dst());
+
+	udp.update_checksum(ip.src(), ip.dst());
+	return { };
 }
 
 
-void Nic_perf::Packet_generator::generate(void               *pkt_base,
-                                          Size_guard         &size_guard,
-                                          Mac_address  const &from_mac,
-                                          Ipv4_address const &from_ip)
+Nic::Offload::Header
+Nic_perf::Packet_generator::generate(void               *pkt_base,
+                                     Size_guard         &size_guard,
+                                     Mac_address  const &from_mac,
+                                     Ipv4_address const &from_ip,
+                                     bool                partial_csum)
 {
 	switch (_state) {
 		case READY:
-			_generate_test_packet(pkt_base, size_guard, from_mac, from_ip);
-			break;
+			return _generate_test_packet(pkt_base, size_guard, from_mac,
+			                             from_ip, partial_csum);
 		case NEED_ARP_REQUEST:
 			_generate_arp_request(pkt_base, size_guard, from_mac, from_ip);
 			_state = WAIT_ARP_REPLY;
@@ -131,4 +145,6 @@ void Nic_perf::Packet_generator::generate(void               *pkt_base,
 			throw Not_ready();
 			break;
 	}
+
+	return { };
 }
@@ -20,6 +20,7 @@
 #include <net/ipv4.h>
 #include <net/arp.h>
 #include <net/udp.h>
+#include <nic_session/offload.h>
 #include <timer_session/connection.h>
 
 namespace Nic_perf {
@@ -53,7 +54,10 @@ class Nic_perf::Packet_generator
 
 		void _generate_arp_request(void *, Size_guard &, Mac_address const &, Ipv4_address const &);
 
-		void _generate_test_packet(void *, Size_guard &, Mac_address const &, Ipv4_address const &);
+		Nic::Offload::Header _generate_test_packet(void *, Size_guard &,
+		                                           Mac_address const &,
+		                                           Ipv4_address const &,
+		                                           bool partial_csum);
 
 		void _handle_timeout(Genode::Duration);
 
@@ -110,7 +114,14 @@ class Nic_perf::Packet_generator
 
 		void handle_arp_reply(Arp_packet const &arp);
 
-		void generate(void *, Size_guard &, Mac_address const &, Ipv4_address const &);
+		/**
+		 * Generate next packet
+		 *
+		 * \param partial_csum  leave the UDP checksum to the receiver
+		 * \return              offload metadata of the packet
+		 */
+		Nic::Offload::Header generate(void *, Size_guard &, Mac_address const &,
+		                              Ipv4_address const &, bool partial_csum);
 };
 
 #endif /* _PACKET_GENERATOR_H_ */
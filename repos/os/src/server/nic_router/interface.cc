@@ -17,6 +17,7 @@
 #include <net/icmp.h>
 #include <net/arp.h>
 #include <net/internet_checksum.h>
+#include <net/offload.h>
 #include <base/quota_guard.h>
 
 /* local includes */
@@ -336,9 +337,28 @@ void Interface::_pass_prot_to_domain(Domain                       &domain,
                                      void                  *const  prot_base,
                                      size_t                 const  prot_size)
 {
-	_update_checksum(
-		prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
+	Nic::Offload::Header offload = _forwarded_rx_offload();
+	if (offload.gso_tcpv4()) {
 
+		/* the segments receive their checksums when being split */
+
+	} else if (prot == L3_protocol::TCP || prot == L3_protocol::UDP) {
+
+		/*
+		 * Leave the completion of the checksum to the receiving interface,
+		 * which may delegate it further to its counter side
+		 */
+		offload = prepare_partial_checksum(
+			&eth, (addr_t)prot_base - (addr_t)&eth, prot_size, prot,
+			ip.src(), ip.dst());
+
+	} else {
+
+		_update_checksum(
+			prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
+
+		offload = { };
+	}
 	ip.update_checksum(ip_icd);
 	domain.interfaces().for_each([&] (Interface &interface)
 	{
@@ -346,7 +366,7 @@ void Interface::_pass_prot_to_domain(Domain                       &domain,
 		if (!domain.use_arp()) {
 			eth.dst(interface._router_mac);
 		}
-		interface.send(eth, size_guard);
+		interface.send(eth, size_guard, offload);
 	});
 }
 
@@ -961,7 +981,7 @@ void Interface::_domain_broadcast(Ethernet_frame &eth,
 {
 	local_domain.interfaces().for_each([&] (Interface &interface) {
 		if (&interface != this) {
-			interface.send(eth, size_guard);
+			interface.send(eth, size_guard, _forwarded_rx_offload());
 		}
 	});
 }
@@ -1429,7 +1449,7 @@ Packet_result Interface::_handle_ip(Ethernet_frame          &eth,
 			if (result.valid())
 				return;
 			remote_domain.interfaces().for_each([&] (Interface &interface) {
-				interface.send(eth, size_guard);
+				interface.send(eth, size_guard, _forwarded_rx_offload());
 			});
 			result = packet_handled();
 		},
@@ -1642,6 +1662,26 @@ void Interface::_drop_packet(Packet_descriptor const &pkt, char const *reason)
 }
 
 
+Packet_result Interface::_handle_pkt_content(Packet_descriptor const &pkt)
+{
+	char   *base = _sink.packet_content(pkt);
+	size_t  size = pkt.size();
+
+	_rx_offload = { };
+	if (_offload.any()) {
+
+		if (size <= sizeof(_rx_offload))
+			return packet_drop("missing offload header");
+
+		Genode::memcpy(&_rx_offload, base, sizeof(_rx_offload));
+		base += sizeof(_rx_offload);
+		size -= sizeof(_rx_offload);
+	}
+	Size_guard size_guard(size);
+	return _handle_eth(base, size_guard, pkt);
+}
+
+
 void Interface::_handle_pkt()
 {
 	Packet_descriptor const pkt = _sink.get_packet();
@@ -1649,8 +1689,7 @@ void Interface::_handle_pkt()
 		_drop_packet(pkt, "invalid Nic packet");
 		return;
 	}
-	Size_guard size_guard(pkt.size());
-	Packet_result result = _handle_eth(_sink.packet_content(pkt), size_guard, pkt);
+	Packet_result result = _handle_pkt_content(pkt);
 	switch (result.type) {
 	case Packet_result::HANDLED: _ack_packet(pkt); break;
 	case Packet_result::POSTPONED: break;
@@ -1724,8 +1763,7 @@ void Interface::_continue_handle_eth(Packet_descriptor const &pkt)
 		_drop_packet(pkt, "invalid Nic packet");
 		return;
 	}
-	Size_guard size_guard(pkt.size());
-	Packet_result result = _handle_eth(_sink.packet_content(pkt), size_guard, pkt);
+	Packet_result result = _handle_pkt_content(pkt);
 	switch (result.type) {
 	case Packet_result::HANDLED: _ack_packet(pkt); break;
 	case Packet_result::POSTPONED: _drop_packet(pkt, "postponed twice"); break;
@@ -1863,11 +1901,52 @@ Packet_result Interface::_handle_eth(void              *const  eth_base,
 }
 
 
-void Interface::send(Ethernet_frame &eth,
-                     Size_guard     &size_guard)
+void Interface::send(Ethernet_frame             &eth,
+                     Size_guard                 &size_guard,
+                     Nic::Offload::Header const &offload)
 {
-	send(size_guard.total_size(), [&] (void *pkt_base, Size_guard &size_guard) {
+	size_t const size = size_guard.total_size();
+
+	if (offload.gso_tcpv4() && !_offload.gso) {
+		_send_segments(eth, size, offload);
+		return;
+	}
+
+	/* complete the checksum on behalf of a counter side without offloading */
+	bool const complete = offload.csum_needed() && !offload.gso_tcpv4()
+	                   && !_offload.csum;
+
+	Nic::Offload::Header header = offload;
+	if (!_offload.csum)
+		header.flags &= (Genode::uint8_t)~(Nic::Offload::Header::CSUM_NEEDED |
+		                           Nic::Offload::Header::CSUM_VALID);
+
+	send(size, header, [&] (void *pkt_base, Size_guard &size_guard) {
 		Genode::memcpy(pkt_base, (void *)&eth, size_guard.total_size());
+		if (complete)
+			complete_checksum(offload, pkt_base, size);
+	});
+}
+
+
+void Interface::_send_segments(Ethernet_frame             &eth,
+                               size_t                      size,
+                               Nic::Offload::Header const &offload)
+{
+	Tcp_segmenter const segmenter(&eth, size, offload.gso_size);
+	if (!segmenter.valid()) {
+		if (_config_ptr->verbose()) {
+			log("[", *_domain_ptr, "] failed to send packet (malformed GSO frame)"); }
+		return;
+	}
+	Tcp_segmenter::Checksum const checksum = _offload.csum
+	                                       ? Tcp_segmenter::Checksum::PARTIAL
+	                                       : Tcp_segmenter::Checksum::COMPLETE;
+
+	segmenter.for_each_segment([&] (unsigned i, size_t seg_size) {
+		Nic::Offload::Header header { };
+		send(seg_size, header, [&] (void *pkt_base, Size_guard &) {
+			header = segmenter.write_segment(i, pkt_base, checksum); });
 	});
 }
 
@@ -1906,7 +1985,8 @@ Interface::Interface(Genode::Entrypoint     &ep,
                      Interface_list         &interfaces,
                      Packet_stream_sink     &sink,
                      Packet_stream_source   &source,
-                     Interface_policy       &policy)
+                     Interface_policy       &policy,
+                     Nic::Offload::Features  offload)
 :
 	_sink                      { sink },
 	_source                    { source },
@@ -1915,6 +1995,7 @@ Interface::Interface(Genode::Entrypoint     &ep,
 	_mac                       { mac },
 	_config_ptr                { &config },
 	_policy                    { policy },
+	_offload                   { offload },
 	_timer                     { timer },
 	_alloc                     { alloc },
 	_interfaces                { interfaces }
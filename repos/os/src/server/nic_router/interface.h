@@ -26,6 +26,7 @@
 /* Genode includes */
 #include <net/dhcp.h>
 #include <net/icmp.h>
+#include <nic_session/offload.h>
 
 namespace Genode { class Generator; }
 
@@ -150,6 +151,8 @@ class Net::Interface : private Interface_list::Element
 		Mac_address                    const  _mac;
 		Configuration                        *_config_ptr;
 		Interface_policy                     &_policy;
+		Nic::Offload::Features         const  _offload;
+		Nic::Offload::Header                  _rx_offload                { };
 		Cached_timer                         &_timer;
 		Genode::Allocator                    &_alloc;
 		Domain                               *_domain_ptr                { };
@@ -312,6 +315,8 @@ class Net::Interface : private Interface_list::Element
 
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
+		[[nodiscard]] Packet_result _handle_pkt_content(Packet_descriptor const &pkt);
+
 		Ipv4_address const &_router_ip() const;
 
 		void _drop_packet(Packet_descriptor const &pkt, char const *reason);
@@ -331,6 +336,23 @@ class Net::Interface : private Interface_list::Element
 		                      void                      * &pkt_base,
 		                      Genode::size_t               pkt_size);
 
+		void _send_segments(Ethernet_frame             &eth,
+		                    Genode::size_t              size,
+		                    Nic::Offload::Header const &offload);
+
+		/**
+		 * Offload metadata of the received packet as passed on unmodified
+		 *
+		 * Other interfaces must not rely on the checksum verification
+		 * claimed by the sender, which is therefore not passed on.
+		 */
+		Nic::Offload::Header _forwarded_rx_offload() const
+		{
+			Nic::Offload::Header header = _rx_offload;
+			header.flags &= (Genode::uint8_t)~Nic::Offload::Header::CSUM_VALID;
+			return header;
+		}
+
 		void _update_dhcp_allocations(Domain &old_domain,
                                       Domain &new_domain);
 
@@ -388,13 +410,23 @@ class Net::Interface : private Interface_list::Element
 		          Interface_list         &interfaces,
 		          Packet_stream_sink     &sink,
 		          Packet_stream_source   &source,
-		          Interface_policy       &policy);
+		          Interface_policy       &policy,
+		          Nic::Offload::Features  offload);
 
 		virtual ~Interface();
 
 		void dhcp_allocation_expired(Dhcp_allocation &allocation);
 
-		void send(Genode::size_t pkt_size, auto const &write_to_pkt)
+		/**
+		 * Send frame with offload metadata
+		 *
+		 * The metadata is transferred only if the counter side uses
+		 * offloading and 'write_to_pkt' may still modify it. The caller is
+		 * responsible for setting only flags accepted by the counter side.
+		 */
+		void send(Genode::size_t              pkt_size,
+		          Nic::Offload::Header const &offload,
+		          auto                 const &write_to_pkt)
 		{
 			if (!link_state()) {
 				_failed_to_send_packet_link();
@@ -404,12 +436,19 @@ class Net::Interface : private Interface_list::Element
 				_failed_to_send_packet_submit();
 				return;
 			}
-			_source.alloc_packet_attempt(pkt_size).with_result(
+			Genode::size_t const hdr_size =
+				_offload.any() ? sizeof(Nic::Offload::Header) : 0;
+
+			_source.alloc_packet_attempt(hdr_size + pkt_size).with_result(
 				[&] (Packet_descriptor pkt)
 				{
-					void *pkt_base { _source.packet_content(pkt) };
+					char *hdr_base { _source.packet_content(pkt) };
+					void *pkt_base { hdr_base + hdr_size };
 					Size_guard size_guard(pkt_size);
 					write_to_pkt(pkt_base, size_guard);
+					if (hdr_size)
+						Genode::memcpy(hdr_base, &offload, hdr_size);
+
 					_send_submit_pkt(pkt, pkt_base, pkt_size);
 				},
 				[&] (Packet_stream_source::Alloc_packet_error)
@@ -419,8 +458,20 @@ class Net::Interface : private Interface_list::Element
 			);
 		}
 
+		void send(Genode::size_t pkt_size, auto const &write_to_pkt)
+		{
+			send(pkt_size, Nic::Offload::Header { }, write_to_pkt);
+		}
+
+		void send(Ethernet_frame             &eth,
+		          Size_guard                 &size_guard,
+		          Nic::Offload::Header const &offload);
+
 		void send(Ethernet_frame &eth,
-		          Size_guard     &size_guard);
+		          Size_guard     &size_guard)
+		{
+			send(eth, size_guard, Nic::Offload::Header { });
+		}
 
 		Link_list &dissolved_links(L3_protocol const protocol);
 
@@ -485,6 +536,20 @@ class Net::Interface : private Interface_list::Element
 		Interface_object_stats    &dhcp_stats()                      { return _dhcp_stats; }
 		void                       wakeup_source()                   { _source.wakeup(); }
 		void                       wakeup_sink()                     { _sink.wakeup(); }
+
+		/**
+		 * Offload metadata accepted from the counter side
+		 *
+		 * The router handles all kinds of metadata as soon as the counter
+		 * side uses offloading at all.
+		 */
+		Nic::Offload::Features accepted_offload() const
+		{
+			if (!_offload.any())
+				return { };
+
+			return { .csum = true, .gso = true };
+		}
 };
 
 #endif /* _INTERFACE_H_ */
@@ -132,12 +132,13 @@ Net::Nic_client_interface::Nic_client_interface(Env                 &env,
 :
 	Nic_client_interface_base   { domain_name, label, _session_link_state },
 	Nic::Packet_allocator       { &alloc },
-	Nic::Connection             { env, this, BUF_SIZE, BUF_SIZE, label.string() },
+	Nic::Connection             { env, this, BUF_SIZE, BUF_SIZE, label.string(),
+	                              { .csum = true, .gso = true } },
 	_session_link_state_handler { env.ep(), *this,
 	                              &Nic_client_interface::_handle_session_link_state },
 	_interface                  { env.ep(), timer, mac_address(), alloc,
 	                              Mac_address(), config, interfaces, *rx(), *tx(),
-	                              *this }
+	                              *this, offload() }
 {
 	/* install packet stream signal handlers */
 	rx_channel()->sigh_packet_avail(_interface.pkt_stream_signal_handler());
@@ -241,7 +241,8 @@ Nic_session_component(Session_env                    &session_env,
                       Session_label            const &label,
                       Interface_list                 &interfaces,
                       Configuration                  &config,
-                      Ram_dataspace_capability const  ram_ds)
+                      Ram_dataspace_capability const  ram_ds,
+                      Nic::Offload::Features   const  offload)
 :
 	Nic_session_component_base { session_env, tx_buf_size,rx_buf_size },
 	Session_rpc_object         { _session_env, _tx_buf.ds(), _rx_buf.ds(),
@@ -249,7 +250,7 @@ Nic_session_component(Session_env                    &session_env,
 	_interface_policy          { label, _session_env, config },
 	_interface                 { _session_env.ep(), timer, router_mac, _alloc,
 	                             mac, config, interfaces, *_tx.sink(),
-	                             *_rx.source(), _interface_policy },
+	                             *_rx.source(), _interface_policy, offload },
 	_ram_ds                    { ram_ds }
 {
 	_interface.attach_to_domain();
@@ -323,7 +324,8 @@ Net::Nic_session_root::_create_session(char const *args)
 								Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 								Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 								_timer, mac, *_router_mac, label, _interfaces,
-								*_config_ptr, ram_ds);
+								*_config_ptr, ram_ds,
+								Nic::Offload::Features::from_args(args));
 						}
 						catch (...) {
 							_mac_alloc.free(mac);
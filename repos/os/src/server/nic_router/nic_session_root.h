@@ -148,7 +148,8 @@ class Net::Nic_session_component : private Nic_session_component_base,
 		                      Genode::Session_label            const &label,
 		                      Interface_list                         &interfaces,
 		                      Configuration                          &config,
-		                      Genode::Ram_dataspace_capability const  ram_ds);
+		                      Genode::Ram_dataspace_capability const  ram_ds,
+		                      Nic::Offload::Features           const  offload);
 
 
 		/******************
@@ -158,6 +159,7 @@ class Net::Nic_session_component : private Nic_session_component_base,
 		Mac_address mac_address() override { return _interface.mac(); }
 		bool link_state() override;
 		void link_state_sigh(Genode::Signal_context_capability sigh) override;
+		Nic::Offload::Features offload() override { return _interface.accepted_offload(); }
 
 
 		/***************
@@ -111,7 +111,15 @@ class Net::Uplink_session_component : private Uplink_session_component_base,
 		                         Genode::Session_label            const &label,
 		                         Interface_list                         &interfaces,
 		                         Configuration                          &config,
-		                         Genode::Ram_dataspace_capability const  ram_ds);
+		                         Genode::Ram_dataspace_capability const  ram_ds,
+		                         Nic::Offload::Features           const  offload);
+
+
+		/********************
+		 ** Uplink::Session **
+		 ********************/
+
+		Nic::Offload::Features offload() override { return _interface.accepted_offload(); }
 
 
 		/***************
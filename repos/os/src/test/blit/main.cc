@@ -367,17 +367,84 @@ static inline void test_simd_blend_mix()
 }
 
 
+template <typename SIMD>
+static inline void test_simd_dither()
+{
+	/* pseudo-random pixel and alpha values */
+	uint32_t pixel[64];
+	uint8_t  alpha[64];
+	uint32_t seed = 0x12345678;
+	for (unsigned i = 0; i < 64; i++) {
+		seed = seed*1103515245 + 12345;
+		pixel[i] = seed;
+		alpha[i] = uint8_t(seed >> 24);
+	}
+
+	auto check = [&] (auto msg, auto const &ref, auto const &simd, unsigned n)
+	{
+		for (unsigned i = 0; i < n; i++) {
+			if (ref[i] != simd[i]) {
+				error("dither ", msg, " mismatch at ", i, ": ref=", Hex(ref[i]),
+				      " simd=", Hex(simd[i]));
+				throw 1;
+			}
+		}
+	};
+
+	/* exercise vectorized loop and scalar remainder at varying offsets */
+	for (unsigned y = 0; y < 16; y += 5) {
+		Dither_row const row(y);
+		for (unsigned x = 0; x < 20; x += 3) {
+			for (unsigned n : { 0u, 7u, 8u, 15u, 16u, 33u, 64u }) {
+
+				uint16_t rgb565_ref[64] { }, rgb565_simd[64] { };
+				Slow::Dither::rgb565(rgb565_ref,  n, pixel, row, x);
+				SIMD::Dither::rgb565(rgb565_simd, n, pixel, row, x);
+				check("rgb565", rgb565_ref, rgb565_simd, n);
+
+				uint32_t xrgb_ref[64] { }, xrgb_simd[64] { };
+				Slow::Dither::xrgb(xrgb_ref,  n, pixel, row, x);
+				SIMD::Dither::xrgb(xrgb_simd, n, pixel, row, x);
+				check("xrgb", xrgb_ref, xrgb_simd, n);
+
+				uint8_t alpha8_ref[64] { }, alpha8_simd[64] { };
+				Slow::Dither::alpha8(alpha8_ref,  n, alpha, row, x);
+				SIMD::Dither::alpha8(alpha8_simd, n, alpha, row, x);
+				check("alpha8", alpha8_ref, alpha8_simd, n);
+			}
+		}
+	}
+
+	/* compare scalar reference against the generic pixel conversion */
+	Dither_row const row(3);
+	for (unsigned x = 0; x < 64; x++) {
+		Pixel_rgb888 p { };
+		p.pixel = pixel[x];
+		int const v = Dither_matrix::value(x, 3) >> 4;
+		Pixel_rgb565 const expected(max(0, p.r() - v), max(0, p.g() - v), max(0, p.b() - v));
+		if (row.rgb565(pixel[x], x) != expected.pixel) {
+			error("dither rgb565 of ", Hex(pixel[x]), " -> ", Hex(row.rgb565(pixel[x], x)),
+			      " expected ", Hex(expected.pixel));
+			throw 1;
+		}
+	}
+	log("dither conversion matches reference");
+}
+
+
 void Component::construct(Genode::Env &)
 {
 #ifdef _INCLUDE__BLIT__INTERNAL__NEON_H_
 	log("-- ARM Neon --");
 	test_simd_b2f<Neon>();
 	test_simd_blend_mix<Neon>();
+	test_simd_dither<Neon>();
 #endif
 #ifdef _INCLUDE__BLIT__INTERNAL__SSE4_H_
 	log("-- SSE4 --");
 	test_simd_b2f<Sse4>();
 	test_simd_blend_mix<Sse4>();
+	test_simd_dither<Sse4>();
 #endif
 
 	test_b2f_dispatch();
@@ -140,6 +140,39 @@ struct Unaligned_blit_test : Test
 	}
 };
 
+template <typename DST_PT, bool SIMD>
+struct Dither_test : Test
+{
+	static constexpr char const *brief = SIMD
+		? "dithered conversion from RGB888 via blit library from RAM to RAM"
+		: "dithered conversion from RGB888 via generic kernel from RAM to RAM";
+
+	Dither_test(Env &env, int id) : Test(env, id, brief)
+	{
+		Blit::Area const area = fb_mode.area;
+
+		Texture<Pixel_rgb888> const texture((Pixel_rgb888 *)buf[1],
+		                                    (unsigned char *)buf[1], area);
+		Surface<DST_PT> surface((DST_PT *)buf[0], area);
+
+		size_t const kib_per_frame = (area.count()*sizeof(DST_PT)) / 1024;
+
+		unsigned       frames   = 0;
+		size_t         kib      = 0;
+		uint64_t const start_ms = timer.elapsed_ms();
+		for (; timer.elapsed_ms() - start_ms < DURATION_MS; frames++) {
+			if (SIMD)
+				Blit::dither(surface, texture, Blit::Point { });
+			else
+				Blit::_dither<Blit::Slow>(surface, texture, Blit::Point { });
+			kib += kib_per_frame;
+		}
+		uint64_t const end_ms = timer.elapsed_ms();
+		conclusion(kib, start_ms, end_ms);
+		log("frames/sec: ", (frames*1000ull) / (end_ms - start_ms));
+	}
+};
+
 struct Main
 {
 	Constructible<Bytewise_ram_test>   test_1 { };
@@ -147,6 +180,11 @@ struct Main
 	Constructible<Blit_test>           test_3 { };
 	Constructible<Unaligned_blit_test> test_4 { };
 
+	Constructible<Dither_test<Pixel_rgb565, false>> test_5 { };
+	Constructible<Dither_test<Pixel_rgb565, true>>  test_6 { };
+	Constructible<Dither_test<Pixel_alpha8, false>> test_7 { };
+	Constructible<Dither_test<Pixel_alpha8, true>>  test_8 { };
+
 	Main(Env &env)
 	{
 		log("--- Framebuffer benchmark ---");
@@ -154,6 +192,10 @@ struct Main
 		test_2.construct(env, 2); test_2.destruct();
 		test_3.construct(env, 3); test_3.destruct();
 		test_4.construct(env, 4); test_4.destruct();
+		test_5.construct(env, 5); test_5.destruct();
+		test_6.construct(env, 6); test_6.destruct();
+		test_7.construct(env, 7); test_7.destruct();
+		test_8.construct(env, 8); test_8.destruct();
 		log("--- Framebuffer benchmark finished ---");
 	}
 };
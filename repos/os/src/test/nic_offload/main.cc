@@ -0,0 +1,319 @@
+/*
+ * \brief  Test for the software fallbacks of NIC offload metadata
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The test checks the completion of partial checksums, the splitting of large
+ * TCP frames into segments, and the allocation of packets that span a
+ * number of blocks other than a power of two.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <net/offload.h>
+#include <net/ethernet.h>
+#include <net/tcp.h>
+#include <net/udp.h>
+#include <net/size_guard.h>
+#include <os/packet_allocator.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+struct Test_failed : Exception { };
+
+static void check(bool condition, char const *what)
+{
+	if (condition)
+		return;
+
+	error("check failed: ", what);
+	throw Test_failed();
+}
+
+
+static uint8_t src_ip_bytes[] { 10, 0, 0, 1 };
+static uint8_t dst_ip_bytes[] { 10, 0, 0, 2 };
+
+static Ipv4_address const SRC_IP { src_ip_bytes };
+static Ipv4_address const DST_IP { dst_ip_bytes };
+
+enum { TCP_SEQ = 1000, TCP_FLAGS_ACK = 0x10, TCP_FLAGS_PSH = 0x08,
+       TCP_FLAGS_FIN = 0x01, TCP_FLAGS_CWR = 0x80 };
+
+
+/**
+ * Frame with an L4 packet of 'payload_size' bytes of deterministic content
+ */
+struct Frame
+{
+	uint8_t buf[Nic::Offload::MAX_FRAME_SIZE] { };
+
+	size_t size      { 0 };
+	size_t l4_offset { 0 };
+
+	Frame(Ipv4_packet::Protocol protocol, size_t payload_size)
+	{
+		Size_guard size_guard(sizeof(buf));
+
+		Ethernet_frame &eth = Ethernet_frame::construct_at(buf, size_guard);
+		eth.dst(Mac_address(0x02));
+		eth.src(Mac_address(0x04));
+		eth.type(Ethernet_frame::Type::IPV4);
+
+		size_t const ip_offset = size_guard.head_size();
+		Ipv4_packet &ip = eth.construct_at_data<Ipv4_packet>(size_guard);
+		ip.header_length(sizeof(Ipv4_packet) / 4);
+		ip.version(4);
+		ip.time_to_live(64);
+		ip.identification(7);
+		ip.protocol(protocol);
+		ip.src(SRC_IP);
+		ip.dst(DST_IP);
+
+		l4_offset = size_guard.head_size();
+		if (protocol == Ipv4_packet::Protocol::TCP) {
+			Tcp_packet &tcp = ip.construct_at_data<Tcp_packet>(size_guard);
+			tcp.src_port(Port(80));
+			tcp.dst_port(Port(1234));
+			tcp.seq_nr(TCP_SEQ);
+			tcp.flags((uint16_t)((sizeof(Tcp_packet) / 4) << 12 | TCP_FLAGS_ACK
+			          | TCP_FLAGS_PSH | TCP_FLAGS_FIN | TCP_FLAGS_CWR));
+		} else {
+			Udp_packet &udp = ip.construct_at_data<Udp_packet>(size_guard);
+			udp.src_port(Port(53));
+			udp.dst_port(Port(1234));
+		}
+
+		size_t const payload_offset = size_guard.head_size();
+		size_guard.consume_head(payload_size);
+		for (size_t i = 0; i < payload_size; i++)
+			buf[payload_offset + i] = (uint8_t)(i*7 + 3);
+
+		size = size_guard.head_size();
+		ip.total_length(size - ip_offset);
+		ip.update_checksum();
+
+		if (protocol == Ipv4_packet::Protocol::TCP)
+			tcp().update_checksum(ip.src(), ip.dst(), size - l4_offset);
+		else {
+			udp().length((uint16_t)(size - l4_offset));
+			udp().update_checksum(ip.src(), ip.dst());
+		}
+	}
+
+	Ipv4_packet &ip()  { return *(Ipv4_packet *)(buf + sizeof(Ethernet_frame)); }
+	Tcp_packet  &tcp() { return *(Tcp_packet  *)(buf + l4_offset); }
+	Udp_packet  &udp() { return *(Udp_packet  *)(buf + l4_offset); }
+};
+
+
+/**
+ * Compare the L4 checksum after prepare/complete with the regular one
+ */
+static void test_complete_checksum(Ipv4_packet::Protocol protocol,
+                                   size_t payload_size)
+{
+	static Frame frame { protocol, payload_size };
+	frame = Frame(protocol, payload_size);
+
+	bool const tcp = (protocol == Ipv4_packet::Protocol::TCP);
+
+	uint16_t const expected = tcp ? frame.tcp().checksum() : frame.udp().checksum();
+
+	Nic::Offload::Header const header =
+		prepare_partial_checksum(frame.buf, frame.l4_offset,
+		                         frame.size - frame.l4_offset, protocol,
+		                         SRC_IP, DST_IP);
+
+	check(header.csum_needed(), "partial checksum metadata");
+	check(header.csum_start == frame.l4_offset, "checksum start");
+
+	uint16_t const partial = tcp ? frame.tcp().checksum() : frame.udp().checksum();
+	check(partial != expected || payload_size == 0, "partial checksum differs");
+
+	check(complete_checksum(header, frame.buf, frame.size), "completion");
+
+	uint16_t const completed = tcp ? frame.tcp().checksum() : frame.udp().checksum();
+	check(completed == expected, "completed checksum matches");
+
+	/* link-layer padding beyond the IPv4 total length is not summed up */
+	uint8_t const pad[] { 0x5a, 0xa5, 0x3c, 0xc3 };
+	memcpy(frame.buf + frame.size, pad, sizeof(pad));
+	prepare_partial_checksum(frame.buf, frame.l4_offset, frame.size - frame.l4_offset,
+	                         protocol, SRC_IP, DST_IP);
+	check(complete_checksum(header, frame.buf, frame.size + sizeof(pad)),
+	      "completion of padded frame");
+
+	uint16_t const padded = tcp ? frame.tcp().checksum() : frame.udp().checksum();
+	check(padded == expected, "padding excluded from checksum");
+
+	/* a checksum field beyond the frame is rejected */
+	check(!complete_checksum(header, frame.buf, header.csum_start + header.csum_offset + 1),
+	      "checksum field beyond frame rejected");
+}
+
+
+static void test_segmentation(size_t payload_size, size_t mss,
+                              Tcp_segmenter::Checksum checksum)
+{
+	static Frame frame { Ipv4_packet::Protocol::TCP, 0 };
+	frame = Frame(Ipv4_packet::Protocol::TCP, payload_size);
+
+	static uint8_t segment[Nic::Offload::MAX_FRAME_SIZE];
+
+	Tcp_segmenter const segmenter(frame.buf, frame.size, mss);
+	check(segmenter.valid(), "TCP frame accepted");
+
+	unsigned const expected_segments =
+		payload_size ? (unsigned)((payload_size + mss - 1) / mss) : 1;
+	check(segmenter.num_segments() == expected_segments, "number of segments");
+
+	size_t const hdr_size = frame.l4_offset + sizeof(Tcp_packet);
+	size_t payload_sum = 0;
+
+	segmenter.for_each_segment([&] (unsigned i, size_t size) {
+
+		bool const last = (i + 1 == segmenter.num_segments());
+
+		check(!payload_size || (size > hdr_size && size - hdr_size <= mss),
+		      "segment size");
+
+		Nic::Offload::Header const header = segmenter.write_segment(i, segment, checksum);
+
+		Ipv4_packet &ip  = *(Ipv4_packet *)(segment + sizeof(Ethernet_frame));
+		Tcp_packet  &tcp = *(Tcp_packet  *)(segment + frame.l4_offset);
+
+		size_t const seg_payload = size - hdr_size;
+
+		check(ip.total_length() == size - sizeof(Ethernet_frame), "IPv4 length");
+		check(ip.identification() == 7 + i, "IPv4 identification");
+		check(!ip.checksum_error(), "IPv4 checksum");
+		check(tcp.seq_nr() == TCP_SEQ + payload_sum, "sequence number");
+		check(tcp.cwr() == (i == 0), "CWR in first segment only");
+		check(tcp.psh() == last && tcp.fin() == last, "PSH/FIN in last segment only");
+		check(!memcmp(segment + hdr_size, frame.buf + hdr_size + payload_sum, seg_payload),
+		      "segment payload");
+
+		if (checksum == Tcp_segmenter::Checksum::PARTIAL) {
+			check(header.csum_needed(), "partial checksum metadata");
+			check(complete_checksum(header, segment, size), "completion");
+		}
+
+		uint16_t const actual = tcp.checksum();
+		tcp.update_checksum(ip.src(), ip.dst(), size - frame.l4_offset);
+		check(tcp.checksum() == actual, "TCP checksum");
+
+		payload_sum += seg_payload;
+	});
+
+	check(payload_sum == payload_size, "payload covered by segments");
+}
+
+
+static void test_segmenter_rejects()
+{
+	static Frame frame { Ipv4_packet::Protocol::UDP, 100 };
+	frame = Frame(Ipv4_packet::Protocol::UDP, 100);
+
+	check(!Tcp_segmenter(frame.buf, frame.size, 1000).valid(), "UDP frame rejected");
+
+	frame = Frame(Ipv4_packet::Protocol::TCP, 100);
+	check(!Tcp_segmenter(frame.buf, frame.size, 0).valid(), "zero MSS rejected");
+	check(!Tcp_segmenter(frame.buf, frame.l4_offset, 1000).valid(), "truncated frame rejected");
+
+	frame.ip().more_fragments(true);
+	check(!Tcp_segmenter(frame.buf, frame.size, 1000).valid(), "fragment rejected");
+}
+
+
+/**
+ * Allocate packets of three blocks each until the range is exhausted
+ */
+static void test_packet_allocator(Allocator &md_alloc)
+{
+	enum { BLOCK = 64, NUM_BLOCKS = 20, CNT = 3, BASE = 0x10000 };
+
+	Packet_allocator alloc(&md_alloc, BLOCK);
+	check(alloc.add_range(BASE, BLOCK*NUM_BLOCKS).ok(), "add range");
+
+	addr_t   addrs[NUM_BLOCKS] { };
+	unsigned num = 0;
+
+	for (;;) {
+		bool const ok = alloc.try_alloc(CNT*BLOCK).convert<bool>(
+			[&] (Range_allocator::Allocation &a) {
+				a.deallocate = false;
+				addrs[num++] = (addr_t)a.ptr;
+				return true; },
+			[&] (Alloc_error) { return false; });
+
+		if (!ok || num == NUM_BLOCKS)
+			break;
+	}
+
+	check(num == NUM_BLOCKS / CNT, "packets fill the range");
+
+	for (unsigned i = 0; i < num; i++) {
+		check(addrs[i] >= BASE && addrs[i] + CNT*BLOCK <= BASE + BLOCK*NUM_BLOCKS,
+		      "packet within range");
+		for (unsigned j = 0; j < i; j++)
+			check(addrs[i] + CNT*BLOCK <= addrs[j] || addrs[j] + CNT*BLOCK <= addrs[i],
+			      "packets do not overlap");
+	}
+
+	/* a freed packet can be allocated again */
+	alloc.free((void *)addrs[1], CNT*BLOCK);
+	check(alloc.try_alloc(CNT*BLOCK).convert<bool>(
+		[&] (Range_allocator::Allocation &a) {
+			a.deallocate = false;
+			return (addr_t)a.ptr == addrs[1]; },
+		[&] (Alloc_error) { return false; }), "freed packet reallocated");
+
+	for (unsigned i = 0; i < num; i++)
+		alloc.free((void *)addrs[i], CNT*BLOCK);
+
+	check(alloc.remove_range(BASE, BLOCK*NUM_BLOCKS).ok(), "remove range");
+}
+
+
+void Component::construct(Genode::Env &env)
+{
+	static Heap heap { env.ram(), env.rm() };
+
+	try {
+		test_complete_checksum(Ipv4_packet::Protocol::TCP, 0);
+		test_complete_checksum(Ipv4_packet::Protocol::TCP, 1459);
+		test_complete_checksum(Ipv4_packet::Protocol::UDP, 1);
+		test_complete_checksum(Ipv4_packet::Protocol::UDP, 1472);
+
+		auto segmentation = [&] (Tcp_segmenter::Checksum checksum) {
+			test_segmentation(0,     1460, checksum);
+			test_segmentation(1000,  1460, checksum);
+			test_segmentation(1460,  1460, checksum);
+			test_segmentation(4381,  1460, checksum);
+			test_segmentation(60000, 1448, checksum);
+		};
+		segmentation(Tcp_segmenter::Checksum::COMPLETE);
+		segmentation(Tcp_segmenter::Checksum::PARTIAL);
+
+		test_segmenter_rejects();
+		test_packet_allocator(heap);
+	}
+	catch (Test_failed) {
+		env.parent().exit(-1);
+		return;
+	}
+
+	log("--- NIC offload test finished ---");
+	env.parent().exit(0);
+}
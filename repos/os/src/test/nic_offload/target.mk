@@ -0,0 +1,3 @@
+TARGET = test-nic_offload
+SRC_CC = main.cc
+LIBS   = base net
@@ -678,6 +678,167 @@ struct Nested_stress_test : Signal_test
 	}
 };
 
+/**
+ * Measure throughput and latency of signal delivery to entrypoints
+ *
+ * For measuring the throughput, a sender submits signals round-robin to a
+ * number of contexts handled by one entrypoint. The latency is derived from
+ * the number of signals bounced back and forth between two entrypoints.
+ */
+struct Entrypoint_signal_bench : Signal_test
+{
+	static constexpr char const *brief = "throughput and latency of entrypoint signals";
+
+	enum { NUM_CONTEXTS = 16, DURATION_MS = 2000, STACK_SIZE = 4*1024*sizeof(long) };
+
+	struct Unequal_sent_and_received_signals : Exception { };
+
+	struct Counter : Signal_dispatcher_base
+	{
+		Entrypoint &ep;
+
+		Signal_context_capability const cap = ep.manage(*this);
+
+		unsigned long signals     = 0;
+		unsigned long activations = 0;
+
+		Counter(Entrypoint &ep) : ep(ep) { }
+
+		~Counter() { ep.dissolve(*this); }
+
+		void dispatch(unsigned num) override
+		{
+			signals += num;
+			activations++;
+		}
+	};
+
+	struct Sender : Thread
+	{
+		Signal_transmitter transmitters[NUM_CONTEXTS] { };
+
+		unsigned long submitted = 0;
+
+		bool volatile stop { false };
+
+		Sender(Env &env) : Thread(env, "sender", Stack_size { 8*1024 }) { }
+
+		void entry() override
+		{
+			while (!stop) {
+				for (Signal_transmitter &transmitter : transmitters)
+					transmitter.submit();
+				submitted += NUM_CONTEXTS;
+			}
+		}
+	};
+
+	struct Player
+	{
+		Entrypoint ep;
+
+		Signal_handler<Player> handler { ep, *this, &Player::handle };
+
+		Signal_transmitter peer { };
+
+		unsigned long received = 0;
+
+		bool volatile stop { false };
+
+		void handle()
+		{
+			received++;
+			if (!stop)
+				peer.submit();
+		}
+
+		Player(Env &env, char const *name)
+		: ep(env, STACK_SIZE, name, Affinity::Location()) { }
+	};
+
+	Env               &env;
+	Timer::Connection  timer { env };
+
+	void measure_throughput()
+	{
+		Entrypoint ep(env, STACK_SIZE, "counter", Affinity::Location());
+
+		Constructible<Counter> counters[NUM_CONTEXTS] { };
+		Sender                 sender { env };
+
+		for (unsigned i = 0; i < NUM_CONTEXTS; i++) {
+			counters[i].construct(ep);
+			sender.transmitters[i].context(counters[i]->cap);
+		}
+
+		auto total = [&] (auto const &fn) {
+			unsigned long sum = 0;
+			for (Constructible<Counter> &counter : counters)
+				sum += fn(*counter);
+			return sum;
+		};
+
+		uint64_t const start_ms = timer.elapsed_ms();
+		sender.start();
+		timer.msleep(DURATION_MS);
+		sender.stop = true;
+		sender.join();
+		uint64_t const duration_ms = max(timer.elapsed_ms() - start_ms, 1ULL);
+
+		for (unsigned i = 0; i < 10; i++) {
+			if (total([] (Counter const &c) { return c.signals; }) == sender.submitted)
+				break;
+			log("waiting for signals still in flight...");
+			timer.msleep(100);
+		}
+
+		unsigned long const signals     = total([] (Counter const &c) { return c.signals; });
+		unsigned long const activations = total([] (Counter const &c) { return c.activations; });
+
+		log("sender submitted ", sender.submitted, " signals to ",
+		    (unsigned)NUM_CONTEXTS, " contexts");
+		log("handlers received ", signals, " signals in ", activations, " activations");
+		log("throughput: ", signals*1000/duration_ms, " signals/s, ",
+		    activations*1000/duration_ms, " activations/s");
+
+		if (signals != sender.submitted)
+			throw Unequal_sent_and_received_signals();
+
+		for (Constructible<Counter> &counter : counters)
+			counter.destruct();
+	}
+
+	void measure_latency()
+	{
+		Player ping { env, "ping" };
+		Player pong { env, "pong" };
+
+		ping.peer.context(pong.handler);
+		pong.peer.context(ping.handler);
+
+		uint64_t const start_us = timer.elapsed_us();
+		ping.peer.submit();
+		timer.msleep(DURATION_MS);
+		ping.stop = true;
+		pong.stop = true;
+		uint64_t const duration_us = timer.elapsed_us() - start_us;
+
+		/* let the last signal arrive before destructing the players */
+		timer.msleep(100);
+
+		unsigned long const deliveries = max(ping.received + pong.received, 1UL);
+
+		log("ping-pong: ", deliveries, " signal deliveries, ",
+		    "latency: ", duration_us*1000/deliveries, " ns");
+	}
+
+	Entrypoint_signal_bench(Env &env, int id) : Signal_test(id, brief), env(env)
+	{
+		measure_throughput();
+		measure_latency();
+	}
+};
+
 struct Main
 {
 	Env                  &env;
@@ -691,10 +852,12 @@ struct Main
 	Constructible<Many_contexts_test>            test_6 { };
 	Constructible<Nested_test>                   test_7 { };
 	Constructible<Nested_stress_test>            test_8 { };
+	Constructible<Entrypoint_signal_bench>       test_9 { };
 
 	void handle_test_8_done()
 	{
 		test_8.destruct();
+		test_9.construct(env, 9); test_9.destruct();
 		log("--- Signalling test finished ---");
 	}
 
@@ -14,6 +14,8 @@
 /* Genode includes */
 #include <base/component.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
+#include <base/registry.h>
 #include <timer_session/connection.h>
 #include <util/fifo.h>
 #include <util/misc_math.h>
@@ -784,6 +786,121 @@ struct Fast_polling : Test
 };
 
 
+/**
+ * Stress the timeout scheduler with a large number of pending timeouts
+ */
+struct Many_timeouts : Test
+{
+	static constexpr char const *brief = "schedule, discard, and trigger many timeouts";
+
+	enum { NR_OF_TIMEOUTS  = 100000 };
+	enum { MAX_DURATION_US = 2000000 };
+	enum { SLACK_US        = 1000 };
+	enum { DISCARD_MOD     = 4 };
+
+	struct Item : Genode::Timeout_handler
+	{
+		Many_timeouts   &test;
+		unsigned const   index;
+		Genode::Timeout  timeout;
+		uint64_t         requested_us { 0 };
+
+		Item(Many_timeouts &test, unsigned index)
+		: test(test), index(index), timeout(test.timer) { }
+
+		void handle_timeout(Duration curr_time) override {
+			test.handle(*this, curr_time); }
+	};
+
+	Heap             heap  { env.ram(), env.rm() };
+	Registry<Registered<Item>> items { };
+	uint64_t         seed  { 1 };
+	unsigned long    expected_cnt  { 0 };
+	unsigned long    triggered_cnt { 0 };
+	uint64_t         max_late_us   { 0 };
+	uint64_t         sum_late_us   { 0 };
+
+	uint64_t random_us()
+	{
+		seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+		return (seed >> 33) % MAX_DURATION_US;
+	}
+
+	uint64_t now_us() { return timer.curr_time().trunc_to_plain_us().value; }
+
+	void handle(Item &item, Duration curr_time)
+	{
+		uint64_t const curr_us = curr_time.trunc_to_plain_us().value;
+
+		if (curr_us < item.timeout.deadline().value) {
+			error("timeout ", item.index, " triggered ",
+			      item.timeout.deadline().value - curr_us, " us too early");
+			error_cnt++;
+		}
+		uint64_t const late_us = curr_us > item.requested_us ?
+		                         curr_us - item.requested_us : 0;
+
+		max_late_us  = max(max_late_us, late_us);
+		sum_late_us += late_us;
+
+		if (++triggered_cnt < expected_cnt)
+			return;
+
+		log("triggered ", triggered_cnt, " timeouts, delay avg ",
+		    sum_late_us / triggered_cnt, " us, max ", max_late_us, " us");
+		Test::done.submit();
+	}
+
+	Many_timeouts(Env                       &env,
+	              unsigned                  &error_cnt,
+	              Signal_context_capability  done,
+	              unsigned                   id)
+	:
+		Test(env, error_cnt, done, id, brief)
+	{
+		/* half of the timeouts tolerate a slack */
+		uint64_t const schedule_start_us = now_us();
+		for (unsigned i = 0; i < NR_OF_TIMEOUTS; i++) {
+
+			Item &item = *new (heap) Registered<Item>(items, *this, i);
+
+			uint64_t const duration_us = random_us();
+
+			item.requested_us = now_us() + duration_us;
+			item.timeout.schedule_one_shot(Microseconds(duration_us), item,
+			                               Microseconds(i % 2 ? SLACK_US : 0));
+		}
+		uint64_t const schedule_us = max(now_us() - schedule_start_us, 1ULL);
+
+		/* discard a fraction of the timeouts */
+		unsigned long discarded_cnt = 0;
+		uint64_t const discard_start_us = now_us();
+		items.for_each([&] (Item &item) {
+			if (item.index % DISCARD_MOD == 0 && item.timeout.scheduled()) {
+				item.timeout.discard();
+				discarded_cnt++;
+			}
+		});
+		uint64_t const discard_us = max(now_us() - discard_start_us, 1ULL);
+
+		expected_cnt = NR_OF_TIMEOUTS - discarded_cnt;
+
+		log("scheduled ", (unsigned)NR_OF_TIMEOUTS, " timeouts in ", schedule_us, " us "
+		    "(", (unsigned)NR_OF_TIMEOUTS*1000000ULL/schedule_us, " per second)");
+		log("discarded ", discarded_cnt, " timeouts in ", discard_us, " us "
+		    "(", discarded_cnt*1000000ULL/discard_us, " per second)");
+
+		if (triggered_cnt >= expected_cnt)
+			Test::done.submit();
+	}
+
+	~Many_timeouts()
+	{
+		items.for_each([&] (Registered<Item> &item) { destroy(heap, &item); });
+	}
+};
+
+
 struct Main
 {
 	Env                           &env;
@@ -792,10 +909,12 @@ struct Main
 	Constructible<Duration_test>   test_1      { };
 	Constructible<Fast_polling>    test_2      { };
 	Constructible<Mixed_timeouts>  test_3      { };
+	Constructible<Many_timeouts>   test_4      { };
 	Signal_handler<Main>           test_0_done { env.ep(), *this, &Main::handle_test_0_done };
 	Signal_handler<Main>           test_1_done { env.ep(), *this, &Main::handle_test_1_done };
 	Signal_handler<Main>           test_2_done { env.ep(), *this, &Main::handle_test_2_done };
 	Signal_handler<Main>           test_3_done { env.ep(), *this, &Main::handle_test_3_done };
+	Signal_handler<Main>           test_4_done { env.ep(), *this, &Main::handle_test_4_done };
 
 	Main(Env &env) : env(env)
 	{
@@ -823,6 +942,12 @@ struct Main
 	void handle_test_3_done()
 	{
 		test_3.destruct();
+		test_4.construct(env, error_cnt, test_4_done, 4);
+	}
+
+	void handle_test_4_done()
+	{
+		test_4.destruct();
 		if (error_cnt) {
 			error("test failed because of ", error_cnt, " error(s)");
 			env.parent().exit(-1);
@@ -348,15 +348,113 @@ class Test_tracing
 };
 
 
+/**
+ * Throughput of a producer that writes entries as fast as possible while
+ * being concurrently consumed
+ *
+ * Each entry carries its index as payload, which must match the sequence
+ * number assigned by the buffer. All entries must be accounted for as either
+ * consumed or lost.
+ */
+class Test_throughput
+{
+	private:
+
+		struct Producer : Thread
+		{
+			Trace::Buffer            &buffer;
+			unsigned long long const  count;
+			bool volatile             done { false };
+
+			void entry() override
+			{
+				for (unsigned long long i = 0; i < count; i++) {
+					char *dst = buffer.reserve(sizeof(i));
+					memcpy(dst, &i, sizeof(i));
+					buffer.commit(sizeof(i));
+				}
+				done = true;
+			}
+
+			Producer(Env &env, Trace::Buffer &buffer, unsigned long long count)
+			:
+				Thread(env, "producer", Stack_size { 8*1024 }),
+				buffer(buffer), count(count)
+			{ }
+		};
+
+		Attached_ram_dataspace _buffer_ds;
+		Trace::Buffer         &_buffer { *_buffer_ds.local_addr<Trace::Buffer>() };
+		Timer::Connection      _timer;
+
+	public:
+
+		struct Failed : Genode::Exception { };
+
+		Test_throughput(Env &env, size_t buffer_sz, unsigned long long count)
+		:
+			_buffer_ds(env.ram(), env.rm(), buffer_sz), _timer(env)
+		{
+			_buffer.init(buffer_sz);
+
+			Trace_buffer consumer(_buffer);
+			Producer     producer(env, _buffer, count);
+
+			unsigned long long consumed = 0;
+			bool               corrupt  = false;
+
+			uint64_t const start_us = _timer.elapsed_us();
+
+			producer.start();
+
+			for (bool done = false; !done; ) {
+
+				/* sample before consuming to drain the buffer after the end */
+				done = producer.done;
+
+				consumer.for_each_new_entry([&] (Trace::Buffer::Entry &entry) {
+					unsigned long long value = 0;
+					memcpy(&value, entry.data(), sizeof(value));
+					if (entry.length() != sizeof(value) || value != entry.sequence())
+						corrupt = true;
+					consumed++;
+					return true;
+				});
+			}
+
+			uint64_t const duration_us = max(_timer.elapsed_us() - start_us, 1ULL);
+
+			producer.join();
+
+			unsigned long long const lost = consumer.lost_entries();
+
+			log("throughput test: ", count, " entries in ", duration_us, " us (",
+			    count*1000/duration_us, " entries/ms), consumed: ", consumed,
+			    ", lost: ", lost);
+
+			if (corrupt) {
+				error("entry payload does not match sequence number");
+				throw Failed();
+			}
+
+			if (consumed + lost != count) {
+				error("accounted ", consumed + lost, " of ", count, " entries");
+				throw Failed();
+			}
+		}
+};
+
+
 struct Main
 {
 	Constructible<Test_tracing<Generator1>> test_1 { };
 	Constructible<Test_tracing<Generator2>> test_2 { };
+	Constructible<Test_throughput>          test_3 { };
 
 	Main(Env &env)
 	{
 		/* determine buffer size so that Generator1 entries fit perfectly */
-		enum { ENTRY_SIZE = sizeof(Trace::Buffer::Entry) + sizeof(Generator1::Entry) };
+		enum { ENTRY_SIZE = Trace::Simple_buffer::entry_size(sizeof(Generator1::Entry)) };
 		enum { BUFFER_SIZE = 32 * ENTRY_SIZE + 2*sizeof(Trace::Buffer) };
 
 		/* consume as fast as possible */
@@ -371,6 +469,10 @@ struct Main
 		test_2.construct(env, BUFFER_SIZE, 10000, 0);
 		test_2.destruct();
 
+		/* concurrent producer and consumer without delays */
+		test_3.construct(env, 256*1024, 1000*1000);
+		test_3.destruct();
+
 		env.parent().exit(0);
 	}
 };